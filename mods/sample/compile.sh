@@ -0,0 +1,10 @@
+# Builds sample.wasm, precompiles it with wamrc and packs both into sample.o2r.
+# --enable-multi-thread keeps the suspend checks the budget watchdog relies on in AOT code.
+clang --target=wasm32 -O3 -nostdlib -Wl,--no-entry -Wl,--allow-undefined -o sample.wasm sample.c
+wamrc --enable-multi-thread -o sample.aot sample.wasm
+rm -rf pack sample.o2r
+mkdir -p pack/mods
+cp sample.wasm sample.aot pack/mods/
+(cd pack && zip -r ../sample.o2r mods)
+mkdir -p ../../build/mods/
+cp sample.o2r ../../build/mods/sample.o2r
@@ -0,0 +1,57 @@
+// Sample mod for the WebAssembly mod runtime. Built without libc; everything it needs comes from the host.
+#include <stdint.h>
+
+#define IMPORT_FUNC(return_type, name) __attribute__((import_module("env"), import_name(#name))) return_type name
+#define EXPORT_FUNC(name) __attribute__((export_name(#name)))
+
+// Mirrors WasmPlayerState in src/engine/wasm.h
+typedef struct {
+    float pos[3];
+    float velocity[3];
+    float speed;
+    int16_t rotation[3];
+    uint16_t type;
+    uint16_t characterId;
+    int16_t currentRank;
+    int16_t lapCount;
+    int16_t nearestPathPointId;
+} PlayerState;
+
+#define PLAYER_EXISTS 0x8000
+
+IMPORT_FUNC(void, host_log)(const char* message);
+IMPORT_FUNC(void, host_nop)(void);
+IMPORT_FUNC(uint32_t, spawn_actor)(const char* id, float x, float y, float z);
+IMPORT_FUNC(int32_t, get_player_count)(void);
+IMPORT_FUNC(int32_t, get_player_state)(int32_t index, PlayerState* state, uint32_t size);
+
+static int32_t sLastLap = 0;
+
+EXPORT_FUNC(init) void init(void) {
+    host_log("sample mod loaded");
+}
+
+// Drops a sign behind player one each time they start a new lap.
+EXPORT_FUNC(tick) void tick(void) {
+    PlayerState state;
+
+    if (!get_player_state(0, &state, sizeof(state)) || !(state.type & PLAYER_EXISTS)) {
+        return;
+    }
+    if (state.lapCount > sLastLap) {
+        spawn_actor("mk:mario_sign", state.pos[0], state.pos[1], state.pos[2] - 100.0f);
+    }
+    sLastLap = state.lapCount;
+}
+
+// Host call overhead benchmark, see wasm_benchmark_host_calls.
+EXPORT_FUNC(bench_host_calls) void bench_host_calls(uint32_t iterations) {
+    for (uint32_t i = 0; i < iterations; i++) {
+        host_nop();
+    }
+}
+
+EXPORT_FUNC(bench_baseline) void bench_baseline(uint32_t iterations) {
+    for (volatile uint32_t i = 0; i < iterations; i++) {
+    }
+}
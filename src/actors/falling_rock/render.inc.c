@@ -24,7 +24,7 @@ void render_actor_falling_rock(Camera* camera, struct FallingRock* rock) {
     height = is_within_render_distance(camera->pos, rock->pos, camera->rot[1], 400.0f, gCameraZoom[camera - camera1],
                                        4000000.0f);
 
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gSettings.noCulling == 1) {
         height = CLAMP(height, 0.0f, 250000.0f);
     }
 
@@ -32,7 +32,7 @@ void render_actor_item_box(Camera* camera, struct ItemBox* item_box) {
 
     temp_f0 = is_within_render_distance(camera->pos, item_box->pos, camera->rot[1], 0.0f, gCameraZoom[camera - camera1],
                                         4000000.0f);
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gSettings.noCulling == 1) {
         temp_f0 = CLAMP(temp_f0, 0.0f, 600000.0f);
     }
     if (!(temp_f0 < 0.0f) && !(600000.0f < temp_f0)) {
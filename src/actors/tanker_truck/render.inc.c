@@ -17,13 +17,13 @@ void render_actor_tanker_truck(Camera* camera, struct Actor* arg1) {
     f32 temp_f0 = is_within_render_distance(camera->pos, arg1->pos, camera->rot[1], 2500.0f,
                                             gCameraZoom[camera - camera1], 9000000.0f);
 
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gSettings.noCulling == 1) {
         temp_f0 = MAX(temp_f0, 0.0f);
     }
 
     if (!(temp_f0 < 0.0f)) {
 
-        if (CVarGetInteger("gDisableLod", 1) == 1) {
+        if (gSettings.disableLod == 1) {
             temp_f0 = 0.0f;
         }
 
@@ -22,7 +22,7 @@ void render_actor_train_engine(Camera* camera, struct TrainCar* actor) {
     f32 distance = is_within_render_distance(camera->pos, actor->pos, camera->rot[1], 2500.0f,
                                              gCameraZoom[camera - camera1], 9000000.0f);
 
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gSettings.noCulling == 1) {
         distance = MAX(distance, 0.0f);
     }
 
@@ -30,7 +30,7 @@ void render_actor_train_engine(Camera* camera, struct TrainCar* actor) {
         return;
     }
 
-    if (CVarGetInteger("gDisableLod", 1) == 1) {
+    if (gSettings.disableLod == 1) {
         distance = 0.0f;
     }
 
@@ -177,7 +177,7 @@ void render_actor_train_tender(Camera* camera, struct TrainCar* actor) {
     f32 temp_f0 = is_within_render_distance(camera->pos, actor->pos, camera->rot[1], 625.0f,
                                             gCameraZoom[camera - camera1], 9000000.0f);
 
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gSettings.noCulling == 1) {
         temp_f0 = MAX(temp_f0, 0.0f);
     }
 
@@ -185,7 +185,7 @@ void render_actor_train_tender(Camera* camera, struct TrainCar* actor) {
         return;
     }
 
-    if (CVarGetInteger("gDisableLod", 1) == 1) {
+    if (gSettings.disableLod == 1) {
         temp_f0 = 0.0f;
     }
 
@@ -270,7 +270,7 @@ void render_actor_train_passenger_car(Camera* camera, struct TrainCar* actor) {
     f32 temp_f0 = is_within_render_distance(camera->pos, actor->pos, camera->rot[1], 2025.0f,
                                             gCameraZoom[camera - camera1], 9000000.0f);
 
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gSettings.noCulling == 1) {
         temp_f0 = MAX(temp_f0, 0.0f);
     }
 
@@ -278,7 +278,7 @@ void render_actor_train_passenger_car(Camera* camera, struct TrainCar* actor) {
         return;
     }
 
-    if (CVarGetInteger("gDisableLod", 1) == 1) {
+    if (gSettings.disableLod == 1) {
         temp_f0 = 0.0f;
     }
 
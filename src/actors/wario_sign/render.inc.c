@@ -15,7 +15,7 @@ void render_actor_wario_sign(Camera* arg0, struct Actor* arg1) {
     f32 unk =
         is_within_render_distance(arg0->pos, arg1->pos, arg0->rot[1], 0, gCameraZoom[arg0 - camera1], 16000000.0f);
 
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gSettings.noCulling == 1) {
         unk = MAX(unk, 0.0f);
     }
 
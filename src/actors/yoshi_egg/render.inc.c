@@ -23,7 +23,7 @@ void render_actor_yoshi_egg(Camera* arg0, Mat4 arg1, struct YoshiValleyEgg* egg,
         temp_f0 = is_within_render_distance(arg0->pos, egg->pos, arg0->rot[1], 200.0f, gCameraZoom[arg0 - camera1],
                                             16000000.0f);
 
-        if (CVarGetInteger("gNoCulling", 0) == 1) {
+        if (gSettings.noCulling == 1) {
             temp_f0 = MAX(temp_f0, 0.0f);
         }
 
@@ -35,7 +35,7 @@ void render_actor_yoshi_egg(Camera* arg0, Mat4 arg1, struct YoshiValleyEgg* egg,
         temp_f0 = 0.0f;
     }
 
-    if (CVarGetInteger("gDisableLod", 1) == 1) {
+    if (gSettings.disableLod == 1) {
         arg3 = 15;
         temp_f0 = 0.0f;
     }
@@ -14,6 +14,7 @@
 #include "buffers/gfx_output_buffer.h"
 
 #include <string.h>
+#include "port/Settings.h"
 
 #define ALIGN16(val) (((val) + 0xF) & ~0xF)
 
@@ -807,9 +808,9 @@ void audio_init(void) {
     init_sequence_players();
     gAudioLoadLock = 0x76557364;
 
-    audio_set_player_volume(SEQ_PLAYER_LEVEL, CVarGetFloat("gMainMusicVolume", 1.0f));
-    audio_set_player_volume(SEQ_PLAYER_ENV, CVarGetFloat("gEnvironmentVolume", 1.0f));
-    audio_set_player_volume(SEQ_PLAYER_SFX, CVarGetFloat("gSFXMusicVolume", 1.0f));
+    audio_set_player_volume(SEQ_PLAYER_LEVEL, Settings_GetVolume(SETTINGS_VOLUME_MUSIC));
+    audio_set_player_volume(SEQ_PLAYER_ENV, Settings_GetVolume(SETTINGS_VOLUME_ENVIRONMENT));
+    audio_set_player_volume(SEQ_PLAYER_SFX, Settings_GetVolume(SETTINGS_VOLUME_SFX));
 }
 #else
 #ifdef VERSION_EU
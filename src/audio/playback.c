@@ -10,6 +10,7 @@
 #include "audio/data.h"
 #include "audio/seqplayer.h"
 #include "port/Engine.h"
+#include "port/Settings.h"
 
 void note_set_vel_pan_reverb(struct Note* note, f32 velocity, u8 pan, u8 reverbVol) {
     struct NoteSubEu* sub = &note->noteSubEu;
@@ -71,7 +72,7 @@ void note_set_vel_pan_reverb(struct Note* note, f32 velocity, u8 pan, u8 reverbV
         velocity = 1.0f;
     }
 
-    float master_vol = CVarGetFloat("gGameMasterVolume", 1.0f);
+    float master_vol = Settings_GetVolume(SETTINGS_VOLUME_MASTER);
     volLeft *= master_vol;
     volRight *= master_vol;
 
@@ -27,6 +27,7 @@
 #include <assets/mario_raceway_data.h>
 #include <assets/moo_moo_farm_data.h>
 #include "port/Game.h"
+#include "port/Settings.h"
 
 extern s32 D_802BA038;
 extern s16 D_802BA048;
@@ -166,6 +167,7 @@ f32 D_801625FC;
 void update_music_volume(s32 target){
     float volume = (float) target / 127.0f;
     CVarSetFloat("gMainMusicVolume", volume);
+    Settings_MarkDirty();
     audio_set_player_volume(SEQ_PLAYER_LEVEL, volume);
 }
 
@@ -216,6 +218,10 @@ void setup_race(void) {
     } else {
         gNextFreeMemoryAddress = gFreeMemoryCourseAnchor;
     }
+    if (gModeSelection == GRAND_PRIX) {
+        // Prepare the next course of the cup while this one is raced
+        CM_PreloadNextCupCourse();
+    }
 
     // Cow related
     D_8015F702 = 0;
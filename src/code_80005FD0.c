@@ -40,6 +40,7 @@
 
 #include "port/Game.h"
 #include "engine/courses/Course.h"
+#include "port/Settings.h"
 
 s32 unk_code_80005FD0_pad[24];
 Collision D_80162E70;
@@ -674,7 +675,7 @@ s32 set_vehicle_render_distance_flags(Vec3f vehiclePos, f32 renderDistance, s32
             }
         }
     }
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gSettings.noCulling == 1) {
         flag |= (RENDER_VEHICLE << PLAYER_ONE) | (RENDER_VEHICLE << PLAYER_TWO) | (RENDER_VEHICLE << PLAYER_THREE) |
                 (RENDER_VEHICLE << PLAYER_FOUR);
     }
@@ -1958,7 +1959,7 @@ void update_player(s32 playerId) {
                     cpu_TargetSpeed[playerId] = CM_GetProps()->D_0D0096B8[gCCSelection];
                 }
 
-                if (CVarGetInteger("gEnableCustomCC", 0) == 1) {
+                if (gSettings.enableCustomCC == 1) {
 #define calc_a(x, y, x2, y2) (y2 - y) / (x2 - x)
 #define calc_b(x, y, b) y - (b * x)
                     f32 a;
@@ -1967,7 +1968,7 @@ void update_player(s32 playerId) {
 #define calc(table)                                   \
     a = calc_a(50, table[CC_50], 150, table[CC_150]); \
     b = calc_b(50, table[CC_50], a);                  \
-    cpu_TargetSpeed[playerId] = a * CVarGetFloat("gCustomCC", 150.0f) + b;
+    cpu_TargetSpeed[playerId] = a * gSettings.customCC + b;
                     // end of define
                     if ((gIsPlayerInCurve[playerId] == true) || (D_801630E8[playerId] == 1) ||
                         (D_801630E8[playerId] == -1) ||
@@ -1991,7 +1992,7 @@ void update_player(s32 playerId) {
                     cpu_TargetSpeed[playerId] = 3.3333333f;
                 }
                 // Override cpu speed for harder cpu enhancment
-                if (CVarGetInteger("gHarderCPU", 0) == 1) {
+                if (gSettings.harderCPU == 1) {
                     cpu_TargetSpeed[playerId] = player->topSpeed * 1.5f;
                 }
 
@@ -7025,7 +7026,7 @@ void cpu_decisions_branch_item(UNUSED s32 playerId, s16* branch, s32 itemId) {
             break;
     }
 
-    if (CVarGetInteger("gHarderCPU", 0) == 1) {
+    if (gSettings.harderCPU == 1) {
         switch (itemId) {
             case ITEM_NONE:
                 value = -1;
@@ -7107,7 +7108,7 @@ void cpu_use_item_strategy(s32 playerId) {
 
             // Harder CPU Items
             if (((gNumPathPointsTraversed[playerId] + (playerId * 20) + 100) % 8 == 0) && (cpuStrategy->timer >= 512) &&
-                (CVarGetInteger("gHarderCPU", 0) == true)) {
+                (gSettings.harderCPU == true)) {
 
                 cpu_decisions_branch_item(playerId, &cpuStrategy->branch,
                                           hard_cpu_gen_random_item((s16) gLapCountByPlayerId[playerId],
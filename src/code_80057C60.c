@@ -40,6 +40,7 @@
 #include "port/Game.h"
 #include "engine/Matrix.h"
 #include "port/interpolation/FrameInterpolation.h"
+#include "port/Settings.h"
 
 //! @warning this macro is undef'd at the end of this file
 #define MAKE_RGB(r, g, b) (((r) << 0x10) | ((g) << 0x08) | (b << 0x00))
@@ -951,7 +952,7 @@ void func_80058F78(void) {
                 draw_simplified_lap_count(PLAYER_ONE);
                 func_8004EB38(0);
                 if (D_801657E6 != false) {
-                    if (CVarGetInteger("gEnableDigitalSpeedometer", false) == true) {
+                    if (gSettings.enableDigitalSpeedometer == true) {
                         render_digital_speedometer(PLAYER_ONE);
                     }
                     render_speedometer(PLAYER_ONE);
@@ -1662,7 +1663,7 @@ void func_8005A99C(void) {
             if (gPlayerCountSelection1 == 3) {
                 D_801657E8 = true;
             }
-            if (CVarGetInteger("gEditorEnabled", 0) == false) {
+            if (gSettings.editorEnabled == false) {
                 gIsHUDVisible = (s32) 1;
             }
             D_8018D170 = (s32) 1;
@@ -29,6 +29,7 @@ void AActor::VehicleCollision(s32 playerId, Player* player){}
 void AActor::Destroy() {
     // Set uuid to zero.
     memset(uuid, 0, sizeof(uuid));
+    bPendingDestroy = true;
 }
 bool AActor::IsMod() { return false; }
 void AActor::SetLocation(FVector pos) {
@@ -39,3 +40,15 @@ void AActor::SetLocation(FVector pos) {
 FVector AActor::GetLocation() const {
     return FVector(Pos[0], Pos[1], Pos[2]);
 }
+
+size_t AActor::StateSize() const {
+    return sizeof(AActor);
+}
+
+void AActor::WriteState(uint8_t* dest) const {
+    memcpy(dest, (const void*) this, sizeof(AActor));
+}
+
+void AActor::ReadState(const uint8_t* src) {
+    memcpy((void*) this, src, sizeof(AActor));
+}
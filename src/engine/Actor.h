@@ -2,6 +2,8 @@
 
 #include <libultraship.h>
 #include "CoreMath.h"
+#include "SaveState.h"
+#include "ActorHandle.h"
 
 extern "C" {
 #include "macros.h"
@@ -29,6 +31,8 @@ public:
     FVector Scale = {1, 1, 1};
 
     Gfx* Model = NULL;
+    bool bPendingDestroy = false;
+    ActorHandle Handle = ACTOR_HANDLE_NONE; // Assigned by World when the actor is added
 
     virtual ~AActor() = default;  // Virtual destructor for proper cleanup in derived classes
 
@@ -43,6 +47,11 @@ public:
 
     virtual void Destroy();
     virtual bool IsMod();
+
+    // Snapshot hooks used by SaveState. Subclasses override these through SAVE_STATE_TRIVIAL.
+    virtual size_t StateSize() const;
+    virtual void WriteState(uint8_t* dest) const;
+    virtual void ReadState(const uint8_t* src);
 };
 
 }
\ No newline at end of file
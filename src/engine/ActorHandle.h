@@ -0,0 +1,20 @@
+#ifndef ACTOR_HANDLE_H
+#define ACTOR_HANDLE_H
+
+#include <libultraship.h>
+
+/**
+ * @brief Stable reference to an actor in gWorldInstance.Actors.
+ *
+ * The low 16 bits hold the slot index and the high 16 bits the slot's generation. The generation is bumped
+ * whenever the slot's actor is freed, so a handle kept past its actor's lifetime resolves to NULL instead of
+ * whatever actor reuses the slot.
+ */
+typedef u32 ActorHandle;
+
+#define ACTOR_HANDLE_NONE 0xFFFFFFFF
+#define ACTOR_HANDLE_MAKE(index, generation) ((ActorHandle) (((u32) (generation) << 16) | ((u32) (index) & 0xFFFF)))
+#define ACTOR_HANDLE_INDEX(handle) ((handle) & 0xFFFF)
+#define ACTOR_HANDLE_GENERATION(handle) ((handle) >> 16)
+
+#endif // ACTOR_HANDLE_H
@@ -10,11 +10,7 @@
 #include "actors/Tree.h"
 #include "vehicles/Train.h"
 #include "vehicles/Boat.h"
-#include "vehicles/Bus.h"
-#include "vehicles/Truck.h"
-#include "vehicles/Car.h"
-#include "vehicles/Truck.h"
-#include "vehicles/TankerTruck.h"
+#include "vehicles/Traffic.h"
 
 #include "objects/Bat.h"
 #include "objects/BombKart.h"
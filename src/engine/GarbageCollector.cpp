@@ -1,45 +1,86 @@
 #include "GarbageCollector.h"
 #include "World.h"
+#include "port/Game.h"
+
+#include <algorithm>
+#include <unordered_set>
 
 void RunGarbageCollector() {
-    //CleanActors();
+    CleanActors();
     CleanObjects();
     CleanStaticMeshActors();
 }
 
+/**
+ * C code refers to actors by their index in gWorldInstance.Actors, so a live actor must never move.
+ * Only the pending destroy actors at the end of the list are reclaimed; a dead actor in the middle
+ * is kept until every actor after it is gone too.
+ */
 void CleanActors() {
-    // for (auto actor = gWorldInstance.Actors.begin(); actor != gWorldInstance.Actors.end();) {
-    //     OObject* act = *actor; // Get a mutable copy
-    //     if (act->PendingDestroy) {
-    //         delete act;
-    //         actor = gWorldInstance.Objects.erase(actor); // Remove from container
-    //         continue;
-    //     }
-    //     actor++;
-    // }
+    auto& actors = gWorldInstance.Actors;
+    auto firstDead = actors.end();
+    while ((firstDead != actors.begin()) && (*(firstDead - 1))->bPendingDestroy) {
+        firstDead--;
+    }
+    if (firstDead == actors.end()) {
+        return;
+    }
+
+    std::unordered_set<const void*> despawnFlags;
+    for (auto actor = firstDead; actor != actors.end(); actor++) {
+        despawnFlags.insert(&(*actor)->Type);
+    }
+    gEditor.RemoveObjectsByDespawnFlag(despawnFlags);
+
+    gWorldInstance.ReleaseActorSlots(firstDead - actors.begin());
+    for (auto actor = firstDead; actor != actors.end(); actor++) {
+        gWorldInstance.DestroyActor(*actor);
+    }
+    actors.erase(firstDead, actors.end());
+    gWorldInstance.InvalidateSchedule();
 }
 
 void CleanStaticMeshActors() {
-    for (auto actor = gWorldInstance.StaticMeshActors.begin(); actor != gWorldInstance.StaticMeshActors.end();) {
-        StaticMeshActor* act = *actor; // Get a mutable copy
-        if (act->bPendingDestroy) {
-            delete act;
-            actor = gWorldInstance.StaticMeshActors.erase(actor); // Remove from container
-            continue;
-        } else {
-            actor++;
-        }
+    auto& actors = gWorldInstance.StaticMeshActors;
+    auto firstDead = std::stable_partition(actors.begin(), actors.end(),
+                                           [](StaticMeshActor* actor) { return !actor->bPendingDestroy; });
+    if (firstDead == actors.end()) {
+        return;
     }
+
+    std::unordered_set<const void*> despawnFlags;
+    for (auto actor = firstDead; actor != actors.end(); actor++) {
+        despawnFlags.insert(&(*actor)->bPendingDestroy);
+    }
+    gEditor.RemoveObjectsByDespawnFlag(despawnFlags);
+
+    for (auto actor = firstDead; actor != actors.end(); actor++) {
+        delete *actor;
+    }
+    actors.erase(firstDead, actors.end());
 }
 
+/**
+ * Objects are only referenced through their gObjectList slot (_objectIndex), never by their position in
+ * gWorldInstance.Objects, so survivors can be compacted freely.
+ */
 void CleanObjects() {
-    for (auto object = gWorldInstance.Objects.begin(); object != gWorldInstance.Objects.end();) {
-        OObject* obj = *object; // Get a mutable copy
-        if (obj->bPendingDestroy) {
-            delete obj;
-            object = gWorldInstance.Objects.erase(object); // Remove from container
-            continue;
-        }
-        object++;
+    auto& objects = gWorldInstance.Objects;
+    auto firstDead =
+        std::stable_partition(objects.begin(), objects.end(), [](OObject* object) { return !object->bPendingDestroy; });
+    if (firstDead == objects.end()) {
+        return;
+    }
+
+    std::unordered_set<const void*> despawnFlags;
+    for (auto object = firstDead; object != objects.end(); object++) {
+        despawnFlags.insert(&(*object)->_objectIndex);
+    }
+    gEditor.RemoveObjectsByDespawnFlag(despawnFlags);
+
+    for (auto object = firstDead; object != objects.end(); object++) {
+        gWorldInstance.DestroyObject(*object);
     }
+    objects.erase(firstDead, objects.end());
+    gWorldInstance.InvalidateSchedule();
 }
@@ -3,7 +3,13 @@
 #include "engine/courses/Course.h"
 
 extern "C" {
-#include "memory.h"
+#include "code_800029B0.h"
+}
+
+ModelLoader::~ModelLoader() {
+    if (_preload.valid()) {
+        course_geometry_free(_preload.get());
+    }
 }
 
 void ModelLoader::Add(LoadModelList list) {
@@ -11,84 +17,148 @@ void ModelLoader::Add(LoadModelList list) {
 }
 
 void ModelLoader::Load() {
-    if (_hasRan) { // Ensure this does not get ran multiple times
-        printf("ModelLoader.cpp has already been ran once.\n");
-        return;
+    // Extract each course once, for every list that uses it.
+    while (!_deferredList.empty()) {
+        std::shared_ptr<Course> course = _deferredList.front().course;
+        PreloadRequest request = MakeRequest(course);
+        request.lists = TakeLists(course);
+
+        CourseGeometryPtr geometry = BuildGeometry(request);
+        if (geometry == nullptr) {
+            printf("ModelLoader: Failed to extract models from course: %s\n", course->Props.Name);
+            continue;
+        }
+
+        for (const auto& list : request.lists) {
+            Extract(geometry.get(), list);
+        }
     }
-    _hasRan = true;
+}
 
-    // Set to track processed courses
-    std::unordered_set<std::shared_ptr<Course>> processedCourses;
+void ModelLoader::Preload(std::shared_ptr<Course> course) {
+    if ((course == nullptr) || _preload.valid()) {
+        return;
+    }
 
-    for (auto& list : _deferredList) {
-        // Check if the course has already been processed
-        if (processedCourses.find(list.course) != processedCourses.end()) {
-            continue; // Skip if already processed
-        }
+    PreloadRequest request = MakeRequest(course);
+    request.lists = TakeLists(course);
 
-        // Process the course
-        ModelLoader::Extract(list.course);
+    _preload = std::async(std::launch::async, &ModelLoader::RunPreload, std::move(request));
+}
 
-        // Mark this course as processed
-        processedCourses.insert(list.course);
+void ModelLoader::FinishPreload() {
+    if (!_preload.valid()) {
+        return;
     }
+    course_geometry_cache_insert(_preload.get());
 }
 
-void ModelLoader::Extract(std::shared_ptr<Course> course) {
-    std::shared_ptr<Course> saveCourse = gWorldInstance.CurrentCourse;
-    gWorldInstance.CurrentCourse = course; // Quick hack so that `get_texture` will find the right textures.
+ModelLoader::PreloadRequest ModelLoader::MakeRequest(const std::shared_ptr<Course>& course) {
+    PreloadRequest request;
+    request.vtx = course->vtx;
+    request.gfx = course->gfx;
+    request.gfxSize = course->gfxSize;
+    request.textures = course->Props.textures;
+    request.trackSections = course->TrackSectionsPtr;
+    request.isMirrorMode = gIsMirrorMode;
+    request.vtxStretch[0] = gVtxStretch[0];
+    request.vtxStretch[1] = gVtxStretch[1];
+    request.vtxStretch[2] = gVtxStretch[2];
+    return request;
+}
 
-    size_t vtxSize = (ResourceGetSizeByName(course->vtx) / sizeof(CourseVtx)) * sizeof(Vtx);
-    size_t texSegSize;
+std::vector<ModelLoader::LoadModelList> ModelLoader::TakeLists(const std::shared_ptr<Course>& course) {
+    std::vector<LoadModelList> lists;
+    auto it = std::remove_if(_deferredList.begin(), _deferredList.end(), [&](const LoadModelList& list) {
+        if (list.course == course) {
+            lists.push_back(list);
+            return true;
+        }
+        return false;
+    });
+    _deferredList.erase(it, _deferredList.end());
+    return lists;
+}
 
-    // Convert course vtx to vtx
-    Vtx* vtx = reinterpret_cast<Vtx*>(malloc(vtxSize));
-    if (vtx == NULL) {
-        printf("ModelLoader: Failed to allocate vertex buffer for course: %s\n", course->Props.Name);
-        return;
+ModelLoader::CourseGeometryPtr ModelLoader::BuildGeometry(PreloadRequest& request) {
+    if ((request.vtx == nullptr) || (request.gfx == nullptr)) {
+        return nullptr;
     }
-    func_802A86A8(reinterpret_cast<CourseVtx*>(LOAD_ASSET_RAW(course->vtx)), vtx, vtxSize / sizeof(Vtx));
+    return CourseGeometryPtr(course_geometry_build(request.vtx, request.gfx, request.gfxSize, request.textures,
+                                                   request.isMirrorMode, request.vtxStretch));
+}
 
-    // Extract packed DLs
-    u8* packed = reinterpret_cast<u8*>(LOAD_ASSET_RAW(course->gfx));
-    Gfx* gfx = reinterpret_cast<Gfx*>(malloc(sizeof(Gfx) * course->gfxSize)); // Size of unpacked DLs
-    if (gfx == NULL) {
-        printf("ModelLoader: Failed to allocate course displaylist memory for course: %s\n", course->Props.Name);
-        return;
+// Worker thread. Must not touch game state; everything it needs is in the request.
+CourseGeometry* ModelLoader::RunPreload(PreloadRequest request) {
+    // Custom tracks are unpacked while they load. Reading the resources still moves archive reads and
+    // decompression off the game thread.
+    if (!request.trackSections.empty()) {
+        LOAD_ASSET_RAW(request.trackSections.c_str());
     }
 
-    displaylist_unpack(reinterpret_cast<uintptr_t*>(gfx), reinterpret_cast<uintptr_t>(packed), 0);
-
-    // Now that the data has been retrieved, extract the model data and save to provided buffers.
-    for (auto& list : _deferredList) {
-        // Ensure the list matches the course being extracted.
-        if (list.course != course) {
-            return;
+    if (request.textures != nullptr) {
+        for (const course_texture* asset = request.textures; asset->addr; asset++) {
+            LOAD_ASSET_RAW(asset->addr);
         }
+    }
 
-        memcpy(list.vtxBuffer, &vtx[list.vtxStart], list.vtxBufferSize * sizeof(Vtx));
-        memcpy(list.gfxBuffer, &gfx[list.gfxStart], list.gfxBufferSize * sizeof(Gfx));
+    CourseGeometryPtr geometry = BuildGeometry(request);
+    if (geometry == nullptr) {
+        return nullptr;
+    }
+
+    for (const auto& list : request.lists) {
+        Extract(geometry.get(), list);
+    }
 
-        UpdateVtx(list);
+    return geometry.release();
+}
 
+void ModelLoader::Extract(const CourseGeometry* geometry, const LoadModelList& list) {
+    if ((list.vtxStart + list.vtxBufferSize > geometry->vtxCount) ||
+        (list.gfxStart + list.gfxBufferSize > geometry->gfxCount)) {
+        printf("ModelLoader: Model list is out of bounds of course %s\n", geometry->gfxAsset);
+        return;
     }
 
-    free(vtx);
-    free(gfx);
+    // Copy from the pristine buffers in case the course is currently loaded and has modified its geometry.
+    memcpy(list.vtxBuffer, &geometry->vtxPristine[list.vtxStart], list.vtxBufferSize * sizeof(Vtx));
+    memcpy(list.gfxBuffer, &geometry->gfxPristine[list.gfxStart], list.gfxBufferSize * sizeof(Gfx));
 
-    _deferredList.clear();
-    gWorldInstance.CurrentCourse = saveCourse;
+    UpdateVtx(geometry, list);
 }
 
-void ModelLoader::UpdateVtx(LoadModelList list) {
-    for (size_t i = 0; i < list.gfxStart + list.gfxBufferSize; i++) {
-        Gfx* gfx = &list.gfxBuffer[i];
+/**
+ * The unpacked commands point into the course's buffers. Re-point them at the list's own buffers.
+ */
+void ModelLoader::UpdateVtx(const CourseGeometry* geometry, const LoadModelList& list) {
+    uintptr_t vtxBegin = reinterpret_cast<uintptr_t>(&geometry->vtx[list.vtxStart]);
+    uintptr_t vtxEnd = reinterpret_cast<uintptr_t>(&geometry->vtx[list.vtxStart + list.vtxBufferSize]);
+    uintptr_t gfxBegin = reinterpret_cast<uintptr_t>(&geometry->gfx[list.gfxStart]);
+    uintptr_t gfxEnd = reinterpret_cast<uintptr_t>(&geometry->gfx[list.gfxStart + list.gfxBufferSize]);
 
-        // Check if the current Gfx command is G_VTX
-        if (GFX_GET_OPCODE(gfx->words.w0) == (G_VTX << 24)) {
-            // Re-write the vtx to point at the provided vtx buffer.
-            size_t vtxIndex = (gfx->words.w1 / sizeof(Vtx)) - list.vtxStart;
-            gfx->words.w1 = reinterpret_cast<uintptr_t>(&list.vtxBuffer[vtxIndex]);
+    for (size_t i = 0; i < list.gfxBufferSize; i++) {
+        Gfx* gfx = &list.gfxBuffer[i];
+        uintptr_t opcode = GFX_GET_OPCODE(gfx->words.w0);
+        uintptr_t addr = gfx->words.w1;
+
+        if (opcode == (G_VTX << 24)) {
+            if ((addr >= vtxBegin) && (addr < vtxEnd)) {
+                gfx->words.w1 = reinterpret_cast<uintptr_t>(&list.vtxBuffer[(addr - vtxBegin) / sizeof(Vtx)]);
+            } else {
+                printf("ModelLoader: Vtx load at gfx %zu is outside of the extracted vtx\n", i);
+                gfx->words.w0 = (uintptr_t) (uint8_t) G_NOOP << 24;
+                gfx->words.w1 = 0;
+            }
+        } else if (opcode == (G_DL << 24)) {
+            if ((addr >= gfxBegin) && (addr < gfxEnd)) {
+                gfx->words.w1 = reinterpret_cast<uintptr_t>(&list.gfxBuffer[(addr - gfxBegin) / sizeof(Gfx)]);
+            } else {
+                // The course geometry may be freed at any time, so never leave a call into it.
+                printf("ModelLoader: Displaylist call at gfx %zu is outside of the extracted gfx\n", i);
+                gfx->words.w0 = (uintptr_t) (uint8_t) G_NOOP << 24;
+                gfx->words.w1 = 0;
+            }
         }
     }
 }
@@ -2,9 +2,11 @@
 
 #include <libultraship.h>
 #include "engine/courses/Course.h"
+#include <future>
 
 extern "C" {
 #include "common_structs.h"
+#include "memory.h"
 }
 
 class Course;
@@ -14,8 +16,11 @@ class Course;
  * Lists are deferred until load time so that models that use the same course may all use the same extraction
  * 
  * Note ensure that the buffers passed to LoadModelList are big enough for the requested data.
+ * Lists that reach outside of the course's vtx or gfx are rejected.
  * 
- * This class should only be ran once.
+ * Load() extracts every deferred list on the calling thread.
+ * Preload() does the same work for a single course on a worker thread and additionally keeps the converted
+ * course geometry, so the next Course::Load() of that course skips vertex conversion and displaylist unpacking.
  * 
  * 
  * Usage:
@@ -48,16 +53,55 @@ public:
         size_t vtxStart; // The starting point to extract data in NumVtx
     };
 
+    ~ModelLoader();
+
     void Add(LoadModelList list);
     void Load();
+
+    /**
+     * Starts loading a course's assets on a worker thread. Only one preload runs at a time; while one is in flight
+     * further requests are ignored. Game thread only.
+     */
+    void Preload(std::shared_ptr<Course> course);
+
+    /**
+     * Waits for the preload in flight, if any, and hands its geometry to the course geometry cache.
+     * Must be called on the game thread before a course is loaded.
+     */
+    void FinishPreload();
+
+    bool IsPreloading() const {
+        return _preload.valid();
+    }
+
 private:
-    struct CourseMap {
+    struct CourseGeometryDeleter {
+        void operator()(CourseGeometry* geometry) const {
+            course_geometry_free(geometry);
+        }
+    };
+    using CourseGeometryPtr = std::unique_ptr<CourseGeometry, CourseGeometryDeleter>;
 
+    // Everything the worker needs, copied from the course on the game thread.
+    struct PreloadRequest {
+        const char* vtx;
+        const char* gfx;
+        size_t gfxSize;
+        const course_texture* textures;
+        std::string trackSections;
+        s32 isMirrorMode;
+        Vec3f vtxStretch;
+        std::vector<LoadModelList> lists;
     };
 
-    void Extract(std::shared_ptr<Course> course);
-    void UpdateVtx(LoadModelList list);
+    static CourseGeometryPtr BuildGeometry(PreloadRequest& request);
+    static CourseGeometry* RunPreload(PreloadRequest request);
+    static PreloadRequest MakeRequest(const std::shared_ptr<Course>& course);
+    static void Extract(const CourseGeometry* geometry, const LoadModelList& list);
+    static void UpdateVtx(const CourseGeometry* geometry, const LoadModelList& list);
+
+    std::vector<LoadModelList> TakeLists(const std::shared_ptr<Course>& course);
 
     std::vector<LoadModelList> _deferredList;
-    bool _hasRan = false;
+    std::future<CourseGeometry*> _preload;
 };
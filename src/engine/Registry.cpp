@@ -1,59 +1,104 @@
-// #include <vector>
-// #include <functional>
-// #include <iostream>
-// #include <map>
-
-// #include "Registry.h"
-// #include "Course.h"
-// #include "port/Game.h"
-
-// template <class T> Registry<T>::Registry() {
-// }
-
-// template <class T> void Registry<T>::Add(std::string id, std::function<T*()> fn) {
-//     // need to handle duplicate registration
-//     ContentVault[id] = fn;
-// }
-
-// template <class T>
-// void Registry<T>::AddArgs(std::string id) {
-//     ArgsVault[id] = [](Args&&... args) -> T* {
-//         return new T(std::forward<Args>(args)...);
-//     };
-// }
-
-// template <class T>
-// T* Registry<T>::Get(std::string id) {
-//     auto it = ContentVault.find(id);
-//     if (it != ContentVault.end()) {
-//         return it->second();
-//     }
-//     return nullptr;
-// }
-
-// // Available Registries
-// Registry<Course> Courses;
-// Registry<Cup> Cups;
-// Registry<AActor> Actors;
-
-// void AddCourse(std::string id, Course* course) {
-//     Courses.Add(id, [course]() { return course; });
-//     course->Id = id;
-// }
-
-// void AddCup(std::string id, Cup* cup) {
-//     Cups.Add(id, [cup]() { return cup; });
-//     //cup->Id = id;
-// }
-
-// void AddActor(std::string id, AActor* actor) {
-//     Actors.Add(id, [actor]() { return actor; });
-// }
-
-// void AddStockContent() {
-//     AddActor("mk:banana", new AMarioSign({0, 0, 0}));
-// }
-
-// template class Registry<Course>;
-// template class Registry<Cup>;
-// template class Registry<AActor>;
+#include <libultraship.h>
+#include <deque>
+
+#include "Registry.h"
+#include "World.h"
+#include "AllActors.h"
+
+extern "C" {
+#include "waypoints.h"
+}
+
+namespace {
+
+// Deque so references returned by GetContentName survive later interning.
+std::deque<std::string> sContentNames = { "" };
+std::unordered_map<std::string, ContentId> sContentIds;
+
+} // namespace
+
+ContentId InternContentId(std::string_view name) {
+    if (name.empty()) {
+        return CONTENT_ID_NONE;
+    }
+
+    auto [it, inserted] = sContentIds.try_emplace(std::string(name), (ContentId) sContentNames.size());
+    if (inserted) {
+        sContentNames.push_back(it->first);
+    }
+    return it->second;
+}
+
+ContentId FindContentId(std::string_view name) {
+    auto it = sContentIds.find(std::string(name));
+    return (it != sContentIds.end()) ? it->second : CONTENT_ID_NONE;
+}
+
+const std::string& GetContentName(ContentId id) {
+    return (id < sContentNames.size()) ? sContentNames[id] : sContentNames[CONTENT_ID_NONE];
+}
+
+// Available Registries
+Registry<std::shared_ptr<Course>> gCourseRegistry;
+Registry<Cup*> gCupRegistry;
+Registry<ActorFactory> gActorRegistry;
+Registry<ObjectFactory> gObjectRegistry;
+
+static void AddActor(const char* id, const char* name, std::function<AActor*(const FVector&)> create) {
+    gActorRegistry.Add(id, { name, std::move(create) });
+}
+
+static void AddObject(const char* id, const char* name, std::function<OObject*(const FVector&)> create) {
+    gObjectRegistry.Add(id, { name, std::move(create) });
+}
+
+// Editor spawned traffic gets its own group of one vehicle
+static AActor* SpawnTraffic(ATraffic::Kind kind) {
+    auto traffic = new ATraffic();
+    traffic->Spawn(kind, 2.0f, 2.5f, &gTrackPaths[0][0], 0);
+    return traffic;
+}
+
+/**
+ * Registers the stock actors and objects that can be spawned from the editor.
+ * Courses and cups are registered through World::AddCourse and World::AddCup.
+ */
+void AddStockContent() {
+    AddActor("mk:mario_sign", "Mario Sign", [](const FVector& pos) { return new AMarioSign(pos); });
+    AddActor("mk:wario_sign", "Wario Sign", [](const FVector& pos) { return new AWarioSign(pos); });
+    AddActor("mk:cloud", "Cloud", [](const FVector& pos) { return new ACloud(pos); });
+    AddActor("mk:finishline", "Finishline", [](const FVector& pos) { return new AFinishline(pos); });
+    AddActor("mk:ghostship", "Ghostship", [](const FVector& pos) { return new AShip(pos, AShip::Skin::GHOSTSHIP); });
+    AddActor("mk:ship_1", "Ship_1", [](const FVector& pos) { return new AShip(pos, AShip::Skin::SHIP2); });
+    AddActor("mk:ship_2", "Ship_2", [](const FVector& pos) { return new AShip(pos, AShip::Skin::SHIP3); });
+    AddActor("mk:spaghetti_ship", "SpaghettiShip", [](const FVector& pos) { return new ASpaghettiShip(pos); });
+    AddActor("mk:starship", "Starship", [](const FVector& pos) { return new AStarship(pos); });
+    AddActor("mk:train", "Train", [](const FVector& pos) { return new ATrain(ATrain::TenderStatus::HAS_TENDER, 4, 2.5f, 0); });
+    AddActor("mk:boat", "Boat", [](const FVector& pos) { return new ABoat((0.6666666f)/4, 0); });
+    AddActor("mk:bus", "Bus", [](const FVector& pos) { return SpawnTraffic(ATraffic::Kind::BUS); });
+    AddActor("mk:car", "Car", [](const FVector& pos) { return SpawnTraffic(ATraffic::Kind::CAR); });
+    AddActor("mk:truck", "Truck", [](const FVector& pos) { return SpawnTraffic(ATraffic::Kind::TRUCK); });
+    AddActor("mk:tanker_truck", "Tanker Truck", [](const FVector& pos) { return SpawnTraffic(ATraffic::Kind::TANKER_TRUCK); });
+
+    AddObject("mk:bat", "Bat", [](const FVector& pos) { return new OBat(pos, IRotator(0, 0, 0)); });
+    AddObject("mk:bomb_kart", "Bomb Kart", [](const FVector& pos) { return new OBombKart(pos, &gTrackPaths[0][0], 0, 0, 0.8333333f); });
+    // AddObject("mk:boos", "Boos", [](const FVector& pos) { return new OBoos(pos, &gTrackPaths[0][0], 0, 0, 0.8333333f); });
+    AddObject("mk:cheep_cheep", "CheepCheep", [](const FVector& pos) { return new OCheepCheep(pos, OCheepCheep::CheepType::RACE, IPathSpan(0, 10)); });
+    AddObject("mk:crab", "Crab", [](const FVector& pos) { return new OCrab(FVector2D(0, 10), FVector2D(20, 10)); });
+    AddObject("mk:chain_chomp", "ChainChomp", [](const FVector& pos) { return new OChainChomp(); });
+    AddObject("mk:flagpole", "Flagpole", [](const FVector& pos) { return new OFlagpole(pos, 0); });
+    AddObject("mk:hedgehog", "Hedgehog", [](const FVector& pos) { return new OHedgehog(pos, FVector2D(0, 10), 0); });
+    AddObject("mk:hot_air_balloon", "HotAirBalloon", [](const FVector& pos) { return new OHotAirBalloon(pos); });
+    AddObject("mk:lakitu", "Lakitu", [](const FVector& pos) { return new OLakitu(0, OLakitu::LakituType::STARTER); });
+    // AddObject("mk:mole", "Mole", [](const FVector& pos) { return new OMole(pos, ); }); // <-- Needs a group
+    AddObject("mk:chick_penguin", "Chick Penguin", [](const FVector& pos) { return new OPenguin(pos, 0, OPenguin::PenguinType::CHICK, OPenguin::Behaviour::SLIDE3); });
+    AddObject("mk:penguin", "Penguin", [](const FVector& pos) { return new OPenguin(pos, 0, OPenguin::PenguinType::ADULT, OPenguin::Behaviour::CIRCLE); });
+    AddObject("mk:emperor_penguin", "Emperor Penguin", [](const FVector& pos) { return new OPenguin(pos, 0, OPenguin::PenguinType::EMPEROR, OPenguin::Behaviour::STRUT); });
+    AddObject("mk:seagull", "Seagull", [](const FVector& pos) { return new OSeagull(pos); });
+    AddObject("mk:thwomp", "Thwomp", [](const FVector& pos) { return new OThwomp(pos.x, pos.z, 0, 1.0f, 0, 0, 2.0f); });
+    AddObject("mk:trashbin", "Trashbin", [](const FVector& pos) { return new OTrashBin(pos, IRotator(0, 0, 0), 1.0f, OTrashBin::Behaviour::MUNCHING); });
+    AddObject("mk:trophy", "Trophy", [](const FVector& pos) { return new OTrophy(pos, OTrophy::TrophyType::GOLD_150, OTrophy::Behaviour::ROTATE2); });
+    AddObject("mk:snowman", "Snowman", [](const FVector& pos) { return new OSnowman(pos); });
+    AddObject("mk:podium", "Podium", [](const FVector& pos) { return new OPodium(pos); });
+    AddObject("mk:balloons", "Balloons", [](const FVector& pos) { return new OGrandPrixBalloons(pos); });
+}
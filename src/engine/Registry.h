@@ -1,33 +1,146 @@
-// #pragma once
-
-// #include "Course.h"
-// #include "Cup.h"
-// #include <unordered_map>
-// #include "AllActors.h"
-// #include "Actor.h"
-// #include "objects/Object.h"
-
-// class AActor; // <-- Forward delare
-
-// template <class T> class Registry {
-//   public:
-//   Registry();
-//   void Add(std::string name, std::function<T*()>);
-  
-//   template <typename... Args>
-//   void AddArgs(std::string id);
-//   T* Get(std::string id);
-// private:
-//   std::unordered_map<std::string, std::function<T*()>> ContentVault;
-//   std::map<std::string, std::function<T*(Args&&...)>> ArgsVault;
-// };
-
-// void AddCourse(std::string id, Course* course);
-// void AddCup(std::string id, Cup* cup);
-// void AddActor(std::string id, AActor* actor);
-
-// void AddStockContent();
-
-// extern Registry<Course> Courses;
-// extern Registry<Cup> Cups;
-// extern Registry<AActor> Actors;
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+#include "CoreMath.h"
+
+class AActor; // <-- Forward declare
+class OObject;
+class Course;
+class Cup;
+
+/**
+ * @brief Interned content identifier, e.g. "mk:mario_raceway".
+ *
+ * A name is hashed once when it is interned; every lookup after that is an integer compare.
+ * Interning is not thread safe and is expected to happen on the game thread.
+ */
+typedef uint32_t ContentId;
+#define CONTENT_ID_NONE 0
+
+ContentId InternContentId(std::string_view name);
+ContentId FindContentId(std::string_view name); // Returns CONTENT_ID_NONE instead of interning an unknown name
+const std::string& GetContentName(ContentId id);
+
+/**
+ * @brief Content of one kind, keyed by interned id and optionally by concrete type.
+ *
+ * Entries keep their registration order so browsers list content in a stable order.
+ */
+template <class T> class Registry {
+public:
+    struct Entry {
+        ContentId Id;
+        std::type_index Type;
+        T Value;
+    };
+
+    /**
+     * Registers value under name. Returns false if the name is empty or already taken.
+     * Only the first entry registered for a given type is returned by GetByType.
+     */
+    bool Add(std::string_view name, T value, std::type_index type = typeid(void)) {
+        if (name.empty()) {
+            printf("[Registry] Refusing to register content without an id\n");
+            return false;
+        }
+
+        ContentId id = InternContentId(name);
+        if (mById.find(id) != mById.end()) {
+            printf("[Registry] Duplicate content id %s\n", GetContentName(id).c_str());
+            return false;
+        }
+
+        mById[id] = mEntries.size();
+        if (type != std::type_index(typeid(void))) {
+            mByType.emplace(type, mEntries.size());
+        }
+        mEntries.push_back({ id, type, std::move(value) });
+        return true;
+    }
+
+    bool Remove(ContentId id) {
+        auto it = mById.find(id);
+        if (it == mById.end()) {
+            return false;
+        }
+
+        mEntries.erase(mEntries.begin() + it->second);
+        Reindex();
+        return true;
+    }
+
+    const T* Get(ContentId id) const {
+        auto it = mById.find(id);
+        return (it != mById.end()) ? &mEntries[it->second].Value : nullptr;
+    }
+
+    const T* Get(std::string_view name) const {
+        return Get(FindContentId(name));
+    }
+
+    const T* GetByType(std::type_index type) const {
+        auto it = mByType.find(type);
+        return (it != mByType.end()) ? &mEntries[it->second].Value : nullptr;
+    }
+
+    template <typename U> const T* GetByType() const {
+        return GetByType(typeid(U));
+    }
+
+    const std::vector<Entry>& GetEntries() const {
+        return mEntries;
+    }
+
+    void Clear() {
+        mEntries.clear();
+        mById.clear();
+        mByType.clear();
+    }
+
+private:
+    void Reindex() {
+        mById.clear();
+        mByType.clear();
+        for (size_t i = 0; i < mEntries.size(); i++) {
+            mById[mEntries[i].Id] = i;
+            if (mEntries[i].Type != std::type_index(typeid(void))) {
+                mByType.emplace(mEntries[i].Type, i);
+            }
+        }
+    }
+
+    std::vector<Entry> mEntries;
+    std::unordered_map<ContentId, size_t> mById;
+    std::unordered_map<std::type_index, size_t> mByType;
+};
+
+/**
+ * @brief Spawns an actor or object for the editor's content browser.
+ */
+struct ActorFactory {
+    const char* Name; // Display name
+    std::function<AActor*(const FVector&)> Create;
+};
+
+struct ObjectFactory {
+    const char* Name; // Display name
+    std::function<OObject*(const FVector&)> Create;
+};
+
+// Available Registries
+extern Registry<std::shared_ptr<Course>> gCourseRegistry;
+extern Registry<Cup*> gCupRegistry;
+extern Registry<ActorFactory> gActorRegistry;
+extern Registry<ObjectFactory> gObjectRegistry;
+
+void AddStockContent();
@@ -1,6 +1,7 @@
 #include "Rulesets.h"
 #include "objects/Thwomp.h"
 #include "objects/Trophy.h"
+#include "port/Settings.h"
 
 extern "C" {
 #include "code_800029B0.h"
@@ -15,7 +16,7 @@ void Rulesets::PreLoad() {
 // Just before BeginPlay() (used to spawn actors) is ran.
 // Only runs a single time at the beginning of a track.
 void Rulesets::PreInit() {
-    if (CVarGetInteger("gDisableItemboxes", false) == true) {
+    if (gSettings.disableItemboxes == true) {
         gPlaceItemBoxes = false;
     } else {
         gPlaceItemBoxes = true;
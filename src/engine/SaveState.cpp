@@ -0,0 +1,599 @@
+#include <libultraship.h>
+#include <algorithm>
+#include <typeinfo>
+#include <unordered_set>
+
+#include "SaveState.h"
+#include "World.h"
+#include "port/Game.h"
+
+extern "C" {
+#include "main.h"
+#include "camera.h"
+#include "objects.h"
+#include "vehicles.h"
+#include "bomb_kart.h"
+#include "code_80005FD0.h"
+#include "code_80057C60.h"
+#include "replays.h"
+
+// Re-declared with their sizes so the region table below can use sizeof.
+extern Player gPlayers[NUM_PLAYERS];
+extern Camera cameras[8];
+extern Object gObjectList[OBJECT_LIST_SIZE];
+extern hud_player playerHUD[4];
+extern u16 gRandomSeed16;
+extern s32 gRaceFrameCounter;
+extern s16 gPlayerBalloonCount[8];
+extern u16 gNumSpawnedShells;
+extern u16 gNumPermanentActors;
+
+extern f32 gCourseCompletionPercentByRank[NUM_PLAYERS];
+extern f32 cpu_TargetSpeed[10];
+extern s16 gPreviousAngleSteering[12];
+extern f32 gTrackPositionFactor[10];
+extern bool gIsPlayerInCurve[10];
+extern f32 gPreviousPlayerAiOffsetX[10];
+extern f32 gPreviousPlayerAiOffsetZ[10];
+extern f32 gPreviousCpuTargetSpeed[10];
+extern u16 gWrongDirectionCounter[12];
+extern u16 gIsPlayerWrongDirection[12];
+extern s32 gPreviousLapProgressScore[10];
+extern u16 gCurrentCPUBehaviourId[12];
+extern u16 gPreviousCPUBehaviourId[12];
+extern u16 cpu_BehaviourState[12];
+extern u16 gPlayersTrackSectionId[12];
+extern u16 gSpeedCPUBehaviour[12];
+extern s16 gCurrentPlayerLookAhead[12];
+extern f32 gPreviousPlayerZ[10];
+extern s16 cpu_enteringPathIntersection[12];
+extern s16 cpu_exitingPathIntersection[12];
+extern s16 bStopAICrossing[10];
+extern TrackPositionFactorInstruction gPlayerTrackPositionFactorInstruction[10];
+extern s16 gTrainSmokeTimer;
+extern s16 gFerrySmokeTimer;
+extern u16 isCrossingTriggeredByIndex[NUM_CROSSINGS];
+extern u16 sCrossingActiveTimer[NUM_CROSSINGS];
+extern TrainStuff gTrainList[NUM_TRAINS];
+extern PaddleBoatStuff gPaddleBoats[NUM_PADDLE_BOATS];
+extern VehicleStuff gBoxTruckList[NUM_RACE_BOX_TRUCKS];
+extern VehicleStuff gSchoolBusList[NUM_RACE_SCHOOL_BUSES];
+extern VehicleStuff gTankerTruckList[NUM_RACE_TANKER_TRUCKS];
+extern VehicleStuff gCarList[NUM_RACE_CARS];
+extern BombKart gBombKarts[NUM_BOMB_KARTS_MAX];
+extern struct unexpiredActors gUnexpiredActorsList[8];
+extern CpuItemStrategyData cpu_ItemStrategy[8];
+extern s16 gGPCurrentRacePlayerIdByRank[12];
+extern s32 gLapCountByPlayerId[10];
+extern s32 gGPCurrentRaceRankByPlayerId[10];
+extern s32 gPreviousGPCurrentRaceRankByPlayerId[10];
+extern s32 gGPCurrentRaceRankByPlayerIdDup[10];
+extern u16 gNearestPathPointByPlayerId[12];
+extern s32 gNumPathPointsTraversed[10];
+extern f32 gLapCompletionPercentByPlayerId[10];
+extern f32 gCourseCompletionPercentByPlayerId[10];
+extern s16 bInMultiPathSection[12];
+extern f32 gPlayerPathY[10];
+extern u16 gPathIndexByPlayerId[12];
+
+extern u16 sPlayerGhostButtonsPrev;
+extern ReplayCursor sPlayerGhostCursor;
+extern u16 sButtonsPrevCourseGhost;
+extern u32 sCourseGhostFramesRemaining;
+extern s16 sCourseGhostReplayIdx;
+extern u16 sPostTTButtonsPrev;
+}
+
+struct SaveStateRegion {
+    void* Data;
+    size_t Size;
+};
+
+#define SAVE_STATE_REGION(var) { (void*) &(var), sizeof(var) }
+
+/**
+ * C globals holding race simulation state. Add new entries here when game code gains state that
+ * must survive a rewind; anything missing from this table will not be restored.
+ */
+static const SaveStateRegion sRegions[] = {
+    SAVE_STATE_REGION(gPlayers),
+    SAVE_STATE_REGION(cameras),
+    SAVE_STATE_REGION(gObjectList),
+    SAVE_STATE_REGION(playerHUD),
+    SAVE_STATE_REGION(gRandomSeed16),
+    SAVE_STATE_REGION(gCourseTimer),
+    SAVE_STATE_REGION(gRaceFrameCounter),
+    SAVE_STATE_REGION(gPlayerBalloonCount),
+    SAVE_STATE_REGION(gNumSpawnedShells),
+    SAVE_STATE_REGION(gNumActors),
+    SAVE_STATE_REGION(gNumPermanentActors),
+
+    // Race progress
+    SAVE_STATE_REGION(gGPCurrentRacePlayerIdByRank),
+    SAVE_STATE_REGION(gLapCountByPlayerId),
+    SAVE_STATE_REGION(gGPCurrentRaceRankByPlayerId),
+    SAVE_STATE_REGION(gPreviousGPCurrentRaceRankByPlayerId),
+    SAVE_STATE_REGION(gGPCurrentRaceRankByPlayerIdDup),
+    SAVE_STATE_REGION(gNearestPathPointByPlayerId),
+    SAVE_STATE_REGION(gNumPathPointsTraversed),
+    SAVE_STATE_REGION(gLapCompletionPercentByPlayerId),
+    SAVE_STATE_REGION(gCourseCompletionPercentByPlayerId),
+    SAVE_STATE_REGION(gCourseCompletionPercentByRank),
+    SAVE_STATE_REGION(bInMultiPathSection),
+    SAVE_STATE_REGION(gPlayerPathY),
+    SAVE_STATE_REGION(gPathIndexByPlayerId),
+
+    // CPU drivers
+    SAVE_STATE_REGION(cpu_TargetSpeed),
+    SAVE_STATE_REGION(gPreviousAngleSteering),
+    SAVE_STATE_REGION(gTrackPositionFactor),
+    SAVE_STATE_REGION(gIsPlayerInCurve),
+    SAVE_STATE_REGION(gPreviousPlayerAiOffsetX),
+    SAVE_STATE_REGION(gPreviousPlayerAiOffsetZ),
+    SAVE_STATE_REGION(gPreviousCpuTargetSpeed),
+    SAVE_STATE_REGION(gWrongDirectionCounter),
+    SAVE_STATE_REGION(gIsPlayerWrongDirection),
+    SAVE_STATE_REGION(gPreviousLapProgressScore),
+    SAVE_STATE_REGION(gCurrentCPUBehaviourId),
+    SAVE_STATE_REGION(gPreviousCPUBehaviourId),
+    SAVE_STATE_REGION(cpu_BehaviourState),
+    SAVE_STATE_REGION(gPlayersTrackSectionId),
+    SAVE_STATE_REGION(gSpeedCPUBehaviour),
+    SAVE_STATE_REGION(gCurrentPlayerLookAhead),
+    SAVE_STATE_REGION(gPreviousPlayerZ),
+    SAVE_STATE_REGION(cpu_enteringPathIntersection),
+    SAVE_STATE_REGION(cpu_exitingPathIntersection),
+    SAVE_STATE_REGION(bStopAICrossing),
+    SAVE_STATE_REGION(gPlayerTrackPositionFactorInstruction),
+    SAVE_STATE_REGION(gUnexpiredActorsList),
+    SAVE_STATE_REGION(cpu_ItemStrategy),
+
+    // Vehicles
+    SAVE_STATE_REGION(gTrainSmokeTimer),
+    SAVE_STATE_REGION(gFerrySmokeTimer),
+    SAVE_STATE_REGION(isCrossingTriggeredByIndex),
+    SAVE_STATE_REGION(sCrossingActiveTimer),
+    SAVE_STATE_REGION(gTrainList),
+    SAVE_STATE_REGION(gPaddleBoats),
+    SAVE_STATE_REGION(gBoxTruckList),
+    SAVE_STATE_REGION(gSchoolBusList),
+    SAVE_STATE_REGION(gTankerTruckList),
+    SAVE_STATE_REGION(gCarList),
+    SAVE_STATE_REGION(gBombKarts),
+
+    // Ghost playback
+    SAVE_STATE_REGION(sPlayerGhostButtonsPrev),
+    SAVE_STATE_REGION(sPlayerGhostCursor),
+    SAVE_STATE_REGION(sButtonsPrevCourseGhost),
+    SAVE_STATE_REGION(sCourseGhostFramesRemaining),
+    SAVE_STATE_REGION(sCourseGhostReplayIdx),
+    SAVE_STATE_REGION(sPostTTButtonsPrev),
+};
+
+/**
+ * Buffer layout: SaveStateHeader, the regions in table order, the actor handle generations, then one entity
+ * block each for actors, objects and emitters. A block is a size_t count followed by the records, each an
+ * EntityHeader and the entity's state bytes.
+ */
+#define SAVE_STATE_MAGIC 0x53544154 // 'STAT'
+
+struct SaveStateHeader {
+    uint32_t Magic;
+    uint32_t RegionsSize;
+    uint64_t Session;
+};
+
+/**
+ * The pointer, serial and type identify the live (or buried) instance the state bytes belong to.
+ */
+struct EntityHeader {
+    const void* Ptr;
+    const std::type_info* Type;
+    uint64_t Serial;
+    uint32_t Size;
+};
+
+struct EntityRecord {
+    EntityHeader Header;
+    const uint8_t* State;
+};
+
+struct ParsedState {
+    SaveStateHeader Header;
+    const uint8_t* Regions;
+    std::vector<uint16_t> Generations;
+    std::vector<EntityRecord> Actors;
+    std::vector<EntityRecord> Objects;
+    std::vector<EntityRecord> Emitters;
+};
+
+static size_t RegionsSize() {
+    size_t size = 0;
+    for (const auto& region : sRegions) {
+        size += region.Size;
+    }
+    return size;
+}
+
+// Keeps the entity from being freed while the capture exists. Returns its serial.
+static uint64_t RetainEntity(const void* entity) {
+    World::StateRef& ref = gWorldInstance.StateRefs[entity];
+    if (ref.Count++ == 0) {
+        ref.Serial = ++gWorldInstance.NextStateSerial;
+    }
+    return ref.Serial;
+}
+
+template <typename T> static void WriteEntities(std::vector<uint8_t>& buf, const std::vector<T*>& entities) {
+    size_t count = entities.size();
+    size_t offset = buf.size();
+    size_t total = sizeof(count);
+    for (const T* entity : entities) {
+        total += sizeof(EntityHeader) + entity->StateSize();
+    }
+
+    buf.resize(offset + total);
+    uint8_t* dest = buf.data() + offset;
+    memcpy(dest, &count, sizeof(count));
+    dest += sizeof(count);
+
+    for (const T* entity : entities) {
+        // Zeroed so padding bytes do not leak into Hash()
+        EntityHeader header;
+        memset(&header, 0, sizeof(header));
+        header.Ptr = entity;
+        header.Type = &typeid(*entity);
+        header.Serial = RetainEntity(entity);
+        header.Size = (uint32_t) entity->StateSize();
+        memcpy(dest, &header, sizeof(header));
+        dest += sizeof(header);
+        entity->WriteState(dest);
+        dest += header.Size;
+    }
+}
+
+static const uint8_t* ParseEntities(const uint8_t* src, const uint8_t* end, std::vector<EntityRecord>& records) {
+    size_t count;
+    if ((src == nullptr) || ((size_t) (end - src) < sizeof(count))) {
+        return nullptr;
+    }
+    memcpy(&count, src, sizeof(count));
+    src += sizeof(count);
+
+    for (size_t i = 0; i < count; i++) {
+        EntityRecord record;
+        if ((size_t) (end - src) < sizeof(record.Header)) {
+            return nullptr;
+        }
+        memcpy(&record.Header, src, sizeof(record.Header));
+        src += sizeof(record.Header);
+        if ((size_t) (end - src) < record.Header.Size) {
+            return nullptr;
+        }
+        record.State = src;
+        src += record.Header.Size;
+        records.push_back(record);
+    }
+    return src;
+}
+
+/**
+ * Splits a buffer into its parts. Fails on truncated buffers and on buffers written with a different region
+ * table; it does not check the session.
+ */
+static bool ParseState(const uint8_t* data, size_t size, ParsedState& state) {
+    const uint8_t* end = data + size;
+    if (size < sizeof(state.Header)) {
+        return false;
+    }
+    memcpy(&state.Header, data, sizeof(state.Header));
+    if ((state.Header.Magic != SAVE_STATE_MAGIC) || (state.Header.RegionsSize != RegionsSize())) {
+        return false;
+    }
+    const uint8_t* src = data + sizeof(state.Header);
+    if ((size_t) (end - src) < state.Header.RegionsSize) {
+        return false;
+    }
+    state.Regions = src;
+    src += state.Header.RegionsSize;
+
+    size_t generations;
+    if ((size_t) (end - src) < sizeof(generations)) {
+        return false;
+    }
+    memcpy(&generations, src, sizeof(generations));
+    src += sizeof(generations);
+    if ((size_t) (end - src) / sizeof(uint16_t) < generations) {
+        return false;
+    }
+    state.Generations.resize(generations);
+    memcpy(state.Generations.data(), src, generations * sizeof(uint16_t));
+    src += generations * sizeof(uint16_t);
+
+    src = ParseEntities(src, end, state.Actors);
+    src = ParseEntities(src, end, state.Objects);
+    src = ParseEntities(src, end, state.Emitters);
+    return (src != nullptr) && (state.Generations.size() >= state.Actors.size());
+}
+
+// Whether every entity of the capture is still the instance it was captured from.
+static bool IsCurrent(const ParsedState& state) {
+    if (state.Header.Session != gWorldInstance.StateSession) {
+        return false;
+    }
+    for (const auto* records : { &state.Actors, &state.Objects, &state.Emitters }) {
+        for (const EntityRecord& record : *records) {
+            auto ref = gWorldInstance.StateRefs.find(record.Header.Ptr);
+            if ((ref == gWorldInstance.StateRefs.end()) || (ref->second.Serial != record.Header.Serial)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// For a copy of a capture. The entities are already alive through the capture the copy was made from.
+static void RetainEntities(const ParsedState& state) {
+    for (const auto* records : { &state.Actors, &state.Objects, &state.Emitters }) {
+        for (const EntityRecord& record : *records) {
+            gWorldInstance.StateRefs[record.Header.Ptr].Count++;
+        }
+    }
+}
+
+static void ReleaseEntities(const ParsedState& state) {
+    for (const auto* records : { &state.Actors, &state.Objects, &state.Emitters }) {
+        for (const EntityRecord& record : *records) {
+            auto ref = gWorldInstance.StateRefs.find(record.Header.Ptr);
+            if ((ref != gWorldInstance.StateRefs.end()) && (ref->second.Serial == record.Header.Serial) &&
+                (--ref->second.Count == 0)) {
+                gWorldInstance.StateRefs.erase(ref);
+            }
+        }
+    }
+    gWorldInstance.CollectGraveyard();
+}
+
+/**
+ * Checks that every captured entity still has the captured type and size. The capture holding them keeps
+ * them alive, either in the lists or in the graveyard. Fills @p resolved in captured order.
+ */
+template <typename T>
+static bool ResolveEntities(const std::vector<EntityRecord>& records, std::vector<T*>& resolved) {
+    for (const EntityRecord& record : records) {
+        T* entity = static_cast<T*>(const_cast<void*>(record.Header.Ptr));
+        if ((*record.Header.Type != typeid(*entity)) || (record.Header.Size != entity->StateSize())) {
+            return false;
+        }
+        resolved.push_back(entity);
+    }
+    return true;
+}
+
+// Live entities missing from the capture; they are destroyed by the restore.
+template <typename T>
+static std::vector<T*> LeavingEntities(const std::vector<T*>& live, const std::vector<T*>& resolved) {
+    std::unordered_set<const T*> kept(resolved.begin(), resolved.end());
+    std::vector<T*> leaving;
+    for (T* entity : live) {
+        if (kept.count(entity) == 0) {
+            leaving.push_back(entity);
+        }
+    }
+    return leaving;
+}
+
+// Takes the resolved entities out of the graveyard and makes them the live list.
+template <typename T>
+static void ReviveEntities(std::vector<T*>& live, std::vector<T*>& dead, std::vector<T*>& resolved) {
+    std::unordered_set<const T*> kept(resolved.begin(), resolved.end());
+    dead.erase(std::remove_if(dead.begin(), dead.end(), [&kept](T* entity) { return kept.count(entity) != 0; }),
+               dead.end());
+    live = std::move(resolved);
+}
+
+template <typename T> static void ReadEntities(const std::vector<EntityRecord>& records, std::vector<T*>& entities) {
+    for (size_t i = 0; i < records.size(); i++) {
+        entities[i]->ReadState(records[i].State);
+    }
+}
+
+bool SaveState::RestoreBuffer(const uint8_t* data, size_t size) {
+    ParsedState state;
+    if (!ParseState(data, size, state)) {
+        printf("[SaveState] Restore failed: the state is damaged or from another build\n");
+        return false;
+    }
+    if (!IsCurrent(state)) {
+        printf("[SaveState] Restore failed: the state was taken in another world or was released\n");
+        return false;
+    }
+
+    // Resolve everything before touching the world so a failed restore leaves it untouched.
+    std::vector<AActor*> actors;
+    std::vector<OObject*> objects;
+    std::vector<ParticleEmitter*> emitters;
+    if (!ResolveEntities(state.Actors, actors) || !ResolveEntities(state.Objects, objects) ||
+        !ResolveEntities(state.Emitters, emitters)) {
+        printf("[SaveState] Restore failed: a captured entity changed its type or size\n");
+        return false;
+    }
+
+    std::vector<AActor*> leavingActors = LeavingEntities(gWorldInstance.Actors, actors);
+    std::vector<OObject*> leavingObjects = LeavingEntities(gWorldInstance.Objects, objects);
+    std::vector<ParticleEmitter*> leavingEmitters = LeavingEntities(gWorldInstance.Emitters, emitters);
+
+    std::unordered_set<const void*> despawnFlags;
+    for (AActor* actor : leavingActors) {
+        despawnFlags.insert(&actor->Type);
+    }
+    for (OObject* object : leavingObjects) {
+        despawnFlags.insert(&object->_objectIndex);
+    }
+    gEditor.RemoveObjectsByDespawnFlag(despawnFlags);
+
+    ReviveEntities(gWorldInstance.Actors, gWorldInstance.DeadActors, actors);
+    ReviveEntities(gWorldInstance.Objects, gWorldInstance.DeadObjects, objects);
+    ReviveEntities(gWorldInstance.Emitters, gWorldInstance.DeadEmitters, emitters);
+    for (AActor* actor : leavingActors) {
+        gWorldInstance.DestroyActor(actor);
+    }
+    for (OObject* object : leavingObjects) {
+        gWorldInstance.DestroyObject(object);
+    }
+    for (ParticleEmitter* emitter : leavingEmitters) {
+        gWorldInstance.DestroyEmitter(emitter);
+    }
+    // Exact generations, so the actors spawned after the restore get the same handles as the first time.
+    gWorldInstance.ActorGenerations = state.Generations;
+    gWorldInstance.InvalidateSchedule();
+
+    const uint8_t* src = state.Regions;
+    for (const auto& region : sRegions) {
+        memcpy(region.Data, src, region.Size);
+        src += region.Size;
+    }
+
+    ReadEntities(state.Actors, gWorldInstance.Actors);
+    ReadEntities(state.Objects, gWorldInstance.Objects);
+    ReadEntities(state.Emitters, gWorldInstance.Emitters);
+    return true;
+}
+
+SaveState::~SaveState() {
+    Clear();
+}
+
+void SaveState::Capture() {
+    Clear();
+    CaptureBuffer(mBuffer);
+}
+
+bool SaveState::Restore() {
+    if (mBuffer.empty()) {
+        return false;
+    }
+    return RestoreBuffer(mBuffer.data(), mBuffer.size());
+}
+
+void SaveState::Clear() {
+    if (!mBuffer.empty()) {
+        ReleaseBuffer(mBuffer.data(), mBuffer.size());
+    }
+    mBuffer.clear();
+}
+
+void SaveState::CaptureBuffer(std::vector<uint8_t>& buffer) {
+    SaveStateHeader header;
+    memset(&header, 0, sizeof(header));
+    header.Magic = SAVE_STATE_MAGIC;
+    header.RegionsSize = (uint32_t) RegionsSize();
+    header.Session = gWorldInstance.StateSession;
+
+    size_t generations = gWorldInstance.ActorGenerations.size();
+    buffer.resize(sizeof(header) + header.RegionsSize + sizeof(generations) + generations * sizeof(uint16_t));
+
+    uint8_t* dest = buffer.data();
+    memcpy(dest, &header, sizeof(header));
+    dest += sizeof(header);
+    for (const auto& region : sRegions) {
+        memcpy(dest, region.Data, region.Size);
+        dest += region.Size;
+    }
+    memcpy(dest, &generations, sizeof(generations));
+    dest += sizeof(generations);
+    memcpy(dest, gWorldInstance.ActorGenerations.data(), generations * sizeof(uint16_t));
+
+    WriteEntities(buffer, gWorldInstance.Actors);
+    WriteEntities(buffer, gWorldInstance.Objects);
+    WriteEntities(buffer, gWorldInstance.Emitters);
+}
+
+bool SaveState::RetainBuffer(const uint8_t* data, size_t size) {
+    ParsedState state;
+    if (!ParseState(data, size, state) || !IsCurrent(state)) {
+        return false;
+    }
+    RetainEntities(state);
+    return true;
+}
+
+void SaveState::ReleaseBuffer(const uint8_t* data, size_t size) {
+    ParsedState state;
+    // After CM_CleanWorld the references are already gone along with the world.
+    if (ParseState(data, size, state) && (state.Header.Session == gWorldInstance.StateSession)) {
+        ReleaseEntities(state);
+    }
+}
+
+bool SaveState::IsBufferCurrent(const uint8_t* data, size_t size) {
+    ParsedState state;
+    return ParseState(data, size, state) && IsCurrent(state);
+}
+
+struct EntityRange {
+    uintptr_t Begin;
+    uintptr_t End;
+    uint64_t Index;
+};
+
+// FNV-1a
+static void HashBytes(uint64_t& hash, const void* data, size_t size) {
+    const uint8_t* bytes = (const uint8_t*) data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ULL;
+    }
+}
+
+/**
+ * Hashes @p size bytes of simulation memory. Pointer sized words pointing into a captured entity are hashed
+ * as the entity's position in the capture plus the offset, so a rerun whose allocations landed elsewhere
+ * still hashes the same.
+ */
+static void HashMemory(uint64_t& hash, const uint8_t* data, size_t size, const std::vector<EntityRange>& ranges) {
+    size_t i = 0;
+    for (; i + sizeof(uintptr_t) <= size; i += sizeof(uintptr_t)) {
+        uintptr_t word;
+        memcpy(&word, data + i, sizeof(word));
+        auto range = std::upper_bound(ranges.begin(), ranges.end(), word,
+                                      [](uintptr_t value, const EntityRange& r) { return value < r.Begin; });
+        if ((range != ranges.begin()) && (word < (range - 1)->End)) {
+            uint64_t position = ((range - 1)->Index << 32) | (word - (range - 1)->Begin);
+            HashBytes(hash, &position, sizeof(position));
+        } else {
+            HashBytes(hash, &word, sizeof(word));
+        }
+    }
+    HashBytes(hash, data + i, size - i);
+}
+
+uint64_t SaveState::Hash() const {
+    ParsedState state;
+    if (mBuffer.empty() || !ParseState(mBuffer.data(), mBuffer.size(), state)) {
+        return 0;
+    }
+
+    std::vector<EntityRange> ranges;
+    for (const auto* records : { &state.Actors, &state.Objects, &state.Emitters }) {
+        for (const EntityRecord& record : *records) {
+            uintptr_t begin = (uintptr_t) record.Header.Ptr;
+            ranges.push_back({ begin, begin + record.Header.Size, ranges.size() });
+        }
+    }
+    std::sort(ranges.begin(), ranges.end(), [](const EntityRange& a, const EntityRange& b) { return a.Begin < b.Begin; });
+
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    HashMemory(hash, state.Regions, state.Header.RegionsSize, ranges);
+    HashBytes(hash, state.Generations.data(), state.Generations.size() * sizeof(uint16_t));
+    for (const auto* records : { &state.Actors, &state.Objects, &state.Emitters }) {
+        size_t count = records->size();
+        HashBytes(hash, &count, sizeof(count));
+        for (const EntityRecord& record : *records) {
+            const char* type = record.Header.Type->name();
+            HashBytes(hash, type, strlen(type));
+            HashMemory(hash, record.State, record.Header.Size, ranges);
+        }
+    }
+    return hash;
+}
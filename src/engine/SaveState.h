@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <vector>
+
+/**
+ * @brief Per-class state hooks for AActor, OObject and ParticleEmitter subclasses.
+ *
+ * Every subclass states its own size so the snapshot copies the whole derived object, not just the base.
+ * The vtable pointer is copied too; this is harmless because restore only targets the same live instance.
+ */
+#define SAVE_STATE_TRIVIAL(Class)                                                                          \
+    size_t StateSize() const override {                                                                    \
+        return sizeof(Class);                                                                              \
+    }                                                                                                      \
+    void WriteState(uint8_t* dest) const override {                                                        \
+        memcpy(dest, (const void*) this, sizeof(Class));                                                   \
+    }                                                                                                      \
+    void ReadState(const uint8_t* src) override {                                                          \
+        memcpy((void*) this, src, sizeof(Class));                                                          \
+    }
+
+/**
+ * @brief Same as SAVE_STATE_TRIVIAL for classes owning one std::vector of plain data.
+ *
+ * The vector keeps its live allocation; only its elements are copied. The element count is part of
+ * StateSize, so a vector that was resized since the capture makes the restore fail validation.
+ */
+#define SAVE_STATE_WITH_VECTOR(Class, member)                                                              \
+    size_t StateSize() const override {                                                                    \
+        return sizeof(Class) + member.size() * sizeof(member[0]);                                          \
+    }                                                                                                      \
+    void WriteState(uint8_t* dest) const override {                                                        \
+        memcpy(dest, (const void*) this, sizeof(Class));                                                   \
+        if (!member.empty()) {                                                                             \
+            memcpy(dest + sizeof(Class), (const void*) member.data(), member.size() * sizeof(member[0]));  \
+        }                                                                                                  \
+    }                                                                                                      \
+    void ReadState(const uint8_t* src) override {                                                          \
+        auto live = std::move(member);                                                                     \
+        memcpy((void*) this, src, sizeof(Class));                                                          \
+        new (&member) decltype(member)(std::move(live));                                                   \
+        if (!member.empty()) {                                                                             \
+            memcpy((void*) member.data(), src + sizeof(Class), member.size() * sizeof(member[0]));         \
+        }                                                                                                  \
+    }
+
+/**
+ * @brief Snapshot of the full race simulation.
+ *
+ * Captures the C globals driving the race (players, cameras, objects, CPU and vehicle state), the actor handle
+ * generations and every actor, object and particle emitter in gWorldInstance into a single reusable buffer.
+ *
+ * Entities are identified by their address and a serial. While a capture exists, entities it holds are buried in the World
+ * graveyard instead of being freed when they are destroyed, so Restore can bring back entities the garbage
+ * collector removed and rebuild the lists in their captured order. Entities spawned after the capture are
+ * destroyed. Brought back entities are not re-added to the editor.
+ *
+ * A capture only restores into the world it was taken in; CM_CleanWorld starts a new one.
+ */
+class SaveState {
+public:
+    SaveState() = default;
+    ~SaveState();
+    SaveState(const SaveState&) = delete;
+    SaveState& operator=(const SaveState&) = delete;
+
+    void Capture();
+    bool Restore();
+    void Clear();
+    /** @brief Hash of the simulation state. Entity addresses are hashed by position, not by value. */
+    uint64_t Hash() const;
+
+    size_t GetSize() const {
+        return mBuffer.size();
+    }
+
+    bool IsValid() const {
+        return !mBuffer.empty();
+    }
+
+    const std::vector<uint8_t>& GetBuffer() const {
+        return mBuffer;
+    }
+
+    /**
+     * @brief Capture, Restore and Clear for a buffer kept outside a SaveState, e.g. by a replay keyframe.
+     * A captured buffer holds its entities until ReleaseBuffer. A copy of it (read back from a replay file)
+     * holds them once RetainBuffer succeeded, which it only does while the buffer is still restorable.
+     */
+    static void CaptureBuffer(std::vector<uint8_t>& buffer);
+    static bool RestoreBuffer(const uint8_t* data, size_t size);
+    static bool RetainBuffer(const uint8_t* data, size_t size);
+    static void ReleaseBuffer(const uint8_t* data, size_t size);
+    static bool IsBufferCurrent(const uint8_t* data, size_t size);
+
+private:
+    std::vector<uint8_t> mBuffer;
+};
@@ -15,6 +15,7 @@ public:
     std::string Model;
     int32_t* Collision;
     bool bPendingDestroy = false;
+    bool bDirty = true; // Edited since the scene was last loaded or saved, see Editor::SaveLevel
     StaticMeshActor(std::string name, FVector pos, IRotator rot, FVector scale, std::string model, int32_t* collision);
 
     nlohmann::json to_json() const {
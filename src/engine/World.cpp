@@ -5,8 +5,12 @@
 #include "objects/BombKart.h"
 #include "TrainCrossing.h"
 #include <memory>
+#include <cstddef>
+#include <algorithm>
+#include <random>
 #include "objects/Object.h"
 #include "port/Game.h"
+#include "GarbageCollector.h"
 
 #include "editor/GameObject.h"
 
@@ -21,7 +25,8 @@ extern "C" {
 #include "mario_raceway_data.h"
 }
 
-World::World() {}
+// Random so save states written by another run of the game never resolve against this one.
+World::World() : StateSession(((uint64_t) std::random_device{}() << 32) | std::random_device{}()) {}
 World::~World() {
     CM_CleanWorld();
 }
@@ -30,11 +35,27 @@ std::shared_ptr<Course> CurrentCourse;
 Cup* CurrentCup;
 
 std::shared_ptr<Course> World::AddCourse(std::shared_ptr<Course> course) {
+    gCourseRegistry.Add(course->Id, course, typeid(*course));
     gWorldInstance.Courses.push_back(course);
     return course;
 }
 
+void World::RemoveCourse(Course* course) {
+    ContentId id = FindContentId(course->Id);
+    const std::shared_ptr<Course>* registered = gCourseRegistry.Get(id);
+    if ((registered != nullptr) && (registered->get() == course)) {
+        gCourseRegistry.Remove(id);
+    }
+    for (auto it = Courses.begin(); it != Courses.end(); ++it) {
+        if (it->get() == course) {
+            Courses.erase(it);
+            break;
+        }
+    }
+}
+
 void World::AddCup(Cup* cup) {
+    gCupRegistry.Add(cup->Id, cup);
     Cups.push_back(cup);
 }
 
@@ -95,15 +116,16 @@ void World::SetCup(Cup* cup) {
     }
 }
 
-void World::SetCourse(const char* name) {
-    //! @todo Use content dictionary instead
-    for (size_t i = 0; i < Courses.size(); i++) {
-        if (strcmp(Courses[i]->Props.Name, name) == 0) {
-            CurrentCourse = Courses[i];
-            break;
-        }
+/**
+ * @brief Selects a course by its content id, e.g. "mk:mario_raceway".
+ */
+void World::SetCourse(const char* id) {
+    const std::shared_ptr<Course>* course = gCourseRegistry.Get(id);
+    if (course == nullptr) {
+        printf("World::SetCourse() Course id %s not found in the course registry\n", id);
+        return;
     }
-    std::runtime_error("SetCourse() Course name not found in Courses list");
+    CurrentCourse = *course;
 }
 
 void World::NextCourse() {
@@ -124,8 +146,75 @@ void World::PreviousCourse() {
     gWorldInstance.CurrentCourse = Courses[CourseIndex];
 }
 
-AActor* World::AddActor(AActor* actor) {
+/**
+ * Appends an actor and gives it a handle for its slot.
+ */
+AActor* World::RegisterActor(AActor* actor) {
+    size_t index = Actors.size();
+    if (index >= ActorGenerations.size()) {
+        ActorGenerations.push_back(0);
+    }
+    actor->Handle = ACTOR_HANDLE_MAKE(index, ActorGenerations[index]);
     Actors.push_back(actor);
+    InvalidateSchedule();
+    return actor;
+}
+
+/**
+ * Invalidates the handles of every slot from first to the end of Actors. Call before those actors are freed.
+ */
+void World::ReleaseActorSlots(size_t first) {
+    for (size_t i = first; i < Actors.size(); i++) {
+        ActorGenerations[i]++;
+    }
+}
+
+AActor* World::ResolveActorHandle(ActorHandle handle) const {
+    size_t index = ACTOR_HANDLE_INDEX(handle);
+    if ((handle == ACTOR_HANDLE_NONE) || (index >= Actors.size()) ||
+        (ActorGenerations[index] != ACTOR_HANDLE_GENERATION(handle))) {
+        return nullptr;
+    }
+    return Actors[index];
+}
+
+template <typename T> static void DestroyEntity(T* entity, std::vector<T*>& graveyard) {
+    if (gWorldInstance.StateRefs.count(entity) != 0) {
+        graveyard.push_back(entity);
+    } else {
+        delete entity;
+    }
+}
+
+void World::DestroyActor(AActor* actor) {
+    DestroyEntity(actor, DeadActors);
+}
+
+void World::DestroyObject(OObject* object) {
+    DestroyEntity(object, DeadObjects);
+}
+
+void World::DestroyEmitter(ParticleEmitter* emitter) {
+    DestroyEntity(emitter, DeadEmitters);
+}
+
+template <typename T> static void CollectEntities(std::vector<T*>& graveyard) {
+    auto firstFree = std::stable_partition(graveyard.begin(), graveyard.end(),
+                                           [](T* entity) { return gWorldInstance.StateRefs.count(entity) != 0; });
+    for (auto entity = firstFree; entity != graveyard.end(); entity++) {
+        delete *entity;
+    }
+    graveyard.erase(firstFree, graveyard.end());
+}
+
+void World::CollectGraveyard(void) {
+    CollectEntities(DeadActors);
+    CollectEntities(DeadObjects);
+    CollectEntities(DeadEmitters);
+}
+
+AActor* World::AddActor(AActor* actor) {
+    RegisterActor(actor);
 
     if (actor->Model != NULL) {
         gEditor.AddObject(actor->Name, (FVector*) &actor->Pos, (IRotator*)&actor->Rot, &actor->Scale,
@@ -138,12 +227,7 @@ AActor* World::AddActor(AActor* actor) {
 }
 
 struct Actor* World::AddBaseActor() {
-    Actors.push_back(new AActor());
-
-    AActor* actor = Actors.back();
-
-    // Skip C++ vtable to access variables in C
-    return reinterpret_cast<struct Actor*>(reinterpret_cast<char*>(Actors.back()) + sizeof(void*));
+    return ConvertAActorToActor(RegisterActor(new AActor()));
 }
 
 void World::AddEditorObject(Actor* actor, const char* name) {
@@ -154,14 +238,23 @@ void World::AddEditorObject(Actor* actor, const char* name) {
     }
 }
 
+/**
+ * Distance from an AActor to its Type member, where the C struct starts. AActor has virtual functions, so it is
+ * not standard layout and offsetof is not valid on it. Measure it once on a real instance instead.
+ */
+static ptrdiff_t ActorTypeOffset(void) {
+    static const ptrdiff_t offset = [] {
+        AActor probe;
+        return reinterpret_cast<char*>(&probe.Type) - reinterpret_cast<char*>(&probe);
+    }();
+    return offset;
+}
+
 /**
  * Converts a C struct Actor* to its C++ AActor class
  */
 AActor* World::ConvertActorToAActor(Actor* actor) {
-    // Move the ptr back so that it points at the vtable.
-    // Which is the initial item in the class, or in other words
-    // Point to the class.
-    return reinterpret_cast<AActor*>((char*) actor - sizeof(void*));
+    return reinterpret_cast<AActor*>((char*) actor - ActorTypeOffset());
 }
 
 /**
@@ -170,17 +263,61 @@ AActor* World::ConvertActorToAActor(Actor* actor) {
 Actor* World::ConvertAActorToActor(AActor* actor) {
     // Move the ptr forward past the vtable.
     // This allows C to access the class variables like a normal Actor* struct.
-    return reinterpret_cast<Actor*>((char*) actor + sizeof(void*));
+    return reinterpret_cast<Actor*>(&actor->Type);
 }
 
 AActor* World::GetActor(size_t index) {
     return Actors[index];
 }
 
-void World::TickActors() {
+void World::InvalidateSchedule(void) {
+    mScheduleDirty = true;
+}
+
+/**
+ * Splits Actors and Objects into runs of consecutive entities of the same class. Only runs after the lists
+ * changed; the size check catches mutations that bypassed InvalidateSchedule.
+ */
+void World::UpdateSchedule(void) {
+    if (!mScheduleDirty && (mScheduledActorCount == Actors.size()) && (mScheduledObjectCount == Objects.size())) {
+        return;
+    }
+
+    auto build = [](const auto& entities, auto& runs, auto getFlags) {
+        runs.clear();
+        for (auto* entity : entities) {
+            const std::type_info* type = &typeid(*entity);
+            if (runs.empty() || (runs.back().Type != type)) {
+                runs.push_back({ type, getFlags(entity), {} });
+            }
+            runs.back().Members.push_back(entity);
+        }
+    };
+
     // This only ticks modded actors
-    for (AActor* actor : Actors) {
-        if (actor->IsMod()) {
+    build(Actors, mActorRuns, [](AActor* actor) -> uint32_t { return actor->IsMod() ? 1 : 0; });
+    build(Objects, mObjectRuns, [](OObject* object) { return object->GetScheduleFlags(); });
+
+    mScheduleDirty = false;
+    mScheduledActorCount = Actors.size();
+    mScheduledObjectCount = Objects.size();
+}
+
+void World::TickActors() {
+    if (!bUseSchedule) {
+        for (AActor* actor : Actors) {
+            if (actor->IsMod()) {
+                actor->Tick();
+            }
+        }
+        return;
+    }
+    UpdateSchedule();
+    for (const auto& run : mActorRuns) {
+        if (run.Flags == 0) {
+            continue;
+        }
+        for (AActor* actor : run.Members) {
             actor->Tick();
         }
     }
@@ -191,6 +328,7 @@ StaticMeshActor* World::AddStaticMeshActor(std::string name, FVector pos, IRotat
     auto actor = StaticMeshActors.back();
     auto gameObj = gEditor.AddObject(actor->Name.c_str(), &actor->Pos, &actor->Rot, &actor->Scale, (Gfx*) LOAD_ASSET_RAW(actor->Model.c_str()), 1.0f,
                       Editor::GameObject::CollisionType::VTX_INTERSECT, 0.0f, (int32_t*) &actor->bPendingDestroy, (int32_t) true);
+    gameObj->DirtyFlag = &actor->bDirty;
     return actor;
 }
 
@@ -201,18 +339,12 @@ void World::DrawStaticMeshActors() {
 }
 
 void World::DeleteStaticMeshActors() {
-    for (auto it = StaticMeshActors.begin(); it != StaticMeshActors.end();) {
-        if ((*it)->bPendingDestroy) {
-            delete *it;  // Deallocate memory for the actor
-            it = StaticMeshActors.erase(it);  // Remove the pointer from the vector
-        } else {
-            ++it;  // Only increment the iterator if we didn't erase an element
-        }
-    }
+    CleanStaticMeshActors();
 }
 
 OObject* World::AddObject(OObject* object) {
     Objects.push_back(object);
+    InvalidateSchedule();
 
     if (object->_objectIndex != -1) {
         Object* cObj = &gObjectList[object->_objectIndex];
@@ -228,16 +360,40 @@ OObject* World::AddObject(OObject* object) {
 }
 
 void World::TickObjects() {
-    for (const auto& object : Objects) {
-        object->Tick();
+    if (!bUseSchedule) {
+        for (const auto& object : Objects) {
+            object->Tick();
+        }
+        return;
+    }
+    UpdateSchedule();
+    for (const auto& run : mObjectRuns) {
+        if (!(run.Flags & OObject::SCHEDULE_TICK)) {
+            continue;
+        }
+        for (OObject* object : run.Members) {
+            object->Tick();
+        }
     }
 }
 
 // Some objects such as lakitu are ticked in process_game_tick.
 // This is a fallback to support those objects. Probably don't use this.
 void World::TickObjects60fps() {
-    for (const auto& object : Objects) {
-        object->Tick60fps();
+    if (!bUseSchedule) {
+        for (const auto& object : Objects) {
+            object->Tick60fps();
+        }
+        return;
+    }
+    UpdateSchedule();
+    for (const auto& run : mObjectRuns) {
+        if (!(run.Flags & OObject::SCHEDULE_TICK_60FPS)) {
+            continue;
+        }
+        for (OObject* object : run.Members) {
+            object->Tick60fps();
+        }
     }
 }
 
@@ -247,8 +403,20 @@ ParticleEmitter* World::AddEmitter(ParticleEmitter* emitter) {
 }
 
 void World::DrawObjects(s32 cameraId) {
-    for (const auto& object : Objects) {
-        object->Draw(cameraId);
+    if (!bUseSchedule) {
+        for (const auto& object : Objects) {
+            object->Draw(cameraId);
+        }
+        return;
+    }
+    UpdateSchedule();
+    for (const auto& run : mObjectRuns) {
+        if (!(run.Flags & OObject::SCHEDULE_DRAW)) {
+            continue;
+        }
+        for (OObject* object : run.Members) {
+            object->Draw(cameraId);
+        }
     }
 }
 
@@ -6,7 +6,7 @@
 #include "objects/Object.h"
 #include "Cup.h"
 #include "vehicles/Train.h"
-#include "vehicles/Car.h"
+#include "vehicles/Traffic.h"
 #include "objects/BombKart.h"
 #include "PlayerBombKart.h"
 #include "vehicles/Train.h"
@@ -16,10 +16,12 @@
 #include "objects/Seagull.h"
 #include "objects/Lakitu.h"
 #include <memory>
+#include <typeinfo>
 #include <unordered_map>
 #include "Actor.h"
 #include "StaticMeshActor.h"
 #include "particles/ParticleEmitter.h"
+#include "Registry.h"
 
 #include "editor/Editor.h"
 #include "editor/GameObject.h"
@@ -55,11 +57,14 @@ public:
     ~World();
 
     std::shared_ptr<Course> AddCourse(std::shared_ptr<Course> course);
+    void RemoveCourse(Course* course);
 
     AActor* AddActor(AActor* actor);
     struct Actor* AddBaseActor();
     void AddEditorObject(Actor* actor, const char* name);
     AActor* GetActor(size_t index);
+    AActor* ResolveActorHandle(ActorHandle handle) const;
+    void ReleaseActorSlots(size_t first);
 
     void TickActors();
     AActor* ConvertActorToAActor(Actor* actor);
@@ -80,6 +85,8 @@ public:
     void DrawParticles(s32 cameraId);
     ParticleEmitter* AddEmitter(ParticleEmitter* emitter);
     void Reset(void); // Sets OObjects or AActors static member variables back to default values
+    void InvalidateSchedule(void); // Call after Actors or Objects are added, removed or reordered
+    bool bUseSchedule = true; // Off runs the plain per-element loops, tests compare the two
 
     void AddCup(Cup*);
     void SetCup(Cup* cup);
@@ -95,14 +102,13 @@ public:
 
 
     // These are only for browsing through the course list
-    void SetCourse(const char*);
+    void SetCourse(const char* id);
     template<typename T>
     void SetCourseByType() {
-        for (const auto& course : Courses) {
-            if (dynamic_cast<T*>(course.get())) {
-                CurrentCourse = course;
-                return;
-            }
+        const std::shared_ptr<Course>* course = gCourseRegistry.GetByType<T>();
+        if (course != nullptr) {
+            CurrentCourse = *course;
+            return;
         }
         printf("World::SetCourseByType() No course by the type found");
     }
@@ -120,9 +126,31 @@ public:
 
     std::vector<StaticMeshActor*> StaticMeshActors;
     std::vector<AActor*> Actors;
+    std::vector<uint16_t> ActorGenerations; // Per slot of Actors, outlives the slot so stale handles stay stale
     std::vector<OObject*> Objects;
     std::vector<ParticleEmitter*> Emitters;
 
+    /**
+     * Entities destroyed while a SaveState still refers to them. They stay allocated, outside the lists above,
+     * so a restore can put them back. Freed once no save state refers to them or when the world is cleaned.
+     */
+    std::vector<AActor*> DeadActors;
+    std::vector<OObject*> DeadObjects;
+    std::vector<ParticleEmitter*> DeadEmitters;
+    struct StateRef {
+        uint32_t Count;  // Save states holding the entity
+        uint64_t Serial; // Tells the entity apart from an earlier one that lived at the same address
+    };
+    std::unordered_map<const void*, StateRef> StateRefs;
+    uint64_t NextStateSerial = 0;
+    uint64_t StateSession; // Changes whenever the world is rebuilt, so older save states stop resolving
+
+    // Free the entity, or bury it while a save state refers to it. The caller removes it from its list.
+    void DestroyActor(AActor* actor);
+    void DestroyObject(OObject* object);
+    void DestroyEmitter(ParticleEmitter* emitter);
+    void CollectGraveyard(void); // Frees the buried entities no save state refers to anymore
+
     std::unordered_map<s32, OLakitu*> Lakitus;
 
     /** Objects **/
@@ -135,7 +163,27 @@ public:
     std::vector<std::shared_ptr<Course>> Courses;
     size_t CourseIndex = 0; // For browsing courses.
 private:
-
+    AActor* RegisterActor(AActor* actor);
+
+    /**
+     * Consecutive entities of one concrete class. Walking the runs in order keeps the insertion order, which
+     * random_int consumption and draw order depend on, while each run keeps the same virtual target hot and
+     * runs of classes without work for a pass are skipped. Courses spawn their objects class by class, so runs
+     * are long in practice.
+     */
+    template <typename T> struct TypeRun {
+        const std::type_info* Type;
+        uint32_t Flags;
+        std::vector<T*> Members;
+    };
+
+    void UpdateSchedule(void);
+
+    std::vector<TypeRun<AActor>> mActorRuns;
+    std::vector<TypeRun<OObject>> mObjectRuns;
+    bool mScheduleDirty = true;
+    size_t mScheduledActorCount = 0;
+    size_t mScheduledObjectCount = 0;
 };
 
 extern World gWorldInstance;
@@ -5,6 +5,7 @@
 
 class ABanana : public AActor {
 public:
+    SAVE_STATE_TRIVIAL(ABanana)
 
     uint16_t PlayerId;
 
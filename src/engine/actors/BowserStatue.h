@@ -15,6 +15,8 @@ extern Gfx gBowserStatueGfx[162];
 
 class ABowserStatue : public AActor {
 public:
+    SAVE_STATE_TRIVIAL(ABowserStatue)
+
     enum Behaviour {
         DEFAULT,
         CRUSH
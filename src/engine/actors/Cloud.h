@@ -13,6 +13,7 @@ extern "C" {
 
 class ACloud : public AActor {
 public:
+    SAVE_STATE_TRIVIAL(ACloud)
 
 
     // Constructor
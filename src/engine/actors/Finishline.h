@@ -13,6 +13,8 @@ extern "C" {
 
 class AFinishline : public AActor {
 public:
+    SAVE_STATE_TRIVIAL(AFinishline)
+
     /**
      * Default behaviour places the finishline at the first waypoint.
      * @arg pos, optional. Sets a custom position
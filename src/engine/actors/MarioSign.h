@@ -10,6 +10,7 @@ extern "C" {
 
 class AMarioSign : public AActor {
 public:
+    SAVE_STATE_TRIVIAL(AMarioSign)
 
     virtual ~AMarioSign() = default;
     explicit AMarioSign(FVector pos);
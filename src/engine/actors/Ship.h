@@ -12,6 +12,7 @@ extern "C" {
 
 class AShip : public AActor {
 public:
+    SAVE_STATE_TRIVIAL(AShip)
 
     enum Skin {
         GHOSTSHIP,
@@ -12,6 +12,8 @@ extern "C" {
 
 class ASpaghettiShip : public AActor {
 public:
+    SAVE_STATE_TRIVIAL(ASpaghettiShip)
+
     explicit ASpaghettiShip(FVector pos);
     virtual ~ASpaghettiShip() = default;
 
@@ -12,6 +12,8 @@ extern "C" {
 
 class AStarship : public AActor {
 public:
+    SAVE_STATE_TRIVIAL(AStarship)
+
     explicit AStarship(FVector pos);
     virtual ~AStarship() = default;
 
@@ -13,6 +13,7 @@ extern "C" {
 // to spawn stock actors
 class ATree : public AActor {
 public:
+    SAVE_STATE_TRIVIAL(ATree)
 
     Gfx* Displaylist;
     const char* Tlut;
@@ -10,6 +10,7 @@ extern "C" {
 
 class AWarioSign : public AActor {
 public:
+    SAVE_STATE_TRIVIAL(AWarioSign)
 
     virtual ~AWarioSign() = default;
     explicit AWarioSign(FVector pos);
@@ -55,6 +55,7 @@ BigDonut::BigDonut() {
     Props.Minimap.FinishlineY = 0;
     ResizeMinimap(&Props.Minimap);
 
+    Id = "mk:big_donut";
     Props.SetText(Props.Name, "big donut", sizeof(Props.Name));
     Props.SetText(Props.DebugName, "doughnut", sizeof(Props.DebugName));
     Props.SetText(Props.CourseLength, "", sizeof(Props.CourseLength));
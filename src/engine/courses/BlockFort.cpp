@@ -57,6 +57,7 @@ BlockFort::BlockFort() {
     Props.Minimap.FinishlineY = 0;
     ResizeMinimap(&Props.Minimap);
 
+    Id = "mk:block_fort";
     Props.SetText(Props.Name, "block fort", sizeof(Props.Name));
     Props.SetText(Props.DebugName, "block", sizeof(Props.DebugName));
     Props.SetText(Props.CourseLength, "", sizeof(Props.CourseLength));
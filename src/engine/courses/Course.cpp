@@ -173,14 +173,8 @@ void Course::Load() {
     }
 
     // Stock
-    size_t vtxSize = (ResourceGetSizeByName(this->vtx) / sizeof(CourseVtx)) * sizeof(Vtx);
     size_t texSegSize;
 
-    // Convert course vtx to vtx
-    Vtx* vtx = reinterpret_cast<Vtx*>(allocate_memory(vtxSize));
-    gSegmentTable[4] = reinterpret_cast<uintptr_t>(&vtx[0]);
-    func_802A86A8(reinterpret_cast<CourseVtx*>(LOAD_ASSET_RAW(this->vtx)), vtx, vtxSize / sizeof(Vtx));
-
     // Load and allocate memory for course textures
     const course_texture* asset = this->Props.textures;
     u8* freeMemory = NULL;
@@ -204,15 +198,8 @@ void Course::Load() {
         asset++;
     }
 
-    // Extract packed DLs
-    u8* packed = reinterpret_cast<u8*>(LOAD_ASSET_RAW(this->gfx));
-    Gfx* gfx = (Gfx*) allocate_memory(sizeof(Gfx) * this->gfxSize); // Size of unpacked DLs
-    if (gfx == NULL) {
-        printf("Failed to allocate course displaylist memory\n");
-    }
-
-    gSegmentTable[7] = reinterpret_cast<uintptr_t>(&gfx[0]);
-    displaylist_unpack(reinterpret_cast<uintptr_t*>(gfx), reinterpret_cast<uintptr_t>(packed), 0);
+    // Convert course vtx and extract packed DLs. Reuses the previous result if this course was loaded recently.
+    load_course_geometry(this->vtx, this->gfx, this->gfxSize);
 
     Course::Init();
 }
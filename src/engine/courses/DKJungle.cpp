@@ -85,6 +85,7 @@ DKJungle::DKJungle() {
     Props.Minimap.FinishlineY = 0;
     ResizeMinimap(&Props.Minimap);
 
+    Id = "mk:dk_jungle";
     Props.SetText(Props.Name, "d.k.'s jungle parkway", sizeof(Props.Name));
     Props.SetText(Props.DebugName, "jungle", sizeof(Props.DebugName));
     Props.SetText(Props.CourseLength, "893m", sizeof(Props.CourseLength));
@@ -55,6 +55,7 @@ DoubleDeck::DoubleDeck() {
     Props.Minimap.FinishlineY = 0;
     ResizeMinimap(&Props.Minimap);
 
+    Id = "mk:double_deck";
     Props.SetText(Props.Name, "double deck", sizeof(Props.Name));
     Props.SetText(Props.DebugName, "deck", sizeof(Props.DebugName));
     Props.SetText(Props.CourseLength, "", sizeof(Props.CourseLength));
@@ -65,6 +65,7 @@ FrappeSnowland::FrappeSnowland() {
     Props.Minimap.Colour = {72, 100, 255};
     ResizeMinimap(&Props.Minimap);
 
+    Id = "mk:frappe_snowland";
     Props.SetText(Props.Name, "frappe snowland", sizeof(Props.Name));
     Props.SetText(Props.DebugName, "snow", sizeof(Props.DebugName));
     Props.SetText(Props.CourseLength, "734m", sizeof(Props.CourseLength));
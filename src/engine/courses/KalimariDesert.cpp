@@ -69,6 +69,7 @@ KalimariDesert::KalimariDesert() {
     Props.Minimap.FinishlineY = 4.0;
     ResizeMinimap(&Props.Minimap);
 
+    Id = "mk:kalimari_desert";
     Props.SetText(Props.Name, "kalimari desert", sizeof(Props.Name));
     Props.SetText(Props.DebugName, "desert", sizeof(Props.DebugName));
     Props.SetText(Props.CourseLength, "753m", sizeof(Props.CourseLength));
@@ -314,7 +314,6 @@ void LuigiRaceway::Jumbotron() {
 void LuigiRaceway::Render(struct UnkStruct_800DC5EC* arg0) {
     UNUSED s32 pad;
     u16 sp22 = (u16) arg0->pathCounter;
-    s16 prevFrame;
 
     gSPTexture(gDisplayListHead++, 0xFFFF, 0xFFFF, 0, G_TX_RENDERTILE, G_ON);
     gSPSetGeometryMode(gDisplayListHead++, G_SHADING_SMOOTH);
@@ -356,13 +355,8 @@ void LuigiRaceway::Render(struct UnkStruct_800DC5EC* arg0) {
     // Render only the first player camera onto the television billboard. Screen agnostic screens of other players).
     if (gActiveScreenMode == SCREEN_MODE_1P) {
 
-        prevFrame = (s16) sRenderedFramebuffer - 1;
+        u16* readback = FB_SubscribeReadback();
 
-        if (prevFrame < 0) {
-            prevFrame = 2;
-        } else if (prevFrame >= 3) {
-            prevFrame = 0;
-        }
         currentScreenSection++;
         if (currentScreenSection >= 6) {
             currentScreenSection = 0;
@@ -372,8 +366,10 @@ void LuigiRaceway::Render(struct UnkStruct_800DC5EC* arg0) {
          * The jumbo television screen used to be split into six sections to fit into the n64's texture size
          * restrictions It isn't split into six sections anymore
          */
-        copy_jumbotron_fb_port(D_800DC5DC, D_800DC5E0, currentScreenSection, (u16*) gPortFramebuffers[prevFrame],
-                               (u16*) (gSegmentTable[5] + 0xF800));
+        if (readback != NULL) {
+            copy_jumbotron_fb_port(D_800DC5DC, D_800DC5E0, currentScreenSection, readback,
+                                   (u16*) (gSegmentTable[5] + 0xF800));
+        }
     }
 }
 
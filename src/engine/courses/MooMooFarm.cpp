@@ -87,6 +87,7 @@ MooMooFarm::MooMooFarm() {
     Props.Minimap.FinishlineY = 0;
     ResizeMinimap(&Props.Minimap);
 
+    Id = "mk:moo_moo_farm";
     Props.SetText(Props.Name, "moo moo farm", sizeof(Props.Name));
     Props.SetText(Props.DebugName, "farm", sizeof(Props.DebugName));
     Props.SetText(Props.CourseLength, "527m", sizeof(Props.CourseLength));
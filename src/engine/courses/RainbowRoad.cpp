@@ -61,6 +61,7 @@ RainbowRoad::RainbowRoad() {
     Props.Minimap.FinishlineY = 0;
     ResizeMinimap(&Props.Minimap);
 
+    Id = "mk:rainbow_road";
     Props.SetText(Props.Name, "rainbow road", sizeof(Props.Name));
     Props.SetText(Props.DebugName, "rainbow", sizeof(Props.DebugName));
     Props.SetText(Props.CourseLength, "2000m", sizeof(Props.CourseLength));
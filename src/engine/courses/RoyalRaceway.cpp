@@ -99,6 +99,7 @@ RoyalRaceway::RoyalRaceway() {
     Props.Minimap.FinishlineY = 0;
     ResizeMinimap(&Props.Minimap);
 
+    Id = "mk:royal_raceway";
     Props.SetText(Props.Name, "royal raceway", sizeof(Props.Name));
     Props.SetText(Props.DebugName, "p circuit", sizeof(Props.DebugName));
     Props.SetText(Props.CourseLength, "1025m", sizeof(Props.CourseLength));
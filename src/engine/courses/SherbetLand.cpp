@@ -62,6 +62,7 @@ SherbetLand::SherbetLand() {
     Props.Minimap.Colour = {72, 100, 255};
     ResizeMinimap(&Props.Minimap);
 
+    Id = "mk:sherbet_land";
     Props.SetText(Props.Name, "sherbet land", sizeof(Props.Name));
     Props.SetText(Props.DebugName, "sherbet", sizeof(Props.DebugName));
     Props.SetText(Props.CourseLength, "756m", sizeof(Props.CourseLength));
@@ -76,6 +76,7 @@ Skyscraper::Skyscraper() {
     Props.Minimap.FinishlineY = 0;
     ResizeMinimap(&Props.Minimap);
 
+    Id = "mk:skyscraper";
     Props.SetText(Props.Name, "skyscraper", sizeof(Props.Name));
     Props.SetText(Props.DebugName, "skyscraper", sizeof(Props.DebugName));
     Props.SetText(Props.CourseLength, "", sizeof(Props.CourseLength));
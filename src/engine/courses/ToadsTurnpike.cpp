@@ -8,10 +8,7 @@
 #include "engine/objects/BombKart.h"
 #include "assets/toads_turnpike_data.h"
 #include "engine/actors/Finishline.h"
-#include "engine/vehicles/Bus.h"
-#include "engine/vehicles/Car.h"
-#include "engine/vehicles/Truck.h"
-#include "engine/vehicles/TankerTruck.h"
+#include "engine/vehicles/Traffic.h"
 
 #include "engine/vehicles/Utils.h"
 
@@ -82,6 +79,7 @@ ToadsTurnpike::ToadsTurnpike() {
     Props.Minimap.FinishlineY = 0;
     ResizeMinimap(&Props.Minimap);
 
+    Id = "mk:toads_turnpike";
     Props.SetText(Props.Name, "toad's turnpike", sizeof(Props.Name));
     Props.SetText(Props.DebugName, "highway", sizeof(Props.DebugName));
     Props.SetText(Props.CourseLength, "1036m", sizeof(Props.CourseLength));
@@ -189,26 +187,31 @@ void ToadsTurnpike::BeginPlay() {
             _numCars = 8;
         }
 
+        // All of the traffic is updated together as one actor
+        auto traffic = new ATraffic();
+
         for (size_t i = 0; i < _numTrucks; i++) {
             waypoint = CalculateWaypointDistribution(i, _numTrucks, gPathCountByPathIndex[0], 0);
-            gWorldInstance.AddActor(new ATruck(a, b,  &gTrackPaths[0][0], waypoint));
+            traffic->Spawn(ATraffic::Kind::TRUCK, a, b, &gTrackPaths[0][0], waypoint);
         }
 
         for (size_t i = 0; i < _numBuses; i++) {
             waypoint = CalculateWaypointDistribution(i, _numBuses, gPathCountByPathIndex[0], 75);
-            gWorldInstance.AddActor(new ABus(a, b, &gTrackPaths[0][0], waypoint));
+            traffic->Spawn(ATraffic::Kind::BUS, a, b, &gTrackPaths[0][0], waypoint);
         }
 
         for (size_t i = 0; i < _numTankerTrucks; i++) {
             waypoint = CalculateWaypointDistribution(i, _numTankerTrucks, gPathCountByPathIndex[0], 50);
-            gWorldInstance.AddActor(new ATankerTruck(a, b, &gTrackPaths[0][0], waypoint));
+            traffic->Spawn(ATraffic::Kind::TANKER_TRUCK, a, b, &gTrackPaths[0][0], waypoint);
         }
 
         for (size_t i = 0; i < _numCars; i++) {
             waypoint = CalculateWaypointDistribution(i, _numCars, gPathCountByPathIndex[0], 25);
-            gWorldInstance.AddActor(new ACar(a, b, &gTrackPaths[0][0], waypoint));
+            traffic->Spawn(ATraffic::Kind::CAR, a, b, &gTrackPaths[0][0], waypoint);
         }
 
+        gWorldInstance.AddActor(traffic);
+
         if (gModeSelection == VERSUS) {
             FVector pos = { 0, 0, 0 };
             gWorldInstance.AddObject(new OBombKart(pos, &gTrackPaths[0][50], 50, 3, 0.8333333f));
@@ -31,6 +31,7 @@ extern "C" {
 #include "collision.h"
 #include "code_8003DC40.h"
 #include "memory.h"
+#include "framebuffer_effects.h"
 #include "skybox_and_splitscreen.h"
 #include "course.h"
 extern const char* wario_stadium_dls[];
@@ -78,6 +79,7 @@ WarioStadium::WarioStadium() {
     Props.Minimap.FinishlineY = 0;
     ResizeMinimap(&Props.Minimap);
 
+    Id = "mk:wario_stadium";
     Props.SetText(Props.Name, "wario stadium", sizeof(Props.Name));
     Props.SetText(Props.DebugName, "stadium", sizeof(Props.DebugName));
     Props.SetText(Props.CourseLength, "1591m", sizeof(Props.CourseLength));
@@ -284,8 +286,6 @@ void WarioStadium::Jumbotron() {
 }
 
 void WarioStadium::Render(struct UnkStruct_800DC5EC* arg0) {
-    s16 prevFrame;
-
     gSPTexture(gDisplayListHead++, 0xFFFF, 0xFFFF, 0, G_TX_RENDERTILE, G_ON);
     gSPSetGeometryMode(gDisplayListHead++, G_SHADING_SMOOTH);
     gSPClearGeometryMode(gDisplayListHead++, G_LIGHTING);
@@ -324,12 +324,7 @@ void WarioStadium::Render(struct UnkStruct_800DC5EC* arg0) {
     D_800DC5DC = 88;
     D_800DC5E0 = 72;
     if (gActiveScreenMode == SCREEN_MODE_1P) {
-        prevFrame = (s16) sRenderedFramebuffer - 1;
-        if (prevFrame < 0) {
-            prevFrame = 2;
-        } else if (prevFrame >= 3) {
-            prevFrame = 0;
-        }
+        u16* readback = FB_SubscribeReadback();
         currentScreenSection++;
         if (currentScreenSection >= 6) {
             currentScreenSection = 0;
@@ -339,8 +334,10 @@ void WarioStadium::Render(struct UnkStruct_800DC5EC* arg0) {
          * The jumbo television screen used to be split into six sections to fit into the n64's texture size
          * restrictions It isn't split into six sections anymore
          */
-        copy_jumbotron_fb_port(D_800DC5DC, D_800DC5E0, currentScreenSection, (u16*) gPortFramebuffers[prevFrame],
-                               (u16*) (gSegmentTable[5] + 0x8800));
+        if (readback != NULL) {
+            copy_jumbotron_fb_port(D_800DC5DC, D_800DC5E0, currentScreenSection, readback,
+                                   (u16*) (gSegmentTable[5] + 0x8800));
+        }
     }
 }
 
@@ -71,6 +71,7 @@ YoshiValley::YoshiValley() {
     Props.Minimap.FinishlineY = 0;
     ResizeMinimap(&Props.Minimap);
 
+    Id = "mk:yoshi_valley";
     Props.SetText(Props.Name, "yoshi valley", sizeof(Props.Name));
     Props.SetText(Props.DebugName, "maze", sizeof(Props.DebugName));
     Props.SetText(Props.CourseLength, "772m", sizeof(Props.CourseLength));
@@ -2,6 +2,8 @@
 
 #include <libultraship/libultraship.h>
 #include <libultra/gbi.h>
+#include <memory>
+#include <unordered_map>
 #include "Matrix.h"
 
 extern "C" {
@@ -10,7 +12,10 @@ extern "C" {
 }
 
 namespace Editor {
-    void GenerateCollisionMesh(GameObject* object, Gfx* model, float scale) {
+    // Meshes stay alive only while an object uses them.
+    static std::unordered_map<const Gfx*, std::weak_ptr<const std::vector<Triangle>>> sCollisionMeshes;
+
+    static void CollectTriangles(std::vector<Triangle>& triangles, Gfx* model) {
         int8_t opcode;
         uintptr_t lo;
         uintptr_t hi;
@@ -27,15 +32,15 @@ namespace Editor {
             opcode = (EDITOR_GFX_GET_OPCODE(lo) >> 24);
             switch(opcode) {
                 case G_DL:
-                    GenerateCollisionMesh(object, (Gfx*)hi, scale);
+                    CollectTriangles(triangles, (Gfx*)hi);
                     break;
                 case G_DL_OTR_HASH:
                     ptr++;
-                    GenerateCollisionMesh(object, (Gfx*)ResourceGetDataByCrc(((uint64_t)(ptr->words.w0 << 32)) + ptr->words.w1), scale);
+                    CollectTriangles(triangles, (Gfx*)ResourceGetDataByCrc(((uint64_t)(ptr->words.w0 << 32)) + ptr->words.w1));
                     break;
                 case G_DL_OTR_FILEPATH:
                    // printf("otr filepath: %s\n", (const char*)hi);
-                    GenerateCollisionMesh(object, (Gfx*)ResourceGetDataByName((const char*)hi), scale);
+                    CollectTriangles(triangles, (Gfx*)ResourceGetDataByName((const char*)hi));
                     break;
                 case G_VTX:
                     vtx = (Vtx*)ptr->words.w1;
@@ -65,7 +70,7 @@ namespace Editor {
                     FVector p2 = FVector(vtx[v2].v.ob[0], vtx[v2].v.ob[1], vtx[v2].v.ob[2]);
                     FVector p3 = FVector(vtx[v3].v.ob[0], vtx[v3].v.ob[1], vtx[v3].v.ob[2]);
 
-                    object->Triangles.push_back({p1, p2, p3});
+                    triangles.push_back({p1, p2, p3});
                     break;
                 }
                 case G_TRI1_OTR: {
@@ -83,7 +88,7 @@ namespace Editor {
                     FVector p2 = FVector(vtx[v2].v.ob[0], vtx[v2].v.ob[1], vtx[v2].v.ob[2]);
                     FVector p3 = FVector(vtx[v3].v.ob[0], vtx[v3].v.ob[1], vtx[v3].v.ob[2]);
 
-                    object->Triangles.push_back({p1, p2, p3});
+                    triangles.push_back({p1, p2, p3});
 
                     break;
                 }
@@ -109,8 +114,8 @@ namespace Editor {
                     FVector p5 = FVector(vtx[v5].v.ob[0], vtx[v5].v.ob[1], vtx[v5].v.ob[2]);
                     FVector p6 = FVector(vtx[v6].v.ob[0], vtx[v6].v.ob[1], vtx[v6].v.ob[2]);
 
-                    object->Triangles.push_back({p1, p2, p3});
-                    object->Triangles.push_back({p4, p5, p6});
+                    triangles.push_back({p1, p2, p3});
+                    triangles.push_back({p4, p5, p6});
                     break;
                 }
                 case G_QUAD: {
@@ -128,8 +133,8 @@ namespace Editor {
                     FVector p3 = FVector(vtx[v3].v.ob[0], vtx[v3].v.ob[1], vtx[v3].v.ob[2]);
                     FVector p4 = FVector(vtx[v4].v.ob[0], vtx[v4].v.ob[1], vtx[v4].v.ob[2]);
 
-                    object->Triangles.push_back({p1, p2, p3});
-                    object->Triangles.push_back({p1, p3, p4});
+                    triangles.push_back({p1, p2, p3});
+                    triangles.push_back({p1, p3, p4});
                     break;
                 }
                 case G_ENDDL:
@@ -141,6 +146,32 @@ namespace Editor {
         }
     }
 
+    std::shared_ptr<const std::vector<Triangle>> GetCollisionMesh(Gfx* model) {
+        if (model == nullptr) {
+            return nullptr;
+        }
+
+        auto& cached = sCollisionMeshes[model];
+        if (auto mesh = cached.lock()) {
+            return mesh;
+        }
+
+        auto triangles = std::make_shared<std::vector<Triangle>>();
+        CollectTriangles(*triangles, model);
+        triangles->shrink_to_fit();
+        cached = triangles;
+
+        // Drop entries for models that nothing uses anymore
+        for (auto it = sCollisionMeshes.begin(); it != sCollisionMeshes.end();) {
+            it = it->second.expired() ? sCollisionMeshes.erase(it) : std::next(it);
+        }
+        return triangles;
+    }
+
+    void GenerateCollisionMesh(GameObject* object, Gfx* model, float scale) {
+        object->Triangles = GetCollisionMesh(model);
+    }
+
     std::unordered_map<GameObject*, std::vector<Vtx>> gDebugObjVtxCache;
 
     // Render a collision model
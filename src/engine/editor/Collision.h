@@ -12,12 +12,15 @@
  * Most actors use cylinder collision. 
  * Proper vtx intersection tests are necessary for object picking
  * 
- * Therefore, generate a full collision mesh for actors
+ * Therefore, generate a full collision mesh for actors.
+ * Meshes are built once per model display list and shared by every object using that model;
+ * objects only keep their transform, which the picker applies to the ray.
  */
 
 #define EDITOR_GFX_GET_OPCODE(var) ((uint32_t) ((var) & 0xFF000000))
 
 namespace Editor {
+    std::shared_ptr<const std::vector<Triangle>> GetCollisionMesh(Gfx* model);
     void GenerateCollisionMesh(GameObject* object, Gfx* model, float scale);
     void DebugCollision(GameObject* obj, FVector pos, IRotator rot, FVector scale, const std::vector<Triangle>& triangles);
 }
\ No newline at end of file
@@ -146,6 +146,27 @@ namespace Editor {
         eGameObjects.clear();
     }
 
+    /**
+     * Drops the editor handles of game entities that are about to be freed, in one pass over eGameObjects.
+     * Tick would otherwise read their despawn flags after the delete.
+     */
+    void Editor::RemoveObjectsByDespawnFlag(const std::unordered_set<const void*>& despawnFlags) {
+        auto it = std::remove_if(eGameObjects.begin(), eGameObjects.end(), [&](GameObject* object) {
+            if (despawnFlags.find(object->DespawnFlag) == despawnFlags.end()) {
+                return false;
+            }
+            if (eObjectPicker._selected == object) {
+                eObjectPicker._selected = nullptr;
+            }
+            if (eObjectPicker.eGizmo._selected == object) {
+                eObjectPicker.eGizmo._selected = nullptr;
+            }
+            delete object;
+            return true;
+        });
+        eGameObjects.erase(it, eGameObjects.end());
+    }
+
     void Editor::DeleteObject() {
         Gizmo* gizmo = &eObjectPicker.eGizmo;
 
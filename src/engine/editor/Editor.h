@@ -8,6 +8,7 @@
 #ifdef __cplusplus
 
 #include "ObjectPicker.h"
+#include <unordered_set>
 namespace Editor {
     class ObjectPicker;
 
@@ -26,6 +27,7 @@ public:
     void AddLight(const char* name, FVector* pos, s8* rot);
     void ClearObjects();
     void RemoveObject();
+    void RemoveObjectsByDespawnFlag(const std::unordered_set<const void*>& despawnFlags);
     void SelectObjectFromSceneExplorer(GameObject* object);
     void SetLevelDimensions(s16 minX, s16 maxX, s16 minZ, s16 maxZ, s16 minY, s16 maxY);
     void ClearMatrixPool();
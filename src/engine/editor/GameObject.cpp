@@ -1,9 +1,10 @@
 #include <libultraship/libultraship.h>
 #include "GameObject.h"
+#include "EditorMath.h"
 
 namespace Editor {
 
-    GameObject::GameObject(const char* name, FVector* pos, IRotator* rot, FVector* scale, Gfx* model, std::vector<Triangle> triangles, CollisionType collision, float boundingBoxSize, int32_t* despawnFlag, int32_t despawnValue) {
+    GameObject::GameObject(const char* name, FVector* pos, IRotator* rot, FVector* scale, Gfx* model, std::shared_ptr<const std::vector<Triangle>> triangles, CollisionType collision, float boundingBoxSize, int32_t* despawnFlag, int32_t despawnValue) {
         Name = name;
         Pos = pos;
         Rot = rot;
@@ -23,6 +24,20 @@ namespace Editor {
 
     GameObject::GameObject() {};
 
+    const std::vector<Triangle>& GameObject::GetTriangles() const {
+        static const std::vector<Triangle> sNoTriangles;
+        return (Triangles != nullptr) ? *Triangles : sNoTriangles;
+    }
+
+    /**
+     * Called by the gizmo and the properties panel whenever they change the object.
+     */
+    void GameObject::MarkEdited() {
+        if (DirtyFlag != nullptr) {
+            *DirtyFlag = true;
+        }
+    }
+
     void GameObject::Draw(){};
 
     void GameObject::Tick(){};
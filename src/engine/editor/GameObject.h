@@ -5,6 +5,7 @@
 #include <libultra/types.h>
 #include "../CoreMath.h"
 #include "EditorMath.h"
+#include <memory>
 #include <vector>
 
 extern "C" {
@@ -22,23 +23,26 @@ public:
             BOUNDING_SPHERE
         };
 
-        GameObject(const char* name, FVector* pos, IRotator* rot, FVector* scale, Gfx* model, std::vector<Triangle> triangles, CollisionType collision, float boundingBoxSize, int32_t* despawnFlag, int32_t despawnValue);
+        GameObject(const char* name, FVector* pos, IRotator* rot, FVector* scale, Gfx* model, std::shared_ptr<const std::vector<Triangle>> triangles, CollisionType collision, float boundingBoxSize, int32_t* despawnFlag, int32_t despawnValue);
         GameObject(FVector* pos, Vec3s* rot);
         GameObject();
         virtual void Tick();
         virtual void Draw();
         virtual void Load() {};
+        const std::vector<Triangle>& GetTriangles() const;
+        void MarkEdited();
 
         const char* Name;
         FVector* Pos;
         IRotator* Rot;
         FVector* Scale;
         Gfx* Model;
-        std::vector<Triangle> Triangles;
+        std::shared_ptr<const std::vector<Triangle>> Triangles; // Model space, shared with every object using Model
         CollisionType Collision;
         float BoundingBoxSize;
         int32_t* DespawnFlag;
         int32_t DespawnValue;
+        bool* DirtyFlag = nullptr; // Set by MarkEdited so the owner knows it has to be saved again
 
     };
 }
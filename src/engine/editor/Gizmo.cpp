@@ -73,6 +73,9 @@ void Gizmo::Load() {
 
 void Gizmo::Tick() {
     if (Enabled) {
+        if (_selected != nullptr) {
+            _selected->MarkEdited();
+        }
         TranslationMode mode = static_cast<TranslationMode>(CVarGetInteger("eGizmoMode", 0));
         switch(mode) {
             case TranslationMode::Move:
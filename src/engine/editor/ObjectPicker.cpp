@@ -14,6 +14,7 @@
 #include "Gizmo.h"
 
 #include "EditorMath.h"
+#include <algorithm>
 
 extern "C" {
 #include "common_structs.h"
@@ -100,19 +101,19 @@ void ObjectPicker::DragHandle() {
 
     switch(static_cast<Gizmo::TranslationMode>(CVarGetInteger("eGizmoMode", 0))) {
         case Gizmo::TranslationMode::Move:
-            tryHandle(Gizmo::GizmoHandle::Z_Axis, eGizmo.Mtx_RedX, eGizmo.RedCollision.Triangles);
-            tryHandle(Gizmo::GizmoHandle::X_Axis, eGizmo.Mtx_GreenY, eGizmo.GreenCollision.Triangles);
-            tryHandle(Gizmo::GizmoHandle::Y_Axis, eGizmo.Mtx_BlueZ, eGizmo.BlueCollision.Triangles);
+            tryHandle(Gizmo::GizmoHandle::Z_Axis, eGizmo.Mtx_RedX, eGizmo.RedCollision.GetTriangles());
+            tryHandle(Gizmo::GizmoHandle::X_Axis, eGizmo.Mtx_GreenY, eGizmo.GreenCollision.GetTriangles());
+            tryHandle(Gizmo::GizmoHandle::Y_Axis, eGizmo.Mtx_BlueZ, eGizmo.BlueCollision.GetTriangles());
             break;
         case Gizmo::TranslationMode::Rotate:
-            tryHandle(Gizmo::GizmoHandle::X_Axis, eGizmo.Mtx_RedX, eGizmo.RedRotateCollision.Triangles);
-            tryHandle(Gizmo::GizmoHandle::Z_Axis, eGizmo.Mtx_GreenY, eGizmo.GreenRotateCollision.Triangles);
-            tryHandle(Gizmo::GizmoHandle::Y_Axis, eGizmo.Mtx_BlueZ, eGizmo.BlueRotateCollision.Triangles);
+            tryHandle(Gizmo::GizmoHandle::X_Axis, eGizmo.Mtx_RedX, eGizmo.RedRotateCollision.GetTriangles());
+            tryHandle(Gizmo::GizmoHandle::Z_Axis, eGizmo.Mtx_GreenY, eGizmo.GreenRotateCollision.GetTriangles());
+            tryHandle(Gizmo::GizmoHandle::Y_Axis, eGizmo.Mtx_BlueZ, eGizmo.BlueRotateCollision.GetTriangles());
             break;
         case Gizmo::TranslationMode::Scale:
-            tryHandle(Gizmo::GizmoHandle::Z_Axis, eGizmo.Mtx_RedX, eGizmo.RedScaleCollision.Triangles);
-            tryHandle(Gizmo::GizmoHandle::X_Axis, eGizmo.Mtx_GreenY, eGizmo.GreenScaleCollision.Triangles);
-            tryHandle(Gizmo::GizmoHandle::Y_Axis, eGizmo.Mtx_BlueZ, eGizmo.BlueScaleCollision.Triangles);
+            tryHandle(Gizmo::GizmoHandle::Z_Axis, eGizmo.Mtx_RedX, eGizmo.RedScaleCollision.GetTriangles());
+            tryHandle(Gizmo::GizmoHandle::X_Axis, eGizmo.Mtx_GreenY, eGizmo.GreenScaleCollision.GetTriangles());
+            tryHandle(Gizmo::GizmoHandle::Y_Axis, eGizmo.Mtx_BlueZ, eGizmo.BlueScaleCollision.GetTriangles());
             break;
 
     }
@@ -147,10 +148,18 @@ void ObjectPicker::Draw() {
 }
 
 void ObjectPicker::FindObject(Ray ray, std::vector<GameObject*> objects) {
-    bool found = false;
+    struct Candidate {
+        float tEnter;
+        GameObject* object;
+        const TriangleBVH* bvh;
+    };
+
     GameObject* closestObject = nullptr;
     float closestDistance = FLT_MAX;
+    std::vector<Candidate> candidates;
+    std::unordered_map<const std::vector<Triangle>*, TriangleBVH> bvhCache;
 
+    // Top level: cull every object by its world space bounds, then only walk the triangle trees that the ray can reach.
     for (auto& object : objects) {
         float boundingBox = object->BoundingBoxSize;
         if (boundingBox == 0.0f) {
@@ -158,18 +167,33 @@ void ObjectPicker::FindObject(Ray ray, std::vector<GameObject*> objects) {
         }
 
         switch(object->Collision) {
-            case GameObject::CollisionType::VTX_INTERSECT:
-                for (const auto& tri : object->Triangles) {
-                    float t;
-                    if (IntersectRayTriangleAndTransform(ray, *object->Pos, tri, t)) {
-                        if (t < closestDistance) {
-                            closestDistance = t;
-                            closestObject = object;
-                            printf("SELECTED OBJECT\n");
-                        }
+            case GameObject::CollisionType::VTX_INTERSECT: {
+                if (object->Triangles == nullptr) {
+                    break;
+                }
+
+                // Objects sharing a model share its mesh, so they also share one tree.
+                auto [entry, inserted] = bvhCache.try_emplace(object->Triangles.get());
+                TriangleBVH& bvh = entry->second;
+                if (inserted) {
+                    if (auto cached = _bvhCache.find(object->Triangles.get()); cached != _bvhCache.end()) {
+                        bvh = std::move(cached->second);
                     }
+                    bvh.Update(*object->Triangles, object->Model);
+                }
+                if (bvh.IsEmpty()) {
+                    break;
+                }
+
+                AABB worldBounds = bvh.GetBounds();
+                worldBounds.Min = worldBounds.Min + *object->Pos;
+                worldBounds.Max = worldBounds.Max + *object->Pos;
+                float tEnter, tExit;
+                if (worldBounds.IntersectRay(ray, tEnter, tExit)) {
+                    candidates.push_back({ std::max(tEnter, 0.0f), object, &bvh });
                 }
                 break;
+            }
             case GameObject::CollisionType::BOUNDING_BOX: {
                 float max = 2.0f;
                 float min = -2.0f;
@@ -196,6 +220,29 @@ void ObjectPicker::FindObject(Ray ray, std::vector<GameObject*> objects) {
                 break;
         }
     }
+
+    // Trees of meshes that no object passed in this time uses are dropped with the old cache.
+    _bvhCache = std::move(bvhCache);
+
+    // Bottom level: nearest boxes first, stop once no remaining box can beat the closest hit.
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Candidate& a, const Candidate& b) { return a.tEnter < b.tEnter; });
+
+    for (const auto& candidate : candidates) {
+        if (candidate.tEnter >= closestDistance) {
+            break;
+        }
+
+        // Picking only applies the object's position, so move the ray into object space.
+        Ray localRay = { ray.Origin - *candidate.object->Pos, ray.Direction };
+        float t;
+        if (candidate.bvh->Intersect(localRay, t) && t < closestDistance) {
+            closestDistance = t;
+            closestObject = candidate.object;
+            printf("SELECTED OBJECT\n");
+        }
+    }
+
     if (closestObject != nullptr) {
         _selected = closestObject;
        // printf("FOUND COLLISION %d\n", type);
@@ -5,6 +5,8 @@
 #include "Collision.h"
 #include "Gizmo.h"
 #include "GameObject.h"
+#include "TriangleBVH.h"
+#include <unordered_map>
 
 namespace Editor {
     class ObjectPicker {
@@ -24,5 +26,8 @@ namespace Editor {
         void Copy(MtxF* src, MtxF* dest);
         void Clear(MtxF* mf);
         bool Debug = false;
+
+        // Model space triangle trees for VTX_INTERSECT objects, one per shared collision mesh.
+        std::unordered_map<const std::vector<Triangle>*, TriangleBVH> _bvhCache;
     };
 }
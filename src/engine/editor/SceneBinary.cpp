@@ -0,0 +1,215 @@
+#include "SceneBinary.h"
+#include "StaticMeshActor.h"
+
+#include <cstring>
+
+#define SCENE_MAGIC 0x43534B4D      // "MKSC"
+#define SCENE_MESH_MAGIC 0x4D534B4D // "MKSM"
+#define SCENE_VERSION 1
+
+namespace Editor {
+    namespace {
+        class SceneWriter {
+        public:
+            explicit SceneWriter(std::vector<uint8_t>& out) : mOut(out) {
+            }
+
+            void Write32(uint32_t value) {
+                uint8_t bytes[4] = { (uint8_t) value, (uint8_t) (value >> 8), (uint8_t) (value >> 16),
+                                     (uint8_t) (value >> 24) };
+                mOut.insert(mOut.end(), bytes, bytes + 4);
+            }
+
+            void Write16(uint16_t value) {
+                mOut.push_back((uint8_t) value);
+                mOut.push_back((uint8_t) (value >> 8));
+            }
+
+            void WriteFloat(float value) {
+                uint32_t bits;
+                memcpy(&bits, &value, sizeof(bits));
+                Write32(bits);
+            }
+
+            void WriteString(const std::string& value) {
+                Write32(value.size());
+                mOut.insert(mOut.end(), value.begin(), value.end());
+            }
+
+            void WriteBytes(const std::vector<uint8_t>& value) {
+                Write32(value.size());
+                mOut.insert(mOut.end(), value.begin(), value.end());
+            }
+
+        private:
+            std::vector<uint8_t>& mOut;
+        };
+
+        // Every read is bounds checked; once one fails the reader stays failed.
+        class SceneReader {
+        public:
+            explicit SceneReader(const std::vector<uint8_t>& data) : mData(data) {
+            }
+
+            bool Ok() const {
+                return mOk;
+            }
+
+            bool AtEnd() const {
+                return mPos == mData.size();
+            }
+
+            uint32_t Read32() {
+                if (!Has(4)) {
+                    return 0;
+                }
+                uint32_t value = mData[mPos] | (mData[mPos + 1] << 8) | (mData[mPos + 2] << 16) |
+                                 ((uint32_t) mData[mPos + 3] << 24);
+                mPos += 4;
+                return value;
+            }
+
+            uint16_t Read16() {
+                if (!Has(2)) {
+                    return 0;
+                }
+                uint16_t value = mData[mPos] | (mData[mPos + 1] << 8);
+                mPos += 2;
+                return value;
+            }
+
+            float ReadFloat() {
+                uint32_t bits = Read32();
+                float value;
+                memcpy(&value, &bits, sizeof(value));
+                return value;
+            }
+
+            std::string ReadString() {
+                uint32_t size = Read32();
+                if (!Has(size)) {
+                    return "";
+                }
+                std::string value((const char*) mData.data() + mPos, size);
+                mPos += size;
+                return value;
+            }
+
+            std::vector<uint8_t> ReadBytes() {
+                uint32_t size = Read32();
+                if (!Has(size)) {
+                    return {};
+                }
+                std::vector<uint8_t> value(mData.begin() + mPos, mData.begin() + mPos + size);
+                mPos += size;
+                return value;
+            }
+
+        private:
+            bool Has(size_t size) {
+                if (!mOk || (mData.size() - mPos < size)) {
+                    mOk = false;
+                    return false;
+                }
+                return true;
+            }
+
+            const std::vector<uint8_t>& mData;
+            size_t mPos = 0;
+            bool mOk = true;
+        };
+    } // namespace
+
+    std::string GetBinarySceneFile(const std::string& sceneFile) {
+        size_t dot = sceneFile.find_last_of('.');
+        size_t slash = sceneFile.find_last_of('/');
+        if ((dot == std::string::npos) || ((slash != std::string::npos) && (dot < slash))) {
+            return sceneFile + ".bin";
+        }
+        return sceneFile.substr(0, dot) + ".bin";
+    }
+
+    std::string GetSceneChunkFile(const std::string& sceneFile, uint32_t chunk) {
+        std::string binary = GetBinarySceneFile(sceneFile);
+        return binary.substr(0, binary.size() - 4) + "_meshes_" + std::to_string(chunk) + ".bin";
+    }
+
+    std::vector<uint8_t> EncodeSceneHeader(const std::vector<uint8_t>& props, uint32_t chunkCount, uint32_t meshCount) {
+        std::vector<uint8_t> out;
+        SceneWriter writer(out);
+
+        writer.Write32(SCENE_MAGIC);
+        writer.Write32(SCENE_VERSION);
+        writer.WriteBytes(props);
+        writer.Write32(chunkCount);
+        writer.Write32(meshCount);
+        return out;
+    }
+
+    bool DecodeSceneHeader(const std::vector<uint8_t>& data, std::vector<uint8_t>& props, uint32_t& chunkCount,
+                           uint32_t& meshCount) {
+        SceneReader reader(data);
+
+        if ((reader.Read32() != SCENE_MAGIC) || (reader.Read32() != SCENE_VERSION)) {
+            return false;
+        }
+        props = reader.ReadBytes();
+        chunkCount = reader.Read32();
+        meshCount = reader.Read32();
+        return reader.Ok();
+    }
+
+    std::vector<uint8_t> EncodeSceneMeshChunk(StaticMeshActor* const* actors, size_t count) {
+        std::vector<uint8_t> out;
+        SceneWriter writer(out);
+
+        writer.Write32(SCENE_MESH_MAGIC);
+        writer.Write32(count);
+        for (size_t i = 0; i < count; i++) {
+            const StaticMeshActor* actor = actors[i];
+            writer.WriteString(actor->Name);
+            writer.WriteFloat(actor->Pos.x);
+            writer.WriteFloat(actor->Pos.y);
+            writer.WriteFloat(actor->Pos.z);
+            writer.Write16(actor->Rot.pitch);
+            writer.Write16(actor->Rot.yaw);
+            writer.Write16(actor->Rot.roll);
+            writer.WriteFloat(actor->Scale.x);
+            writer.WriteFloat(actor->Scale.y);
+            writer.WriteFloat(actor->Scale.z);
+            writer.WriteString(actor->Model);
+        }
+        return out;
+    }
+
+    bool DecodeSceneMeshChunk(const std::vector<uint8_t>& data, std::vector<StaticMeshActor*>& out) {
+        SceneReader reader(data);
+
+        if (reader.Read32() != SCENE_MESH_MAGIC) {
+            return false;
+        }
+
+        uint32_t count = reader.Read32();
+        for (uint32_t i = 0; (i < count) && reader.Ok(); i++) {
+            auto actor = new StaticMeshActor("", FVector(0, 0, 0), IRotator(0, 0, 0), FVector(1, 1, 1), "", nullptr);
+            actor->Name = reader.ReadString();
+            actor->Pos.x = reader.ReadFloat();
+            actor->Pos.y = reader.ReadFloat();
+            actor->Pos.z = reader.ReadFloat();
+            actor->Rot.pitch = reader.Read16();
+            actor->Rot.yaw = reader.Read16();
+            actor->Rot.roll = reader.Read16();
+            actor->Scale.x = reader.ReadFloat();
+            actor->Scale.y = reader.ReadFloat();
+            actor->Scale.z = reader.ReadFloat();
+            actor->Model = reader.ReadString();
+
+            if (!reader.Ok()) {
+                delete actor;
+                break;
+            }
+            out.push_back(actor);
+        }
+        return reader.Ok() && reader.AtEnd();
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class StaticMeshActor;
+
+/**
+ * @file Editor Binary Scene
+ *
+ * Compact scene encoding used by SaveLevel/LoadLevel. scene.json stays available through ExportLevelJson for diffing.
+ *
+ * scene.bin holds the track properties and the number of static mesh chunks. The static mesh actors are stored in
+ * chunk files of SCENE_MESHES_PER_CHUNK actors each, so a save only rewrites the chunks whose actors changed.
+ * All values are little endian.
+ */
+
+#define SCENE_MESHES_PER_CHUNK 256
+
+namespace Editor {
+    std::string GetBinarySceneFile(const std::string& sceneFile);
+    std::string GetSceneChunkFile(const std::string& sceneFile, uint32_t chunk);
+
+    // Props are stored as CBOR of the same document Props::to_json produces
+    std::vector<uint8_t> EncodeSceneHeader(const std::vector<uint8_t>& props, uint32_t chunkCount, uint32_t meshCount);
+    bool DecodeSceneHeader(const std::vector<uint8_t>& data, std::vector<uint8_t>& props, uint32_t& chunkCount,
+                           uint32_t& meshCount);
+
+    std::vector<uint8_t> EncodeSceneMeshChunk(StaticMeshActor* const* actors, size_t count);
+    // Appends the decoded actors to out. Returns false if the chunk is damaged.
+    bool DecodeSceneMeshChunk(const std::vector<uint8_t>& data, std::vector<StaticMeshActor*>& out);
+}
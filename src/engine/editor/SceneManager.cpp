@@ -3,9 +3,11 @@
 #include "CoreMath.h"
 #include "World.h"
 #include "GameObject.h"
+#include "SceneBinary.h"
 
 #include <iostream>
 #include <fstream>
+#include <unordered_map>
 #include <nlohmann/json.hpp>
 #include "port/Engine.h"
 #include <libultraship/src/resource/type/Json.h>
@@ -18,8 +20,130 @@ namespace Editor {
     std::shared_ptr<Ship::Archive> CurrentArchive;
     std::string SceneFile = "";
 
+    namespace {
+        struct SavedChunk {
+            std::vector<const StaticMeshActor*> Actors; // In file order
+            bool Written = false;
+        };
+
+        // What the archive currently holds for a binary scene, so saves can skip unchanged chunks.
+        struct SavedScene {
+            std::vector<uint8_t> Header;
+            std::vector<SavedChunk> Chunks;
+        };
+
+        std::unordered_map<std::string, SavedScene> sSavedScenes;
+
+        std::string GetSavedSceneKey(const std::shared_ptr<Ship::Archive>& archive, const std::string& sceneFile) {
+            return archive->GetPath() + ":" + sceneFile;
+        }
+
+        bool WriteSceneFile(const std::string& path, const std::vector<uint8_t>& data) {
+            if (!GameEngine::Instance->context->GetResourceManager()->GetArchiveManager()->WriteFile(CurrentArchive, path, data)) {
+                return false;
+            }
+            // The archive changed under paths that may already be resolved
+            GameEngine_InvalidateResolutionCache();
+            return true;
+        }
+
+        // A chunk is encoded again if it never reached the archive, now holds other actors, or one of them was edited
+        bool IsChunkChanged(const SavedScene& saved, uint32_t chunk, StaticMeshActor* const* actors, size_t count) {
+            if ((chunk >= saved.Chunks.size()) || !saved.Chunks[chunk].Written ||
+                (saved.Chunks[chunk].Actors.size() != count)) {
+                return true;
+            }
+            for (size_t i = 0; i < count; i++) {
+                if ((saved.Chunks[chunk].Actors[i] != actors[i]) || actors[i]->bDirty) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool ReadSceneFile(const std::shared_ptr<Ship::Archive>& archive, const std::string& path, std::vector<uint8_t>& out) {
+            auto file = archive->LoadFile(path);
+            if ((file == nullptr) || (file->Buffer == nullptr)) {
+                return false;
+            }
+            out.assign(file->Buffer->begin(), file->Buffer->end());
+            return true;
+        }
+    } // namespace
+
+    /**
+     * Saves the scene in the binary format. Static mesh actors are written in fixed size chunks, and only chunks with an
+     * actor the editor changed (StaticMeshActor::bDirty) or a different set of actors than last loaded or saved are
+     * encoded and rewritten; the header goes last so it never points at a chunk that failed to write.
+     */
     void SaveLevel() {
-        auto props = gWorldInstance.CurrentCourse->Props;
+        if ((!CurrentArchive) || SceneFile.empty()) {
+            printf("Could not save scene file, SceneFile or CurrentArchive not set\n");
+            return;
+        }
+
+        const auto& actors = gWorldInstance.StaticMeshActors;
+        SavedScene& saved = sSavedScenes[GetSavedSceneKey(CurrentArchive, SceneFile)];
+        uint32_t chunkCount = (actors.size() + SCENE_MESHES_PER_CHUNK - 1) / SCENE_MESHES_PER_CHUNK;
+        size_t rewritten = 0;
+        bool ok = true;
+
+        for (uint32_t chunk = 0; chunk < chunkCount; chunk++) {
+            size_t first = chunk * SCENE_MESHES_PER_CHUNK;
+            size_t count = std::min<size_t>(SCENE_MESHES_PER_CHUNK, actors.size() - first);
+
+            if (!IsChunkChanged(saved, chunk, actors.data() + first, count)) {
+                continue;
+            }
+            if (!WriteSceneFile(GetSceneChunkFile(SceneFile, chunk), EncodeSceneMeshChunk(actors.data() + first, count))) {
+                ok = false;
+                continue;
+            }
+            if (chunk >= saved.Chunks.size()) {
+                saved.Chunks.resize(chunk + 1);
+            }
+            saved.Chunks[chunk].Actors.assign(actors.begin() + first, actors.begin() + first + count);
+            saved.Chunks[chunk].Written = true;
+            for (size_t i = first; i < first + count; i++) {
+                actors[i]->bDirty = false;
+            }
+            rewritten++;
+        }
+
+        if (!ok) {
+            printf("Failed to write scene file!\n");
+            return;
+        }
+
+        std::vector<uint8_t> props;
+        try {
+            props = nlohmann::json::to_cbor(gWorldInstance.CurrentCourse->Props.to_json());
+        } catch (const nlohmann::json::exception& e) {
+            printf("SceneManager::SaveLevel():\n  JSON error during props encoding: %s\n", e.what());
+            return;
+        }
+
+        std::vector<uint8_t> header = EncodeSceneHeader(props, chunkCount, actors.size());
+        if (header != saved.Header) {
+            if (!WriteSceneFile(GetBinarySceneFile(SceneFile), header)) {
+                printf("Failed to write scene file!\n");
+                return;
+            }
+            saved.Header = std::move(header);
+        }
+        // Chunks past the new count are no longer referenced by the header
+        saved.Chunks.resize(chunkCount);
+
+        printf("Successfully wrote scene file!\n  Wrote: %s (%zu of %u mesh chunks changed)\n",
+               GetBinarySceneFile(SceneFile).c_str(), rewritten, chunkCount);
+    }
+
+    /**
+     * Writes the whole scene as scene.json, for diffing and hand editing. LoadLevel only reads it when the track has
+     * no binary scene yet.
+     */
+    void ExportLevelJson() {
+        auto& props = gWorldInstance.CurrentCourse->Props;
 
         if ((CurrentArchive) && (!SceneFile.empty())) {
             nlohmann::json data;
@@ -48,28 +172,83 @@ namespace Editor {
             // data["Objects"] = objects;
 
             try {
-                auto dat = data.dump();
+                auto dat = data.dump(4);
                 std::vector<uint8_t> stringify;
                 stringify.assign(dat.begin(), dat.end());
 
-                bool wrote = GameEngine::Instance->context->GetResourceManager()->GetArchiveManager()->WriteFile(CurrentArchive, SceneFile, stringify);
-                if (wrote) {
-                    printf("Successfully wrote scene file!\n  Wrote: %s\n", SceneFile.c_str());
+                if (WriteSceneFile(SceneFile, stringify)) {
+                    printf("Successfully exported scene file!\n  Wrote: %s\n", SceneFile.c_str());
                 } else {
-                    printf("Failed to write scene file!\n");
+                    printf("Failed to export scene file!\n");
                 }
             } catch (const nlohmann::json::exception& e) {
-                printf("SceneManager::SaveLevel():\n  JSON error during dump: %s\n", e.what());
+                printf("SceneManager::ExportLevelJson():\n  JSON error during dump: %s\n", e.what());
             }
         } else {
-            printf("Could not save scene file, SceneFile or CurrentArchive not set\n");
+            printf("Could not export scene file, SceneFile or CurrentArchive not set\n");
         }
     }
 
+    static bool LoadBinaryLevel(std::shared_ptr<Ship::Archive> archive, Course* course, const std::string& sceneFile) {
+        std::vector<uint8_t> header;
+        if (!ReadSceneFile(archive, GetBinarySceneFile(sceneFile), header)) {
+            return false;
+        }
+
+        std::vector<uint8_t> props;
+        uint32_t chunkCount;
+        uint32_t meshCount;
+        if (!DecodeSceneHeader(header, props, chunkCount, meshCount)) {
+            printf("SceneManager::LoadLevel() %s is damaged, falling back to the json scene\n",
+                   GetBinarySceneFile(sceneFile).c_str());
+            return false;
+        }
+
+        try {
+            course->Props.from_json(nlohmann::json::from_cbor(props));
+        } catch (const std::exception& e) {
+            std::cerr << "SceneManager::LoadLevel() Error parsing track properties: " << e.what() << std::endl;
+        }
+
+        SavedScene& saved = sSavedScenes[GetSavedSceneKey(archive, sceneFile)];
+        saved.Header = std::move(header);
+        saved.Chunks.assign(chunkCount, {});
+
+        std::vector<StaticMeshActor*> actors;
+        actors.reserve(meshCount);
+        for (uint32_t chunk = 0; chunk < chunkCount; chunk++) {
+            std::vector<uint8_t> bytes;
+            size_t first = actors.size();
+            if (!ReadSceneFile(archive, GetSceneChunkFile(sceneFile, chunk), bytes) ||
+                !DecodeSceneMeshChunk(bytes, actors)) {
+                // Left unwritten in saved.Chunks so the next save rewrites it
+                printf("SceneManager::LoadLevel() Mesh chunk %u of %s is missing or damaged\n", chunk, sceneFile.c_str());
+                continue;
+            }
+            for (size_t i = first; i < actors.size(); i++) {
+                actors[i]->bDirty = false;
+            }
+            saved.Chunks[chunk].Actors.assign(actors.begin() + first, actors.end());
+            saved.Chunks[chunk].Written = true;
+        }
+
+        gWorldInstance.StaticMeshActors.clear();  // Clear existing actors, if any
+        gWorldInstance.StaticMeshActors.reserve(actors.size());
+        for (auto actor : actors) {
+            Load_AddStaticMeshActor(actor);
+        }
+        return true;
+    }
+
     void LoadLevel(std::shared_ptr<Ship::Archive> archive, Course* course, std::string sceneFile) {
         SceneFile = sceneFile;
 
         if (archive && (course != nullptr)) {
+            if (LoadBinaryLevel(archive, course, sceneFile)) {
+                return;
+            }
+
+            // No binary scene yet; the next save converts the track.
             auto initData = std::make_shared<Ship::ResourceInitData>();
             initData->Parent = archive;
             initData->Format = RESOURCE_FORMAT_BINARY;
@@ -77,8 +256,12 @@ namespace Editor {
             initData->Type = static_cast<uint32_t>(Ship::ResourceType::Json);
             initData->ResourceVersion = 0;
 
-            nlohmann::json data = std::static_pointer_cast<Ship::Json>(
-                GameEngine::Instance->context->GetResourceManager()->LoadResource(sceneFile, true, initData))->Data;
+            auto resource = std::static_pointer_cast<Ship::Json>(
+                GameEngine::Instance->context->GetResourceManager()->LoadResource(sceneFile, true, initData));
+            if (resource == nullptr) {
+                return;
+            }
+            nlohmann::json data = resource->Data;
 
             if (data.is_null() || data.empty()) {
                 return;
@@ -112,14 +295,16 @@ namespace Editor {
     }
 
     void Load_AddStaticMeshActor(const nlohmann::json& actorJson) {
-        gWorldInstance.StaticMeshActors.push_back(new StaticMeshActor("", FVector(0, 0, 0), IRotator(0, 0, 0), FVector(1, 1, 1), "", nullptr));
-        auto actor = gWorldInstance.StaticMeshActors.back();
+        auto actor = new StaticMeshActor("", FVector(0, 0, 0), IRotator(0, 0, 0), FVector(1, 1, 1), "", nullptr);
         actor->from_json(actorJson);
+        Load_AddStaticMeshActor(actor);
+    }
 
-        printf("After from_json: Pos(%f, %f, %f), Name: %s, Model: %s\n", 
-        actor->Pos.x, actor->Pos.y, actor->Pos.z, actor->Name.c_str(), actor->Model.c_str());
-        gEditor.AddObject(actor->Name.c_str(), &actor->Pos, &actor->Rot, &actor->Scale, (Gfx*) nullptr, 1.0f,
+    void Load_AddStaticMeshActor(StaticMeshActor* actor) {
+        gWorldInstance.StaticMeshActors.push_back(actor);
+        auto gameObj = gEditor.AddObject(actor->Name.c_str(), &actor->Pos, &actor->Rot, &actor->Scale, (Gfx*) nullptr, 1.0f,
                         GameObject::CollisionType::BOUNDING_BOX, 20.0f, (int32_t*) &actor->bPendingDestroy, (int32_t) 1);
+        gameObj->DirtyFlag = &actor->bDirty;
     }
 
     void SetSceneFile(std::shared_ptr<Ship::Archive> archive, std::string sceneFile) {
@@ -1,10 +1,14 @@
 #include <libultraship/libultraship.h>
 #include "engine/courses/Course.h"
 
+class StaticMeshActor;
+
 namespace Editor {
         void SaveLevel();
+        void ExportLevelJson();
         void LoadLevel(std::shared_ptr<Ship::Archive> archive, Course* course, std::string sceneFile);
         void Load_AddStaticMeshActor(const nlohmann::json& actorJson);
+        void Load_AddStaticMeshActor(StaticMeshActor* actor);
         void SetSceneFile(std::shared_ptr<Ship::Archive> archive, std::string sceneFile);
         void LoadMinimap(std::shared_ptr<Ship::Archive> archive, Course* course, std::string filePath);
 
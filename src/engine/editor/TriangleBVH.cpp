@@ -0,0 +1,194 @@
+#include "TriangleBVH.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace Editor {
+    // Triangles per leaf. Small enough that leaves stay cheap, large enough to keep the tree shallow.
+    static constexpr uint32_t BVH_LEAF_SIZE = 4;
+
+    void AABB::Expand(const FVector& p) {
+        Min = FVector(std::min(Min.x, p.x), std::min(Min.y, p.y), std::min(Min.z, p.z));
+        Max = FVector(std::max(Max.x, p.x), std::max(Max.y, p.y), std::max(Max.z, p.z));
+    }
+
+    void AABB::Expand(const AABB& box) {
+        Expand(box.Min);
+        Expand(box.Max);
+    }
+
+    bool AABB::IsValid() const {
+        return Min.x <= Max.x && Min.y <= Max.y && Min.z <= Max.z;
+    }
+
+    bool AABB::IntersectRay(const Ray& ray, float& tEnter, float& tExit) const {
+        const float* origin = &ray.Origin.x;
+        const float* dir = &ray.Direction.x;
+        const float* boxMin = &Min.x;
+        const float* boxMax = &Max.x;
+        float tmin = -FLT_MAX;
+        float tmax = FLT_MAX;
+
+        for (size_t i = 0; i < 3; i++) {
+            if (std::abs(dir[i]) > 1e-6f) {
+                float inv = 1.0f / dir[i];
+                float t1 = (boxMin[i] - origin[i]) * inv;
+                float t2 = (boxMax[i] - origin[i]) * inv;
+                if (t1 > t2) {
+                    std::swap(t1, t2);
+                }
+                tmin = std::max(tmin, t1);
+                tmax = std::min(tmax, t2);
+                if (tmax < tmin) {
+                    return false;
+                }
+            } else if (origin[i] < boxMin[i] || origin[i] > boxMax[i]) {
+                return false; // Parallel and outside the slab
+            }
+        }
+
+        if (tmax < 0.0f) {
+            return false; // Box is behind the ray
+        }
+
+        tEnter = tmin;
+        tExit = tmax;
+        return true;
+    }
+
+    void TriangleBVH::Update(const std::vector<Triangle>& triangles, const Gfx* model) {
+        if ((_sourceData == triangles.data()) && (_sourceSize == triangles.size()) && (_sourceModel == model)) {
+            return;
+        }
+        Build(triangles);
+        _sourceModel = model;
+    }
+
+    void TriangleBVH::Clear() {
+        _nodes.clear();
+        _triangles.clear();
+        _sourceData = nullptr;
+        _sourceSize = 0;
+        _sourceModel = nullptr;
+    }
+
+    void TriangleBVH::Build(const std::vector<Triangle>& triangles) {
+        Clear();
+        _sourceData = triangles.data();
+        _sourceSize = triangles.size();
+
+        if (triangles.empty()) {
+            return;
+        }
+
+        _triangles = triangles;
+
+        std::vector<FVector> centroids;
+        centroids.reserve(_triangles.size());
+        for (const auto& tri : _triangles) {
+            centroids.push_back((tri.v0 + tri.v1 + tri.v2) * (1.0f / 3.0f));
+        }
+
+        _nodes.reserve(2 * (_triangles.size() / BVH_LEAF_SIZE + 1));
+        BuildRecursive(0, _triangles.size(), centroids);
+    }
+
+    uint32_t TriangleBVH::BuildRecursive(uint32_t first, uint32_t count, std::vector<FVector>& centroids) {
+        uint32_t index = _nodes.size();
+        _nodes.push_back({});
+
+        AABB bounds;
+        AABB centroidBounds;
+        for (uint32_t i = first; i < first + count; i++) {
+            bounds.Expand(_triangles[i].v0);
+            bounds.Expand(_triangles[i].v1);
+            bounds.Expand(_triangles[i].v2);
+            centroidBounds.Expand(centroids[i]);
+        }
+        _nodes[index].Bounds = bounds;
+
+        if (count <= BVH_LEAF_SIZE) {
+            _nodes[index].First = first;
+            _nodes[index].Count = count;
+            return index;
+        }
+
+        // Median split along the longest axis of the centroid bounds
+        FVector extent = centroidBounds.Max - centroidBounds.Min;
+        int axis = 0;
+        if (extent.y > extent.x) {
+            axis = 1;
+        }
+        if (extent.z > (&extent.x)[axis]) {
+            axis = 2;
+        }
+
+        std::vector<uint32_t> order(count);
+        std::iota(order.begin(), order.end(), first);
+        uint32_t mid = count / 2;
+        std::nth_element(order.begin(), order.begin() + mid, order.end(), [&](uint32_t a, uint32_t b) {
+            return (&centroids[a].x)[axis] < (&centroids[b].x)[axis];
+        });
+
+        std::vector<Triangle> sortedTris;
+        std::vector<FVector> sortedCentroids;
+        sortedTris.reserve(count);
+        sortedCentroids.reserve(count);
+        for (uint32_t i : order) {
+            sortedTris.push_back(_triangles[i]);
+            sortedCentroids.push_back(centroids[i]);
+        }
+        std::copy(sortedTris.begin(), sortedTris.end(), _triangles.begin() + first);
+        std::copy(sortedCentroids.begin(), sortedCentroids.end(), centroids.begin() + first);
+
+        BuildRecursive(first, mid, centroids);
+        uint32_t right = BuildRecursive(first + mid, count - mid, centroids);
+        _nodes[index].First = right;
+        _nodes[index].Count = 0;
+        return index;
+    }
+
+    bool TriangleBVH::Intersect(const Ray& ray, float& t) const {
+        if (_nodes.empty()) {
+            return false;
+        }
+
+        float closest = FLT_MAX;
+        bool hit = false;
+        uint32_t stack[64];
+        size_t stackSize = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0) {
+            const Node& node = _nodes[stack[--stackSize]];
+            float tEnter, tExit;
+            if (!node.Bounds.IntersectRay(ray, tEnter, tExit) || tEnter > closest) {
+                continue;
+            }
+
+            if (node.Count != 0) {
+                for (uint32_t i = node.First; i < node.First + node.Count; i++) {
+                    float triT;
+                    if (IntersectRayTriangle(ray, _triangles[i], triT) && triT < closest) {
+                        closest = triT;
+                        hit = true;
+                    }
+                }
+            } else {
+                uint32_t left = &node - _nodes.data() + 1;
+                stack[stackSize++] = node.First;
+                stack[stackSize++] = left;
+            }
+        }
+
+        if (hit) {
+            t = closest;
+        }
+        return hit;
+    }
+
+    const AABB& TriangleBVH::GetBounds() const {
+        static const AABB empty;
+        return _nodes.empty() ? empty : _nodes[0].Bounds;
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <libultraship/libultraship.h>
+#include <libultra/types.h>
+#include "../CoreMath.h"
+#include "EditorMath.h"
+#include <vector>
+#include <cfloat>
+
+/**
+ * @file Editor Triangle BVH
+ *
+ * Bounding volume hierarchy over a GameObject's collision triangles.
+ * Triangles are stored in object space; the picker moves the ray into object space instead
+ * of moving the triangles into world space. So the tree only needs to be rebuilt when the
+ * source triangles change, never when an object is dragged around.
+ */
+
+namespace Editor {
+    struct AABB {
+        FVector Min = FVector(FLT_MAX, FLT_MAX, FLT_MAX);
+        FVector Max = FVector(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+        void Expand(const FVector& p);
+        void Expand(const AABB& box);
+        bool IsValid() const;
+        // Slab test. tEnter/tExit are distances along ray.Direction.
+        bool IntersectRay(const Ray& ray, float& tEnter, float& tExit) const;
+    };
+
+    class TriangleBVH {
+    public:
+        // Rebuild from triangles if they are not the set this tree was built from.
+        void Update(const std::vector<Triangle>& triangles, const Gfx* model);
+        void Build(const std::vector<Triangle>& triangles);
+        void Clear();
+
+        // Closest hit in the tree's space. t is only written on a hit.
+        bool Intersect(const Ray& ray, float& t) const;
+
+        const AABB& GetBounds() const;
+        bool IsEmpty() const {
+            return _nodes.empty();
+        }
+
+    private:
+        struct Node {
+            AABB Bounds;
+            uint32_t First; // First triangle when Count != 0, otherwise index of the right child.
+            uint32_t Count; // Triangles in a leaf, 0 for interior nodes. Left child is always this + 1.
+        };
+
+        uint32_t BuildRecursive(uint32_t first, uint32_t count, std::vector<FVector>& centroids);
+
+        std::vector<Node> _nodes;
+        std::vector<Triangle> _triangles;
+
+        // Identity of the source triangles, used to detect a model change.
+        const Triangle* _sourceData = nullptr;
+        size_t _sourceSize = 0;
+        const Gfx* _sourceModel = nullptr;
+    };
+}
@@ -28,6 +28,8 @@ extern "C" {
  */
 class OBat : public OObject {
 public:
+    SAVE_STATE_TRIVIAL(OBat)
+
     explicit OBat(const FVector& pos, const IRotator& rot);
 
     ~OBat() {
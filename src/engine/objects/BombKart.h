@@ -24,6 +24,8 @@ extern "C" {
  */
 class OBombKart : public OObject {
   public:
+    SAVE_STATE_TRIVIAL(OBombKart)
+
     enum States : uint16_t { // 0,1,3,5
         DISABLED,
         CCW,
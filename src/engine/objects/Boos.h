@@ -36,6 +36,8 @@ extern "C" {
  */
 class OBoos : public OObject {
 public:
+    SAVE_STATE_WITH_VECTOR(OBoos, _indices)
+
     explicit OBoos(size_t numBoos, const IPathSpan& leftBoundary, const IPathSpan& active, const IPathSpan& rightBoundary);
 
     ~OBoos() {
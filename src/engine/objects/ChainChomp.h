@@ -22,6 +22,8 @@ extern "C" {
  */
 class OChainChomp : public OObject {
 public:
+    SAVE_STATE_TRIVIAL(OChainChomp)
+
     explicit OChainChomp();
 
 
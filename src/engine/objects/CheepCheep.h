@@ -18,6 +18,8 @@ extern "C" {
 
 class OCheepCheep : public OObject {
 public:
+    SAVE_STATE_TRIVIAL(OCheepCheep)
+
     enum CheepType {
         RACE,
         PODIUM_CEREMONY
@@ -30,6 +30,8 @@ extern "C" {
  */
 class OCrab : public OObject {
 public:
+    SAVE_STATE_TRIVIAL(OCrab)
+
     explicit OCrab(const FVector2D& start, const FVector2D& end);
 
     virtual void Tick() override;
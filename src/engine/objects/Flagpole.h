@@ -19,6 +19,8 @@ extern "C" {
 
 class OFlagpole : public OObject {
 public:
+    SAVE_STATE_TRIVIAL(OFlagpole)
+
     explicit OFlagpole(const FVector& pos, s16 direction);
 
     ~OFlagpole() {
@@ -24,6 +24,7 @@ extern "C" {
  */
 class OGrandPrixBalloons : public OObject {
 public:
+    SAVE_STATE_TRIVIAL(OGrandPrixBalloons)
 
     explicit OGrandPrixBalloons(const FVector& pos);
 
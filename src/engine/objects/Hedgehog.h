@@ -24,6 +24,8 @@ extern "C" {
  */
 class OHedgehog : public OObject {
 public:
+    SAVE_STATE_TRIVIAL(OHedgehog)
+
     explicit OHedgehog(const FVector& pos, const FVector2D& patrolPoint, s16 unk);
 
     ~OHedgehog() {
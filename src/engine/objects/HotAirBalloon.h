@@ -19,6 +19,8 @@ extern "C" {
 
 class OHotAirBalloon : public OObject {
 public:
+    SAVE_STATE_TRIVIAL(OHotAirBalloon)
+
     explicit OHotAirBalloon(const FVector& pos);
 
     virtual void Tick() override;
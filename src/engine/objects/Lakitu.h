@@ -21,6 +21,8 @@ extern "C" {
  */
 class OLakitu : public OObject {
 public:
+    SAVE_STATE_TRIVIAL(OLakitu)
+
     enum LakituType : uint32_t {
         STARTER = 1,
         FINISH, // Checkered flag
@@ -43,6 +45,9 @@ public:
 
     virtual void Tick() override;
     virtual void Tick60fps() override;
+    virtual uint32_t GetScheduleFlags() const override {
+        return SCHEDULE_TICK | SCHEDULE_TICK_60FPS | SCHEDULE_DRAW;
+    }
     virtual void Draw(s32 playerId) override;
 
     void func_80078F64();
@@ -21,6 +21,8 @@ class OMoleGroup;
 
 class OMole : public OObject {
 public:
+    SAVE_STATE_TRIVIAL(OMole)
+
     explicit OMole(FVector pos, OMoleGroup* group);
 
     virtual void Tick() override;
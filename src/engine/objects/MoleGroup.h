@@ -10,6 +10,8 @@ class OMole;
 
 class OMoleGroup : public OObject {
 public:
+    SAVE_STATE_WITH_VECTOR(OMoleGroup, _moles)
+
     struct MoleEntry {
         OMole* Mole;
         FVector Pos;
@@ -19,6 +21,9 @@ public:
     explicit OMoleGroup(std::vector<FVector> moles);
 
     virtual void Tick() override;
+    virtual uint32_t GetScheduleFlags() const override {
+        return SCHEDULE_TICK;
+    }
 
     void func_80081FF4(s32 objectIndex);
 
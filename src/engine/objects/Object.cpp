@@ -21,3 +21,17 @@ void OObject::Destroy() {
     bPendingDestroy = true;
 }
 void OObject::Reset() { }
+// Tick60fps is only overridden by a handful of classes, which opt in themselves.
+uint32_t OObject::GetScheduleFlags() const { return SCHEDULE_TICK | SCHEDULE_DRAW; }
+
+size_t OObject::StateSize() const {
+    return sizeof(OObject);
+}
+
+void OObject::WriteState(uint8_t* dest) const {
+    memcpy(dest, (const void*) this, sizeof(OObject));
+}
+
+void OObject::ReadState(const uint8_t* src) {
+    memcpy((void*) this, src, sizeof(OObject));
+}
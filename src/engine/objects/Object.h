@@ -1,6 +1,7 @@
 #pragma once
 
 #include <libultraship.h>
+#include "SaveState.h"
 
 extern "C" {
     #include "camera.h"
@@ -9,6 +10,13 @@ extern "C" {
 
 class OObject {
 public:
+    // Passes World runs for a class. Must be the same for every instance of a class.
+    enum ScheduleFlags : uint32_t {
+        SCHEDULE_TICK = 1 << 0,
+        SCHEDULE_TICK_60FPS = 1 << 1,
+        SCHEDULE_DRAW = 1 << 2,
+    };
+
     uint8_t uuid[16];
     Object o;
     const char* Name = "";
@@ -25,4 +33,10 @@ public:
     virtual void Expire();
     virtual void Destroy(); // Mark object for deletion at the start of the next frame
     virtual void Reset();
+    virtual uint32_t GetScheduleFlags() const;
+
+    // Snapshot hooks used by SaveState. Subclasses override these through SAVE_STATE_TRIVIAL.
+    virtual size_t StateSize() const;
+    virtual void WriteState(uint8_t* dest) const;
+    virtual void ReadState(const uint8_t* src);
 };
@@ -17,6 +17,8 @@ extern "C" {
 
 class OPenguin : public OObject {
 public:
+    SAVE_STATE_TRIVIAL(OPenguin)
+
     enum PenguinType : uint32_t {
         CHICK,
         ADULT,
@@ -19,6 +19,8 @@ extern "C" {
 
 class OPodium : public OObject {
 public:
+    SAVE_STATE_TRIVIAL(OPodium)
+
     enum Behaviour : uint16_t {
     };
 
@@ -19,6 +19,8 @@ extern "C" {
 //! @todo unk_0D5 needs to be a struct variable probably. What does it do? Behaviour?
 class OSeagull : public OObject {
 public:
+    SAVE_STATE_TRIVIAL(OSeagull)
+
     explicit OSeagull(FVector pos);
 
     ~OSeagull() {
@@ -19,6 +19,8 @@ extern "C" {
 
 class OSnowman : public OObject {
 public:
+    SAVE_STATE_TRIVIAL(OSnowman)
+
     explicit OSnowman(const FVector& pos);
 
     ~OSnowman() {
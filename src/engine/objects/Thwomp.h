@@ -32,6 +32,8 @@ extern "C" {
  */
 class OThwomp : public OObject {
 public:
+    SAVE_STATE_TRIVIAL(OThwomp)
+
     enum States : uint16_t {
         DISABLED,
         STATIONARY,
@@ -55,6 +57,9 @@ public:
     }
 
     virtual void Tick60fps() override;
+    virtual uint32_t GetScheduleFlags() const override {
+        return SCHEDULE_TICK_60FPS | SCHEDULE_DRAW;
+    }
     virtual void Draw(s32 cameraId) override;
     void SetVisibility(s32 objectIndex);
     void func_80080B28(s32 objectIndex, s32 playerId);
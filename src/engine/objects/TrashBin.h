@@ -19,6 +19,7 @@ extern "C" {
 
 class OTrashBin : public OObject {
 public:
+    SAVE_STATE_TRIVIAL(OTrashBin)
 
     enum Behaviour {
         STATIC, // The lid stays shut
@@ -19,6 +19,8 @@ extern "C" {
 
 class OTrophy : public OObject {
 public:
+    SAVE_STATE_TRIVIAL(OTrophy)
+
     enum TrophyType {
         BRONZE,
         SILVER,
@@ -11,3 +11,15 @@ void ParticleEmitter::Tick() {  }
 void ParticleEmitter::Draw(s32  cameraId) { }
 
 bool ParticleEmitter::IsMod() { return false; }
+
+size_t ParticleEmitter::StateSize() const {
+    return sizeof(ParticleEmitter);
+}
+
+void ParticleEmitter::WriteState(uint8_t* dest) const {
+    memcpy(dest, (const void*) this, sizeof(ParticleEmitter));
+}
+
+void ParticleEmitter::ReadState(const uint8_t* src) {
+    memcpy((void*) this, src, sizeof(ParticleEmitter));
+}
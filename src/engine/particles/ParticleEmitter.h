@@ -1,6 +1,7 @@
 #pragma once
 
 #include <libultraship.h>
+#include "SaveState.h"
 
 extern "C" {
 #include "macros.h"
@@ -18,6 +19,11 @@ public:
     virtual void Tick();
     virtual void Draw(s32 cameraId);
     virtual bool IsMod();
+
+    // Snapshot hooks used by SaveState. Subclasses override these through SAVE_STATE_TRIVIAL.
+    virtual size_t StateSize() const;
+    virtual void WriteState(uint8_t* dest) const;
+    virtual void ReadState(const uint8_t* src);
 };
 
 }
\ No newline at end of file
@@ -21,6 +21,8 @@ extern "C" {
  */
 class StarEmitter : public ParticleEmitter {
 public:
+    SAVE_STATE_TRIVIAL(StarEmitter)
+
     enum Behaviour : uint16_t {
     };
 
@@ -11,6 +11,7 @@ extern "C" {
 
 class ABoat : public AActor {
     public:
+    SAVE_STATE_TRIVIAL(ABoat)
 
     const char* Type = "mk:boat";
     size_t Index;
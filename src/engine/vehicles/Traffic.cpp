@@ -0,0 +1,351 @@
+#include <libultraship.h>
+#include "Traffic.h"
+#include <vector>
+
+extern "C" {
+#include "macros.h"
+#include "main.h"
+#include "defines.h"
+#include "code_80005FD0.h"
+#include "actors.h"
+#include "math_util.h"
+#include "sounds.h"
+#include "update_objects.h"
+#include "render_player.h"
+#include "external.h"
+extern s8 gPlayerCount;
+}
+
+// Indexed by ATraffic::Kind. Compiled in rather than loaded from a resource: these are the values the old per-kind
+// classes hard-coded, and the archives have no traffic data to load them from.
+static const ATraffic::KindInfo sKindInfo[] = {
+    { "Truck", ACTOR_BOX_TRUCK, 55.0f, 12.5f, SOUND_ARG_LOAD(0x51, 0x01, 0x80, 0x03) },
+    { "Bus", ACTOR_SCHOOL_BUS, 55.0f, 12.5f, SOUND_ARG_LOAD(0x51, 0x01, 0x80, 0x03) },
+    { "Tanker Truck", ACTOR_TANKER_TRUCK, 55.0f, 12.5f, SOUND_ARG_LOAD(0x51, 0x01, 0x80, 0x03) },
+    { "Car", ACTOR_CAR, 11.5f, 8.5f, SOUND_ARG_LOAD(0x51, 0x01, 0x80, 0x05) },
+};
+static_assert(ARRAY_COUNT(sKindInfo) == (size_t) ATraffic::Kind::COUNT, "Every traffic kind needs an entry");
+
+size_t ATraffic::_counts[(size_t) Kind::COUNT] = { 0 };
+
+ATraffic::ATraffic() {
+    Name = "Traffic";
+}
+
+ATraffic::~ATraffic() {
+    for (Kind kind : Kinds) {
+        _counts[(size_t) kind]--;
+    }
+}
+
+const ATraffic::KindInfo& ATraffic::GetKindInfo(Kind kind) {
+    return sKindInfo[(size_t) kind];
+}
+
+size_t ATraffic::GetCount(Kind kind) {
+    return _counts[(size_t) kind];
+}
+
+/**
+ * Places a vehicle on the road at the given path point and returns its row. Spawn order matters: lanes come
+ * from random_int outside of time trials, and the per-kind count picks them in time trials.
+ */
+size_t ATraffic::Spawn(Kind kind, f32 speedA, f32 speedB, TrackPathPoint* path, uint32_t waypoint) {
+    const KindInfo& info = GetKindInfo(kind);
+    size_t index = _counts[(size_t) kind];
+    TrackPathPoint* point = &path[(u16) waypoint];
+
+    std::array<f32, 3> position = { (f32) point->posX, (f32) point->posY, (f32) point->posZ };
+    std::array<f32, 3> velocity = { 0.0f, 0.0f, 0.0f };
+    std::array<s16, 3> rotation = { 0, 0, 0 };
+    u16 pathPoint = waypoint;
+    s16 lane;
+    f32 laneOffset;
+    f32 speed;
+
+    if (gModeSelection == TIME_TRIALS) {
+        lane = ((index - 1) % 3);
+    } else {
+        lane = random_int(3);
+    }
+    laneOffset = (f32) ((f64) (f32) (lane - 1) * 0.6);
+    if (((gCCSelection > CC_50) || (gModeSelection == TIME_TRIALS)) && (lane == 2)) {
+        speed = speedA;
+    } else {
+        speed = speedB;
+    }
+    if (gIsInExtra == 0) {
+        rotation[1] = func_8000D6D0(position.data(), (s16*) &pathPoint, speed, laneOffset, 0, 3);
+    } else {
+        rotation[1] = func_8000D940(position.data(), (s16*) &pathPoint, speed, laneOffset, 0);
+    }
+    sVehicleSoundRenderCounter = 10;
+
+    spawn_vehicle_on_road(position.data(), rotation.data(), velocity.data(), pathPoint, laneOffset, speed);
+    s16 actorIndex = add_actor_to_empty_slot(position.data(), rotation.data(), velocity.data(), info.ActorType);
+
+    Kinds.push_back(kind);
+    Lanes.push_back(lane);
+    LaneOffsets.push_back(laneOffset);
+    Speeds.push_back(speed);
+    PathPoints.push_back(pathPoint);
+    Positions.push_back(position);
+    Velocities.push_back(velocity);
+    Rotations.push_back(rotation);
+    ActorIndices.push_back(actorIndex);
+    SoundFlags.push_back(0);
+    HonkFlags.push_back(0);
+
+    _counts[(size_t) kind]++;
+    return Kinds.size() - 1;
+}
+
+bool ATraffic::IsMod() {
+    return true;
+}
+
+void ATraffic::Tick() {
+    bool isInExtra = (gIsInExtra != 0);
+    bool isMirrorMode = (gIsMirrorMode != 0);
+
+    for (size_t i = 0; i < Kinds.size(); i++) {
+        f32* position = Positions[i].data();
+        f32* velocity = Velocities[i].data();
+        s16* rotation = Rotations[i].data();
+        f32& laneOffset = LaneOffsets[i];
+        f32 prevX = position[0];
+        f32 prevY = position[1];
+        f32 prevZ = position[2];
+        f32 targetOffset;
+        f32 dx;
+        f32 dz;
+        s16 yaw;
+        s16 pitch;
+        Vec3f before;
+        Vec3f after;
+
+        before[0] = prevY;
+        before[1] = 0.0f;
+        before[2] = 0.0f;
+        targetOffset = func_80013C74(Lanes[i], PathPoints[i]);
+        if (laneOffset < targetOffset) {
+            laneOffset = laneOffset + 0.06;
+            if (targetOffset < laneOffset) {
+                laneOffset = targetOffset;
+            }
+        }
+        if (targetOffset < laneOffset) {
+            laneOffset = laneOffset - 0.06;
+            if (laneOffset < targetOffset) {
+                laneOffset = targetOffset;
+            }
+        }
+        if (!isInExtra) {
+            yaw = func_8000D6D0(position, (s16*) &PathPoints[i], Speeds[i], laneOffset, 0, 3);
+        } else {
+            yaw = func_8000D940(position, (s16*) &PathPoints[i], Speeds[i], laneOffset, 0);
+        }
+        adjust_angle(&rotation[1], yaw, 100);
+        dx = position[0] - prevX;
+        dz = position[2] - prevZ;
+        after[0] = position[1];
+        after[1] = 0.0f;
+        after[2] = sqrtf((dx * dx) + (dz * dz));
+        pitch = get_angle_between_two_vectors(before, after);
+        adjust_angle(&rotation[0], -pitch, 100);
+        velocity[0] = position[0] - prevX;
+        velocity[1] = position[1] - prevY;
+        velocity[2] = position[2] - prevZ;
+
+        struct Actor* vehicleActor = GET_ACTOR(ActorIndices[i]);
+        vehicleActor->pos[0] = position[0];
+        vehicleActor->pos[1] = position[1];
+        vehicleActor->pos[2] = position[2];
+        vehicleActor->rot[0] = rotation[0];
+        if (isMirrorMode) {
+            vehicleActor->rot[1] = -rotation[1];
+        } else {
+            vehicleActor->rot[1] = rotation[1];
+        }
+        vehicleActor->rot[2] = rotation[2];
+        vehicleActor->velocity[0] = velocity[0];
+        vehicleActor->velocity[1] = velocity[1];
+        vehicleActor->velocity[2] = velocity[2];
+    }
+}
+
+void ATraffic::Draw(Camera* camera) {
+    s32 waypointCount = gPathCountByPathIndex[0];
+
+    if (gPlayers[camera->playerId].speed < 1.6666666666666667) {
+        return;
+    }
+
+    for (size_t i = 0; i < Kinds.size(); i++) {
+        u16 pathPoint = PathPoints[i];
+        for (s32 offset = 0; offset < 0x18; offset += 3) {
+            if (((sSomeNearestPathPoint + offset) % waypointCount) == pathPoint) {
+                gPlayerTrackPositionFactorInstruction[camera->playerId].target =
+                    player_track_position_factor_vehicle(Lanes[i], gTrackPositionFactor[camera->playerId], pathPoint);
+                break;
+            }
+        }
+    }
+}
+
+// Picks the horn a passing vehicle plays from the engine sound of its kind
+static u32 GetHornSound(u32 soundBits) {
+    switch (soundBits) {
+        case SOUND_ARG_LOAD(0x51, 0x01, 0x80, 0x05):
+            if (random_int(4) == 0) {
+                return SOUND_ARG_LOAD(0x19, 0x01, 0x70, 0x3C);
+            }
+            return SOUND_ARG_LOAD(0x19, 0x01, 0x70, 0x3B);
+        case SOUND_ARG_LOAD(0x51, 0x01, 0x80, 0x02):
+            if (random_int(2) != 0) {
+                return SOUND_ARG_LOAD(0x19, 0x01, 0x70, 0x3D);
+            }
+            return SOUND_ARG_LOAD(0x19, 0x01, 0x70, 0x3E);
+        case SOUND_ARG_LOAD(0x51, 0x01, 0x80, 0x03):
+            if (random_int(2) != 0) {
+                return SOUND_ARG_LOAD(0x19, 0x01, 0x70, 0x3F);
+            }
+            return SOUND_ARG_LOAD(0x19, 0x01, 0x70, 0x40);
+        case SOUND_ARG_LOAD(0x51, 0x01, 0x80, 0x04):
+            if (random_int(2) != 0) {
+                return SOUND_ARG_LOAD(0x19, 0x01, 0x70, 0x41);
+            }
+            return SOUND_ARG_LOAD(0x19, 0x01, 0x70, 0x42);
+        default:
+            return SOUND_ARG_LOAD(0x19, 0x01, 0x70, 0x3B);
+    }
+}
+
+void ATraffic::VehicleCollision(s32 playerId, Player* player) {
+    bool isHuman = ((player->type & PLAYER_HUMAN) && !(player->type & PLAYER_CPU));
+    u16 waypointCount = gPathCountByPathIndex[0];
+
+    if (((D_801631E0[playerId] == 1) && !isHuman) || (player->effects & 0x01000000)) {
+        return;
+    }
+
+    f32 playerX = player->pos[0];
+    f32 playerY = player->pos[1];
+    f32 playerZ = player->pos[2];
+
+    for (size_t i = 0; i < Kinds.size(); i++) {
+        const KindInfo& info = GetKindInfo(Kinds[i]);
+        f32* position = Positions[i].data();
+        f32* velocity = Velocities[i].data();
+        f32 dx = playerX - position[0];
+        f32 dy = playerY - position[1];
+        f32 dz = playerZ - position[2];
+
+        if ((dx > -100.0) && (dx < 100.0) && (dy > -20.0) && (dy < 20.0) && (dz > -100.0) && (dz < 100.0)) {
+            if (is_collide_with_vehicle(position[0], position[2], velocity[0], velocity[2], info.CollisionLength,
+                                        info.CollisionWidth, playerX, playerZ) == (s32) 1) {
+                player->soundEffects |= REVERSE_SOUND_EFFECT;
+            }
+        }
+        if (!isHuman) {
+            continue;
+        }
+
+        s8& soundFlags = SoundFlags[i];
+        if ((dx > -300.0) && (dx < 300.0) && (dy > -20.0) && (dy < 20.0) && (dz > -300.0) && (dz < 300.0)) {
+            if ((sVehicleSoundRenderCounter > 0) && (soundFlags == 0)) {
+                sVehicleSoundRenderCounter -= 1;
+                soundFlags |= (RENDER_VEHICLE << playerId);
+                func_800C9D80(position, velocity, info.SoundBits);
+            }
+        } else {
+            if (soundFlags != 0) {
+                soundFlags &= ~(RENDER_VEHICLE << playerId);
+                if (soundFlags == 0) {
+                    sVehicleSoundRenderCounter += 1;
+                    func_800C9EF4(position, info.SoundBits);
+                }
+            }
+        }
+
+        s8& honkFlags = HonkFlags[i];
+        if (!((dx > -200.0) && (dx < 200.0) && (dy > -20.0) && (dy < 20.0) && (dz > -200.0) && (dz < 200.0))) {
+            if (honkFlags & (1 << playerId)) {
+                honkFlags &= ~(1 << playerId);
+            }
+            continue;
+        }
+        if (honkFlags & (1 << playerId)) {
+            continue;
+        }
+
+        bool honk = false;
+        switch (gIsInExtra) {
+            case 0:
+                if (is_path_point_in_range(PathPoints[i], gNearestPathPointByPlayerId[playerId], 10, 0,
+                                           waypointCount) > 0) {
+                    if ((gIsPlayerWrongDirection[playerId] == 0) && (player->speed < Speeds[i])) {
+                        honk = true;
+                    }
+                    if (gIsPlayerWrongDirection[playerId] == 1) {
+                        honk = true;
+                    }
+                }
+                break;
+            case 1:
+                if (is_path_point_in_range(PathPoints[i], gNearestPathPointByPlayerId[playerId], 0, 10,
+                                           waypointCount) > 0) {
+                    if (random_int(2) == 0) {
+                        if (gIsPlayerWrongDirection[playerId] == 0) {
+                            honk = true;
+                        }
+                        if ((gIsPlayerWrongDirection[playerId] == 1) && (player->speed < Speeds[i])) {
+                            honk = true;
+                        }
+                    } else {
+                        honkFlags |= (1 << playerId);
+                    }
+                }
+                break;
+        }
+        if (honk) {
+            u32 hornSound = GetHornSound(info.SoundBits);
+            honkFlags |= (1 << playerId);
+            func_800C98B8(position, velocity, hornSound);
+        }
+    }
+}
+
+/**
+ * Snapshots the AActor base followed by every column. The row count is part of StateSize, so a group that
+ * gained or lost vehicles since the capture fails restore validation instead of being resized.
+ */
+size_t ATraffic::StateSize() const {
+    size_t size = sizeof(AActor);
+    ForEachColumn(*this, [&](const auto& column) { size += column.size() * sizeof(column[0]); });
+    return size;
+}
+
+void ATraffic::WriteState(uint8_t* dest) const {
+    memcpy(dest, (const void*) static_cast<const AActor*>(this), sizeof(AActor));
+    dest += sizeof(AActor);
+    ForEachColumn(*this, [&](const auto& column) {
+        size_t size = column.size() * sizeof(column[0]);
+        if (size != 0) {
+            memcpy(dest, (const void*) column.data(), size);
+        }
+        dest += size;
+    });
+}
+
+void ATraffic::ReadState(const uint8_t* src) {
+    memcpy((void*) static_cast<AActor*>(this), src, sizeof(AActor));
+    src += sizeof(AActor);
+    ForEachColumn(*this, [&](auto& column) {
+        size_t size = column.size() * sizeof(column[0]);
+        if (size != 0) {
+            memcpy((void*) column.data(), src, size);
+        }
+        src += size;
+    });
+}
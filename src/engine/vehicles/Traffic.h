@@ -0,0 +1,91 @@
+#pragma once
+
+#include <libultraship.h>
+#include "Actor.h"
+#include <array>
+#include <vector>
+
+extern "C" {
+#include "main.h"
+#include "vehicles.h"
+#include "waypoints.h"
+#include "sounds.h"
+}
+
+/**
+ * @brief Road traffic (cars, buses, trucks and tanker trucks) following a track path.
+ *
+ * Every vehicle in a group is stored as one row across the columns below and the whole group is updated in
+ * a single pass. The four vehicle kinds only differ by the parameters in the kind table in Traffic.cpp.
+ */
+class ATraffic : public AActor {
+  public:
+    enum class Kind : uint8_t {
+        TRUCK,
+        BUS,
+        TANKER_TRUCK,
+        CAR,
+        COUNT
+    };
+
+    struct KindInfo {
+        const char* Name;
+        s16 ActorType;
+        f32 CollisionLength;
+        f32 CollisionWidth;
+        u32 SoundBits;
+    };
+
+    explicit ATraffic();
+    ~ATraffic();
+
+    static const KindInfo& GetKindInfo(Kind kind);
+
+    // Number of live vehicles of this kind across every traffic group
+    static size_t GetCount(Kind kind);
+
+    size_t Spawn(Kind kind, f32 speedA, f32 speedB, TrackPathPoint* path, uint32_t waypoint);
+
+    size_t GetVehicleCount() const {
+        return Kinds.size();
+    }
+
+    std::vector<Kind> Kinds;
+    std::vector<s16> Lanes;
+    std::vector<f32> LaneOffsets;
+    std::vector<f32> Speeds;
+    std::vector<u16> PathPoints;
+    std::vector<std::array<f32, 3>> Positions;
+    std::vector<std::array<f32, 3>> Velocities;
+    std::vector<std::array<s16, 3>> Rotations;
+    std::vector<s16> ActorIndices;
+    std::vector<s8> SoundFlags;
+    std::vector<s8> HonkFlags;
+
+    virtual void Tick() override;
+    virtual void Draw(Camera* camera) override;
+    virtual void VehicleCollision(s32 playerId, Player* player) override;
+    virtual bool IsMod() override;
+
+    size_t StateSize() const override;
+    void WriteState(uint8_t* dest) const override;
+    void ReadState(const uint8_t* src) override;
+
+  private:
+    // Calls f on every column, in a fixed order shared by the save state hooks
+    template <typename Self, typename F> static void ForEachColumn(Self& self, F&& f) {
+        f(self.Kinds);
+        f(self.Lanes);
+        f(self.LaneOffsets);
+        f(self.Speeds);
+        f(self.PathPoints);
+        f(self.Positions);
+        f(self.Velocities);
+        f(self.Rotations);
+        f(self.ActorIndices);
+        f(self.SoundFlags);
+        f(self.HonkFlags);
+    }
+
+    static size_t _counts[(size_t) Kind::COUNT];
+};
@@ -15,6 +15,7 @@ extern "C" {
  */
 class ATrain : public AActor {
     public:
+    SAVE_STATE_WITH_VECTOR(ATrain, PassengerCars)
 
     enum TenderStatus {
         NO_TENDER,
@@ -1,247 +1,497 @@
-// extern "C" {
-// #include <iwasm/include/wasm_c_api.h>
-// #include <iwasm/include/wasm_export.h>
-// #include <iwasm/include/lib_export.h>
-// #include <iwasm/interpreter/wasm_runtime.h>
-// #include <stdint.h>
-// #include <stdio.h>
-// #include <stdlib.h>
-// #include <sys/stat.h>
-// #include <dirent.h>
-// }
-
-// #include <fstream>
-// #include <iostream>
-// #include <vector>
-// #include <filesystem>
-// #include <functional>
-// #include <main.h>
-// #include <menu_items.h>
-// #include <common_data.h>
-// #include <data_segment2.h>
-// #include <render_objects.h>
-
-// struct mod_instance {
-//     wasm_exec_env_t exec_env;
-//     char* name;
-// };
-
-// std::vector<mod_instance> mods_instance = {};
-
-// std::vector<std::function<void()>> render_hook = {};
-
-// void hook_render(wasm_exec_env_t exec_env, uint32 func1) {
-//     render_hook.push_back([exec_env, func1]() { wasm_runtime_call_indirect(exec_env, func1, 0, NULL); });
-// }
-
-// extern "C" void call_render_hook() {
-//     for (auto f : render_hook) {
-//         f();
-//     }
-// }
-
-// bool CreateDirectoryRecursive(std::string const& dirName, std::error_code& err) {
-//     err.clear();
-//     if (!std::filesystem::create_directories(dirName, err)) {
-//         if (std::filesystem::exists(dirName)) {
-//             // The folder already exists:
-//             err.clear();
-//             return true;
-//         }
-//         return false;
-//     }
-//     return true;
-// }
-
-// void load_mod_wasm_file(char* mod_name, char* buffer, size_t size) {
-//     char error_buf[128];
-//     wasm_module_t module;
-//     wasm_module_inst_t module_inst;
-//     wasm_exec_env_t exec_env;
-//     uint32_t stack_size = 8092 * 8092, heap_size = 8092 * 8;
-//     /* parse the WASM file from buffer and create a WASM module */
-//     module = wasm_runtime_load((uint8_t*) buffer, size, error_buf, sizeof(error_buf));
-//     printf("error? %s\n", error_buf);
-
-//     if (module == NULL) {
-//         printf("%s\n", error_buf);
-//         exit(-1);
-//     }
-
-//     /* create an instance of the WASM module (WASM linear memory is ready) */
-//     module_inst = wasm_runtime_instantiate(module, stack_size, heap_size, error_buf, sizeof(error_buf));
-//     if (module_inst == NULL) {
-//         printf("%s\n", error_buf);
-//         exit(-1);
-//     }
-
-//     /* lookup a WASM function by its name
-//      The function signature can NULL here */
-
-//     /* creat an execution environment to execute the WASM functions */
-//     exec_env = wasm_runtime_create_exec_env(module_inst, stack_size);
-//     mods_instance.push_back({ exec_env, mod_name });
-// }
-
-// mod_instance* find_mod(char* name) {
-//     for (size_t i = 0; i < mods_instance.size(); i++) {
-//         if (strcmp(mods_instance[i].name, name) == 0) {
-//             return &mods_instance[i];
-//         }
-//     }
-//     return NULL;
-// }
-
-// wasm_module_inst_t get_mods_instance(char* mod_name) {
-//     return wasm_exec_env_get_module_inst(find_mod(mod_name)->exec_env);
-// }
-
-// wasm_function_inst_t mod_lookup_function(char* mod_name, char* function_name) {
-//     return wasm_runtime_lookup_function(get_mods_instance(mod_name), function_name);
-// }
-
-// bool mod_call_function_wasm(char* mod_name, char* function_name, uint32 argc, uint32 argv[]) {
-//     wasm_function_inst_t func = mod_lookup_function(mod_name, function_name);
-//     if (func == NULL) {
-//         printf("error to find the function\n");
-//         return false;
-//     }
-
-//     return wasm_runtime_call_wasm(find_mod(mod_name)->exec_env, func, 1, argv);
-// }
-
-// void mod_print_exception(char* mod_name) {
-//     printf("%s\n", wasm_runtime_get_exception(get_mods_instance(mod_name)));
-// }
-
-// uint32 call_extern_function(wasm_exec_env_t exec_env, char* mod_name, char* function_name, uint32 argc,
-//                             uint32 argv_offset) {
-//     if (!wasm_runtime_validate_app_addr(wasm_exec_env_get_module_inst(exec_env), (uint64) argv_offset,
-//                                         (uint64) argc * 4)) {
-//         return false;
-//     }
-//     uint32* argv =
-//         (uint32*) wasm_runtime_addr_app_to_native(wasm_exec_env_get_module_inst(exec_env), (uint64) argv_offset);
-//     return mod_call_function_wasm(mod_name, function_name, argc, argv);
-// }
-
-// void post_debug_print(wasm_exec_env_t exec_env) {
-//     gSPDisplayList(gDisplayListHead++, (Gfx*) D_0D007EB8);
-//     gSPDisplayList(gDisplayListHead++, (Gfx*) D_020076E0);
-//     func_80093C98(1);
-// }
-
-// void load_debug_font_wrapper(wasm_exec_env_t exec_env) {
-//     load_debug_font();
-// }
-
-// void debug_print_str2_wrapper(wasm_exec_env_t exec_env, uint32 x, uint32 y, char* str) {
-//     debug_print_str2(x, y, str);
-// }
-
-// /* the native functions that will be exported to WASM app */
-// static NativeSymbol native_symbols[] = {
-//     EXPORT_WASM_API_WITH_SIG(call_extern_function, "($$ii)i"), EXPORT_WASM_API_WITH_SIG(hook_render, "(i)"),
-//     EXPORT_WASM_API_WITH_SIG(post_debug_print, "()"),          EXPORT_WASM_API_WITH_SIG2(load_debug_font, "()"),
-//     EXPORT_WASM_API_WITH_SIG2(debug_print_str2, "(ii$)"),
-//     // EXPORT_WASM_API_WITH_SIG(display_input_read, "(*)i"),
-//     // EXPORT_WASM_API_WITH_SIG(display_flush, "(iiii*)")
-// };
-
-// /* all the runtime memory allocations are retricted in the global_heap_buf array */
-// static char global_heap_buf[512 * 1024];
-
-// char* read_wasm_binary_to_buffer(char* path, uint32_t* size) {
-//     std::ifstream file;
-//     file.open(path, std::ios::binary);
-//     if (!file.is_open()) {
-//         perror(path);
-//         return NULL;
-//     }
-
-//     file.seekg(0, std::ios::end);
-
-//     *size = file.tellg();
-
-//     file.seekg(0);
-
-//     char* c_buffer = (char*) malloc(*size);
-//     file.read(c_buffer, *size);
-//     return c_buffer;
-// }
-
-// extern "C" void load_wasm() {
-//     printf("load wasm\n");
-//     char* buffer;
-
-//     /* initialize the wasm runtime by default configurations */
-//     wasm_runtime_init();
-
-//     RuntimeInitArgs init_args;
-//     memset(&init_args, 0, sizeof(RuntimeInitArgs));
-
-//     /* configure the memory allocator for the runtime */
-//     init_args.mem_alloc_type = Alloc_With_Pool;
-//     init_args.mem_alloc_option.pool.heap_buf = global_heap_buf;
-//     init_args.mem_alloc_option.pool.heap_size = sizeof(global_heap_buf);
-
-//     /* set maximum thread number if needed when multi-thread is enabled,
-//     the default value is 4 */
-//     init_args.max_thread_num = 4;
-
-//     /* initialize runtime environment with user configurations*/
-//     if (!wasm_runtime_full_init(&init_args)) {
-//         exit(-1);
-//     }
-
-//     int n_native_symbols = sizeof(native_symbols) / sizeof(NativeSymbol);
-//     if (!wasm_runtime_register_natives("env", native_symbols, n_native_symbols)) {
-//         exit(-1);
-//     }
-//     uint32_t size;
-
-//     std::error_code err;
-//     if (!CreateDirectoryRecursive("mods", err)) {
-//         // Report the error:
-//         std::cout << "CreateDirectoryRecursive FAILED, err: " << err.message() << std::endl;
-//     }
-
-//     /* read WASM file into a memory buffer */
-//     for (const auto& entry : std::filesystem::directory_iterator("mods")) {
-//         if (std::filesystem::is_regular_file(entry) && entry.path().extension() == ".wasm") {
-//             std::string path = entry.path().string();
-//             std::string name = entry.path().stem().string();
-//             printf("found %s\n", name.c_str());
-//             buffer = read_wasm_binary_to_buffer((char*) path.c_str(), &size);
-//             if (buffer == NULL) {
-//                 printf("error read binary\n");
-//             }
-//             load_mod_wasm_file((char*) name.c_str(), buffer, size);
-//             mod_call_function_wasm((char*) name.c_str(), "init", 0, NULL);
-//         }
-//     }
-//     // buffer = read_wasm_binary_to_buffer("test.wasm", &size);
-//     // if (buffer == NULL) {
-//     //     printf("error read binary\n");
-//     //     exit(-1);
-//     // }
-
-//     // load_mod_wasm_file("test", buffer, size);
-
-//     // uint32_t argv[2];
-
-//     // /* arguments are always transferred in 32-bit element */
-//     // argv[0] = 8;
-//     // printf("run fib function\n");
-//     // /* call the WASM function */
-//     // if (mod_call_function_wasm("test", "fib", 1, argv)) {
-//     //     /* the return value is stored in argv[0] */
-//     //     printf("fib function return: %d\n", argv[0]);
-//     // } else {
-//     //     /* exception is thrown if call fails */
-//     //     // wasm_runtime_dump_call_stack(exec_env);
-//     //     mod_print_exception("test");
-//     // }
-//     // mod_call_function_wasm("test", "init", 0, NULL);
-//     // exit(-1);
-// }
\ No newline at end of file
+#include <libultraship.h>
+
+#include "wasm.h"
+
+#ifdef USE_WASM_MODS
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "port/Engine.h"
+#include "port/Game.h"
+#include "World.h"
+#include "Registry.h"
+#include "profiler.h"
+
+extern "C" {
+#include <wasm_export.h>
+#include <lib_export.h>
+#include <main.h>
+#include <defines.h>
+#include <menu_items.h>
+#include <common_data.h>
+#include <data_segment2.h>
+#include <render_objects.h>
+}
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr uint32_t kStackSize = 64 * 1024;
+constexpr uint32_t kHeapSize = 64 * 1024;
+// Explicit developer actions (init, benchmarks) are not frame critical but must still terminate.
+constexpr auto kUnbudgetedTimeout = std::chrono::seconds(5);
+// However many mods share the per-tick budget, each call gets at least this long.
+constexpr auto kMinSlice = std::chrono::microseconds(250);
+// Overruns in a row before a mod is disabled. A single slow call, e.g. the OS preempting the game thread, is forgiven.
+constexpr uint32_t kMaxOverruns = 3;
+
+struct WasmMod {
+    std::string Name;
+    std::vector<uint8_t> Binary; // Must outlive Module
+    wasm_module_t Module = nullptr;
+    wasm_module_inst_t Instance = nullptr;
+    wasm_exec_env_t ExecEnv = nullptr;
+    wasm_function_inst_t Tick = nullptr;
+    std::vector<uint32_t> RenderHooks; // Function table indices
+    uint32_t Overruns = 0;             // Calls in a row cut short by the watchdog
+    bool Faulted = false;
+};
+
+std::vector<std::unique_ptr<WasmMod>> sMods;
+size_t sNextTickMod = 0; // Rotates so an exhausted budget does not always starve the same mods
+bool sRuntimeReady = false;
+
+/**
+ * Interrupts a mod that runs past its deadline. wasm_runtime_terminate only raises a trap inside the
+ * instance, so the game thread regains control on the next loop back-edge or call in the module.
+ */
+class Watchdog {
+public:
+    void Start() {
+        mRunning = true;
+        mThread = std::thread([this]() { Run(); });
+    }
+
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mRunning = false;
+        }
+        mCv.notify_one();
+        if (mThread.joinable()) {
+            mThread.join();
+        }
+    }
+
+    void Arm(wasm_module_inst_t target, Clock::time_point deadline) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mTarget = target;
+            mDeadline = deadline;
+            mFired = false;
+        }
+        mCv.notify_one();
+    }
+
+    // Returns true if the watchdog terminated the call.
+    bool Disarm() {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mTarget = nullptr;
+        return mFired;
+    }
+
+private:
+    void Run() {
+        trace_set_thread_name("WasmWatchdog");
+        std::unique_lock<std::mutex> lock(mMutex);
+        while (mRunning) {
+            if (mTarget == nullptr) {
+                mCv.wait(lock);
+            } else if (mCv.wait_until(lock, mDeadline) == std::cv_status::timeout && (mTarget != nullptr) &&
+                       (Clock::now() >= mDeadline)) {
+                wasm_runtime_terminate(mTarget);
+                mFired = true;
+                mTarget = nullptr;
+            }
+        }
+    }
+
+    std::thread mThread;
+    std::mutex mMutex;
+    std::condition_variable mCv;
+    wasm_module_inst_t mTarget = nullptr;
+    Clock::time_point mDeadline;
+    bool mRunning = false;
+    bool mFired = false;
+};
+
+Watchdog sWatchdog;
+
+WasmMod* GetMod(wasm_exec_env_t execEnv) {
+    return (WasmMod*) wasm_runtime_get_custom_data(wasm_runtime_get_module_inst(execEnv));
+}
+
+void Fault(WasmMod* mod, const char* reason) {
+    mod->Faulted = true;
+    printf("[WASM] Disabled mod %s: %s\n", mod->Name.c_str(), reason);
+}
+
+/**
+ * Calls into a mod with a hard time slice of its own. A trap disables the mod for the rest of the session since
+ * its state can no longer be trusted. Running past the slice cuts the call short and counts as an overrun; the
+ * mod is only disabled after kMaxOverruns in a row.
+ */
+bool CallMod(WasmMod* mod, Clock::duration slice, uint32_t argc, uint32_t* argv, wasm_function_inst_t func,
+             uint32_t tableIndex = 0) {
+    if (mod->Faulted) {
+        return false;
+    }
+
+    sWatchdog.Arm(mod->Instance, Clock::now() + slice);
+    bool ok = (func != nullptr) ? wasm_runtime_call_wasm(mod->ExecEnv, func, argc, argv)
+                                : wasm_runtime_call_indirect(mod->ExecEnv, tableIndex, argc, argv);
+    bool timedOut = sWatchdog.Disarm();
+
+    if (timedOut) {
+        wasm_runtime_clear_exception(mod->Instance);
+        if (++mod->Overruns >= kMaxOverruns) {
+            Fault(mod, "overran its time slice repeatedly");
+        } else {
+            printf("[WASM] %s overran its %lld us time slice\n", mod->Name.c_str(),
+                   (long long) std::chrono::duration_cast<std::chrono::microseconds>(slice).count());
+        }
+        return false;
+    }
+    if (!ok) {
+        Fault(mod, wasm_runtime_get_exception(mod->Instance));
+        return false;
+    }
+    mod->Overruns = 0;
+    return true;
+}
+
+Clock::duration GetBudget() {
+    return std::chrono::microseconds(CVarGetInteger("gWasmTickBudgetUs", 2000));
+}
+
+// Splits the budget evenly between the mods that run, one mod using up its share does not shorten the others'.
+Clock::duration GetSlice(Clock::duration budget, size_t mods) {
+    Clock::duration slice = budget / (Clock::rep) std::max<size_t>(mods, 1);
+    return std::max(slice, Clock::duration(kMinSlice));
+}
+
+/* Host functions exported to mods under the "env" module */
+
+void hook_render(wasm_exec_env_t execEnv, uint32_t func) {
+    GetMod(execEnv)->RenderHooks.push_back(func);
+}
+
+void host_log(wasm_exec_env_t execEnv, const char* message) {
+    printf("[WASM] %s: %s\n", GetMod(execEnv)->Name.c_str(), message);
+}
+
+// Does nothing; used to measure the fixed cost of crossing into the host.
+void host_nop(wasm_exec_env_t execEnv) {
+}
+
+uint32_t spawn_actor(wasm_exec_env_t execEnv, const char* id, float x, float y, float z) {
+    const ActorFactory* factory = gActorRegistry.Get(id);
+    if (factory == nullptr) {
+        printf("[WASM] %s: spawn_actor unknown actor %s\n", GetMod(execEnv)->Name.c_str(), id);
+        return ACTOR_HANDLE_NONE;
+    }
+    AActor* actor = gWorldInstance.AddActor(factory->Create(FVector(x, y, z)));
+    return (actor != nullptr) ? actor->Handle : ACTOR_HANDLE_NONE;
+}
+
+int32_t spawn_object(wasm_exec_env_t execEnv, const char* id, float x, float y, float z) {
+    const ObjectFactory* factory = gObjectRegistry.Get(id);
+    if (factory == nullptr) {
+        printf("[WASM] %s: spawn_object unknown object %s\n", GetMod(execEnv)->Name.c_str(), id);
+        return 0;
+    }
+    return gWorldInstance.AddObject(factory->Create(FVector(x, y, z))) != nullptr;
+}
+
+int32_t get_player_count(wasm_exec_env_t execEnv) {
+    return NUM_PLAYERS;
+}
+
+// The runtime validates that buffer and size lie inside the module's linear memory ("*~").
+int32_t get_player_state(wasm_exec_env_t execEnv, int32_t index, void* buffer, uint32_t size) {
+    if ((index < 0) || (index >= NUM_PLAYERS) || (size < sizeof(WasmPlayerState))) {
+        return 0;
+    }
+
+    const Player* player = &gPlayers[index];
+    WasmPlayerState state;
+    memset(&state, 0, sizeof(state));
+    for (size_t i = 0; i < 3; i++) {
+        state.pos[i] = player->pos[i];
+        state.velocity[i] = player->velocity[i];
+        state.rotation[i] = player->rotation[i];
+    }
+    state.speed = player->speed;
+    state.type = player->type;
+    state.characterId = player->characterId;
+    state.currentRank = player->currentRank;
+    state.lapCount = player->lapCount;
+    state.nearestPathPointId = player->nearestPathPointId;
+    memcpy(buffer, &state, sizeof(state));
+    return 1;
+}
+
+void post_debug_print(wasm_exec_env_t execEnv) {
+    gSPDisplayList(gDisplayListHead++, (Gfx*) D_0D007EB8);
+    gSPDisplayList(gDisplayListHead++, (Gfx*) D_020076E0);
+    func_80093C98(1);
+}
+
+void load_debug_font_wrapper(wasm_exec_env_t execEnv) {
+    load_debug_font();
+}
+
+void debug_print_str2_wrapper(wasm_exec_env_t execEnv, int32_t x, int32_t y, const char* str) {
+    debug_print_str2(x, y, (char*) str);
+}
+
+NativeSymbol sNativeSymbols[] = {
+    EXPORT_WASM_API_WITH_SIG(hook_render, "(i)"),
+    EXPORT_WASM_API_WITH_SIG(host_log, "($)"),
+    EXPORT_WASM_API_WITH_SIG(host_nop, "()"),
+    EXPORT_WASM_API_WITH_SIG(spawn_actor, "($fff)i"),
+    EXPORT_WASM_API_WITH_SIG(spawn_object, "($fff)i"),
+    EXPORT_WASM_API_WITH_SIG(get_player_count, "()i"),
+    EXPORT_WASM_API_WITH_SIG(get_player_state, "(i*~)i"),
+    EXPORT_WASM_API_WITH_SIG(post_debug_print, "()"),
+    EXPORT_WASM_API_WITH_SIG2(load_debug_font, "()"),
+    EXPORT_WASM_API_WITH_SIG2(debug_print_str2, "(ii$)"),
+};
+
+void DestroyMod(WasmMod* mod) {
+    if (mod->ExecEnv != nullptr) {
+        wasm_runtime_destroy_exec_env(mod->ExecEnv);
+    }
+    if (mod->Instance != nullptr) {
+        wasm_runtime_deinstantiate(mod->Instance);
+    }
+    if (mod->Module != nullptr) {
+        wasm_runtime_unload(mod->Module);
+    }
+}
+
+void LoadMod(const std::string& path) {
+    auto file = GameEngine::Instance->context->GetResourceManager()->GetArchiveManager()->LoadFile(path);
+    if ((file == nullptr) || (file->Buffer == nullptr)) {
+        printf("[WASM] Could not read %s\n", path.c_str());
+        return;
+    }
+
+    auto mod = std::make_unique<WasmMod>();
+    size_t nameStart = path.find_last_of('/') + 1;
+    mod->Name = path.substr(nameStart, path.find_last_of('.') - nameStart);
+    mod->Binary.assign(file->Buffer->begin(), file->Buffer->end());
+
+    // wasm_runtime_load detects AOT images by their magic, so .aot and .wasm share this path.
+    char error[128];
+    mod->Module = wasm_runtime_load(mod->Binary.data(), mod->Binary.size(), error, sizeof(error));
+    if (mod->Module == nullptr) {
+        printf("[WASM] Could not load %s: %s\n", path.c_str(), error);
+        return;
+    }
+
+    mod->Instance = wasm_runtime_instantiate(mod->Module, kStackSize, kHeapSize, error, sizeof(error));
+    if (mod->Instance == nullptr) {
+        printf("[WASM] Could not instantiate %s: %s\n", path.c_str(), error);
+        DestroyMod(mod.get());
+        return;
+    }
+
+    mod->ExecEnv = wasm_runtime_create_exec_env(mod->Instance, kStackSize);
+    if (mod->ExecEnv == nullptr) {
+        printf("[WASM] Could not create an execution environment for %s\n", path.c_str());
+        DestroyMod(mod.get());
+        return;
+    }
+
+    wasm_runtime_set_custom_data(mod->Instance, mod.get());
+    mod->Tick = wasm_runtime_lookup_function(mod->Instance, "tick");
+
+    printf("[WASM] Loaded %s (%s)\n", mod->Name.c_str(),
+           (get_package_type(mod->Binary.data(), mod->Binary.size()) == Wasm_Module_AoT) ? "AOT" : "JIT");
+
+    wasm_function_inst_t init = wasm_runtime_lookup_function(mod->Instance, "init");
+    if (init != nullptr) {
+        if (!CallMod(mod.get(), kUnbudgetedTimeout, 0, nullptr, init) && !mod->Faulted) {
+            Fault(mod.get(), "init did not finish");
+        }
+    }
+    sMods.push_back(std::move(mod));
+}
+
+} // namespace
+
+/**
+ * Loads every WebAssembly mod found under mods/ in the loaded archives.
+ * A precompiled name.aot (see wamrc) is preferred over name.wasm; plain modules run on the fast JIT.
+ */
+extern "C" void load_wasm(void) {
+    RuntimeInitArgs initArgs;
+    memset(&initArgs, 0, sizeof(initArgs));
+    initArgs.mem_alloc_type = Alloc_With_System_Allocator;
+    initArgs.running_mode = wasm_runtime_is_running_mode_supported(Mode_Fast_JIT) ? Mode_Fast_JIT : Mode_Interp;
+    initArgs.native_module_name = "env";
+    initArgs.native_symbols = sNativeSymbols;
+    initArgs.n_native_symbols = sizeof(sNativeSymbols) / sizeof(NativeSymbol);
+
+    if (!wasm_runtime_full_init(&initArgs)) {
+        printf("[WASM] Could not initialize the runtime\n");
+        return;
+    }
+    sRuntimeReady = true;
+    sWatchdog.Start();
+
+    auto manager = GameEngine::Instance->context->GetResourceManager()->GetArchiveManager();
+    auto aotFiles = manager->ListFiles("mods/*.aot");
+    auto wasmFiles = manager->ListFiles("mods/*.wasm");
+
+    if (aotFiles != nullptr) {
+        for (const auto& path : *aotFiles) {
+            LoadMod(path);
+        }
+    }
+    if (wasmFiles != nullptr) {
+        for (const auto& path : *wasmFiles) {
+            std::string aotPath = path.substr(0, path.find_last_of('.')) + ".aot";
+            if (!manager->HasFile(aotPath)) {
+                LoadMod(path);
+            }
+        }
+    }
+}
+
+extern "C" void unload_wasm(void) {
+    if (!sRuntimeReady) {
+        return;
+    }
+
+    for (auto& mod : sMods) {
+        DestroyMod(mod.get());
+    }
+    sMods.clear();
+    sWatchdog.Stop();
+    wasm_runtime_destroy();
+    sRuntimeReady = false;
+}
+
+/**
+ * Runs each mod's tick export in its own slice of the per-tick budget (gWasmTickBudgetUs).
+ * A mod whose whole slice no longer fits in what is left of the budget waits for the next tick.
+ * Skipped during a determinism check, see CM_IsCheckingDeterminism.
+ */
+extern "C" void tick_wasm_mods(void) {
+    if (sMods.empty() || CM_IsCheckingDeterminism()) {
+        return;
+    }
+
+    TRACE_ZONE_BEGIN("WasmMods");
+    size_t ticking = std::count_if(sMods.begin(), sMods.end(), [](const std::unique_ptr<WasmMod>& mod) {
+        return (mod->Tick != nullptr) && !mod->Faulted;
+    });
+    Clock::duration budget = GetBudget();
+    Clock::duration slice = GetSlice(budget, ticking);
+    Clock::time_point end = Clock::now() + budget;
+    size_t count = sMods.size();
+    size_t first = sNextTickMod % count;
+    sNextTickMod = first + 1;
+
+    for (size_t i = 0, started = 0; i < count; i++) {
+        WasmMod* mod = sMods[(first + i) % count].get();
+        if ((mod->Tick == nullptr) || mod->Faulted) {
+            continue;
+        }
+        // The first mod always runs, so a budget below kMinSlice still makes progress
+        if ((started > 0) && (Clock::now() + slice > end)) {
+            // Resume with the first mod that was skipped.
+            sNextTickMod = first + i;
+            break;
+        }
+        started++;
+        CallMod(mod, slice, 0, nullptr, mod->Tick);
+    }
+    TRACE_ZONE_END();
+}
+
+extern "C" void call_render_hook(void) {
+    if (sMods.empty()) {
+        return;
+    }
+
+    size_t hooked = std::count_if(sMods.begin(), sMods.end(), [](const std::unique_ptr<WasmMod>& mod) {
+        return !mod->RenderHooks.empty() && !mod->Faulted;
+    });
+    Clock::duration slice = GetSlice(GetBudget(), hooked);
+    for (auto& mod : sMods) {
+        // A mod's hooks share its slice
+        Clock::time_point modEnd = Clock::now() + slice;
+        for (uint32_t hook : mod->RenderHooks) {
+            Clock::time_point now = Clock::now();
+            if (mod->Faulted || (now >= modEnd)) {
+                break;
+            }
+            CallMod(mod.get(), modEnd - now, 0, nullptr, nullptr, hook);
+        }
+    }
+}
+
+/**
+ * Measures the cost of calling from a mod into the host. Mods opt in by exporting
+ * bench_host_calls(n), which calls host_nop n times, and bench_baseline(n), the same loop without the call.
+ */
+extern "C" void wasm_benchmark_host_calls(u32 iterations) {
+    if (iterations == 0) {
+        return;
+    }
+
+    for (auto& mod : sMods) {
+        wasm_function_inst_t bench = wasm_runtime_lookup_function(mod->Instance, "bench_host_calls");
+        wasm_function_inst_t baseline = wasm_runtime_lookup_function(mod->Instance, "bench_baseline");
+        if ((bench == nullptr) || (baseline == nullptr)) {
+            continue;
+        }
+
+        uint32_t argv[1] = { iterations };
+        Clock::time_point start = Clock::now();
+        if (!CallMod(mod.get(), kUnbudgetedTimeout, 1, argv, baseline)) {
+            continue;
+        }
+        Clock::time_point middle = Clock::now();
+        argv[0] = iterations;
+        if (!CallMod(mod.get(), kUnbudgetedTimeout, 1, argv, bench)) {
+            continue;
+        }
+        Clock::time_point end = Clock::now();
+
+        double baselineNs = std::chrono::duration<double, std::nano>(middle - start).count() / iterations;
+        double callNs = std::chrono::duration<double, std::nano>(end - middle).count() / iterations;
+        printf("[WASM] %s: %u host calls, %.1f ns per iteration, %.1f ns per host call over baseline\n",
+               mod->Name.c_str(), iterations, callNs, callNs - baselineNs);
+    }
+}
+
+#else
+
+extern "C" void load_wasm(void) {
+}
+
+extern "C" void unload_wasm(void) {
+}
+
+extern "C" void tick_wasm_mods(void) {
+}
+
+extern "C" void call_render_hook(void) {
+}
+
+extern "C" void wasm_benchmark_host_calls(u32 iterations) {
+}
+
+#endif // USE_WASM_MODS
@@ -1,2 +1,37 @@
-void load_wasm();
-void call_render_hook();
\ No newline at end of file
+#ifndef ENGINE_WASM_H
+#define ENGINE_WASM_H
+
+#include <libultraship.h>
+
+/**
+ * @brief Player state as seen by WebAssembly mods through get_player_state.
+ *
+ * Part of the mod ABI: fields may be appended but never reordered.
+ */
+typedef struct {
+    f32 pos[3];
+    f32 velocity[3];
+    f32 speed;
+    s16 rotation[3];
+    u16 type;
+    u16 characterId;
+    s16 currentRank;
+    s16 lapCount;
+    s16 nearestPathPointId;
+} WasmPlayerState;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void load_wasm(void);
+void unload_wasm(void);
+void tick_wasm_mods(void);
+void call_render_hook(void);
+void wasm_benchmark_host_calls(u32 iterations);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_WASM_H
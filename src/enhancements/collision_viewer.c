@@ -1,6 +1,9 @@
 #include <libultraship.h>
 #include <libultra/gbi.h>
 #include <common_structs.h>
+#include <macros.h>
+#include <stdlib.h>
+#include <string.h>
 #include "code_800029B0.h"
 #include "mk64.h"
 #include "main.h"
@@ -13,10 +16,221 @@
 #include "assets/other_textures.h"
 #include "assets/common_data.h"
 
-//! @todo decide to use colours or textures and fix displaylists because they are buggy
+/**
+ * The collision viewer draws gCollisionMesh grouped by material.
+ * Each material owns a vertex buffer and a display list that are built once
+ * whenever the collision mesh changes. Rendering then only needs to set up
+ * each material's texture state a single time before calling its display list.
+ */
+
+// Vertices loaded per gSPVertex call. Kept a multiple of three and below the RSP vertex cache size.
+#define COLLISION_VIEWER_VTX_PER_LOAD 30
+
+typedef enum {
+    COLLISION_MAT_DEFAULT, // Untextured, keeps the course vertex colours
+    COLLISION_MAT_ASPHALT,
+    COLLISION_MAT_SNOW_OFFROAD,
+    COLLISION_MAT_RAMP,
+    COLLISION_MAT_DIRT,
+    COLLISION_MAT_STONE,
+    COLLISION_MAT_SNOW,
+    COLLISION_MAT_SAND_OFFROAD,
+    COLLISION_MAT_GRASS,
+    COLLISION_MAT_ICE,
+    COLLISION_MAT_TRAIN_TRACK,
+    COLLISION_MAT_OUT_OF_BOUNDS,
+    COLLISION_MAT_BRIDGE,
+    COLLISION_MAT_COUNT
+} CollisionMaterialId;
+
+typedef struct {
+    const char* texture; // RGBA16 texture, NULL for shade-only materials
+    u8 maskS;            // log2 of the texture width
+    u8 maskT;            // log2 of the texture height
+    bool overrideColour; // Replace the vertex colours with rgb below
+    u8 rgb[3];
+} CollisionMaterial;
+
+typedef struct {
+    Vtx* vtx;
+    Gfx* dl;
+    size_t triCount;
+} CollisionBatch;
+
+static const CollisionMaterial sCollisionMaterials[COLLISION_MAT_COUNT] = {
+    [COLLISION_MAT_DEFAULT] = { NULL, 0, 0, false, { 0, 0, 0 } },
+    [COLLISION_MAT_ASPHALT] = { NULL, 0, 0, true, { 50, 50, 50 } },
+    [COLLISION_MAT_SNOW_OFFROAD] = { NULL, 0, 0, true, { 80, 80, 80 } },
+    [COLLISION_MAT_RAMP] = { NULL, 0, 0, true, { 255, 255, 0 } },
+    [COLLISION_MAT_DIRT] = { gTexture64AF50, 5, 5, false, { 0, 0, 0 } },
+    [COLLISION_MAT_STONE] = { gTexture6528DC, 5, 5, false, { 0, 0, 0 } },
+    [COLLISION_MAT_SNOW] = { gTexture677F04, 5, 5, false, { 0, 0, 0 } },
+    [COLLISION_MAT_SAND_OFFROAD] = { gTexture67B9B0, 5, 5, false, { 0, 0, 0 } },
+    [COLLISION_MAT_GRASS] = { gTextureGrass1, 5, 5, false, { 0, 0, 0 } },
+    [COLLISION_MAT_ICE] = { gTexture643B3C, 5, 5, false, { 0, 0, 0 } },
+    [COLLISION_MAT_TRAIN_TRACK] = { gTextureRailroadTrack, 6, 5, false, { 0, 0, 0 } },
+    [COLLISION_MAT_OUT_OF_BOUNDS] = { gTexture64313C, 5, 5, false, { 0, 0, 0 } },
+    [COLLISION_MAT_BRIDGE] = { gTexture676FB0, 5, 5, false, { 0, 0, 0 } },
+};
+
+static CollisionBatch sCollisionBatches[COLLISION_MAT_COUNT];
+
+// Mesh the batches were built from. Used to detect a new mesh if nobody invalidated us.
+static CollisionTriangle* sBuiltMesh = NULL;
+static u16 sBuiltMeshCount = 0;
+static bool sCollisionViewerDirty = true;
+
+static CollisionMaterialId get_collision_material(u16 surfaceType) {
+    switch (surfaceType) {
+        case ASPHALT:
+            return COLLISION_MAT_ASPHALT;
+        case DIRT:
+            return COLLISION_MAT_DIRT;
+        case STONE:
+            return COLLISION_MAT_STONE;
+        case SNOW:
+            return COLLISION_MAT_SNOW;
+        case SAND_OFFROAD:
+            return COLLISION_MAT_SAND_OFFROAD;
+        case GRASS:
+            return COLLISION_MAT_GRASS;
+        case ICE:
+            return COLLISION_MAT_ICE;
+        case SNOW_OFFROAD:
+            return COLLISION_MAT_SNOW_OFFROAD;
+        case TRAIN_TRACK:
+            return COLLISION_MAT_TRAIN_TRACK;
+        case OUT_OF_BOUNDS:
+            return COLLISION_MAT_OUT_OF_BOUNDS;
+        case BOOST_RAMP_WOOD:
+        case BOOST_RAMP_ASPHALT:
+        case RAMP:
+            return COLLISION_MAT_RAMP;
+        case WOOD_BRIDGE:
+        case ROPE_BRIDGE:
+        case BRIDGE:
+            return COLLISION_MAT_BRIDGE;
+        // SAND, WET_SAND, CLIFF, DIRT_OFFROAD, CAVE and anything unknown
+        default:
+            return COLLISION_MAT_DEFAULT;
+    }
+}
+
+static void free_collision_batches(void) {
+    for (size_t i = 0; i < COLLISION_MAT_COUNT; i++) {
+        free(sCollisionBatches[i].vtx);
+        free(sCollisionBatches[i].dl);
+    }
+    memset(sCollisionBatches, 0, sizeof(sCollisionBatches));
+}
+
+static void build_collision_batch_dl(CollisionBatch* batch) {
+    size_t vtxCount = batch->triCount * 3;
+    size_t loads = (vtxCount + COLLISION_VIEWER_VTX_PER_LOAD - 1) / COLLISION_VIEWER_VTX_PER_LOAD;
+    // One vertex load and up to five gSP2Triangles per load, plus the end command.
+    Gfx* gfx = malloc(sizeof(Gfx) * (loads * (1 + COLLISION_VIEWER_VTX_PER_LOAD / 6) + 1));
+
+    batch->dl = gfx;
+    for (size_t start = 0; start < vtxCount; start += COLLISION_VIEWER_VTX_PER_LOAD) {
+        size_t count = MIN(vtxCount - start, COLLISION_VIEWER_VTX_PER_LOAD);
+        size_t tris = count / 3;
+        size_t tri;
+
+        gSPVertex(gfx++, &batch->vtx[start], count, 0);
+        for (tri = 0; tri + 1 < tris; tri += 2) {
+            gSP2Triangles(gfx++, tri * 3, tri * 3 + 1, tri * 3 + 2, 0, tri * 3 + 3, tri * 3 + 4, tri * 3 + 5, 0);
+        }
+        if (tri < tris) {
+            gSP1Triangle(gfx++, tri * 3, tri * 3 + 1, tri * 3 + 2, 0);
+        }
+    }
+    gSPEndDisplayList(gfx++);
+}
+
+static void build_collision_batches(void) {
+    size_t fill[COLLISION_MAT_COUNT] = { 0 };
+
+    free_collision_batches();
+
+    for (size_t i = 0; i < gCollisionMeshCount; i++) {
+        sCollisionBatches[get_collision_material(gCollisionMesh[i].surfaceType)].triCount++;
+    }
+
+    for (size_t i = 0; i < COLLISION_MAT_COUNT; i++) {
+        if (sCollisionBatches[i].triCount != 0) {
+            sCollisionBatches[i].vtx = malloc(sizeof(Vtx) * sCollisionBatches[i].triCount * 3);
+        }
+    }
+
+    // Copy the vertices so the course geometry itself is never recoloured.
+    for (size_t i = 0; i < gCollisionMeshCount; i++) {
+        CollisionTriangle* tri = &gCollisionMesh[i];
+        CollisionMaterialId id = get_collision_material(tri->surfaceType);
+        const CollisionMaterial* mat = &sCollisionMaterials[id];
+        Vtx* dst = &sCollisionBatches[id].vtx[fill[id]];
+
+        dst[0] = *tri->vtx1;
+        dst[1] = *tri->vtx2;
+        dst[2] = *tri->vtx3;
+        if (mat->overrideColour) {
+            for (size_t j = 0; j < 3; j++) {
+                dst[j].v.cn[0] = mat->rgb[0];
+                dst[j].v.cn[1] = mat->rgb[1];
+                dst[j].v.cn[2] = mat->rgb[2];
+            }
+        }
+        fill[id] += 3;
+    }
+
+    for (size_t i = 0; i < COLLISION_MAT_COUNT; i++) {
+        if (sCollisionBatches[i].triCount != 0) {
+            build_collision_batch_dl(&sCollisionBatches[i]);
+        }
+    }
+
+    sBuiltMesh = gCollisionMesh;
+    sBuiltMeshCount = gCollisionMeshCount;
+    sCollisionViewerDirty = false;
+}
+
+void collision_viewer_invalidate(void) {
+    sCollisionViewerDirty = true;
+}
+
+static void set_collision_material(const CollisionMaterial* mat) {
+    gDPPipeSync(gDisplayListHead++);
+    if (mat->texture == NULL) {
+        gSPTexture(gDisplayListHead++, 0xFFFF, 0xFFFF, 0, G_TX_RENDERTILE, G_OFF);
+        gDPSetCombineMode(gDisplayListHead++, G_CC_SHADE, G_CC_SHADE);
+        gDPSetRenderMode(gDisplayListHead++, G_RM_AA_ZB_OPA_SURF, G_RM_AA_ZB_OPA_SURF2);
+        return;
+    }
+
+    s32 width = 1 << mat->maskS;
+    s32 height = 1 << mat->maskT;
+    s32 line = (width * 2) / 8;
+
+    gSPTexture(gDisplayListHead++, 0xFFFF, 0xFFFF, 0, G_TX_RENDERTILE, G_ON);
+    gDPTileSync(gDisplayListHead++);
+    gDPSetTile(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, line, 0x0000, G_TX_RENDERTILE, 0,
+               G_TX_NOMIRROR | G_TX_WRAP, mat->maskT, G_TX_NOLOD, G_TX_NOMIRROR | G_TX_WRAP, mat->maskS, G_TX_NOLOD);
+    gDPSetTileSize(gDisplayListHead++, G_TX_RENDERTILE, 0, 0, (width - 1) << G_TEXTURE_IMAGE_FRAC,
+                   (height - 1) << G_TEXTURE_IMAGE_FRAC);
+    gDPSetTextureImage(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 1, mat->texture);
+    gDPTileSync(gDisplayListHead++);
+    gDPSetTile(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 0, 0x0000, G_TX_LOADTILE, 0, G_TX_NOMIRROR | G_TX_WRAP,
+               G_TX_NOMASK, G_TX_NOLOD, G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK, G_TX_NOLOD);
+    gDPLoadSync(gDisplayListHead++);
+    gDPLoadBlock(gDisplayListHead++, G_TX_LOADTILE, 0, 0, width * height - 1, CALC_DXT(width, G_IM_SIZ_16b_BYTES));
+    gDPSetCombineMode(gDisplayListHead++, G_CC_MODULATEIA, G_CC_MODULATEIA);
+    gDPSetRenderMode(gDisplayListHead++, G_RM_AA_ZB_XLU_INTER, G_RM_NOOP2);
+}
 
 void render_collision(void) {
-    Mat4 matrix;
+    if (sCollisionViewerDirty || (sBuiltMesh != gCollisionMesh) || (sBuiltMeshCount != gCollisionMeshCount)) {
+        build_collision_batches();
+    }
+
     gSPTexture(gDisplayListHead++, 0xFFFF, 0xFFFF, 0, G_TX_RENDERTILE, G_OFF);
     gSPSetGeometryMode(gDisplayListHead++, G_ZBUFFER | G_SHADE | G_SHADING_SMOOTH);
     gSPClearGeometryMode(gDisplayListHead++, G_CULL_BACK);
@@ -30,303 +244,13 @@ void render_collision(void) {
     // Set matrix
     gSPMatrix(gDisplayListHead++, &gIdentityMatrix, G_MTX_MODELVIEW | G_MTX_LOAD | G_MTX_NOPUSH);
 
-    for (size_t i = 0; i < gCollisionMeshCount; i++) {
-        // Load vertices for this tri
-
-        switch (gCollisionMesh[i].surfaceType) {
-            case ASPHALT:
-
-                //     gSPTexture(gDisplayListHead++, 0xFFFF, 0xFFFF, 0, G_TX_RENDERTILE, G_ON);
-                //     gDPTileSync(gDisplayListHead++);
-                //    gDPSetTile(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 8, 0x0000, G_TX_RENDERTILE, 0,
-                //    G_TX_NOMIRROR | G_TX_WRAP, 5, G_TX_NOLOD, G_TX_MIRROR | G_TX_WRAP, 6, G_TX_NOLOD);
-                //     gDPSetTileSize(gDisplayListHead++, G_TX_RENDERTILE, 0, 0, 0x00FC, 0x007C);
-                //     gDPSetTextureImage(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 1, gTextureRoad1);
-                //     gDPTileSync(gDisplayListHead++);
-                //     gDPSetTile(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 0, 0x0000, G_TX_LOADTILE, 0,
-                //     G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK, G_TX_NOLOD, G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK,
-                //     G_TX_NOLOD); gDPLoadSync(gDisplayListHead++); gDPLoadBlock(gDisplayListHead++, G_TX_LOADTILE, 0,
-                //     0, 2047, 128); gDPSetCombineMode(gDisplayListHead++, G_CC_MODULATEIA, G_CC_MODULATEIA);
-                //     gDPSetRenderMode(gDisplayListHead++, G_RM_AA_ZB_XLU_INTER, G_RM_NOOP2);
-                gCollisionMesh[i].vtx1->v.cn[0] = 50;
-                gCollisionMesh[i].vtx1->v.cn[1] = 50;
-                gCollisionMesh[i].vtx1->v.cn[2] = 50;
-                gCollisionMesh[i].vtx2->v.cn[0] = 50;
-                gCollisionMesh[i].vtx2->v.cn[1] = 50;
-                gCollisionMesh[i].vtx2->v.cn[2] = 50;
-                gCollisionMesh[i].vtx3->v.cn[0] = 50;
-                gCollisionMesh[i].vtx3->v.cn[1] = 50;
-                gCollisionMesh[i].vtx3->v.cn[2] = 50;
-
-                break;
-            case DIRT: // gTexture64619C
-                gSPTexture(gDisplayListHead++, 0xFFFF, 0xFFFF, 0, G_TX_RENDERTILE, G_ON);
-                gDPTileSync(gDisplayListHead++);
-                gDPSetTile(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 8, 0x0000, G_TX_RENDERTILE, 0,
-                           G_TX_NOMIRROR | G_TX_WRAP, 5, G_TX_NOLOD, G_TX_NOMIRROR | G_TX_WRAP, 5, G_TX_NOLOD);
-                gDPSetTileSize(gDisplayListHead++, G_TX_RENDERTILE, 0, 0, 0x007C, 0x007C);
-                gDPSetTextureImage(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 1, gTexture64AF50);
-                gDPTileSync(gDisplayListHead++);
-                gDPSetTile(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 0, 0x0000, G_TX_LOADTILE, 0,
-                           G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK, G_TX_NOLOD, G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK,
-                           G_TX_NOLOD);
-                gDPLoadSync(gDisplayListHead++);
-                gDPLoadBlock(gDisplayListHead++, G_TX_LOADTILE, 0, 0, 1023, 256);
-                gDPSetCombineMode(gDisplayListHead++, G_CC_MODULATEIA, G_CC_MODULATEIA);
-                gDPSetRenderMode(gDisplayListHead++, G_RM_AA_ZB_XLU_INTER, G_RM_NOOP2);
-                // gCollisionMesh[i].vtx1->v.cn[0] = 255;
-                // gCollisionMesh[i].vtx1->v.cn[1] = 248;
-                // gCollisionMesh[i].vtx1->v.cn[2] = 220;
-                // gCollisionMesh[i].vtx2->v.cn[0] = 255;
-                // gCollisionMesh[i].vtx2->v.cn[1] = 248;
-                // gCollisionMesh[i].vtx2->v.cn[2] = 220;
-                // gCollisionMesh[i].vtx3->v.cn[0] = 255;
-                // gCollisionMesh[i].vtx3->v.cn[1] = 248;
-                // gCollisionMesh[i].vtx3->v.cn[2] = 220;
-                break;
-            case SAND:
-                // gSPTexture(gDisplayListHead++, 0xFFFF, 0xFFFF, 0, G_TX_RENDERTILE, G_ON);
-                // gDPTileSync(gDisplayListHead++);
-                // gDPSetTile(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 8, 0x0000, G_TX_RENDERTILE, 0,
-                // G_TX_NOMIRROR | G_TX_WRAP, 5, G_TX_NOLOD, G_TX_NOMIRROR | G_TX_WRAP, 5, G_TX_NOLOD);
-                // gDPSetTileSize(gDisplayListHead++, G_TX_RENDERTILE, 0, 0, 0x007C, 0x007C);
-                // gDPSetTextureImage(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 1, gTexture67BEE8);
-                // gDPTileSync(gDisplayListHead++);
-                // gDPSetTile(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 0, 0x0000, G_TX_LOADTILE, 0,
-                // G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK, G_TX_NOLOD, G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK,
-                // G_TX_NOLOD); gDPLoadSync(gDisplayListHead++); gDPLoadBlock(gDisplayListHead++, G_TX_LOADTILE, 0, 0,
-                // 1023, 256); gDPSetCombineMode(gDisplayListHead++, G_CC_MODULATEIA, G_CC_MODULATEIA);
-                // gDPSetRenderMode(gDisplayListHead++, G_RM_AA_ZB_XLU_INTER, G_RM_NOOP2);
-                // gCollisionMesh[i].vtx1->v.cn[0] = 255;
-                // gCollisionMesh[i].vtx1->v.cn[1] = 121;
-                // gCollisionMesh[i].vtx1->v.cn[2] = 25;
-                // gCollisionMesh[i].vtx2->v.cn[0] = 255;
-                // gCollisionMesh[i].vtx2->v.cn[1] = 121;
-                // gCollisionMesh[i].vtx2->v.cn[2] = 25;
-                // gCollisionMesh[i].vtx3->v.cn[0] = 255;
-                // gCollisionMesh[i].vtx3->v.cn[1] = 121;
-                // gCollisionMesh[i].vtx3->v.cn[2] = 25;
-                break;
-            case STONE:
-                gSPTexture(gDisplayListHead++, 0xFFFF, 0xFFFF, 0, G_TX_RENDERTILE, G_ON);
-                gDPTileSync(gDisplayListHead++);
-                gDPSetTile(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 8, 0x0000, G_TX_RENDERTILE, 0,
-                           G_TX_NOMIRROR | G_TX_WRAP, 5, G_TX_NOLOD, G_TX_NOMIRROR | G_TX_WRAP, 5, G_TX_NOLOD);
-                gDPSetTileSize(gDisplayListHead++, G_TX_RENDERTILE, 0, 0, 0x007C, 0x007C);
-                gDPSetTextureImage(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 1, gTexture6528DC);
-                gDPTileSync(gDisplayListHead++);
-                gDPSetTile(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 0, 0x0000, G_TX_LOADTILE, 0,
-                           G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK, G_TX_NOLOD, G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK,
-                           G_TX_NOLOD);
-                gDPLoadSync(gDisplayListHead++);
-                gDPLoadBlock(gDisplayListHead++, G_TX_LOADTILE, 0, 0, 1023, 256);
-                gDPSetCombineMode(gDisplayListHead++, G_CC_MODULATEIA, G_CC_MODULATEIA);
-                gDPSetRenderMode(gDisplayListHead++, G_RM_AA_ZB_XLU_INTER, G_RM_NOOP2);
-                // gCollisionMesh[i].vtx1->v.cn[0] = 128;
-                // gCollisionMesh[i].vtx1->v.cn[1] = 128;
-                // gCollisionMesh[i].vtx1->v.cn[2] = 128;
-                // gCollisionMesh[i].vtx2->v.cn[0] = 128;
-                // gCollisionMesh[i].vtx2->v.cn[1] = 128;
-                // gCollisionMesh[i].vtx2->v.cn[2] = 128;
-                // gCollisionMesh[i].vtx3->v.cn[0] = 128;
-                // gCollisionMesh[i].vtx3->v.cn[1] = 128;
-                // gCollisionMesh[i].vtx3->v.cn[2] = 128;
-                break;
-            case SNOW:
-                gSPTexture(gDisplayListHead++, 0xFFFF, 0xFFFF, 0, G_TX_RENDERTILE, G_ON);
-                gDPTileSync(gDisplayListHead++);
-                gDPSetTile(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 8, 0x0000, G_TX_RENDERTILE, 0,
-                           G_TX_NOMIRROR | G_TX_WRAP, 5, G_TX_NOLOD, G_TX_NOMIRROR | G_TX_WRAP, 5, G_TX_NOLOD);
-                gDPSetTileSize(gDisplayListHead++, G_TX_RENDERTILE, 0, 0, 0x007C, 0x007C);
-                gDPSetTextureImage(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 1, gTexture677F04);
-                gDPTileSync(gDisplayListHead++);
-                gDPSetTile(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 0, 0x0000, G_TX_LOADTILE, 0,
-                           G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK, G_TX_NOLOD, G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK,
-                           G_TX_NOLOD);
-                gDPLoadSync(gDisplayListHead++);
-                gDPLoadBlock(gDisplayListHead++, G_TX_LOADTILE, 0, 0, 1023, 256);
-                gDPSetCombineMode(gDisplayListHead++, G_CC_MODULATEIA, G_CC_MODULATEIA);
-                gDPSetRenderMode(gDisplayListHead++, G_RM_AA_ZB_XLU_INTER, G_RM_NOOP2);
-                break;
-            case SAND_OFFROAD:
-                gSPTexture(gDisplayListHead++, 0xFFFF, 0xFFFF, 0, G_TX_RENDERTILE, G_ON);
-                gDPTileSync(gDisplayListHead++);
-                gDPSetTile(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 8, 0x0000, G_TX_RENDERTILE, 0,
-                           G_TX_NOMIRROR | G_TX_WRAP, 5, G_TX_NOLOD, G_TX_NOMIRROR | G_TX_WRAP, 5, G_TX_NOLOD);
-                gDPSetTileSize(gDisplayListHead++, G_TX_RENDERTILE, 0, 0, 0x007C, 0x007C);
-                gDPSetTextureImage(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 1, gTexture67B9B0);
-                gDPTileSync(gDisplayListHead++);
-                gDPSetTile(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 0, 0x0000, G_TX_LOADTILE, 0,
-                           G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK, G_TX_NOLOD, G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK,
-                           G_TX_NOLOD);
-                gDPLoadSync(gDisplayListHead++);
-                gDPLoadBlock(gDisplayListHead++, G_TX_LOADTILE, 0, 0, 1023, 256);
-                gDPSetCombineMode(gDisplayListHead++, G_CC_MODULATEIA, G_CC_MODULATEIA);
-                gDPSetRenderMode(gDisplayListHead++, G_RM_AA_ZB_XLU_INTER, G_RM_NOOP2);
-                break;
-            case GRASS: // gTextureGrass1
-
-                gSPTexture(gDisplayListHead++, 0xFFFF, 0xFFFF, 0, G_TX_RENDERTILE, G_ON);
-                gDPTileSync(gDisplayListHead++);
-                gDPSetTile(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 8, 0x0000, G_TX_RENDERTILE, 0,
-                           G_TX_NOMIRROR | G_TX_WRAP, 5, G_TX_NOLOD, G_TX_NOMIRROR | G_TX_WRAP, 5, G_TX_NOLOD);
-                gDPSetTileSize(gDisplayListHead++, G_TX_RENDERTILE, 0, 0, 0x007C, 0x007C);
-                gDPSetTextureImage(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 1, gTextureGrass1);
-                gDPTileSync(gDisplayListHead++);
-                gDPSetTile(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 0, 0x0000, G_TX_LOADTILE, 0,
-                           G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK, G_TX_NOLOD, G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK,
-                           G_TX_NOLOD);
-                gDPLoadSync(gDisplayListHead++);
-                gDPLoadBlock(gDisplayListHead++, G_TX_LOADTILE, 0, 0, 1023, 256);
-                gDPSetCombineMode(gDisplayListHead++, G_CC_MODULATEIA, G_CC_MODULATEIA);
-                gDPSetRenderMode(gDisplayListHead++, G_RM_AA_ZB_XLU_INTER, G_RM_NOOP2);
-
-                // gCollisionMesh[i].vtx1->v.cn[0] = 50;
-                // gCollisionMesh[i].vtx1->v.cn[1] = 180;
-                // gCollisionMesh[i].vtx1->v.cn[2] = 50;
-                // gCollisionMesh[i].vtx2->v.cn[0] = 50;
-                // gCollisionMesh[i].vtx2->v.cn[1] = 180;
-                // gCollisionMesh[i].vtx2->v.cn[2] = 50;
-                // gCollisionMesh[i].vtx3->v.cn[0] = 50;
-                // gCollisionMesh[i].vtx3->v.cn[1] = 180;
-                // gCollisionMesh[i].vtx3->v.cn[2] = 50;
-                break;
-            case ICE:
-                gSPTexture(gDisplayListHead++, 0xFFFF, 0xFFFF, 0, G_TX_RENDERTILE, G_ON);
-                gDPTileSync(gDisplayListHead++);
-                gDPSetTile(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 8, 0x0000, G_TX_RENDERTILE, 0,
-                           G_TX_NOMIRROR | G_TX_WRAP, 5, G_TX_NOLOD, G_TX_NOMIRROR | G_TX_WRAP, 5, G_TX_NOLOD);
-                gDPSetTileSize(gDisplayListHead++, G_TX_RENDERTILE, 0, 0, 0x007C, 0x007C);
-                gDPSetTextureImage(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 1, gTexture643B3C);
-                gDPTileSync(gDisplayListHead++);
-                gDPSetTile(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 0, 0x0000, G_TX_LOADTILE, 0,
-                           G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK, G_TX_NOLOD, G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK,
-                           G_TX_NOLOD);
-                gDPLoadSync(gDisplayListHead++);
-                gDPLoadBlock(gDisplayListHead++, G_TX_LOADTILE, 0, 0, 1023, 256);
-                gDPSetCombineMode(gDisplayListHead++, G_CC_MODULATEIA, G_CC_MODULATEIA);
-                gDPSetRenderMode(gDisplayListHead++, G_RM_AA_ZB_XLU_INTER, G_RM_NOOP2);
-                break;
-            case WET_SAND:
-                // gSPTexture(gDisplayListHead++, 0xFFFF, 0xFFFF, 0, G_TX_RENDERTILE, G_ON);
-                // gDPTileSync(gDisplayListHead++);
-                // gDPSetTile(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 8, 0x0000, G_TX_RENDERTILE, 0,
-                // G_TX_NOMIRROR | G_TX_CLAMP, 6, G_TX_NOLOD, G_TX_NOMIRROR | G_TX_WRAP, 5, G_TX_NOLOD);
-                // gDPSetTileSize(gDisplayListHead++, G_TX_RENDERTILE, 0, 0, 0x007C, 0x00FC);
-                // gDPSetTextureImage(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 1, gTexture66DD38);
-                // gDPTileSync(gDisplayListHead++);
-                // gDPSetTile(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 0, 0x0000, G_TX_LOADTILE, 0,
-                // G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK, G_TX_NOLOD, G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK,
-                // G_TX_NOLOD); gDPLoadSync(gDisplayListHead++); gDPLoadBlock(gDisplayListHead++, G_TX_LOADTILE, 0, 0,
-                // 1023, 256); gDPSetCombineMode(gDisplayListHead++, G_CC_MODULATEIA, G_CC_MODULATEIA);
-                // gDPSetRenderMode(gDisplayListHead++, G_RM_AA_ZB_XLU_INTER, G_RM_NOOP2);
-                break;
-            case SNOW_OFFROAD:
-                gCollisionMesh[i].vtx1->v.cn[0] = 80;
-                gCollisionMesh[i].vtx1->v.cn[1] = 80;
-                gCollisionMesh[i].vtx1->v.cn[2] = 80;
-                gCollisionMesh[i].vtx2->v.cn[0] = 80;
-                gCollisionMesh[i].vtx2->v.cn[1] = 80;
-                gCollisionMesh[i].vtx2->v.cn[2] = 80;
-                gCollisionMesh[i].vtx3->v.cn[0] = 80;
-                gCollisionMesh[i].vtx3->v.cn[1] = 80;
-                gCollisionMesh[i].vtx3->v.cn[2] = 80;
-                break;
-            case CLIFF:
-                break;
-            case DIRT_OFFROAD:
-                break;
-            case TRAIN_TRACK: // gTextureRailroadTrack
-                gSPTexture(gDisplayListHead++, 0xFFFF, 0xFFFF, 0, G_TX_RENDERTILE, G_ON);
-                gDPTileSync(gDisplayListHead++);
-                gDPSetTile(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 16, 0x0000, G_TX_RENDERTILE, 0,
-                           G_TX_NOMIRROR | G_TX_WRAP, 5, G_TX_NOLOD, G_TX_NOMIRROR | G_TX_WRAP, 6, G_TX_NOLOD);
-                gDPSetTileSize(gDisplayListHead++, G_TX_RENDERTILE, 0, 0, 0x00FC, 0x007C);
-                gDPSetTextureImage(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 1, gTextureRailroadTrack);
-                gDPTileSync(gDisplayListHead++);
-                gDPSetTile(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 0, 0x0000, G_TX_LOADTILE, 0,
-                           G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK, G_TX_NOLOD, G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK,
-                           G_TX_NOLOD);
-                gDPLoadSync(gDisplayListHead++);
-                gDPLoadBlock(gDisplayListHead++, G_TX_LOADTILE, 0, 0, 2047, 128);
-                gDPSetCombineMode(gDisplayListHead++, G_CC_MODULATEIA, G_CC_MODULATEIA);
-                gDPSetRenderMode(gDisplayListHead++, G_RM_AA_ZB_XLU_INTER, G_RM_NOOP2);
-                break;
-            case CAVE:
-                break;
-            case OUT_OF_BOUNDS:
-                gSPTexture(gDisplayListHead++, 0xFFFF, 0xFFFF, 0, G_TX_RENDERTILE, G_ON);
-                gDPTileSync(gDisplayListHead++);
-                gDPSetTile(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 8, 0x0000, G_TX_RENDERTILE, 0,
-                           G_TX_NOMIRROR | G_TX_WRAP, 5, G_TX_NOLOD, G_TX_NOMIRROR | G_TX_WRAP, 5, G_TX_NOLOD);
-                gDPSetTileSize(gDisplayListHead++, G_TX_RENDERTILE, 0, 0, 0x007C, 0x007C);
-                gDPSetTextureImage(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 1, gTexture64313C);
-                gDPTileSync(gDisplayListHead++);
-                gDPSetTile(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 0, 0x0000, G_TX_LOADTILE, 0,
-                           G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK, G_TX_NOLOD, G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK,
-                           G_TX_NOLOD);
-                gDPLoadSync(gDisplayListHead++);
-                gDPLoadBlock(gDisplayListHead++, G_TX_LOADTILE, 0, 0, 1023, 256);
-                gDPSetCombineMode(gDisplayListHead++, G_CC_MODULATEIA, G_CC_MODULATEIA);
-                gDPSetRenderMode(gDisplayListHead++, G_RM_AA_ZB_XLU_INTER, G_RM_NOOP2);
-                // gCollisionMesh[i].vtx1->v.cn[0] = 255;
-                // gCollisionMesh[i].vtx1->v.cn[1] = 0;
-                // gCollisionMesh[i].vtx1->v.cn[2] = 0;
-                // gCollisionMesh[i].vtx2->v.cn[0] = 255;
-                // gCollisionMesh[i].vtx2->v.cn[1] = 0;
-                // gCollisionMesh[i].vtx2->v.cn[2] = 0;
-                // gCollisionMesh[i].vtx3->v.cn[0] = 255;
-                // gCollisionMesh[i].vtx3->v.cn[1] = 0;
-                // gCollisionMesh[i].vtx3->v.cn[2] = 0;
-                break;
-            case BOOST_RAMP_WOOD:
-            case BOOST_RAMP_ASPHALT:
-            case RAMP:
-                gCollisionMesh[i].vtx1->v.cn[0] = 255;
-                gCollisionMesh[i].vtx1->v.cn[1] = 255;
-                gCollisionMesh[i].vtx1->v.cn[2] = 0;
-                gCollisionMesh[i].vtx2->v.cn[0] = 255;
-                gCollisionMesh[i].vtx2->v.cn[1] = 255;
-                gCollisionMesh[i].vtx2->v.cn[2] = 0;
-                gCollisionMesh[i].vtx3->v.cn[0] = 255;
-                gCollisionMesh[i].vtx3->v.cn[1] = 255;
-                gCollisionMesh[i].vtx3->v.cn[2] = 0;
-                break;
-            case WOOD_BRIDGE:
-            case ROPE_BRIDGE:
-            case BRIDGE:
-                gSPTexture(gDisplayListHead++, 0xFFFF, 0xFFFF, 0, G_TX_RENDERTILE, G_ON);
-                gDPTileSync(gDisplayListHead++);
-                gDPSetTile(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 8, 0x0000, G_TX_RENDERTILE, 0,
-                           G_TX_NOMIRROR | G_TX_WRAP, 5, G_TX_NOLOD, G_TX_NOMIRROR | G_TX_WRAP, 5, G_TX_NOLOD);
-                gDPSetTileSize(gDisplayListHead++, G_TX_RENDERTILE, 0, 0, 0x007C, 0x007C);
-                gDPSetTextureImage(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 1, gTexture676FB0);
-                gDPTileSync(gDisplayListHead++);
-                gDPSetTile(gDisplayListHead++, G_IM_FMT_RGBA, G_IM_SIZ_16b, 0, 0x0000, G_TX_LOADTILE, 0,
-                           G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK, G_TX_NOLOD, G_TX_NOMIRROR | G_TX_WRAP, G_TX_NOMASK,
-                           G_TX_NOLOD);
-                gDPLoadSync(gDisplayListHead++);
-                gDPLoadBlock(gDisplayListHead++, G_TX_LOADTILE, 0, 0, 1023, 256);
-                gDPSetCombineMode(gDisplayListHead++, G_CC_MODULATEIA, G_CC_MODULATEIA);
-                gDPSetRenderMode(gDisplayListHead++, G_RM_AA_ZB_XLU_INTER, G_RM_NOOP2);
-                // gCollisionMesh[i].vtx1->v.cn[0] = 0;
-                // gCollisionMesh[i].vtx1->v.cn[1] = 255;
-                // gCollisionMesh[i].vtx1->v.cn[2] = 0;
-                // gCollisionMesh[i].vtx2->v.cn[0] = 0;
-                // gCollisionMesh[i].vtx2->v.cn[1] = 255;
-                // gCollisionMesh[i].vtx2->v.cn[2] = 0;
-                // gCollisionMesh[i].vtx3->v.cn[0] = 0;
-                // gCollisionMesh[i].vtx3->v.cn[1] = 255;
-                // gCollisionMesh[i].vtx3->v.cn[2] = 0;
-                break;
+    for (size_t i = 0; i < COLLISION_MAT_COUNT; i++) {
+        if (sCollisionBatches[i].triCount == 0) {
+            continue;
         }
-
-        gSPVertex(gDisplayListHead++, gCollisionMesh[i].vtx1, 1, 0);
-        gSPVertex(gDisplayListHead++, gCollisionMesh[i].vtx2, 1, 1);
-        gSPVertex(gDisplayListHead++, gCollisionMesh[i].vtx3, 1, 2);
-
-        // Draw tri
-        gSP1Triangle(gDisplayListHead++, 0, 1, 2, 0);
-        gSPTexture(gDisplayListHead++, 0xFFFF, 0xFFFF, 0, G_TX_RENDERTILE, G_OFF);
+        set_collision_material(&sCollisionMaterials[i]);
+        gSPDisplayList(gDisplayListHead++, sCollisionBatches[i].dl);
     }
+
+    gSPTexture(gDisplayListHead++, 0xFFFF, 0xFFFF, 0, G_TX_RENDERTILE, G_OFF);
 }
@@ -4,5 +4,7 @@
 #include <libultraship.h>
 
 void render_collision(void);
+// Marks the prebuilt collision geometry stale. Call whenever gCollisionMesh is regenerated.
+void collision_viewer_invalidate(void);
 
 #endif // COLLISION_VIEWER_H
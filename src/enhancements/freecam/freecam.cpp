@@ -2,6 +2,7 @@
 #include <window/Window.h>
 #include "port/Engine.h"
 #include "port/Game.h"
+#include "port/Settings.h"
 #include <controller/controldevice/controller/mapping/keyboard/KeyboardScancodes.h>
 #include <window/Window.h>
 #include "port/interpolation/FrameInterpolation.h"
@@ -79,6 +80,7 @@ void freecam(Camera* camera, Player* player, s8 index) {
         enabled = false;
         freecamEnabled = false;
         CVarSetInteger("gFreecam", false);
+        Settings_MarkDirty();
     }
     
     if (freecamEnabled && !enabled) {
@@ -113,6 +115,7 @@ void freecam_loop(Camera* camera, Player* player, s8 index) {
     if ((fController.buttonPressed & L_TRIG) && (fController.buttonPressed & R_TRIG)) {
         // Toggle freecam
         CVarSetInteger("gFreecam", !CVarGetInteger("gFreecam", 0));
+        Settings_MarkDirty();
     }
     // Calculate forward direction
     freecam_calculate_forward_vector_allow_rotation(camera, freeCam.forwardVector);
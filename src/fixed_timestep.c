@@ -0,0 +1,66 @@
+#include "fixed_timestep.h"
+
+void fixed_timestep_init(FixedTimestep* ts, FixedTimestepClock clock, uint64_t step, uint32_t maxTicks) {
+    ts->clock = clock;
+    ts->step = step;
+    // Absorbs vsync jitter so a 30 fps display does not alternate between one and three ticks per frame
+    ts->snap = step / 64;
+    ts->maxTicks = maxTicks;
+    fixed_timestep_reset(ts);
+}
+
+/**
+ * Forgets accumulated time. The next call to fixed_timestep_advance only starts the clock.
+ */
+void fixed_timestep_reset(FixedTimestep* ts) {
+    ts->lastTime = 0;
+    ts->accumulator = 0;
+    ts->started = false;
+}
+
+/**
+ * Samples the clock and returns how many logic ticks to run this frame.
+ */
+uint32_t fixed_timestep_advance(FixedTimestep* ts) {
+    uint64_t now = ts->clock();
+    uint64_t elapsed;
+    uint64_t ticks;
+    uint64_t remainder;
+
+    if (!ts->started) {
+        ts->started = true;
+        ts->lastTime = now;
+        return 0;
+    }
+
+    elapsed = (now > ts->lastTime) ? (now - ts->lastTime) : 0;
+    ts->lastTime = now;
+
+    // Round frame times that are within the snap window of a whole number of steps
+    remainder = elapsed % ts->step;
+    if (remainder < ts->snap && elapsed >= ts->step) {
+        elapsed -= remainder;
+    } else if (ts->step - remainder < ts->snap) {
+        elapsed += ts->step - remainder;
+    }
+
+    ts->accumulator += elapsed;
+    ticks = ts->accumulator / ts->step;
+
+    if (ticks > ts->maxTicks) {
+        // Too far behind (a hitch, a breakpoint or a load); run the cap and drop the rest
+        ticks = ts->maxTicks;
+        ts->accumulator = 0;
+    } else {
+        ts->accumulator -= ticks * ts->step;
+    }
+
+    return (uint32_t) ticks;
+}
+
+/**
+ * How far the clock is between the last tick and the next one, from 0 to 1.
+ */
+float fixed_timestep_alpha(const FixedTimestep* ts) {
+    return (float) ts->accumulator / (float) ts->step;
+}
@@ -0,0 +1,47 @@
+#ifndef FIXED_TIMESTEP_H
+#define FIXED_TIMESTEP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define NSEC_PER_SEC 1000000000ULL
+
+/**
+ * @brief Returns a monotonic time in nanoseconds.
+ */
+typedef uint64_t (*FixedTimestepClock)(void);
+
+/**
+ * @brief Turns wall clock time into a whole number of fixed length logic ticks.
+ *
+ * Elapsed time goes into an accumulator and every full step taken out of it is one tick. Leftover time carries over
+ * to the next frame, so the tick rate does not drift. The fraction of a step left over is the interpolation alpha.
+ *
+ * Kept free of game and SDL state so tests/FixedTimestepTest.c can drive it with a fake clock; the SDL clock,
+ * fixed_timestep_now, lives in main.c.
+ */
+typedef struct {
+    FixedTimestepClock clock;
+    uint64_t step;     // Nanoseconds per tick
+    uint64_t snap;     // Frame times this close to a whole number of steps are rounded to it
+    uint64_t lastTime;
+    uint64_t accumulator;
+    uint32_t maxTicks; // Catch-up cap; time beyond this many ticks per frame is dropped
+    bool started;
+} FixedTimestep;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint64_t fixed_timestep_now(void);
+void fixed_timestep_init(FixedTimestep* ts, FixedTimestepClock clock, uint64_t step, uint32_t maxTicks);
+void fixed_timestep_reset(FixedTimestep* ts);
+uint32_t fixed_timestep_advance(FixedTimestep* ts);
+float fixed_timestep_alpha(const FixedTimestep* ts);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FIXED_TIMESTEP_H
@@ -36,6 +36,9 @@
 #include "render_courses.h"
 #include "actors.h"
 #include "replays.h"
+#include "fixed_timestep.h"
+#include "port/FramePacing.h"
+#include <SDL2/SDL.h>
 #include <debug.h>
 #include "crash_screen.h"
 #include "buffers/gfx_output_buffer.h"
@@ -44,6 +47,7 @@
 #include "port/interpolation/FrameInterpolation.h"
 #include "engine/wasm.h"
 #include "port/Game.h"
+#include "port/Settings.h"
 #include "engine/Matrix.h"
 
 // Declarations (not in this file)
@@ -111,8 +115,9 @@ u8 gControllerBits;
 CollisionGrid gCollisionGrid[1024];
 u16 gNumActors;
 u16 gMatrixObjectCount;
-s32 gTickLogic;   // Tick game physics at 60fps
+s32 gTickLogic;   // Number of 60hz game physics ticks to run this frame
 s32 gTickVisuals; // Tick animations at 30fps
+f32 gTickAlpha;   // Fraction of a physics tick accumulated but not run yet, for the renderer to interpolate with
 s32 gTickGame;
 f32 D_80150118;
 
@@ -139,7 +144,6 @@ struct SPTask* gGfxSPTask;
 s32 D_801502A0;
 s32 D_801502A4;
 u16* gPhysicalFramebuffers[3];
-u16 gPortFramebuffers[3][SCREEN_WIDTH * SCREEN_HEIGHT];
 uintptr_t gPhysicalZBuffer;
 UNUSED u32 D_801502B8;
 UNUSED u32 D_801502BC;
@@ -361,7 +365,7 @@ void update_controller(s32 index) {
 
     // Prevents pause menu intereference while controlling flycam
     // Freecam only works with controller 1
-    if ((CVarGetInteger("gFreecam", 0) == 1) && (gGamestate == RACING) && (index == 0)) {
+    if ((gSettings.freecam == 1) && (gGamestate == RACING) && (index == 0)) {
         freecam_update_controller();
         return;
     }
@@ -629,73 +633,41 @@ void game_init_clear_framebuffer(void) {
     clear_framebuffer(0);
 }
 
-//! @deprecated
-// This function was made to tick the game logic at native 60 fps.
-// However, many game objects are not in that special tick loop and run at native 30fps.
-// Thus adding `if (gTickVisuals) { // stuff here }` would prevent double speed and allow ticking visuals once every 30 fps.
-// This does not however, create extra interpolated frames. Whereas a possible solution, it is not the best solution.
-// This function should be cleaned up and removed, since frame interpolation now exists.
-void calculate_updaterate(void) {
-    static u32 prevtime = 0;
-    static u32 remainder = 0;
-    static u32 logicAccumulator = 0;
-    static u32 visualsAccumulator = 0;
-    static u32 frameCounter = 0; // For tracking frames for logic updates
-    u32 now = SDL_GetTicks();    // Replaces osGetTime()
-    u32 frameRate = 0;
-    s32 total;
-
-    // Get target FPS from configuration variable
-    s32 targetFPS = 30;
-
-    if (targetFPS < 30) {
-        targetFPS = 30;
-    }
+#define LOGIC_TICKS_PER_SECOND 60
+#define MAX_CATCHUP_TICKS 4 // Two 30fps frames worth of ticks
 
-    // Detect frame rate based on time passed
-    if (now > prevtime) {
-        total = (now - prevtime) + remainder;
-    } else {
-        // Handle counter reset (shouldn't happen with SDL_GetTicks, but kept for logic parity)
-        total = (0xffffffff - prevtime) + 1 + now + remainder;
-    }
+static FixedTimestep sLogicTimestep;
 
-    prevtime = now;
+/**
+ * Default clock for the scheduler, backed by the SDL performance counter.
+ */
+uint64_t fixed_timestep_now(void) {
+    static uint64_t frequency = 0;
+    uint64_t counter = SDL_GetPerformanceCounter();
 
-    // Avoid division by zero
-    if (total > 0) {
-        // Calculate approximate frame rate (milliseconds per frame)
-        frameRate = 1000 / total; // Frame rate in frames per second
-    } else {
-        frameRate = targetFPS; // Fallback to target FPS
+    if (frequency == 0) {
+        frequency = SDL_GetPerformanceFrequency();
     }
 
-    // Default both to no updates
-    gTickLogic = 0;
-    gTickVisuals = 0;
-
-    // Calculate the update rates based on target FPS
-    s32 logicUpdateInterval = 1000 / 60;   // Time in ms between logic updates
-    s32 visualsUpdateInterval = 1000 / 30; // 30 FPS for visuals
+    // Split the conversion so counter * NSEC_PER_SEC cannot overflow
+    return (counter / frequency) * NSEC_PER_SEC + ((counter % frequency) * NSEC_PER_SEC) / frequency;
+}
 
-    // Accumulate time for logic updates
-    logicAccumulator += total;
-    if (logicAccumulator >= logicUpdateInterval) {
-        logicAccumulator -= logicUpdateInterval; // Subtract full interval
-        if (targetFPS < 60) {
-            gTickLogic = 2;
-        } else {
-            gTickLogic = 2;    // Perform logic update
-        }
+/**
+ * @brief Decides how many physics ticks run this frame.
+ *
+ * Physics runs on a fixed 60hz step measured with a nanosecond clock, so the game keeps real time speed when the
+ * display does not run at a multiple of 30fps. Visuals still tick once per frame, interpolation fills in the rest.
+ */
+void update_tick_schedule(void) {
+    if (sLogicTimestep.clock == NULL) {
+        fixed_timestep_init(&sLogicTimestep, fixed_timestep_now, NSEC_PER_SEC / LOGIC_TICKS_PER_SECOND,
+                            MAX_CATCHUP_TICKS);
     }
 
-    // Visual updates (based on 30 FPS equivalent)
-    visualsAccumulator += total;                       // Increment for each frame
-    if (visualsAccumulator >= visualsUpdateInterval) { // Check if it's time to update visuals
-        visualsAccumulator -= visualsUpdateInterval;
-        // gTickVisuals <-- Goes here to use the native 60fps system
-    }
-    gTickVisuals = 1;    // Perform visual update
+    gTickLogic = fixed_timestep_advance(&sLogicTimestep);
+    gTickAlpha = fixed_timestep_alpha(&sLogicTimestep);
+    gTickVisuals = 1;
 }
 
 void display_debug_info(void) {
@@ -744,13 +716,16 @@ void display_debug_info(void) {
 }
 
 void process_game_tick(void) {
+    TRACE_ZONE_BEGIN("process_game_tick");
 
     if (gIsEditorPaused == false) {
         if (D_8015011E) {
             gCourseTimer += COURSE_TIMER_ITER;
         }
         func_802909F0();
+        TRACE_ZONE_BEGIN("collision");
         evaluate_collision_for_players_and_actors();
+        TRACE_ZONE_END();
         handle_a_press_for_all_players_during_race();
     }
 
@@ -760,7 +735,7 @@ void process_game_tick(void) {
     // But it needs to be here for player 1 to work in all modes.
     func_8001EE98(gPlayerOne, camera1, 0);
     // Required if freecam was to have a new camera
-    //if (CVarGetInteger("gFreecam", 0) == true) {
+    //if (gSettings.freecam == true) {
     //    freecam(gFreecamCamera, gPlayerOne, 0);
     //} else {
         //func_8001EE98(gPlayerOne, camera1, 0);
@@ -768,6 +743,7 @@ void process_game_tick(void) {
 
     // Editor requires this so the camera keeps moving while the game is paused.
     if (gIsEditorPaused == true) {
+        TRACE_ZONE_END();
         return;
     }
 
@@ -796,8 +772,33 @@ void process_game_tick(void) {
     func_80059AC8();
     update_course_actors();
     CM_TickActors();
+    tick_wasm_mods();
     func_802966A0();
     func_8028FCBC();
+    TRACE_ZONE_END();
+}
+
+/**
+ * The simulation half of race_logic_loop for one frame, without drawing it. Used to catch up after a replay
+ * seek and by the tests.
+ */
+void race_logic_step(void) {
+    ClearMatrixPools();
+    ClearObjectsMatrixPool();
+    ClearEffectsMatrixPool();
+    Editor_ClearMatrix();
+    gMatrixObjectCount = 0;
+    gMatrixEffectCount = 0;
+
+    for (size_t i = 0; i < REPLAY_TICKS_PER_FRAME; i++) {
+        if (gModeSelection == TIME_TRIALS) {
+            replays_tick();
+        }
+        process_game_tick();
+    }
+    func_80022744();
+    func_8005A070();
+    CM_RunGarbageCollector();
 }
 
 void race_logic_loop(void) {
@@ -826,18 +827,30 @@ void race_logic_loop(void) {
     func_802A4EF4();
 
     if (gModeSelection == TIME_TRIALS) {
-        replays_loop();
+        replays_apply_seek();
+        // No ticks run while paused, but the replays still see the paused frames as they always did
+        if (gIsGamePaused != 0) {
+            replays_loop();
+        }
     }
 
     // Wait for all racers to load
     if (gNetwork.enabled) {
         network_all_players_loaded();
     }
+    replication_update();
 
     if (gIsGamePaused == false) {
+        CM_RunDeterminismCheck();
+        frame_pacing_begin_logic();
         for (size_t i = 0; i < gTickLogic; i++) {
+            if (gModeSelection == TIME_TRIALS) {
+                replays_tick();
+            }
             process_game_tick();
         }
+        frame_pacing_end_logic(gTickLogic);
+        FrameInterpolation_SetTickSpan(gTickLogic, gTickAlpha);
         if (gIsEditorPaused == false) {
             func_80022744();
         }
@@ -914,7 +927,8 @@ void race_logic_loop(void) {
     // Copies after all the main rendering is complete. This is accurate to hardware.
     // This means things like jumbotron will have the pause menu rendered in it.
     // To avoid that, this line can be moved above func_800591B4.
-    FB_WriteFramebufferSliceToCPU(&gDisplayListHead, gPortFramebuffers[sRenderingFramebuffer], true);
+    // Only reads back on frames where something (e.g. a jumbotron) subscribed through FB_SubscribeReadback.
+    FB_QueueReadback(&gDisplayListHead);
     gDPFullSync(gDisplayListHead++);
     gSPEndDisplayList(gDisplayListHead++);
 
@@ -1272,7 +1286,8 @@ void thread5_iteration(void) {
         func_800CB2C4();
     }
 #endif
-    calculate_updaterate();
+    update_tick_schedule();
+    Settings_Update();
     if (GfxDebuggerIsDebugging()) {
         Graphics_PushFrame(gGfxPool->gfxPool);
         return;
@@ -1283,14 +1298,16 @@ void thread5_iteration(void) {
         update_gamestate();
     }
     profiler_log_thread5_time(THREAD5_START);
+    frame_pacing_begin_frame();
     config_gfx_pool();
     FB_CreateFramebuffers();
     read_controllers();
     game_state_handler();
 
-    // call_render_hook();
+    call_render_hook();
 
     end_master_display_list();
+    frame_pacing_end_build();
     display_and_vsync();
 }
 
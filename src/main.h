@@ -161,6 +161,7 @@ extern u16 gNumActors;
 extern u16 gMatrixObjectCount;
 extern s32 gTickLogic;
 extern s32 gTickVisuals;
+extern f32 gTickAlpha;
 extern f32 D_80150118;
 extern u16 wasSoftReset;
 extern u16 D_8015011E;
@@ -180,7 +181,6 @@ extern struct SPTask* gGfxSPTask;
 extern s32 D_801502A0;
 extern s32 D_801502A4;
 extern u16* gPhysicalFramebuffers[];
-extern u16 gPortFramebuffers[3][SCREEN_WIDTH * SCREEN_HEIGHT];
 extern uintptr_t gPhysicalZBuffer;
 extern Mat4 sBillBoardMtx;
 
@@ -203,6 +203,8 @@ extern u32 gGfxSPTaskStack[];
 extern OSMesg gPIMesgBuf[];
 extern OSMesgQueue gPIMesgQueue;
 void race_logic_loop(void);
+void race_logic_step(void);
+void process_game_tick(void);
 extern s32 gGamestate;
 
 extern s32 gRaceState;
@@ -16,6 +16,7 @@
 #include "port/Engine.h"
 #include "engine/Matrix.h"
 #include "port/interpolation/FrameInterpolation.h"
+#include "port/Settings.h"
 
 #pragma intrinsic(sqrtf)
 
@@ -450,7 +451,7 @@ bool is_particle_on_screen(Vec3f arg0, Camera* arg1, u16 arg2) {
     u16 temp_t9;
     s32 ret;
 
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gSettings.noCulling == 1) {
         return true;
     }
 
@@ -726,7 +727,7 @@ void func_80042330_portrait(s32 x, s32 y, u16 angle, f32 scale, s16 lapCount) {
     Mat4 matrix;
     // printf("panel %d %d %d\n", x, (s32)OTRGetDimensionFromLeftEdge(x), (s32)OTRGetDimensionFromLeftEdge(0));
 
-    if ((gHUDModes != 2) && (D_801657E2 == 0) || (CVarGetInteger("gBetterResultPortraits", 0) == true)) {
+    if ((gHUDModes != 2) && (D_801657E2 == 0) || (gSettings.betterResultPortraits == true)) {
         if (x < (SCREEN_WIDTH / 2)) {
             x = (s32) OTRGetDimensionFromLeftEdge(x);
         } else {
@@ -49,6 +49,7 @@
 #include "src/engine/HM_Intro.h"
 #include "src/port/interpolation/FrameInterpolation.h"
 #include "heap.h"
+#include "port/Settings.h"
 
 const char* GetCupName(void);
 
@@ -1445,7 +1446,7 @@ s32 func_80091D74(void) {
     UNUSED s32 pad[10];
     s32 i;
 
-    if (CVarGetInteger("gControllerPakScreen", 0) == 0) {
+    if (gSettings.controllerPakScreen == 0) {
         if (!gControllerBits) {
             return 0;
         }
@@ -6369,7 +6370,7 @@ GLOBAL_ASM("asm/non_matchings/menu_items/add_menu_item.s")
 #endif
 
 static void draw_debug(void) {
-    if (CVarGetInteger("gEnableDebugMode", 0) != 0) {
+    if (gSettings.enableDebugMode != 0) {
         set_text_color(TEXT_RED);
         print_text1_right(0x138, 0xEA, "DEBUG", 0, 0.5f, 0.5f);
     }
@@ -6378,7 +6379,7 @@ static void draw_debug(void) {
 static void draw_version(void) {
     s32 column = 0x138;
 
-    if (CVarGetInteger("gEnableDebugMode", 0) != 0) {
+    if (gSettings.enableDebugMode != 0) {
         column -= (s32) ((f32) (get_string_width("DEBUG") + 5 )) * 0.5f;
     }
 
@@ -6528,7 +6529,7 @@ void render_menus(MenuItem* arg0) {
             case MENU_ITEM_UI_GAME_SELECT:
                 gDisplayListHead =
                     render_menu_textures(gDisplayListHead, seg2_game_select_texture, arg0->column, arg0->row);
-                if (CVarGetInteger("gShowSpaghettiVersion", true)) {
+                if (gSettings.showSpaghettiVersion) {
                     draw_version();
                     draw_debug();
                 }
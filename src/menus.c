@@ -20,6 +20,7 @@
 #include <sounds.h>
 #include "spawn_players.h"
 #include "port/Game.h"
+#include "port/Settings.h"
 
 /** BSS **/
 s32 gIntroModelZEye;
@@ -1040,7 +1041,7 @@ void splash_menu_act(struct Controller* controller, u16 controllerIdx) {
                 if (btnAndStick & (R_JPAD | L_JPAD)) {
                     play_sound2(SOUND_MENU_CURSOR_MOVE);
                     if (gEnableDebugMode) {
-                        gEnableDebugMode = CVarGetInteger("gEnableDebugMode", 0);
+                        gEnableDebugMode = gSettings.enableDebugMode;
                     } else {
                         gEnableDebugMode = true;
                     }
@@ -1780,6 +1781,7 @@ void course_select_menu_act(struct Controller* controller, u16 controllerIdx) {
                         SetCourseFromCup();
                         gCurrentCourseId = gCupCourseOrder[gCupSelection][COURSE_ONE];
                         gMenuTimingCounter = 0;
+                        CM_PreloadCourse();
                     }
                     reset_cycle_flash_menu();
                 }
@@ -1816,6 +1818,7 @@ void course_select_menu_act(struct Controller* controller, u16 controllerIdx) {
                     play_sound2(SOUND_MENU_SELECT);
                     reset_cycle_flash_menu();
                     gMenuTimingCounter = 0;
+                    CM_PreloadCourse();
                 }
                 break;
             case SUB_MENU_MAP_SELECT_OK:
@@ -1857,7 +1860,7 @@ void course_select_menu_act(struct Controller* controller, u16 controllerIdx) {
 void load_menu_states(s32 menuSelection) {
     s32 i;
 
-    gDebugMenuSelection = CVarGetInteger("gEnableDebugMode", 0) + 1;
+    gDebugMenuSelection = gSettings.enableDebugMode + 1;
     gMenuTimingCounter = 0;
     gMenuDelayTimer = 0;
     gDemoUseController = 0;
@@ -1896,7 +1899,7 @@ void load_menu_states(s32 menuSelection) {
         case 0:
         case START_MENU: {
             gIsMirrorMode = 0;
-            gEnableDebugMode = CVarGetInteger("gEnableDebugMode", 0);
+            gEnableDebugMode = gSettings.enableDebugMode;
             CM_SetCup(GetMushroomCup());
             gCupSelection = MUSHROOM_CUP;
             gCourseIndexInCup = 0;
@@ -1915,7 +1918,7 @@ void load_menu_states(s32 menuSelection) {
         }
         case 1:
         case MAIN_MENU: {
-            gEnableDebugMode = CVarGetInteger("gEnableDebugMode", 0);
+            gEnableDebugMode = gSettings.enableDebugMode;
             gIsMirrorMode = 0;
             gCourseMapInit = 0;
             func_800B5F30();
@@ -0,0 +1,203 @@
+#include <libultraship.h>
+#include <macros.h>
+#include <stdlib.h>
+#include <string.h>
+#include "mio0.h"
+
+#define MIO0_WINDOW 0x1000
+#define MIO0_MIN_MATCH 3
+#define MIO0_MAX_MATCH 18
+#define MIO0_HASH_BITS 12
+#define MIO0_MAX_CHAIN 32
+
+static void mio0_write_u32(u8* dst, u32 value) {
+    dst[0] = (value >> 24) & 0xFF;
+    dst[1] = (value >> 16) & 0xFF;
+    dst[2] = (value >> 8) & 0xFF;
+    dst[3] = value & 0xFF;
+}
+
+static u32 mio0_read_u32(const u8* src) {
+    return ((u32) src[0] << 24) | ((u32) src[1] << 16) | ((u32) src[2] << 8) | (u32) src[3];
+}
+
+static u32 mio0_hash(const u8* src) {
+    u32 value = ((u32) src[0] << 16) | ((u32) src[1] << 8) | (u32) src[2];
+    return (value * 2654435761u) >> (32 - MIO0_HASH_BITS);
+}
+
+size_t mio0_max_encoded_size(size_t srcSize) {
+    // Every token is a literal in the worst case
+    return MIO0_HEADER_SIZE + ((srcSize + 31) / 32) * 4 + srcSize;
+}
+
+size_t mio0_encode(const u8* src, size_t srcSize, u8* dst, size_t dstCapacity) {
+    size_t layoutWords = (srcSize + 31) / 32;
+    size_t literalCount = 0;
+    size_t refCount = 0;
+    size_t tokenCount = 0;
+    size_t pos = 0;
+    size_t layoutSize;
+    size_t total = 0;
+    u32* layout;
+    u8* literals;
+    u8* refs;
+    s32* head;
+    s32* prev;
+
+    // Offsets in the header are 32-bit
+    if (srcSize > 0x7FFFFFFF) {
+        return 0;
+    }
+
+    layout = (u32*) calloc(layoutWords + 1, sizeof(u32));
+    literals = (u8*) malloc(srcSize + 1);
+    refs = (u8*) malloc(((srcSize / MIO0_MIN_MATCH) + 1) * 2);
+    head = (s32*) malloc(sizeof(s32) << MIO0_HASH_BITS);
+    prev = (s32*) malloc(sizeof(s32) * MIO0_WINDOW);
+    if ((layout == NULL) || (literals == NULL) || (refs == NULL) || (head == NULL) || (prev == NULL)) {
+        goto cleanup;
+    }
+    memset(head, 0xFF, sizeof(s32) << MIO0_HASH_BITS);
+
+    while (pos < srcSize) {
+        size_t bestLen = 0;
+        size_t bestDist = 0;
+        size_t end;
+
+        if (pos + MIO0_MIN_MATCH <= srcSize) {
+            size_t maxLen = MIN(MIO0_MAX_MATCH, srcSize - pos);
+            s32 candidate = head[mio0_hash(&src[pos])];
+            s32 steps = 0;
+
+            while ((candidate >= 0) && ((pos - candidate) <= MIO0_WINDOW) && (steps++ < MIO0_MAX_CHAIN)) {
+                size_t len = 0;
+                while ((len < maxLen) && (src[candidate + len] == src[pos + len])) {
+                    len++;
+                }
+                if (len > bestLen) {
+                    bestLen = len;
+                    bestDist = pos - candidate;
+                    if (len == maxLen) {
+                        break;
+                    }
+                }
+                candidate = prev[candidate & (MIO0_WINDOW - 1)];
+            }
+        }
+
+        if (bestLen >= MIO0_MIN_MATCH) {
+            u16 ref = (u16) (((bestLen - MIO0_MIN_MATCH) << 12) | (bestDist - 1));
+            refs[refCount * 2] = ref >> 8;
+            refs[refCount * 2 + 1] = ref & 0xFF;
+            refCount++;
+            end = pos + bestLen;
+        } else {
+            layout[tokenCount / 32] |= 0x80000000u >> (tokenCount % 32);
+            literals[literalCount++] = src[pos];
+            end = pos + 1;
+        }
+        tokenCount++;
+
+        // Insert every consumed position into the hash chains
+        for (; pos < end; pos++) {
+            if (pos + MIO0_MIN_MATCH <= srcSize) {
+                u32 hash = mio0_hash(&src[pos]);
+                prev[pos & (MIO0_WINDOW - 1)] = head[hash];
+                head[hash] = (s32) pos;
+            }
+        }
+    }
+
+    layoutSize = ((tokenCount + 31) / 32) * 4;
+    total = MIO0_HEADER_SIZE + layoutSize + refCount * 2 + literalCount;
+    if (total > dstCapacity) {
+        total = 0;
+        goto cleanup;
+    }
+
+    memcpy(dst, "MIO0", 4);
+    mio0_write_u32(&dst[4], (u32) srcSize);
+    mio0_write_u32(&dst[8], (u32) (MIO0_HEADER_SIZE + layoutSize));
+    mio0_write_u32(&dst[12], (u32) (MIO0_HEADER_SIZE + layoutSize + refCount * 2));
+    for (size_t i = 0; i < layoutSize / 4; i++) {
+        mio0_write_u32(&dst[MIO0_HEADER_SIZE + i * 4], layout[i]);
+    }
+    memcpy(&dst[MIO0_HEADER_SIZE + layoutSize], refs, refCount * 2);
+    memcpy(&dst[MIO0_HEADER_SIZE + layoutSize + refCount * 2], literals, literalCount);
+
+cleanup:
+    free(layout);
+    free(literals);
+    free(refs);
+    free(head);
+    free(prev);
+    return total;
+}
+
+size_t mio0_decoded_size(const u8* src, size_t srcSize) {
+    if ((srcSize < MIO0_HEADER_SIZE) || (memcmp(src, "MIO0", 4) != 0)) {
+        return 0;
+    }
+    return mio0_read_u32(&src[4]);
+}
+
+s32 mio0_decode(const u8* src, size_t srcSize, u8* dst, size_t dstCapacity) {
+    size_t decodedSize = mio0_decoded_size(src, srcSize);
+    size_t layoutPos = MIO0_HEADER_SIZE;
+    size_t refPos;
+    size_t literalPos;
+    size_t out = 0;
+    u32 layoutWord = 0;
+    s32 bitsLeft = 0;
+
+    if ((srcSize < MIO0_HEADER_SIZE) || (memcmp(src, "MIO0", 4) != 0) || (decodedSize > dstCapacity)) {
+        return -1;
+    }
+    refPos = mio0_read_u32(&src[8]);
+    literalPos = mio0_read_u32(&src[12]);
+    if ((refPos > srcSize) || (literalPos > srcSize) || (refPos > literalPos)) {
+        return -1;
+    }
+
+    while (out < decodedSize) {
+        if (bitsLeft == 0) {
+            if (layoutPos + 4 > refPos) {
+                return -1;
+            }
+            layoutWord = mio0_read_u32(&src[layoutPos]);
+            layoutPos += 4;
+            bitsLeft = 32;
+        }
+
+        if (layoutWord & 0x80000000u) {
+            if (literalPos >= srcSize) {
+                return -1;
+            }
+            dst[out++] = src[literalPos++];
+        } else {
+            u16 ref;
+            size_t len;
+            size_t dist;
+
+            if (refPos + 2 > literalPos) {
+                return -1;
+            }
+            ref = (u16) ((src[refPos] << 8) | src[refPos + 1]);
+            refPos += 2;
+            len = (ref >> 12) + MIO0_MIN_MATCH;
+            dist = (ref & 0xFFF) + 1;
+            if ((dist > out) || (out + len > decodedSize)) {
+                return -1;
+            }
+            // Byte by byte, matches may overlap the bytes they produce
+            for (size_t i = 0; i < len; i++, out++) {
+                dst[out] = dst[out - dist];
+            }
+        }
+        layoutWord <<= 1;
+        bitsLeft--;
+    }
+
+    return (s32) out;
+}
@@ -0,0 +1,33 @@
+#ifndef MIO0_H
+#define MIO0_H
+
+#include <libultraship.h>
+
+/**
+ * MIO0 (LZ77 with a separate layout bitstream) encoder and decoder.
+ *
+ * Unlike the mio0decode/mio0encode stubs these work on real pointers and bounded buffers,
+ * so they can be used for port side data such as replays.
+ */
+
+#define MIO0_HEADER_SIZE 0x10
+
+/** @brief Worst case size of the encoded output for srcSize bytes of input. */
+size_t mio0_max_encoded_size(size_t srcSize);
+
+/**
+ * @brief Compresses src into dst.
+ * @return Number of bytes written, or 0 if dst is too small or allocation failed.
+ */
+size_t mio0_encode(const u8* src, size_t srcSize, u8* dst, size_t dstCapacity);
+
+/** @brief Reads the decoded size from a MIO0 header. Returns 0 if the header is invalid. */
+size_t mio0_decoded_size(const u8* src, size_t srcSize);
+
+/**
+ * @brief Decompresses src into dst.
+ * @return Number of bytes written, or -1 if the data is malformed or dst is too small.
+ */
+s32 mio0_decode(const u8* src, size_t srcSize, u8* dst, size_t dstCapacity);
+
+#endif // MIO0_H
@@ -6,8 +6,7 @@
 
 #include "networking.h"
 #include "main.h"
-
-#define BUFFER_SIZE 10240
+#include "profiler.h"
 
 NetworkClient dummyClient; // For use before server sends the real client
 NetworkClient* localClient = NULL;
@@ -32,9 +31,15 @@ bool threadStarted = false;
 int isNetworkingThreadEnabled = true;
 void (*remoteConnectedHandler)(void);
 
+// Only touched by the network thread
+static char sReceiveBuffer[NETWORK_BUFFER_SIZE];
+static size_t sReceivedSize = 0;
+static char sPacketBuffer[NETWORK_BUFFER_SIZE + 1];
+
 void ConnectToServer(char* ip, uint16_t port, char* username) {
     if (!threadStarted) {
         threadStarted = true;
+        replication_init();
         networking_init(ip, port);
 
         SDL_Delay(20);
@@ -89,6 +94,7 @@ void networking_init(char* ip, uint16_t port) {
 }
 
 int networking_loop(void* data) {
+    trace_set_thread_name("Network");
     while (isNetworkingThreadEnabled) {
         while (!gNetwork.isConnected && isNetworkingThreadEnabled) { // && isRemoteInteractorEnabled) {
             printf("[SpaghettiOnline] Attempting to make connection to server...\n");
@@ -97,6 +103,7 @@ int networking_loop(void* data) {
             if (gNetwork.tcpSocket) {
                 gNetwork.isConnected = true;
                 printf("[SpaghettiOnline] Connection to server established!\n");
+                replication_handshake();
 
                 if (remoteConnectedHandler) {
                     remoteConnectedHandler();
@@ -105,6 +112,7 @@ int networking_loop(void* data) {
             }
         }
 
+        sReceivedSize = 0;
         SDLNet_SocketSet socketSet = SDLNet_AllocSocketSet(1);
         if (gNetwork.tcpSocket) {
             SDLNet_TCP_AddSocket(socketSet, gNetwork.tcpSocket);
@@ -125,15 +133,37 @@ int networking_loop(void* data) {
                 continue;
             }
 
-            char remoteDataReceived[512];
-            memset(remoteDataReceived, 0, sizeof(remoteDataReceived));
-            int len = SDLNet_TCP_Recv(gNetwork.tcpSocket, &remoteDataReceived, sizeof(remoteDataReceived));
+            // TCP is a stream, packets may arrive split or several at once
+            int len = SDLNet_TCP_Recv(gNetwork.tcpSocket, sReceiveBuffer + sReceivedSize,
+                                      sizeof(sReceiveBuffer) - sReceivedSize);
             if (!len || !gNetwork.tcpSocket || len == -1) {
                 printf("[SpaghettiOnline] SDLNet_TCP_Recv: %s\n", SDLNet_GetError());
                 break;
             }
-
-            handleReceivedData(remoteDataReceived, len); // HandleRemoteData(remoteDataReceived);
+            sReceivedSize += len;
+
+            TRACE_ZONE_BEGIN("handleReceivedData");
+            size_t offset = 0;
+            while (sReceivedSize - offset >= 3) {
+                size_t packetSize =
+                    3 + ((uint8_t) sReceiveBuffer[offset + 1] | ((uint8_t) sReceiveBuffer[offset + 2] << 8));
+                if (packetSize > sizeof(sReceiveBuffer)) {
+                    printf("[SpaghettiOnline] Packet of %zu bytes does not fit the receive buffer\n", packetSize);
+                    offset = sReceivedSize;
+                    break;
+                }
+                if (sReceivedSize - offset < packetSize) {
+                    break;
+                }
+                // String payloads are read as C strings
+                memcpy(sPacketBuffer, sReceiveBuffer + offset, packetSize);
+                sPacketBuffer[packetSize] = '\0';
+                handleReceivedData(sPacketBuffer, packetSize);
+                offset += packetSize;
+            }
+            memmove(sReceiveBuffer, sReceiveBuffer + offset, sReceivedSize - offset);
+            sReceivedSize -= offset;
+            TRACE_ZONE_END();
 
             // receivedData.append(remoteDataReceived, len);
 
@@ -197,8 +227,8 @@ void handleReceivedData(const char* buffer, size_t bufSize) {
         case PACKET_LOADED:
             handle_start_game(); // handle_start_game(data);
             break;
-        case PACKET_PLAYER:
-            replicate_player(data);
+        case PACKET_UDP_ENDPOINT:
+            replication_set_server_endpoint(data, length);
             break;
         case PACKET_SET_COURSE:
             set_course(data);
@@ -217,7 +247,9 @@ void handleReceivedData(const char* buffer, size_t bufSize) {
 }
 
 void networking_cleanup(SDLNet_SocketSet socketSet) {
+    replication_shutdown();
     send_str_packet(gNetwork.tcpSocket, PACKET_LEAVE, localClient->username);
+
     SDLNet_TCP_Close(gNetwork.tcpSocket);
     SDLNet_FreeSocketSet(socketSet);
     SDLNet_Quit();
@@ -4,9 +4,12 @@
 #include <libultraship.h>
 #include <common_structs.h>
 #include <SDL2/SDL_net.h>
+#include "replication_codec.h"
 
 #define NETWORK_MAX_PLAYERS 8
 #define NETWORK_USERNAME_LENGTH 32
+// Largest session control packet, header included. Snapshots go over UDP and are bounded by REPLICATION_MTU.
+#define NETWORK_BUFFER_SIZE 10240
 
 enum {
     PACKET_JOIN,
@@ -21,7 +24,8 @@ enum {
     PACKET_START_SESSION,
     PACKET_PLAYER,
     PACKET_ACTOR,
-    PACKET_OBJECT
+    PACKET_OBJECT,
+    PACKET_UDP_ENDPOINT // Client sends its u16 UDP port, the server answers with its u16 UDP port and a u32 token
 };
 
 typedef struct {
@@ -72,11 +76,42 @@ void set_course(const char* data);
 void networking_start_session(const char* data);
 
 /* Replication */
-void replicate_player(const char* data);
+typedef struct {
+    uint32_t packetsSent;
+    uint32_t packetsReceived;
+    uint32_t packetsDropped;  // Dropped by the network condition shim
+    uint32_t packetsRejected; // Unknown baseline, malformed or not sent by the server
+    uint32_t fullSnapshotsSent;
+    uint32_t bytesSent;
+    uint32_t bytesReceived;
+    uint32_t bytesSentPerSecond;
+    uint32_t bytesReceivedPerSecond;
+} ReplicationStats;
+
+// Simulated network conditions applied to outgoing snapshots
+typedef struct {
+    s32 lossPercent;
+    s32 latencyMs;
+    s32 jitterMs;
+} ReplicationConditions;
+
+extern ReplicationStats gReplicationStats;
+
+void replication_init(void);
+void replication_init_loopback(uint16_t port);
+void replication_shutdown(void);
+void replication_update(void);
+void replication_handshake(void);
+void replication_set_server_endpoint(const char* data, size_t size);
+void replication_receive(const u8* data, size_t size);
+void replication_set_conditions(const ReplicationConditions* conditions);
+void ActorReplication(ReplicationSnapshot* snapshot);
+void ObjectReplication(ReplicationSnapshot* snapshot);
 void assign_player_slots(const char* data);
 
 /* Packets */
 void send_int_packet(TCPsocket socket, uint8_t type, uint32_t payload, uint16_t size);
+void send_data_packet(TCPsocket socket, uint8_t type, const uint8_t* payload, uint16_t size);
 void handleJoinPacket(const char* data);
 void handleLeavePacket(const char* data);
 void handleMessagePacket(const char* data);
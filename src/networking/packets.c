@@ -28,26 +28,33 @@ void handle_start_game() {
     gIsGamePaused = false;
 }
 
-#define BUFFER_SIZE 1024
-void send_data_packet(TCPsocket socket, int type, const uint8_t* payload, size_t payload_size) {
-    // uint8_t buffer[BUFFER_SIZE];
-    // size_t packet_size = sizeof(type) + payload_size;
-    // if (packet_size > BUFFER_SIZE) {
-    //     fprintf(stderr, "Packet size exceeds buffer size\n");
-    //     return;
-    // }
-
-    // memcpy(buffer, &type, sizeof(type));
-    // memcpy(buffer + sizeof(type), payload, payload_size);
-
-    // int len = SDLNet_TCP_Send(socket, buffer, packet_size);
-    // if (len < packet_size) {
-    //     fprintf(stderr, "SDLNet_TCP_Send: %s\n", SDLNet_GetError());
-    // }
+void send_data_packet(TCPsocket socket, uint8_t type, const uint8_t* payload, uint16_t size) {
+    uint8_t buffer[NETWORK_BUFFER_SIZE];
+    int offset = 0;
+
+    if (3 + size > NETWORK_BUFFER_SIZE) {
+        fprintf(stderr, "Payload is too large to fit in buffer\n");
+        return;
+    }
+
+    buffer[offset] = type;
+    offset += sizeof(uint8_t);
+
+    buffer[offset] = size & 0xFF;
+    buffer[offset + 1] = size >> 8;
+    offset += sizeof(uint16_t);
+
+    memcpy(buffer + offset, payload, size);
+    offset += size;
+
+    int len = SDLNet_TCP_Send(socket, buffer, offset);
+    if (len < offset) {
+        fprintf(stderr, "SDLNet_TCP_Send: %s\n", SDLNet_GetError());
+    }
 }
 
 void send_str_packet(TCPsocket socket, uint8_t type, const char* payload) {
-    char buffer[BUFFER_SIZE];
+    char buffer[NETWORK_BUFFER_SIZE];
     int offset = 0;
 
     // Copy the integer type into the buffer
@@ -56,7 +63,7 @@ void send_str_packet(TCPsocket socket, uint8_t type, const char* payload) {
 
     // Copy the payload into the buffer
     int size = strlen(payload);
-    if (offset + size >= BUFFER_SIZE) {
+    if (offset + size >= NETWORK_BUFFER_SIZE) {
         fprintf(stderr, "Payload is too large to fit in buffer\n");
         return;
     }
@@ -76,12 +83,12 @@ void send_str_packet(TCPsocket socket, uint8_t type, const char* payload) {
 
 // void send_packet(TCPsocket socket, uint8_t type, const char *payload, uint16_t size) {
 //     // Ensure the buffer is large enough to hold the type, colon, and payload
-//     if (sizeof(int) + 1 + size > BUFFER_SIZE) {
+//     if (sizeof(int) + 1 + size > NETWORK_BUFFER_SIZE) {
 //         fprintf(stderr, "Sending data too big for the buffer\n");
 //         return;
 //     }
 
-//     char buffer[BUFFER_SIZE];
+//     char buffer[NETWORK_BUFFER_SIZE];
 //     int offset = 0;
 
 //     // Copy the type into the buffer
@@ -101,12 +108,12 @@ void send_str_packet(TCPsocket socket, uint8_t type, const char* payload) {
 
 void send_int_packet(TCPsocket socket, uint8_t type, uint32_t payload, uint16_t size) {
     // Ensure the buffer is large enough to hold the type, colon, and payload
-    if (sizeof(int) + 1 + size > BUFFER_SIZE) {
+    if (sizeof(int) + 1 + size > NETWORK_BUFFER_SIZE) {
         fprintf(stderr, "Sending data too big for the buffer\n");
         return;
     }
 
-    char buffer[BUFFER_SIZE];
+    char buffer[NETWORK_BUFFER_SIZE];
     int offset = 0;
 
     // Write the packet type into the buffer
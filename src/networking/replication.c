@@ -1,14 +1,719 @@
 #include <libultraship.h>
+#include <stdlib.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_net.h>
+#include <actor_types.h>
+#include <objects.h>
 #include "networking.h"
 #include "main.h"
 
-void replicate_player(const char* data) {
-    // gPlayerOne->pos[0];
-    // send_data_packet(client, PACKET_PLAYER, &gPlayerOne, sizeof(Player));
+/**
+ * Snapshot replication.
+ *
+ * Every REPLICATION_SEND_RATE-th of a second the local state (own player, plus actors and objects on the host)
+ * is quantized into a snapshot. The snapshot is delta encoded against the newest snapshot every peer has
+ * acknowledged, so only the fields that changed are sent (see replication_codec.h). Every packet carries the
+ * sequence it was built with, the baseline it was encoded against and, per player slot, an ack of the newest
+ * snapshot received from that slot.
+ *
+ * Snapshots travel over UDP so a lost packet never holds back newer ones; the TCP connection only carries session
+ * control. Endpoints are exchanged during the TCP handshake: the client sends PACKET_UDP_ENDPOINT with its local UDP
+ * port, and the server answers with its own UDP port and a session token. The client then sends hello packets
+ * holding the token until the server echoes one, which lets the server map the address it sees (after NAT) to the
+ * slot. The server relays every snapshot to the other clients over UDP and drops snapshots whose slot does not
+ * match the endpoint they came from. The loopback test sends snapshots to ourselves instead.
+ *
+ * The UDP socket is only used by the game thread; the network thread hands over the server endpoint under a mutex.
+ *
+ * The sender keeps REPLICATION_HISTORY snapshots of what the receivers will reconstruct (records that did not fit
+ * in the packet keep their baseline value), so a baseline is always exact. Receivers keep as many per sender slot.
+ *
+ * Snapshot layout: u8 type, u8 sender slot, u16 sequence, u16 baseline, u16 record count, one u16 ack per player
+ * slot, then the records. Hello layout: u8 type, u8 sender slot, u32 token.
+ */
+
+#define REPLICATION_SEND_RATE 20
+#define REPLICATION_MTU 1200
+#define REPLICATION_HEADER_SIZE (8 + NETWORK_MAX_PLAYERS * 2)
+#define REPLICATION_PACKET_SNAPSHOT 0x53
+#define REPLICATION_PACKET_HELLO 0x48
+#define REPLICATION_HELLO_SIZE 6
+#define REPLICATION_HELLO_INTERVAL 250
+#define REPLICATION_SHIM_QUEUE_SIZE 128
+// A slot that stays silent this long no longer holds back the baseline
+#define REPLICATION_PEER_TIMEOUT 2000
+
+#define REPLICATION_POS_SCALE 8.0f
+#define REPLICATION_VEL_SCALE 64.0f
+
+typedef enum {
+    REPLICATION_TRANSPORT_NONE,
+    REPLICATION_TRANSPORT_SERVER, // UDP to the server, which relays to the other clients
+    REPLICATION_TRANSPORT_LOOPBACK
+} ReplicationTransport;
+
+typedef struct {
+    u32 deliverAt;
+    s32 len;
+    u8 data[REPLICATION_MTU];
+} ReplicationDelayedPacket;
+
+typedef struct {
+    bool active;
+    u32 lastHeard;
+    u16 latestReceived; // Newest snapshot received from this slot
+    u16 ackedSequence;  // Newest of our snapshots this slot received
+    ReplicationSnapshot history[REPLICATION_HISTORY];
+} ReplicationPeer;
+
+ReplicationStats gReplicationStats;
+
+static ReplicationTransport sTransport = REPLICATION_TRANSPORT_NONE;
+static UDPsocket sSocket = NULL;
+static UDPpacket* sPacket = NULL;
+static IPaddress sPeerAddress;
+static bool sHavePeerAddress = false;
+static bool sServerAnswered = false; // The server echoed a hello, so it knows our public endpoint
+static u32 sToken = 0;
+static u32 sLastHelloTime = 0;
+
+static ReplicationSnapshot sCurrent;
+static ReplicationSnapshot sDecoded;
+static ReplicationSnapshot sSendHistory[REPLICATION_HISTORY];
+static ReplicationPeer sPeers[NETWORK_MAX_PLAYERS];
+static u16 sSequence = 0;
+static u32 sLastSendTime = 0;
+static u32 sStatsWindowStart = 0;
+static u32 sStatsBytesSent = 0;
+static u32 sStatsBytesReceived = 0;
+
+static ReplicationConditions sConditions = { 0 };
+static ReplicationDelayedPacket sShimQueue[REPLICATION_SHIM_QUEUE_SIZE];
+static s32 sShimQueueCount = 0;
+
+// Shared with the network thread, guarded by sMutex
+static SDL_mutex* sMutex = NULL;
+static u16 sLocalPort = 0;
+static bool sEndpointPending = false;
+static u16 sPendingPort = 0;
+static u32 sPendingToken = 0;
+
+static s32 quantize(f32 value, f32 scale) {
+    f32 scaled = value * scale;
+    return (s32) (scaled < 0.0f ? scaled - 0.5f : scaled + 0.5f);
+}
+
+static f32 dequantize(s32 value, f32 scale) {
+    return (f32) value / scale;
+}
+
+static void quantize_transform(ReplicatedEntity* entity, Vec3f pos, Vec3f velocity) {
+    for (s32 i = 0; i < 3; i++) {
+        entity->fields[REPLICATION_FIELD_POS_X + i] = quantize(pos[i], REPLICATION_POS_SCALE);
+        entity->fields[REPLICATION_FIELD_VEL_X + i] = quantize(velocity[i], REPLICATION_VEL_SCALE);
+    }
+}
+
+static void dequantize_transform(const ReplicatedEntity* entity, Vec3f pos, Vec3f velocity) {
+    for (s32 i = 0; i < 3; i++) {
+        pos[i] = dequantize(entity->fields[REPLICATION_FIELD_POS_X + i], REPLICATION_POS_SCALE);
+        velocity[i] = dequantize(entity->fields[REPLICATION_FIELD_VEL_X + i], REPLICATION_VEL_SCALE);
+    }
+}
+
+static bool replication_is_host(void) {
+    return (localClient != NULL) && (localClient->slot == 0);
+}
+
+static s32 replication_local_slot(void) {
+    return (localClient != NULL) ? localClient->slot : 0;
+}
+
+// The local player is always spawned in gPlayers[0], see spawn_network_players
+static Player* replication_player_for_slot(s32 slot) {
+    s32 localSlot = replication_local_slot();
+
+    if (slot == localSlot) {
+        return &gPlayers[0];
+    }
+    if (slot == 0) {
+        return &gPlayers[localSlot];
+    }
+    return &gPlayers[slot];
+}
+
+static void replicate_local_player(ReplicationSnapshot* snapshot) {
+    Player* player = &gPlayers[0];
+    ReplicatedEntity* entity =
+        replication_snapshot_add(snapshot, REPLICATION_ENTITY_ID(REPLICATION_ENTITY_PLAYER, replication_local_slot()));
+
+    if (entity == NULL) {
+        return;
+    }
+    quantize_transform(entity, player->pos, player->velocity);
+    for (s32 i = 0; i < 3; i++) {
+        entity->fields[REPLICATION_FIELD_ROT_X + i] = player->rotation[i];
+    }
+    entity->fields[REPLICATION_FIELD_SPEED] = quantize(player->speed, REPLICATION_VEL_SCALE);
+    entity->fields[REPLICATION_FIELD_TYPE] = player->characterId;
+    entity->fields[REPLICATION_FIELD_FLAGS] = player->type;
+    entity->fields[REPLICATION_FIELD_LAP] = player->lapCount;
+}
+
+void ActorReplication(ReplicationSnapshot* snapshot) {
+    for (size_t i = 0; (i < ACTOR_LIST_SIZE) && (i <= 0xFFF); i++) {
+        struct Actor* actor = GET_ACTOR(i);
+        ReplicatedEntity* entity;
+
+        if ((actor->flags & 0x8000) == 0) {
+            continue;
+        }
+        entity = replication_snapshot_add(snapshot, REPLICATION_ENTITY_ID(REPLICATION_ENTITY_ACTOR, i));
+        if (entity == NULL) {
+            return;
+        }
+        quantize_transform(entity, actor->pos, actor->velocity);
+        for (s32 j = 0; j < 3; j++) {
+            entity->fields[REPLICATION_FIELD_ROT_X + j] = actor->rot[j];
+        }
+        entity->fields[REPLICATION_FIELD_TYPE] = actor->type;
+        entity->fields[REPLICATION_FIELD_STATE] = actor->state;
+        entity->fields[REPLICATION_FIELD_FLAGS] = actor->flags;
+    }
+}
+
+void ObjectReplication(ReplicationSnapshot* snapshot) {
+    s32 count = 0;
+
+    for (s32 i = 0; i < OBJECT_LIST_SIZE; i++) {
+        Object* object = &gObjectList[i];
+        ReplicatedEntity* entity;
+
+        if (object->unk_0CA == 0) {
+            continue;
+        }
+        if (count++ >= REPLICATION_MAX_OBJECTS) {
+            return;
+        }
+        entity = replication_snapshot_add(snapshot, REPLICATION_ENTITY_ID(REPLICATION_ENTITY_OBJECT, i));
+        if (entity == NULL) {
+            return;
+        }
+        quantize_transform(entity, object->pos, object->velocity);
+        for (s32 j = 0; j < 3; j++) {
+            entity->fields[REPLICATION_FIELD_ROT_X + j] = (s16) object->orientation[j];
+        }
+        entity->fields[REPLICATION_FIELD_TYPE] = object->type;
+        entity->fields[REPLICATION_FIELD_STATE] = object->state;
+    }
+}
+
+// Each slot only has authority over its own player, actors and objects belong to the host in slot 0
+static void apply_entity(s32 senderSlot, const ReplicatedEntity* entity) {
+    s32 index = REPLICATION_ENTITY_INDEX(entity->id);
+
+    switch (REPLICATION_ENTITY_KIND(entity->id)) {
+        case REPLICATION_ENTITY_PLAYER: {
+            Player* player;
+
+            if ((index != senderSlot) || (index == replication_local_slot())) {
+                return;
+            }
+            player = replication_player_for_slot(index);
+            dequantize_transform(entity, player->pos, player->velocity);
+            for (s32 i = 0; i < 3; i++) {
+                player->rotation[i] = (s16) entity->fields[REPLICATION_FIELD_ROT_X + i];
+            }
+            player->speed = dequantize(entity->fields[REPLICATION_FIELD_SPEED], REPLICATION_VEL_SCALE);
+            break;
+        }
+        case REPLICATION_ENTITY_ACTOR: {
+            struct Actor* actor;
+
+            if ((senderSlot != 0) || replication_is_host() || ((size_t) index >= ACTOR_LIST_SIZE)) {
+                return;
+            }
+            actor = GET_ACTOR(index);
+            if (actor->type != entity->fields[REPLICATION_FIELD_TYPE]) {
+                return;
+            }
+            dequantize_transform(entity, actor->pos, actor->velocity);
+            for (s32 i = 0; i < 3; i++) {
+                actor->rot[i] = (s16) entity->fields[REPLICATION_FIELD_ROT_X + i];
+            }
+            break;
+        }
+        case REPLICATION_ENTITY_OBJECT: {
+            Object* object;
+
+            if ((senderSlot != 0) || replication_is_host() || (index >= OBJECT_LIST_SIZE)) {
+                return;
+            }
+            object = &gObjectList[index];
+            if ((object->unk_0CA == 0) || (object->type != entity->fields[REPLICATION_FIELD_TYPE])) {
+                return;
+            }
+            dequantize_transform(entity, object->pos, object->velocity);
+            for (s32 i = 0; i < 3; i++) {
+                object->orientation[i] = (u16) entity->fields[REPLICATION_FIELD_ROT_X + i];
+            }
+            break;
+        }
+    }
+}
+
+static void replication_reset_peer(ReplicationPeer* peer) {
+    peer->active = false;
+    peer->lastHeard = 0;
+    peer->latestReceived = REPLICATION_NO_SEQUENCE;
+    peer->ackedSequence = REPLICATION_NO_SEQUENCE;
+    for (s32 i = 0; i < REPLICATION_HISTORY; i++) {
+        peer->history[i].sequence = REPLICATION_NO_SEQUENCE;
+    }
+}
+
+/**
+ * Picks the oldest snapshot acknowledged by every slot we are hearing from. A peer that lost that very snapshot
+ * rejects the packet until the baseline moves on, which it does as soon as its acks catch up.
+ */
+static const ReplicationSnapshot* replication_pick_baseline(u32 now) {
+    u16 oldest = REPLICATION_NO_SEQUENCE;
+    bool any = false;
+
+    for (s32 slot = 0; slot < NETWORK_MAX_PLAYERS; slot++) {
+        ReplicationPeer* peer = &sPeers[slot];
+
+        if (!peer->active) {
+            continue;
+        }
+        if ((now - peer->lastHeard) >= REPLICATION_PEER_TIMEOUT) {
+            replication_reset_peer(peer);
+            continue;
+        }
+        if (peer->ackedSequence == REPLICATION_NO_SEQUENCE) {
+            return NULL;
+        }
+        if (!any || replication_sequence_newer(oldest, peer->ackedSequence)) {
+            oldest = peer->ackedSequence;
+        }
+        any = true;
+    }
+    if (!any || ((u16) (sSequence - oldest) >= REPLICATION_HISTORY) ||
+        (sSendHistory[oldest % REPLICATION_HISTORY].sequence != oldest)) {
+        return NULL;
+    }
+    return &sSendHistory[oldest % REPLICATION_HISTORY];
 }
 
-void ActorReplication() {
+static bool replication_udp_send(const u8* data, s32 len) {
+    if ((sTransport == REPLICATION_TRANSPORT_NONE) || !sHavePeerAddress || (sSocket == NULL) || (sPacket == NULL) ||
+        (len > sPacket->maxlen)) {
+        return false;
+    }
+    memcpy(sPacket->data, data, len);
+    sPacket->len = len;
+    sPacket->address = sPeerAddress;
+    if (SDLNet_UDP_Send(sSocket, -1, sPacket) == 0) {
+        printf("[SpaghettiOnline] SDLNet_UDP_Send: %s\n", SDLNet_GetError());
+        return false;
+    }
+    return true;
 }
 
-void ObjectReplication() {
+static void replication_transport_send(const u8* data, s32 len) {
+    if (!replication_udp_send(data, len)) {
+        return;
+    }
+    gReplicationStats.packetsSent++;
+    gReplicationStats.bytesSent += len;
+    sStatsBytesSent += len;
+}
+
+// Network condition shim: drops packets and holds the rest back to simulate latency and jitter
+static void replication_send(const u8* data, s32 len) {
+    u32 delay;
+    ReplicationDelayedPacket* delayed;
+
+    if ((sConditions.lossPercent > 0) && ((rand() % 100) < sConditions.lossPercent)) {
+        gReplicationStats.packetsDropped++;
+        return;
+    }
+    delay = sConditions.latencyMs;
+    if (sConditions.jitterMs > 0) {
+        delay += rand() % (sConditions.jitterMs + 1);
+    }
+    if ((delay == 0) || (sShimQueueCount >= REPLICATION_SHIM_QUEUE_SIZE)) {
+        replication_transport_send(data, len);
+        return;
+    }
+    delayed = &sShimQueue[sShimQueueCount++];
+    delayed->deliverAt = SDL_GetTicks() + delay;
+    delayed->len = len;
+    memcpy(delayed->data, data, len);
+}
+
+static void replication_flush_shim(u32 now) {
+    s32 kept = 0;
+
+    for (s32 i = 0; i < sShimQueueCount; i++) {
+        if ((s32) (now - sShimQueue[i].deliverAt) >= 0) {
+            replication_transport_send(sShimQueue[i].data, sShimQueue[i].len);
+        } else {
+            if (kept != i) {
+                sShimQueue[kept] = sShimQueue[i];
+            }
+            kept++;
+        }
+    }
+    sShimQueueCount = kept;
+}
+
+static void replication_send_snapshot(u32 now) {
+    u8 buffer[REPLICATION_MTU];
+    ReplicationWriter writer = { buffer, sizeof(buffer), 0, false };
+    const ReplicationSnapshot* baseline;
+    ReplicationSnapshot* sent;
+    size_t length;
+    u16 records;
+
+    sCurrent.sequence = sSequence;
+    sCurrent.entityCount = 0;
+    replicate_local_player(&sCurrent);
+    if (replication_is_host()) {
+        ActorReplication(&sCurrent);
+        ObjectReplication(&sCurrent);
+    }
+
+    baseline = replication_pick_baseline(now);
+    writer.pos = REPLICATION_HEADER_SIZE;
+    sent = &sSendHistory[sSequence % REPLICATION_HISTORY];
+    records = replication_encode_snapshot(&writer, &sCurrent, baseline, sent);
+    length = writer.pos;
+
+    writer.pos = 0;
+    replication_write_u8(&writer, REPLICATION_PACKET_SNAPSHOT);
+    replication_write_u8(&writer, (u8) replication_local_slot());
+    replication_write_u16(&writer, sSequence);
+    replication_write_u16(&writer, (baseline != NULL) ? baseline->sequence : REPLICATION_NO_SEQUENCE);
+    replication_write_u16(&writer, records);
+    for (s32 slot = 0; slot < NETWORK_MAX_PLAYERS; slot++) {
+        replication_write_u16(&writer, sPeers[slot].latestReceived);
+    }
+
+    replication_send(buffer, (s32) length);
+    if (baseline == NULL) {
+        gReplicationStats.fullSnapshotsSent++;
+    }
+
+    sSequence++;
+    if (sSequence == REPLICATION_NO_SEQUENCE) {
+        sSequence = 0;
+    }
+}
+
+void replication_receive(const u8* data, size_t size) {
+    ReplicationReader reader = { data, size, 0, false };
+    const ReplicationSnapshot* baseline = NULL;
+    ReplicationPeer* peer;
+    u16 acks[NETWORK_MAX_PLAYERS];
+    u16 sequence;
+    u16 baselineSequence;
+    u16 records;
+    u16 ack;
+    s32 slot;
+
+    if ((size < REPLICATION_HEADER_SIZE) || (replication_read_u8(&reader) != REPLICATION_PACKET_SNAPSHOT)) {
+        gReplicationStats.packetsRejected++;
+        return;
+    }
+    slot = replication_read_u8(&reader);
+    sequence = replication_read_u16(&reader);
+    baselineSequence = replication_read_u16(&reader);
+    records = replication_read_u16(&reader);
+    for (s32 i = 0; i < NETWORK_MAX_PLAYERS; i++) {
+        acks[i] = replication_read_u16(&reader);
+    }
+    if ((slot >= NETWORK_MAX_PLAYERS) || (sequence == REPLICATION_NO_SEQUENCE)) {
+        gReplicationStats.packetsRejected++;
+        return;
+    }
+
+    gReplicationStats.packetsReceived++;
+    gReplicationStats.bytesReceived += size;
+    sStatsBytesReceived += size;
+
+    peer = &sPeers[slot];
+    peer->active = true;
+    peer->lastHeard = SDL_GetTicks();
+
+    ack = acks[replication_local_slot()];
+    if ((ack != REPLICATION_NO_SEQUENCE) && ((peer->ackedSequence == REPLICATION_NO_SEQUENCE) ||
+                                             replication_sequence_newer(ack, peer->ackedSequence))) {
+        peer->ackedSequence = ack;
+    }
+
+    if (baselineSequence != REPLICATION_NO_SEQUENCE) {
+        baseline = &peer->history[baselineSequence % REPLICATION_HISTORY];
+        if (baseline->sequence != baselineSequence) {
+            // Baseline fell out of the history, wait for the sender to pick a newer one
+            gReplicationStats.packetsRejected++;
+            return;
+        }
+    }
+    if (!replication_decode_snapshot(&reader, records, baseline, &sDecoded)) {
+        gReplicationStats.packetsRejected++;
+        return;
+    }
+    sDecoded.sequence = sequence;
+    peer->history[sequence % REPLICATION_HISTORY] = sDecoded;
+
+    // Late packets still serve as baselines, but only the newest state is applied
+    if ((peer->latestReceived != REPLICATION_NO_SEQUENCE) &&
+        !replication_sequence_newer(sequence, peer->latestReceived)) {
+        return;
+    }
+    peer->latestReceived = sequence;
+    for (u16 i = 0; i < sDecoded.entityCount; i++) {
+        apply_entity(slot, &sDecoded.entities[i]);
+    }
+}
+
+/**
+ * Called on the network thread once the TCP connection is up, tells the server which UDP port we send snapshots
+ * from. The server may see another port after NAT; the hellos sort that out.
+ */
+void replication_handshake(void) {
+    u8 payload[2];
+    u16 port;
+
+    if (sMutex == NULL) {
+        return;
+    }
+    SDL_LockMutex(sMutex);
+    port = (sTransport == REPLICATION_TRANSPORT_SERVER) ? sLocalPort : 0;
+    SDL_UnlockMutex(sMutex);
+    if (port == 0) {
+        return;
+    }
+    payload[0] = port & 0xFF;
+    payload[1] = port >> 8;
+    send_data_packet(gNetwork.tcpSocket, PACKET_UDP_ENDPOINT, payload, sizeof(payload));
+}
+
+// Called on the network thread with the server's answer: u16 UDP port, u32 token
+void replication_set_server_endpoint(const char* data, size_t size) {
+    const u8* bytes = (const u8*) data;
+
+    if ((sMutex == NULL) || (size < 6)) {
+        printf("[SpaghettiOnline] Malformed UDP endpoint packet\n");
+        return;
+    }
+    SDL_LockMutex(sMutex);
+    sPendingPort = bytes[0] | (bytes[1] << 8);
+    sPendingToken = bytes[2] | (bytes[3] << 8) | (bytes[4] << 16) | ((u32) bytes[5] << 24);
+    sEndpointPending = true;
+    SDL_UnlockMutex(sMutex);
+}
+
+static void replication_reset(void) {
+    for (s32 i = 0; i < REPLICATION_HISTORY; i++) {
+        sSendHistory[i].sequence = REPLICATION_NO_SEQUENCE;
+    }
+    for (s32 slot = 0; slot < NETWORK_MAX_PLAYERS; slot++) {
+        replication_reset_peer(&sPeers[slot]);
+    }
+    sSequence = 0;
+    sShimQueueCount = 0;
+    sLastSendTime = 0;
+    sLastHelloTime = 0;
+    sStatsWindowStart = SDL_GetTicks();
+    sStatsBytesSent = 0;
+    sStatsBytesReceived = 0;
+    memset(&gReplicationStats, 0, sizeof(gReplicationStats));
+}
+
+static void replication_close_socket(void) {
+    if (sPacket != NULL) {
+        SDLNet_FreePacket(sPacket);
+        sPacket = NULL;
+    }
+    if (sSocket != NULL) {
+        SDLNet_UDP_Close(sSocket);
+        sSocket = NULL;
+        SDLNet_Quit();
+    }
+    sHavePeerAddress = false;
+    sServerAnswered = false;
+}
+
+// Port 0 picks any free port
+static bool replication_open_socket(uint16_t port) {
+    replication_close_socket();
+    if (SDLNet_Init() == -1) {
+        printf("[SpaghettiOnline] SDLNet_Init: %s\n", SDLNet_GetError());
+        return false;
+    }
+    sSocket = SDLNet_UDP_Open(port);
+    if (sSocket == NULL) {
+        printf("[SpaghettiOnline] SDLNet_UDP_Open: %s\n", SDLNet_GetError());
+        SDLNet_Quit();
+        return false;
+    }
+    sPacket = SDLNet_AllocPacket(REPLICATION_MTU);
+    if (sPacket == NULL) {
+        printf("[SpaghettiOnline] SDLNet_AllocPacket: %s\n", SDLNet_GetError());
+        replication_close_socket();
+        return false;
+    }
+    return true;
+}
+
+static void replication_start(ReplicationTransport transport) {
+    IPaddress* local = SDLNet_UDP_GetPeerAddress(sSocket, -1);
+
+    replication_reset();
+    SDL_LockMutex(sMutex);
+    sTransport = transport;
+    sLocalPort = (local != NULL) ? SDLNet_Read16(&local->port) : 0;
+    sEndpointPending = false;
+    SDL_UnlockMutex(sMutex);
+}
+
+// Must run on the game thread before the network thread starts, so the mutex and the local port are in place
+void replication_init(void) {
+    if (sMutex == NULL) {
+        sMutex = SDL_CreateMutex();
+    }
+    if (!replication_open_socket(0)) {
+        return;
+    }
+    replication_start(REPLICATION_TRANSPORT_SERVER);
+}
+
+void replication_init_loopback(uint16_t port) {
+    if (sMutex == NULL) {
+        sMutex = SDL_CreateMutex();
+    }
+    if (!replication_open_socket(port)) {
+        return;
+    }
+    if (SDLNet_ResolveHost(&sPeerAddress, "127.0.0.1", port) == -1) {
+        printf("[SpaghettiOnline] SDLNet_ResolveHost: %s\n", SDLNet_GetError());
+        replication_close_socket();
+        return;
+    }
+    replication_start(REPLICATION_TRANSPORT_LOOPBACK);
+    sHavePeerAddress = true;
+    sServerAnswered = true;
+    printf("[SpaghettiOnline] Replication loopback on port %d\n", port);
+}
+
+/**
+ * Stops replication. Safe to call from the network thread (networking_cleanup), the UDP socket is closed by the
+ * next replication_update on the game thread.
+ */
+void replication_shutdown(void) {
+    if (sMutex == NULL) {
+        return;
+    }
+    SDL_LockMutex(sMutex);
+    sTransport = REPLICATION_TRANSPORT_NONE;
+    sEndpointPending = false;
+    SDL_UnlockMutex(sMutex);
+}
+
+void replication_set_conditions(const ReplicationConditions* conditions) {
+    sConditions = *conditions;
+}
+
+// Sent directly, not through the condition shim, until the server echoes one back
+static void replication_send_hello(u32 now) {
+    u8 buffer[REPLICATION_HELLO_SIZE];
+    ReplicationWriter writer = { buffer, sizeof(buffer), 0, false };
+
+    if ((now - sLastHelloTime) < REPLICATION_HELLO_INTERVAL) {
+        return;
+    }
+    sLastHelloTime = now;
+    replication_write_u8(&writer, REPLICATION_PACKET_HELLO);
+    replication_write_u8(&writer, (u8) replication_local_slot());
+    replication_write_u16(&writer, sToken & 0xFFFF);
+    replication_write_u16(&writer, sToken >> 16);
+    replication_udp_send(buffer, (s32) writer.pos);
+}
+
+static void replication_receive_udp(void) {
+    while (SDLNet_UDP_Recv(sSocket, sPacket) > 0) {
+        // Only the server (or ourselves in the loopback test) may send snapshots
+        if (!sHavePeerAddress || (sPacket->address.host != sPeerAddress.host) ||
+            (sPacket->address.port != sPeerAddress.port)) {
+            gReplicationStats.packetsRejected++;
+            continue;
+        }
+        sServerAnswered = true;
+        if ((sPacket->len > 0) && (sPacket->data[0] != REPLICATION_PACKET_HELLO)) {
+            replication_receive(sPacket->data, sPacket->len);
+        }
+    }
+}
+
+void replication_update(void) {
+    ReplicationTransport transport;
+    bool endpointPending;
+    u16 serverPort;
+    u32 token;
+    u32 now;
+
+    if (sMutex == NULL) {
+        return;
+    }
+    SDL_LockMutex(sMutex);
+    transport = sTransport;
+    endpointPending = sEndpointPending;
+    serverPort = sPendingPort;
+    token = sPendingToken;
+    sEndpointPending = false;
+    SDL_UnlockMutex(sMutex);
+
+    if (transport == REPLICATION_TRANSPORT_NONE) {
+        replication_close_socket();
+        return;
+    }
+    if (sSocket == NULL) {
+        return;
+    }
+    now = SDL_GetTicks();
+
+    if (endpointPending && (transport == REPLICATION_TRANSPORT_SERVER)) {
+        // Same host as the TCP connection, resolved by networking_init before the network thread started
+        sPeerAddress.host = gNetwork.address.host;
+        SDLNet_Write16(serverPort, &sPeerAddress.port);
+        sToken = token;
+        sHavePeerAddress = true;
+        sServerAnswered = false;
+        sLastHelloTime = now - REPLICATION_HELLO_INTERVAL;
+    }
+
+    replication_receive_udp();
+    if (!sHavePeerAddress) {
+        return;
+    }
+    if (!sServerAnswered) {
+        replication_send_hello(now);
+    }
+
+    replication_flush_shim(now);
+    if ((now - sLastSendTime) >= (1000 / REPLICATION_SEND_RATE)) {
+        sLastSendTime = now;
+        replication_send_snapshot(now);
+    }
+
+    if ((now - sStatsWindowStart) >= 1000) {
+        gReplicationStats.bytesSentPerSecond = sStatsBytesSent * 1000 / (now - sStatsWindowStart);
+        gReplicationStats.bytesReceivedPerSecond = sStatsBytesReceived * 1000 / (now - sStatsWindowStart);
+        sStatsBytesSent = 0;
+        sStatsBytesReceived = 0;
+        sStatsWindowStart = now;
+    }
 }
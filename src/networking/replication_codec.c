@@ -0,0 +1,210 @@
+#include <string.h>
+
+#include "replication_codec.h"
+
+bool replication_sequence_newer(uint16_t a, uint16_t b) {
+    return (a != b) && ((uint16_t) (a - b) < 0x8000);
+}
+
+static void writer_bytes(ReplicationWriter* writer, const void* data, size_t size) {
+    if (writer->overflow || (writer->pos + size > writer->size)) {
+        writer->overflow = true;
+        return;
+    }
+    memcpy(writer->data + writer->pos, data, size);
+    writer->pos += size;
+}
+
+void replication_write_u8(ReplicationWriter* writer, uint8_t value) {
+    writer_bytes(writer, &value, sizeof(value));
+}
+
+void replication_write_u16(ReplicationWriter* writer, uint16_t value) {
+    uint8_t bytes[2] = { value & 0xFF, value >> 8 };
+    writer_bytes(writer, bytes, sizeof(bytes));
+}
+
+void replication_write_varint(ReplicationWriter* writer, int32_t value) {
+    uint32_t zigzag = ((uint32_t) value << 1) ^ (uint32_t) (value >> 31);
+    do {
+        uint8_t byte = zigzag & 0x7F;
+        zigzag >>= 7;
+        replication_write_u8(writer, byte | (zigzag != 0 ? 0x80 : 0));
+    } while (zigzag != 0);
+}
+
+uint8_t replication_read_u8(ReplicationReader* reader) {
+    if (reader->overflow || (reader->pos + 1 > reader->size)) {
+        reader->overflow = true;
+        return 0;
+    }
+    return reader->data[reader->pos++];
+}
+
+uint16_t replication_read_u16(ReplicationReader* reader) {
+    uint16_t low = replication_read_u8(reader);
+    return low | ((uint16_t) replication_read_u8(reader) << 8);
+}
+
+int32_t replication_read_varint(ReplicationReader* reader) {
+    uint32_t zigzag = 0;
+    int32_t shift = 0;
+    uint8_t byte;
+    do {
+        byte = replication_read_u8(reader);
+        if (shift > 28) {
+            reader->overflow = true;
+            return 0;
+        }
+        zigzag |= (uint32_t) (byte & 0x7F) << shift;
+        shift += 7;
+    } while ((byte & 0x80) && !reader->overflow);
+    return (int32_t) (zigzag >> 1) ^ -(int32_t) (zigzag & 1);
+}
+
+ReplicatedEntity* replication_snapshot_add(ReplicationSnapshot* snapshot, uint16_t id) {
+    ReplicatedEntity* entity;
+
+    if (snapshot->entityCount >= REPLICATION_MAX_ENTITIES) {
+        return NULL;
+    }
+    entity = &snapshot->entities[snapshot->entityCount++];
+    memset(entity, 0, sizeof(ReplicatedEntity));
+    entity->id = id;
+    return entity;
+}
+
+static uint16_t entity_diff(const ReplicatedEntity* entity, const ReplicatedEntity* reference) {
+    uint16_t mask = 0;
+    for (int32_t i = 0; i < REPLICATION_FIELD_COUNT; i++) {
+        int32_t base = (reference != NULL) ? reference->fields[i] : 0;
+        if (entity->fields[i] != base) {
+            mask |= 1 << i;
+        }
+    }
+    // An empty mask means removal, new entities always send at least one field
+    if ((mask == 0) && (reference == NULL)) {
+        mask = 1 << REPLICATION_FIELD_POS_X;
+    }
+    return mask;
+}
+
+// Writes one record, rolling back if it does not fit
+static bool write_record(ReplicationWriter* writer, const ReplicatedEntity* entity, const ReplicatedEntity* reference,
+                         uint16_t id, uint16_t mask) {
+    size_t start = writer->pos;
+
+    replication_write_u16(writer, id);
+    replication_write_u16(writer, mask);
+    for (int32_t i = 0; i < REPLICATION_FIELD_COUNT; i++) {
+        if (mask & (1 << i)) {
+            int32_t base = (reference != NULL) ? reference->fields[i] : 0;
+            // Wrapping difference, fields may span the whole s32 range
+            replication_write_varint(writer, (int32_t) ((uint32_t) entity->fields[i] - (uint32_t) base));
+        }
+    }
+    if (writer->overflow) {
+        writer->pos = start;
+        writer->overflow = false;
+        return false;
+    }
+    return true;
+}
+
+uint16_t replication_encode_snapshot(ReplicationWriter* writer, const ReplicationSnapshot* current,
+                                     const ReplicationSnapshot* baseline, ReplicationSnapshot* sent) {
+    uint16_t baseCount = (baseline != NULL) ? baseline->entityCount : 0;
+    uint16_t records = 0;
+    uint16_t i = 0;
+    uint16_t j = 0;
+
+    sent->sequence = current->sequence;
+    sent->entityCount = 0;
+
+    while ((i < current->entityCount) || (j < baseCount)) {
+        const ReplicatedEntity* entity = (i < current->entityCount) ? &current->entities[i] : NULL;
+        const ReplicatedEntity* reference = (j < baseCount) ? &baseline->entities[j] : NULL;
+        uint16_t mask;
+
+        if ((reference != NULL) && ((entity == NULL) || (reference->id < entity->id))) {
+            // Entity no longer exists
+            if (write_record(writer, reference, NULL, reference->id, 0)) {
+                records++;
+            } else {
+                sent->entities[sent->entityCount++] = *reference;
+            }
+            j++;
+            continue;
+        }
+        if ((reference != NULL) && (reference->id == entity->id)) {
+            j++;
+        } else {
+            reference = NULL;
+        }
+        i++;
+
+        mask = entity_diff(entity, reference);
+        if (mask == 0) {
+            sent->entities[sent->entityCount++] = *entity;
+        } else if (write_record(writer, entity, reference, entity->id, mask)) {
+            sent->entities[sent->entityCount++] = *entity;
+            records++;
+        } else if (reference != NULL) {
+            sent->entities[sent->entityCount++] = *reference;
+        }
+    }
+    return records;
+}
+
+bool replication_decode_snapshot(ReplicationReader* reader, uint16_t records, const ReplicationSnapshot* baseline,
+                                 ReplicationSnapshot* out) {
+    uint16_t baseCount = (baseline != NULL) ? baseline->entityCount : 0;
+    uint16_t j = 0;
+    int32_t lastId = -1;
+
+    out->entityCount = 0;
+    for (uint16_t r = 0; r < records; r++) {
+        uint16_t id = replication_read_u16(reader);
+        uint16_t mask = replication_read_u16(reader);
+        ReplicatedEntity entity;
+
+        if (reader->overflow || ((int32_t) id <= lastId)) {
+            return false;
+        }
+        lastId = id;
+
+        // Entities without a record are unchanged
+        while ((j < baseCount) && (baseline->entities[j].id < id)) {
+            if (out->entityCount >= REPLICATION_MAX_ENTITIES) {
+                return false;
+            }
+            out->entities[out->entityCount++] = baseline->entities[j++];
+        }
+        if ((j < baseCount) && (baseline->entities[j].id == id)) {
+            entity = baseline->entities[j++];
+        } else {
+            memset(&entity, 0, sizeof(entity));
+            entity.id = id;
+        }
+        if (mask == 0) {
+            continue;
+        }
+        for (int32_t i = 0; i < REPLICATION_FIELD_COUNT; i++) {
+            if (mask & (1 << i)) {
+                uint32_t delta = (uint32_t) replication_read_varint(reader);
+                entity.fields[i] = (int32_t) ((uint32_t) entity.fields[i] + delta);
+            }
+        }
+        if (reader->overflow || (out->entityCount >= REPLICATION_MAX_ENTITIES)) {
+            return false;
+        }
+        out->entities[out->entityCount++] = entity;
+    }
+    while (j < baseCount) {
+        if (out->entityCount >= REPLICATION_MAX_ENTITIES) {
+            return false;
+        }
+        out->entities[out->entityCount++] = baseline->entities[j++];
+    }
+    return true;
+}
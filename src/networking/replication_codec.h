@@ -0,0 +1,100 @@
+#ifndef REPLICATION_CODEC_H
+#define REPLICATION_CODEC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Snapshot delta codec used by replication.c.
+ *
+ * Kept free of game and SDL state so tests/ReplicationCodecTest.c can round-trip snapshots on its own.
+ * Records are u16 entity id, u16 field mask and one zigzag varint per set bit, holding the difference to the
+ * baseline field. A record with an empty mask removes the entity.
+ */
+
+#define REPLICATION_HISTORY 32
+#define REPLICATION_MAX_ENTITIES 192
+#define REPLICATION_MAX_OBJECTS 64
+#define REPLICATION_NO_SEQUENCE 0xFFFF
+
+enum {
+    REPLICATION_ENTITY_PLAYER,
+    REPLICATION_ENTITY_ACTOR,
+    REPLICATION_ENTITY_OBJECT
+};
+
+// Quantized fields, positions are in 1/8 units and velocities in 1/64 units
+enum {
+    REPLICATION_FIELD_POS_X,
+    REPLICATION_FIELD_POS_Y,
+    REPLICATION_FIELD_POS_Z,
+    REPLICATION_FIELD_ROT_X,
+    REPLICATION_FIELD_ROT_Y,
+    REPLICATION_FIELD_ROT_Z,
+    REPLICATION_FIELD_VEL_X,
+    REPLICATION_FIELD_VEL_Y,
+    REPLICATION_FIELD_VEL_Z,
+    REPLICATION_FIELD_SPEED,
+    REPLICATION_FIELD_TYPE,
+    REPLICATION_FIELD_STATE,
+    REPLICATION_FIELD_FLAGS,
+    REPLICATION_FIELD_LAP,
+    REPLICATION_FIELD_COUNT
+};
+
+#define REPLICATION_ENTITY_ID(kind, index) ((uint16_t) (((kind) << 12) | (index)))
+#define REPLICATION_ENTITY_KIND(id) ((id) >> 12)
+#define REPLICATION_ENTITY_INDEX(id) ((id) & 0xFFF)
+
+typedef struct {
+    uint16_t id; // Entity kind in the top 4 bits, list index in the rest
+    int32_t fields[REPLICATION_FIELD_COUNT];
+} ReplicatedEntity;
+
+typedef struct {
+    uint16_t sequence;
+    uint16_t entityCount;
+    ReplicatedEntity entities[REPLICATION_MAX_ENTITIES]; // Sorted by id
+} ReplicationSnapshot;
+
+typedef struct {
+    uint8_t* data;
+    size_t size;
+    size_t pos;
+    bool overflow;
+} ReplicationWriter;
+
+typedef struct {
+    const uint8_t* data;
+    size_t size;
+    size_t pos;
+    bool overflow;
+} ReplicationReader;
+
+/** @brief True if sequence @p a is newer than @p b, taking wraparound into account. */
+bool replication_sequence_newer(uint16_t a, uint16_t b);
+
+void replication_write_u8(ReplicationWriter* writer, uint8_t value);
+void replication_write_u16(ReplicationWriter* writer, uint16_t value);
+void replication_write_varint(ReplicationWriter* writer, int32_t value);
+uint8_t replication_read_u8(ReplicationReader* reader);
+uint16_t replication_read_u16(ReplicationReader* reader);
+int32_t replication_read_varint(ReplicationReader* reader);
+
+/** @brief Appends an entity to @p snapshot. Returns NULL when the snapshot is full. */
+ReplicatedEntity* replication_snapshot_add(ReplicationSnapshot* snapshot, uint16_t id);
+
+/**
+ * @brief Encodes @p current against @p baseline (NULL for a full snapshot) and stores what the receiver will
+ * reconstruct in @p sent. Records that do not fit keep their baseline value in @p sent, so it is always an exact
+ * baseline. Returns the number of records written.
+ */
+uint16_t replication_encode_snapshot(ReplicationWriter* writer, const ReplicationSnapshot* current,
+                                     const ReplicationSnapshot* baseline, ReplicationSnapshot* sent);
+
+/** @brief Decodes @p records records against @p baseline into @p out. Returns false on malformed data. */
+bool replication_decode_snapshot(ReplicationReader* reader, uint16_t records, const ReplicationSnapshot* baseline,
+                                 ReplicationSnapshot* out);
+
+#endif // REPLICATION_CODEC_H
@@ -23,6 +23,7 @@
 #include "port/Game.h"
 #include "src/enhancements/moon_jump.h"
 #include "engine/Matrix.h"
+#include "port/Settings.h"
 
 extern s32 D_8018D168;
 
@@ -512,7 +513,7 @@ u16 check_player_camera_collision_rubberbanding(Player* player, Camera* camera,
     s16 var_v0;
     u16 ret;
 
-    if (CVarGetInteger("gDisableRubberbanding", 0) != 0) {
+    if (gSettings.disableRubberbanding != 0) {
         return true;
     }
 
@@ -2378,8 +2379,8 @@ void func_8002D268(Player* player, UNUSED Camera* camera, s8 screenId, s8 player
         player->pos[2] = nextZ;
     }
     player->pos[1] = nextY;
-    if (CVarGetInteger("gNoWallColision", 0)) {
-        player->pos[1] = nextY < CVarGetFloat("gMinHeight", 0.0f) ? CVarGetFloat("gMinHeight", 0.0f) : nextY;
+    if (gSettings.noWallCollision) {
+        player->pos[1] = nextY < gSettings.minHeight ? gSettings.minHeight : nextY;
     }
     if ((player->type & PLAYER_HUMAN) && (!(player->type & PLAYER_CPU))) {
         func_8002BB9C(player, &nextX, &nextZ, screenId, playerId, newVelocity);
@@ -4544,7 +4545,7 @@ void func_80037BB4(Player* player, Vec3f arg1) {
 
 void func_80037CFC(Player* player, struct Controller* controller, s8 arg2) {
 
-    if (CVarGetInteger("gEnableMoonJump", 0)) {
+    if (gSettings.enableMoonJump) {
         moon_jump(player, controller);
     }
 
@@ -27,6 +27,8 @@
 #include "SpaghettiGui.h"
 
 #include "port/interpolation/FrameInterpolation.h"
+#include "port/FramePacing.h"
+#include "port/Settings.h"
 #include <graphic/Fast3D/Fast3dWindow.h>
 #include <graphic/Fast3D/interpreter.h>
 // #include <Fast3D/gfx_rendering_api.h>
@@ -51,7 +53,9 @@ float gInterpolationStep = 0.0f;
 // #include <PngFactory.h>
 #include "audio/internal.h"
 #include "audio/GameAudio.h"
+#include "memory.h"
 }
+#include "profiler.h"
 
 Fast::Interpreter* GetInterpreter() {
     return static_pointer_cast<Fast::Fast3dWindow>(Ship::Context::GetInstance()->GetWindow())
@@ -389,6 +393,7 @@ void GameEngine::StartFrame() const {
         case KbScancode::LUS_KB_TAB: {
             // Toggle HD Assets
             CVarSetInteger("gEnhancements.Mods.AlternateAssets", !CVarGetInteger("gEnhancements.Mods.AlternateAssets", 0));
+            Settings_MarkDirty();
             break;
         }
         case KbScancode::LUS_KB_P: {
@@ -420,7 +425,9 @@ void GameEngine::RunCommands(Gfx* Commands, const std::vector<std::unordered_map
     interpreter->mInterpolationIndex = 0;
 
     for (const auto& m : mtx_replacements) {
+        TRACE_ZONE("Fast3D");
         wnd->DrawAndRunGraphicsCommands(Commands, m);
+        FramePacing::Present();
         interpreter->mInterpolationIndex++;
     }
 
@@ -428,7 +435,9 @@ void GameEngine::RunCommands(Gfx* Commands, const std::vector<std::unordered_map
     if (prevAltAssets != curAltAssets) {
         prevAltAssets = curAltAssets;
         Ship::Context::GetInstance()->GetResourceManager()->SetAltAssetsEnabled(curAltAssets);
+        GameEngine_InvalidateResolutionCache();
         gfx_texture_cache_clear();
+        course_geometry_cache_invalidate();
     }
 }
 
@@ -457,11 +466,14 @@ void GameEngine::ProcessGfxCommands(Gfx* commands) {
 
     while (time + original_fps <= next_original_frame) {
         time += original_fps;
-        if (time != next_original_frame) {
-            mtx_replacements.push_back(FrameInterpolation_Interpolate((float) time / next_original_frame));
+        FramePacing::BeginInterpolation();
+        float step = FrameInterpolation_GetTickStep((float) time / next_original_frame);
+        if (step != 1.0f) {
+            mtx_replacements.push_back(FrameInterpolation_Interpolate(step));
         } else {
             mtx_replacements.emplace_back();
         }
+        FramePacing::EndInterpolation();
     }
     // printf("mtxf size: %d\n", mtx_replacements.size());
 
@@ -480,6 +492,7 @@ void GameEngine::ProcessGfxCommands(Gfx* commands) {
 
 // Audio
 void GameEngine::HandleAudioThread() {
+    trace_set_thread_name("Audio");
     while (audio.running) {
         {
             std::unique_lock<std::mutex> Lock(audio.mutex);
@@ -500,11 +513,14 @@ void GameEngine::HandleAudioThread() {
         f32 hmas_buffer[SAMPLES_PER_FRAME] = { 0 };
         s16 mix_buffer[SAMPLES_PER_FRAME] = { 0 };
 
-        for (size_t i = 0; i < NUM_AUDIO_CHANNELS; i++) {
-            create_next_audio_buffer(nas_buffer + i * (num_audio_samples * 2), num_audio_samples);
-        }
+        {
+            TRACE_ZONE("AudioSynthesis");
+            for (size_t i = 0; i < NUM_AUDIO_CHANNELS; i++) {
+                create_next_audio_buffer(nas_buffer + i * (num_audio_samples * 2), num_audio_samples);
+            }
 
-        GameEngine::Instance->gHMAS->CreateBuffer((u8*)hmas_buffer, 4 * num_audio_samples * sizeof(float));
+            GameEngine::Instance->gHMAS->CreateBuffer((u8*)hmas_buffer, 4 * num_audio_samples * sizeof(float));
+        }
 
         float master_vol = CVarGetFloat("gGameMasterVolume", 1.0f);
 
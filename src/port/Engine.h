@@ -119,6 +119,9 @@ uint32_t OTRGetGameViewportHeight();
 uint32_t OTRCalculateCenterOfAreaFromRightEdge(int32_t center);
 uint32_t OTRCalculateCenterOfAreaFromLeftEdge(int32_t center);
 int32_t GameEngine_ResourceGetTexTypeByName(const char* name);
+void GameEngine_InvalidateResolutionCache(void);
+void GameEngine_GetResolutionCacheStats(uint64_t* hits, uint64_t* misses);
+void GameEngine_ResetResolutionCacheStats(void);
 #ifdef __cplusplus
 }
 #endif
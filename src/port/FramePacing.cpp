@@ -0,0 +1,147 @@
+#include <libultraship.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <vector>
+#include <spdlog/spdlog.h>
+
+#include "FramePacing.h"
+
+#include "fixed_timestep.h"
+
+namespace {
+
+// More presents than this per game frame only happen at absurd interpolation targets; the rest record 0
+constexpr size_t kMaxPresentsPerFrame = 32;
+
+// Game thread only
+struct FrameState {
+    u32 GameFrame = 0;
+    u64 Start = 0;
+    u64 LogicStart = 0;
+    u64 LogicNs = 0;
+    u32 LogicTicks = 0;
+    u64 BuildNs = 0;
+    u64 InterpolationStart = 0;
+    u64 InterpolationNs[kMaxPresentsPerFrame];
+    size_t InterpolationCount = 0;
+    size_t PresentIndex = 0;
+    u64 LastPresent = 0;
+};
+
+FrameState sFrame;
+
+FramePacingSample sSamples[FRAME_PACING_CAPACITY];
+// Number of samples ever written. Slot (n % FRAME_PACING_CAPACITY) is filled before n + 1 is published.
+std::atomic<uint64_t> sWritten{ 0 };
+
+void Publish(const FramePacingSample& sample) {
+    uint64_t index = sWritten.load(std::memory_order_relaxed);
+    sSamples[index % FRAME_PACING_CAPACITY] = sample;
+    sWritten.store(index + 1, std::memory_order_release);
+}
+
+double ToMs(u64 ns) {
+    return (double) ns / 1000000.0;
+}
+
+} // namespace
+
+void frame_pacing_begin_frame(void) {
+    sFrame.GameFrame++;
+    sFrame.Start = fixed_timestep_now();
+    sFrame.LogicNs = 0;
+    sFrame.LogicTicks = 0;
+    sFrame.BuildNs = 0;
+    sFrame.InterpolationCount = 0;
+    sFrame.PresentIndex = 0;
+}
+
+void frame_pacing_begin_logic(void) {
+    sFrame.LogicStart = fixed_timestep_now();
+}
+
+void frame_pacing_end_logic(u32 ticks) {
+    sFrame.LogicNs += fixed_timestep_now() - sFrame.LogicStart;
+    sFrame.LogicTicks += ticks;
+}
+
+void frame_pacing_end_build(void) {
+    u64 elapsed = fixed_timestep_now() - sFrame.Start;
+    sFrame.BuildNs = (elapsed > sFrame.LogicNs) ? (elapsed - sFrame.LogicNs) : 0;
+}
+
+namespace FramePacing {
+
+void BeginInterpolation() {
+    sFrame.InterpolationStart = fixed_timestep_now();
+}
+
+void EndInterpolation() {
+    if (sFrame.InterpolationCount < kMaxPresentsPerFrame) {
+        sFrame.InterpolationNs[sFrame.InterpolationCount++] = fixed_timestep_now() - sFrame.InterpolationStart;
+    }
+}
+
+void Present() {
+    u64 now = fixed_timestep_now();
+    FramePacingSample sample;
+
+    sample.gameFrame = sFrame.GameFrame;
+    sample.logicTicks = sFrame.LogicTicks;
+    sample.logicNs = sFrame.LogicNs;
+    sample.buildNs = sFrame.BuildNs;
+    sample.interpolationNs =
+        (sFrame.PresentIndex < sFrame.InterpolationCount) ? sFrame.InterpolationNs[sFrame.PresentIndex] : 0;
+    sample.presentIntervalNs = (sFrame.LastPresent != 0) ? (now - sFrame.LastPresent) : 0;
+
+    sFrame.LastPresent = now;
+    sFrame.PresentIndex++;
+    Publish(sample);
+}
+
+/**
+ * Copies without locking. The write count is read again afterwards and any sample the game thread may have
+ * overwritten during the copy is dropped from the front.
+ */
+size_t GetRecentSamples(FramePacingSample* out, size_t count) {
+    uint64_t written = sWritten.load(std::memory_order_acquire);
+    count = std::min<uint64_t>({ (uint64_t) count, written, FRAME_PACING_CAPACITY });
+
+    uint64_t first = written - count;
+    for (size_t i = 0; i < count; i++) {
+        out[i] = sSamples[(first + i) % FRAME_PACING_CAPACITY];
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t after = sWritten.load(std::memory_order_relaxed);
+    // The slot of sample `after` may be mid-write, and it shares a slot with sample after - CAPACITY
+    uint64_t firstIntact = (after >= FRAME_PACING_CAPACITY) ? (after - FRAME_PACING_CAPACITY + 1) : 0;
+    if (first < firstIntact) {
+        size_t lost = (size_t) std::min<uint64_t>(firstIntact - first, count);
+        std::copy(out + lost, out + count, out);
+        count -= lost;
+    }
+    return count;
+}
+
+bool ExportCsv(const std::string& path, size_t count) {
+    std::vector<FramePacingSample> samples(std::min<size_t>(count, FRAME_PACING_CAPACITY));
+    samples.resize(GetRecentSamples(samples.data(), samples.size()));
+
+    FILE* file = fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        SPDLOG_ERROR("Could not write frame pacing capture to {}", path);
+        return false;
+    }
+
+    fprintf(file, "game_frame,logic_ticks,logic_ms,build_ms,interpolation_ms,present_interval_ms\n");
+    for (const FramePacingSample& sample : samples) {
+        fprintf(file, "%u,%u,%.4f,%.4f,%.4f,%.4f\n", sample.gameFrame, sample.logicTicks, ToMs(sample.logicNs),
+                ToMs(sample.buildNs), ToMs(sample.interpolationNs), ToMs(sample.presentIntervalNs));
+    }
+    fclose(file);
+    return true;
+}
+
+} // namespace FramePacing
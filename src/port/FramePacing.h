@@ -0,0 +1,54 @@
+#ifndef FRAME_PACING_H
+#define FRAME_PACING_H
+
+#include <libultraship.h>
+
+/**
+ * @brief Per present frame timings used to measure stutter.
+ *
+ * One game frame (logic ticks plus one display list) is presented one or more times when interpolation is on.
+ * Every present records a sample; presents of the same game frame share its logic and build times.
+ *
+ * Samples go into a fixed ring buffer written only by the game thread and published with a single atomic
+ * store, so recording takes no locks and stays on in release builds.
+ */
+
+#define FRAME_PACING_CAPACITY 4096
+
+typedef struct {
+    u32 gameFrame;
+    u32 logicTicks;
+    u64 logicNs;           // Game physics ticks run for this game frame
+    u64 buildNs;           // Display list build for this game frame, logic excluded
+    u64 interpolationNs;   // Matrix interpolation for this present
+    u64 presentIntervalNs; // Time since the previous present, 0 for the first one
+} FramePacingSample;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void frame_pacing_begin_frame(void);
+void frame_pacing_begin_logic(void);
+void frame_pacing_end_logic(u32 ticks);
+void frame_pacing_end_build(void);
+
+#ifdef __cplusplus
+}
+
+#include <string>
+
+namespace FramePacing {
+    // Called by the renderer; interpolation times are queued until the present they belong to
+    void BeginInterpolation();
+    void EndInterpolation();
+    void Present();
+
+    // Copies up to count of the newest samples into out, oldest first, and returns how many were copied.
+    // Safe from any thread.
+    size_t GetRecentSamples(FramePacingSample* out, size_t count);
+    bool ExportCsv(const std::string& path, size_t count);
+}
+#endif
+
+#endif // FRAME_PACING_H
@@ -1,4 +1,7 @@
 #include <libultraship.h>
+#include <atomic>
+#include <string>
+#include <unordered_map>
 
 #include "Engine.h"
 #include "DisplayList.h"
@@ -8,13 +11,94 @@ extern "C" {
 #include <align_asset_macro.h>
 }
 
+namespace {
+
+// Bumped whenever the same path may resolve to a different resource (alt assets, archive changes).
+std::atomic<uint32_t> sResolutionGeneration{ 1 };
+uint64_t sResolutionHits = 0;
+uint64_t sResolutionMisses = 0;
+
+// Each entry holds its resource alive, so a long session that streams many dynamic paths must not keep them all.
+constexpr size_t kResolutionCacheLimit = 4096;
+
+/**
+ * Remembers what an __OTR__ path resolved to, keyed by the address of the path string.
+ *
+ * Asset paths are almost always static strings, so the pointer identifies them. A copy of the string
+ * is kept to catch the rare dynamic path (e.g. a StaticMeshActor model) whose memory is reused for another path.
+ * Starts over once it holds kResolutionCacheLimit paths, which a course's static assets stay well below.
+ */
+class ResolutionCache {
+public:
+    template <typename Resolve> uintptr_t Get(const char* path, Resolve&& resolve) {
+        uint32_t generation = sResolutionGeneration.load(std::memory_order_relaxed);
+        if (mGeneration != generation) {
+            mEntries.clear();
+            mGeneration = generation;
+        }
+
+        auto it = mEntries.find(path);
+        if ((it != mEntries.end()) && (strcmp(it->second.Path.c_str(), path) == 0)) {
+            sResolutionHits++;
+            return it->second.Resolved;
+        }
+
+        sResolutionMisses++;
+        Entry entry;
+        entry.Path = path;
+        entry.Resolved = resolve(entry.Resource);
+        if (entry.Resolved == 0) {
+            // Missing resource, let the next call try again
+            return 0;
+        }
+        uintptr_t resolved = entry.Resolved;
+        if ((it == mEntries.end()) && (mEntries.size() >= kResolutionCacheLimit)) {
+            mEntries.clear();
+        }
+        mEntries[path] = std::move(entry);
+        return resolved;
+    }
+
+private:
+    struct Entry {
+        std::string Path;
+        uintptr_t Resolved = 0;
+        std::shared_ptr<Ship::IResource> Resource; // Keeps Resolved alive
+    };
+
+    std::unordered_map<const char*, Entry> mEntries;
+    uint32_t mGeneration = 0;
+};
+
+ResolutionCache sDisplayListCache;
+ResolutionCache sVertexCache;
+ResolutionCache sTexCache;
+
+} // namespace
+
+extern "C" void GameEngine_InvalidateResolutionCache(void) {
+    sResolutionGeneration.fetch_add(1, std::memory_order_relaxed);
+}
+
+extern "C" void GameEngine_GetResolutionCacheStats(uint64_t* hits, uint64_t* misses) {
+    *hits = sResolutionHits;
+    *misses = sResolutionMisses;
+}
+
+extern "C" void GameEngine_ResetResolutionCacheStats(void) {
+    sResolutionHits = 0;
+    sResolutionMisses = 0;
+}
+
 extern "C" void gSPDisplayList(Gfx* pkt, Gfx* dl) {
     char* imgData = (char*) dl;
 
     if (GameEngine_OTRSigCheck(imgData)) {
-        auto resource = Ship::Context::GetInstance()->GetResourceManager()->LoadResource(imgData);
-        auto res = std::static_pointer_cast<Fast::DisplayList>(resource);
-        dl = &res->Instructions[0];
+        dl = (Gfx*) sDisplayListCache.Get(imgData, [imgData](std::shared_ptr<Ship::IResource>& resource) {
+            resource = Ship::Context::GetInstance()->GetResourceManager()->LoadResource(imgData);
+            auto res = std::static_pointer_cast<Fast::DisplayList>(resource);
+            return reinterpret_cast<uintptr_t>(&res->Instructions[0]);
+        });
     }
 
     __gSPDisplayList(pkt, dl);
@@ -23,7 +107,11 @@ extern "C" void gSPDisplayList(Gfx* pkt, Gfx* dl) {
 extern "C" void gSPVertex(Gfx* pkt, uintptr_t v, int n, int v0) {
 
     if (GameEngine_OTRSigCheck((char*) v)) {
-        v = (uintptr_t) ResourceGetDataByName((char*) v);
+        const char* path = (const char*) v;
+        v = sVertexCache.Get(path, [path](std::shared_ptr<Ship::IResource>& resource) {
+            resource = Ship::Context::GetInstance()->GetResourceManager()->LoadResource(path);
+            return reinterpret_cast<uintptr_t>(ResourceGetDataByName(path));
+        });
     }
 
     __gSPVertex(pkt, v, n, v0);
@@ -37,16 +125,18 @@ extern "C" void gSPInvalidateTexCache(Gfx* pkt, uintptr_t texAddr) {
     auto data = reinterpret_cast<char*>(texAddr);
 
     if (texAddr != 0 && GameEngine_OTRSigCheck(data)) {
-        const auto res = Ship::Context::GetInstance()->GetResourceManager()->LoadResource(data);
-        const auto type = static_cast<Fast::ResourceType>(res->GetInitData()->Type);
-
-        if (res->GetInitData()->Type == static_cast<uint32_t>(Fast::ResourceType::DisplayList)) {
-            texAddr = reinterpret_cast<uintptr_t>(&std::static_pointer_cast<Fast::DisplayList>(res)->Instructions[0]);
-        } else if (res->GetInitData()->Type == static_cast<uint32_t>(MK64::ResourceType::MK_Array)) {
-            texAddr = reinterpret_cast<uintptr_t>(std::static_pointer_cast<MK64::Array>(res)->Vertices.data());
-        } else {
-            texAddr = reinterpret_cast<uintptr_t>(res->GetRawPointer());
-        }
+        texAddr = sTexCache.Get(data, [data](std::shared_ptr<Ship::IResource>& resource) -> uintptr_t {
+            const auto res = Ship::Context::GetInstance()->GetResourceManager()->LoadResource(data);
+            resource = res;
+
+            if (res->GetInitData()->Type == static_cast<uint32_t>(Fast::ResourceType::DisplayList)) {
+                return reinterpret_cast<uintptr_t>(&std::static_pointer_cast<Fast::DisplayList>(res)->Instructions[0]);
+            } else if (res->GetInitData()->Type == static_cast<uint32_t>(MK64::ResourceType::MK_Array)) {
+                return reinterpret_cast<uintptr_t>(std::static_pointer_cast<MK64::Array>(res)->Vertices.data());
+            } else {
+                return reinterpret_cast<uintptr_t>(res->GetRawPointer());
+            }
+        });
     }
 
     __gSPInvalidateTexCache(pkt, texAddr);
@@ -2,6 +2,7 @@
 
 #include "Game.h"
 #include "port/Engine.h"
+#include "port/pak.h"
 
 #include <graphic/Fast3D/Fast3dWindow.h>
 #include "engine/World.h"
@@ -36,6 +37,10 @@
 #include "engine/actors/BowserStatue.h"
 
 #include "engine/GarbageCollector.h"
+#include "engine/SaveState.h"
+#include "profiler.h"
+#include "engine/wasm.h"
+#include "port/Settings.h"
 
 #include "engine/TrainCrossing.h"
 #include "engine/objects/BombKart.h"
@@ -50,6 +55,10 @@
 #include "engine/editor/SceneManager.h"
 #include "engine/Rulesets.h"
 
+#ifdef BUILD_TESTS
+#include "GameTests.h"
+#endif
+
 #ifdef _WIN32
 #include <locale.h>
 #endif
@@ -62,7 +71,6 @@ extern "C" {
 #include "render_courses.h"
 #include "menus.h"
 #include "update_objects.h"
-// #include "engine/wasm.h"
 }
 
 extern "C" void Graphics_PushFrame(Gfx* data) {
@@ -91,52 +99,68 @@ Editor::Editor gEditor;
 
 s32 gTrophyIndex = NULL;
 
+static std::shared_ptr<Course> GetRegisteredCourse(const char* id) {
+    const std::shared_ptr<Course>* course = gCourseRegistry.Get(id);
+    if (course == nullptr) {
+        printf("[Game] Course %s is not registered\n", id);
+        return nullptr;
+    }
+    return *course;
+}
+
 void CustomEngineInit() {
-    /* Add all courses to the global course list */
-    std::shared_ptr<Course> mario         = gWorldInstance.AddCourse(std::make_shared<MarioRaceway>());
-    std::shared_ptr<Course> choco         = gWorldInstance.AddCourse(std::make_shared<ChocoMountain>());
-    std::shared_ptr<Course> bowser        = gWorldInstance.AddCourse(std::make_shared<BowsersCastle>());
-    std::shared_ptr<Course> banshee       = gWorldInstance.AddCourse(std::make_shared<BansheeBoardwalk>());
-    std::shared_ptr<Course> yoshi         = gWorldInstance.AddCourse(std::make_shared<YoshiValley>());
-    std::shared_ptr<Course> frappe        = gWorldInstance.AddCourse(std::make_shared<FrappeSnowland>());
-    std::shared_ptr<Course> koopa         = gWorldInstance.AddCourse(std::make_shared<KoopaTroopaBeach>());
-    std::shared_ptr<Course> royal         = gWorldInstance.AddCourse(std::make_shared<RoyalRaceway>());
-    std::shared_ptr<Course> luigi         = gWorldInstance.AddCourse(std::make_shared<LuigiRaceway>());
-    std::shared_ptr<Course> mooMoo        = gWorldInstance.AddCourse(std::make_shared<MooMooFarm>());
-    std::shared_ptr<Course> toads         = gWorldInstance.AddCourse(std::make_shared<ToadsTurnpike>());
-    std::shared_ptr<Course> kalimari      = gWorldInstance.AddCourse(std::make_shared<KalimariDesert>());
-    std::shared_ptr<Course> sherbet       = gWorldInstance.AddCourse(std::make_shared<SherbetLand>());
-    std::shared_ptr<Course> rainbow       = gWorldInstance.AddCourse(std::make_shared<RainbowRoad>());
-    std::shared_ptr<Course> wario         = gWorldInstance.AddCourse(std::make_shared<WarioStadium>());
-    std::shared_ptr<Course> block         = gWorldInstance.AddCourse(std::make_shared<BlockFort>());
-    std::shared_ptr<Course> skyscraper    = gWorldInstance.AddCourse(std::make_shared<Skyscraper>());
-    std::shared_ptr<Course> doubleDeck    = gWorldInstance.AddCourse(std::make_shared<DoubleDeck>());
-    std::shared_ptr<Course> dkJungle      = gWorldInstance.AddCourse(std::make_shared<DKJungle>());
-    std::shared_ptr<Course> bigDonut      = gWorldInstance.AddCourse(std::make_shared<BigDonut>());
-//    std::shared_ptr<Course> harbour       = gWorldInstance.AddCourse(std::make_shared<Harbour>());
-    std::shared_ptr<Course> testCourse    = gWorldInstance.AddCourse(std::make_shared<TestCourse>());
+    /* Add all courses to the global course list and the course registry */
+    gWorldInstance.AddCourse(std::make_shared<MarioRaceway>());
+    gWorldInstance.AddCourse(std::make_shared<ChocoMountain>());
+    gWorldInstance.AddCourse(std::make_shared<BowsersCastle>());
+    gWorldInstance.AddCourse(std::make_shared<BansheeBoardwalk>());
+    gWorldInstance.AddCourse(std::make_shared<YoshiValley>());
+    gWorldInstance.AddCourse(std::make_shared<FrappeSnowland>());
+    gWorldInstance.AddCourse(std::make_shared<KoopaTroopaBeach>());
+    gWorldInstance.AddCourse(std::make_shared<RoyalRaceway>());
+    gWorldInstance.AddCourse(std::make_shared<LuigiRaceway>());
+    gWorldInstance.AddCourse(std::make_shared<MooMooFarm>());
+    gWorldInstance.AddCourse(std::make_shared<ToadsTurnpike>());
+    gWorldInstance.AddCourse(std::make_shared<KalimariDesert>());
+    gWorldInstance.AddCourse(std::make_shared<SherbetLand>());
+    gWorldInstance.AddCourse(std::make_shared<RainbowRoad>());
+    gWorldInstance.AddCourse(std::make_shared<WarioStadium>());
+    gWorldInstance.AddCourse(std::make_shared<BlockFort>());
+    gWorldInstance.AddCourse(std::make_shared<Skyscraper>());
+    gWorldInstance.AddCourse(std::make_shared<DoubleDeck>());
+    gWorldInstance.AddCourse(std::make_shared<DKJungle>());
+    gWorldInstance.AddCourse(std::make_shared<BigDonut>());
+//    gWorldInstance.AddCourse(std::make_shared<Harbour>());
+    gWorldInstance.AddCourse(std::make_shared<TestCourse>());
+
+    AddStockContent();
 
     gPodiumCeremony = std::make_unique<PodiumCeremony>();
 
     // Construct cups with vectors of Course* (non-owning references)
     gMushroomCup = new Cup("mk:mushroom_cup", "Mushroom Cup", {
-        luigi, mooMoo, koopa, kalimari
+        GetRegisteredCourse("mk:luigi_raceway"), GetRegisteredCourse("mk:moo_moo_farm"),
+        GetRegisteredCourse("mk:koopa_beach"), GetRegisteredCourse("mk:kalimari_desert")
     });
 
     gFlowerCup = new Cup("mk:flower_cup", "Flower Cup", {
-        toads, frappe, choco, mario
+        GetRegisteredCourse("mk:toads_turnpike"), GetRegisteredCourse("mk:frappe_snowland"),
+        GetRegisteredCourse("mk:choco_mountain"), GetRegisteredCourse("mk:mario_raceway")
     });
 
     gStarCup = new Cup("mk:star_cup", "Star Cup", {
-        wario, sherbet, royal, bowser
+        GetRegisteredCourse("mk:wario_stadium"), GetRegisteredCourse("mk:sherbet_land"),
+        GetRegisteredCourse("mk:royal_raceway"), GetRegisteredCourse("mk:bowsers_castle")
     });
 
     gSpecialCup = new Cup("mk:special_cup", "Special Cup", {
-        dkJungle, yoshi, banshee, rainbow
+        GetRegisteredCourse("mk:dk_jungle"), GetRegisteredCourse("mk:yoshi_valley"),
+        GetRegisteredCourse("mk:banshee_boardwalk"), GetRegisteredCourse("mk:rainbow_road")
     });
 
     gBattleCup = new Cup("mk:battle_cup", "Battle Cup", {
-        bigDonut, block, doubleDeck, skyscraper
+        GetRegisteredCourse("mk:big_donut"), GetRegisteredCourse("mk:block_fort"),
+        GetRegisteredCourse("mk:double_deck"), GetRegisteredCourse("mk:skyscraper")
     });
 
     /* Instantiate Cups */
@@ -149,21 +173,20 @@ void CustomEngineInit() {
     //SelectMarioRaceway(); // This results in a nullptr
     SetMarioRaceway();
 
-    // ModelLoader::LoadModelList bowserStatueList = {
-    //     .course = gBowsersCastle,
-    //     .gfxBuffer = &gBowserStatueGfx[0],
-    //     .gfxBufferSize = 162,
-    //     .gfxStart = (0x2BB8 / 8), // 0x2BB8 / sizeof(OldGfx)
-    //     .vtxBuffer = &gBowserStatueVtx[0],
-    //     .vtxBufferSize = 717,
-    //     .vtxStart = 1942,
-    // };
+    ModelLoader::LoadModelList bowserStatueList = {
+        .course = GetRegisteredCourse("mk:bowsers_castle"),
+        .gfxBuffer = &gBowserStatueGfx[0],
+        .gfxBufferSize = 162,
+        .gfxStart = (0x2BB8 / 8), // 0x2BB8 / sizeof(OldGfx)
+        .vtxBuffer = &gBowserStatueVtx[0],
+        .vtxBufferSize = 717,
+        .vtxStart = 1942,
+    };
 
     // Model loader systems allows cutting pieces out of courses and making them actors.
-    // Commented out due to alleged stability issues.
-    // gModelLoader.Add(bowserStatueList);
+    gModelLoader.Add(bowserStatueList);
 
-    // gModelLoader.Load();
+    gModelLoader.Load();
 }
 
 void CustomEngineDestroy() {
@@ -172,6 +195,11 @@ void CustomEngineDestroy() {
     delete gStarCup;
     delete gSpecialCup;
     delete gBattleCup;
+
+    gCupRegistry.Clear();
+    gCourseRegistry.Clear();
+    gActorRegistry.Clear();
+    gObjectRegistry.Clear();
 }
 
 extern "C" {
@@ -237,18 +265,32 @@ const char* GetCupName(void) {
 }
 
 void LoadCourse() {
+    // A preload may be writing the geometry this load is about to use
+    gModelLoader.FinishPreload();
+
     if (gWorldInstance.CurrentCourse) {
         gRulesets.PreLoad();
         gWorldInstance.CurrentCourse->Load();
     }
 }
 
+void CM_PreloadCourse() {
+    gModelLoader.Preload(gWorldInstance.CurrentCourse);
+}
+
+void CM_PreloadNextCupCourse() {
+    Cup* cup = gWorldInstance.CurrentCup;
+    if ((cup != nullptr) && (cup->CursorPosition + 1 < cup->GetSize())) {
+        gModelLoader.Preload(cup->Courses[cup->CursorPosition + 1]);
+    }
+}
+
 size_t GetCourseIndex() {
     return gWorldInstance.CourseIndex;
 }
 
-void SetCourse(const char* name) {
-    gWorldInstance.SetCourse(name);
+void SetCourse(const char* id) {
+    gWorldInstance.SetCourse(id);
 }
 
 void NextCourse() {
@@ -362,6 +404,7 @@ void CM_RenderCredits() {
 }
 
 void CM_TickActors() {
+    TRACE_ZONE("TickActors");
     if (gWorldInstance.CurrentCourse) {
         gWorldInstance.TickActors();
     }
@@ -397,6 +440,7 @@ void CM_BeginPlay() {
 }
 
 void CM_TickObjects() {
+    TRACE_ZONE("TickObjects");
     if (gWorldInstance.CurrentCourse) {
         gWorldInstance.TickObjects();
     }
@@ -615,34 +659,51 @@ void* GetCourse(void) {
     return gWorldInstance.CurrentCourse.get();
 }
 
+/**
+ * Stands in for actors the garbage collector already reclaimed. C code keeps actor indices around (parentIndex,
+ * bananaIndices, ...) and expects a destroyed actor to read back as an empty slot, the way gActorList did.
+ */
+static Actor sReclaimedActor;
+
 struct Actor* CM_GetActor(size_t index) {
     if (index < gWorldInstance.Actors.size()) {
-        AActor* actor = gWorldInstance.Actors[index];
-        return reinterpret_cast<struct Actor*>(reinterpret_cast<char*>(actor) + sizeof(void*));
-    } else {
-        // throw std::runtime_error("GetActor() index out of bounds");
+        return gWorldInstance.ConvertAActorToActor(gWorldInstance.Actors[index]);
+    }
+    // Writes through a stale index must not stick
+    sReclaimedActor = {};
+    return &sReclaimedActor;
+}
+
+ActorHandle CM_GetActorHandle(struct Actor* actor) {
+    if ((actor == NULL) || (actor == &sReclaimedActor)) {
+        return ACTOR_HANDLE_NONE;
+    }
+    return gWorldInstance.ConvertActorToAActor(actor)->Handle;
+}
+
+struct Actor* CM_ResolveActorHandle(ActorHandle handle) {
+    AActor* actor = gWorldInstance.ResolveActorHandle(handle);
+    if (actor == nullptr) {
         return NULL;
     }
+    return gWorldInstance.ConvertAActorToActor(actor);
 }
 
 size_t CM_FindActorIndex(Actor* actor) {
-    // Move the ptr back to look at the vtable.
-    // This gets us the proper C++ class instead of just the variables used in C.
-    AActor* a = reinterpret_cast<AActor*>(reinterpret_cast<char*>(actor) - sizeof(void*));
-    auto actors = gWorldInstance.Actors;
-
-    auto it = std::find(actors.begin(), actors.end(), static_cast<AActor*>(a));
-    if (it != actors.end()) {
-        return std::distance(actors.begin(), it);
+    ActorHandle handle = CM_GetActorHandle(actor);
+    if (gWorldInstance.ResolveActorHandle(handle) == nullptr) {
+        printf("FindActorIndex() actor not found\n");
+        return -1;
     }
-    printf("FindActorIndex() actor not found\n");
-    return -1;
+    return ACTOR_HANDLE_INDEX(handle);
 }
 
+/**
+ * Marks the actor for the garbage collector, which frees it once no live actor sits after it.
+ */
 void CM_DeleteActor(size_t index) {
-    std::vector<AActor*> actors = gWorldInstance.Actors;
-    if (index < actors.size()) {
-        actors.erase(actors.begin() + index);
+    if (index < gWorldInstance.Actors.size()) {
+        gWorldInstance.Actors[index]->bPendingDestroy = true;
     }
 }
 
@@ -667,17 +728,37 @@ void CM_CleanWorld(void) {
         delete actor;
     }
 
+    // Save states taken in this world cannot be restored into the next one.
+    for (auto& actor : world->DeadActors) {
+        delete actor;
+    }
+
+    for (auto& object : world->DeadObjects) {
+        delete object;
+    }
+
+    for (auto& emitter : world->DeadEmitters) {
+        delete emitter;
+    }
+    world->DeadActors.clear();
+    world->DeadObjects.clear();
+    world->DeadEmitters.clear();
+    world->StateRefs.clear();
+    world->StateSession++;
+
     for (size_t i = 0; i < ARRAY_COUNT(gWorldInstance.playerBombKart); i++) {
         gWorldInstance.playerBombKart[i].state = PlayerBombKart::PlayerBombKartState::DISABLED;
         gWorldInstance.playerBombKart[i]._primAlpha = 0;
     }
 
     gEditor.ClearObjects();
+    gWorldInstance.ReleaseActorSlots(0);
     gWorldInstance.Actors.clear();
     gWorldInstance.StaticMeshActors.clear();
     gWorldInstance.Objects.clear();
     gWorldInstance.Emitters.clear();
     gWorldInstance.Lakitus.clear();
+    gWorldInstance.InvalidateSchedule();
     gWorldInstance.Reset();
 }
 
@@ -704,9 +785,9 @@ size_t CM_GetActorSize() {
 }
 
 void CM_ActorCollision(Player* player, Actor* actor) {
-    AActor* a = gWorldInstance.ConvertActorToAActor(actor);
+    AActor* a = gWorldInstance.ResolveActorHandle(CM_GetActorHandle(actor));
 
-    if (a->IsMod()) {
+    if ((a != nullptr) && a->IsMod()) {
         a->Collision(player, a);
     }
 }
@@ -786,9 +867,96 @@ void* GetBattleCup(void) {
 void CM_RunGarbageCollector(void) {
     RunGarbageCollector();
 }
+
+static s32 sDeterminismCheckTicks = 0;
+static bool sCheckingDeterminism = false;
+
+void CM_RequestDeterminismCheck(s32 ticks) {
+    sDeterminismCheckTicks = ticks;
+}
+
+/**
+ * Simulates @p ticks ticks twice from the same save state and compares the state hashes. The garbage collector
+ * runs after every tick like it does at the end of a frame. The race is rewound to where it was afterwards so
+ * the check is invisible to the player. Returns true when both runs ended in the same state.
+ */
+bool CM_CheckDeterminism(s32 ticks) {
+    SaveState start;
+    SaveState result;
+    start.Capture();
+
+    uint64_t hashes[2];
+    for (size_t run = 0; run < 2; run++) {
+        if (!start.Restore()) {
+            printf("[SaveState] Determinism check aborted: could not restore the start state\n");
+            sCheckingDeterminism = false;
+            return false;
+        }
+        sCheckingDeterminism = true;
+        for (s32 i = 0; i < ticks; i++) {
+            process_game_tick();
+            RunGarbageCollector();
+        }
+        result.Capture();
+        hashes[run] = result.Hash();
+        // Let the entities spawned by this run be freed rather than buried.
+        result.Clear();
+    }
+    sCheckingDeterminism = false;
+    if (!start.Restore()) {
+        printf("[SaveState] Determinism check could not rewind the race; it continues from the second run\n");
+    }
+
+    printf("[SaveState] Determinism check over %d ticks (%zu byte state): %016llx / %016llx %s\n", ticks,
+           start.GetSize(), (unsigned long long) hashes[0], (unsigned long long) hashes[1],
+           (hashes[0] == hashes[1]) ? "OK" : "MISMATCH");
+    return hashes[0] == hashes[1];
+}
+
+bool CM_IsCheckingDeterminism(void) {
+    return sCheckingDeterminism;
+}
+
+void CM_RunDeterminismCheck(void) {
+    if (sDeterminismCheckTicks <= 0) {
+        return;
+    }
+    s32 ticks = sDeterminismCheckTicks;
+    sDeterminismCheckTicks = 0;
+    CM_CheckDeterminism(ticks);
+}
+
+size_t CM_CaptureState(u8** outData) {
+    std::vector<uint8_t> buffer;
+    SaveState::CaptureBuffer(buffer);
+    *outData = (u8*) malloc(buffer.size());
+    if (*outData == nullptr) {
+        SaveState::ReleaseBuffer(buffer.data(), buffer.size());
+        return 0;
+    }
+    memcpy(*outData, buffer.data(), buffer.size());
+    return buffer.size();
+}
+
+bool CM_RestoreState(const u8* data, size_t size) {
+    return SaveState::RestoreBuffer(data, size);
+}
+
+bool CM_RetainState(const u8* data, size_t size) {
+    return SaveState::RetainBuffer(data, size);
+}
+
+void CM_ReleaseState(const u8* data, size_t size) {
+    SaveState::ReleaseBuffer(data, size);
+}
+
+bool CM_IsStateCurrent(const u8* data, size_t size) {
+    return SaveState::IsBufferCurrent(data, size);
+}
 }
 
 void push_frame() {
+    TRACE_ZONE("Frame");
     GameEngine::StartAudioFrame();
     GameEngine::Instance->StartFrame();
     thread5_iteration();
@@ -811,12 +979,37 @@ extern "C"
     // Allow non-ascii characters for Windows
     setlocale(LC_ALL, ".UTF8");
 #endif
-    // load_wasm();
+    trace_set_thread_name("Game");
+    // --trace <path> records the whole session, for headless and scripted runs.
+    const char* tracePath = nullptr;
+    for (int i = 1; i < argc - 1; i++) {
+        if (strcmp(argv[i], "--trace") == 0) {
+            tracePath = argv[i + 1];
+            trace_capture_start();
+        }
+    }
+#ifdef BUILD_TESTS
+    // --run-test <name> runs one of the in-game tests instead of the interactive loop.
+    // --record-golden makes it rewrite its golden files instead of checking them.
+    const char* testName = nullptr;
+    bool recordGolden = false;
+    for (int i = 1; i < argc; i++) {
+        if ((strcmp(argv[i], "--run-test") == 0) && (i < argc - 1)) {
+            testName = argv[i + 1];
+        }
+        if (strcmp(argv[i], "--record-golden") == 0) {
+            recordGolden = true;
+        }
+    }
+#endif
+
     GameEngine::Create();
+    Settings_Refresh();
     audio_init();
     sound_init();
 
     CustomEngineInit();
+    load_wasm();
 
     switch(CVarGetInteger("gSkipIntro", 0)) {
         case 0:
@@ -840,11 +1033,24 @@ extern "C"
 
     thread5_game_loop();
     gEditor.Load();
-    while (WindowIsRunning()) {
+    int exitCode = 0;
+    bool interactive = true;
+#ifdef BUILD_TESTS
+    if (testName != nullptr) {
+        exitCode = RunGameTest(testName, recordGolden);
+        interactive = false;
+    }
+#endif
+    while (interactive && WindowIsRunning()) {
         push_frame();
     }
+    if (tracePath != nullptr) {
+        trace_capture_stop(tracePath);
+    }
+    ControllerPak_Shutdown();
+    unload_wasm();
     CustomEngineDestroy();
     // GameEngine::Instance->ProcessFrame(push_frame);
     GameEngine::Instance->Destroy();
-    return 0;
+    return exitCode;
 }
@@ -12,6 +12,7 @@ extern "C" {
 #endif
 #include "camera.h"
 #include "actor_types.h"
+#include "engine/ActorHandle.h"
 
 extern s32 gTrophyIndex;
 
@@ -42,9 +43,13 @@ const char* GetCupName(void);
 
 void LoadCourse();
 
+void CM_PreloadCourse();
+
+void CM_PreloadNextCupCourse();
+
 size_t GetCourseIndex();
 
-void SetCourse(const char* name);
+void SetCourse(const char* id);
 
 void NextCourse();
 void PreviousCourse();
@@ -152,6 +157,8 @@ void CM_AddEditorObject(struct Actor* actor, const char* name);
 void Editor_AddLight(s8* direction);
 size_t CM_GetActorSize();
 size_t CM_FindActorIndex(struct Actor* actor);
+ActorHandle CM_GetActorHandle(struct Actor* actor);
+struct Actor* CM_ResolveActorHandle(ActorHandle handle);
 void CM_ActorCollision(Player* player, struct Actor* actor);
 void CM_CleanWorld(void);
 
@@ -215,6 +222,25 @@ void* GetCup();
 
 void CM_RunGarbageCollector(void);
 
+void CM_RequestDeterminismCheck(s32 ticks);
+void CM_RunDeterminismCheck(void);
+bool CM_CheckDeterminism(s32 ticks);
+/**
+ * True while CM_CheckDeterminism simulates. WebAssembly mods sit it out: their memory is not part of a save
+ * state and their wall clock budget decides which of them get to tick.
+ */
+bool CM_IsCheckingDeterminism(void);
+
+/**
+ * Save states for C code, see SaveState. CM_CaptureState mallocs the buffer, which holds its entities until
+ * CM_ReleaseState. CM_RetainState makes a copy of a buffer hold them too and fails if it can't be restored.
+ */
+size_t CM_CaptureState(u8** outData);
+bool CM_RestoreState(const u8* data, size_t size);
+bool CM_RetainState(const u8* data, size_t size);
+void CM_ReleaseState(const u8* data, size_t size);
+bool CM_IsStateCurrent(const u8* data, size_t size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,185 @@
+#include <cstdio>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "PakJournal.h"
+
+#define JOURNAL_MAGIC 0x4A504B4D // "MKPJ"
+#define JOURNAL_COMMIT 0x454E4F44 // "DONE"
+#define JOURNAL_VERSION 1
+
+static uint32_t Pak_Checksum(const uint8_t* data, size_t size) {
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * Pushes a written file past the OS cache. fflush only hands it to the OS, which may still lose it in a power cut.
+ */
+static bool Pak_SyncFile(FILE* file) {
+#ifdef _WIN32
+    // _commit is FlushFileBuffers on the file's handle
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+bool Pak_ReadWholeFile(const char* path, std::vector<uint8_t>& out) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    out.resize(size > 0 ? size : 0);
+    size_t read = out.empty() ? 0 : fread(out.data(), 1, out.size(), file);
+    fclose(file);
+    out.resize(read);
+    return true;
+}
+
+bool Pak_WriteWholeFile(const char* path, const std::vector<uint8_t>& data) {
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+
+    size_t written = data.empty() ? 0 : fwrite(data.data(), 1, data.size(), file);
+    bool ok = (written == data.size()) && (fflush(file) == 0) && Pak_SyncFile(file);
+    fclose(file);
+    return ok;
+}
+
+static void Journal_Put32(std::vector<uint8_t>& out, uint32_t value) {
+    uint8_t bytes[4] = { (uint8_t) value, (uint8_t) (value >> 8), (uint8_t) (value >> 16), (uint8_t) (value >> 24) };
+    out.insert(out.end(), bytes, bytes + 4);
+}
+
+static bool Journal_Get32(const std::vector<uint8_t>& in, size_t& pos, uint32_t* value) {
+    if (pos + 4 > in.size()) {
+        return false;
+    }
+    *value = in[pos] | (in[pos + 1] << 8) | (in[pos + 2] << 16) | ((uint32_t) in[pos + 3] << 24);
+    pos += 4;
+    return true;
+}
+
+/**
+ * Layout: magic, version, entry count, then per entry: path length, path, remove flag, data size, data.
+ * Closed by a checksum over everything before it and the commit marker.
+ */
+std::vector<uint8_t> Journal_Serialize(const std::vector<JournalEntry>& entries) {
+    std::vector<uint8_t> out;
+
+    Journal_Put32(out, JOURNAL_MAGIC);
+    Journal_Put32(out, JOURNAL_VERSION);
+    Journal_Put32(out, entries.size());
+    for (const auto& entry : entries) {
+        Journal_Put32(out, entry.path.size());
+        out.insert(out.end(), entry.path.begin(), entry.path.end());
+        Journal_Put32(out, entry.remove);
+        Journal_Put32(out, entry.data.size());
+        out.insert(out.end(), entry.data.begin(), entry.data.end());
+    }
+    Journal_Put32(out, Pak_Checksum(out.data(), out.size()));
+    Journal_Put32(out, JOURNAL_COMMIT);
+    return out;
+}
+
+/**
+ * Returns false for a torn or otherwise incomplete journal; those were never committed and must be ignored.
+ */
+bool Journal_Parse(const std::vector<uint8_t>& in, std::vector<JournalEntry>& entries) {
+    size_t pos = 0;
+    uint32_t magic, version, count, checksum, commit;
+
+    if (in.size() < 20) {
+        return false;
+    }
+
+    size_t body = in.size() - 8;
+    pos = body;
+    Journal_Get32(in, pos, &checksum);
+    Journal_Get32(in, pos, &commit);
+    if ((commit != JOURNAL_COMMIT) || (checksum != Pak_Checksum(in.data(), body))) {
+        return false;
+    }
+
+    pos = 0;
+    Journal_Get32(in, pos, &magic);
+    Journal_Get32(in, pos, &version);
+    Journal_Get32(in, pos, &count);
+    if ((magic != JOURNAL_MAGIC) || (version != JOURNAL_VERSION)) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        JournalEntry entry;
+        uint32_t pathSize, remove, dataSize;
+
+        if (!Journal_Get32(in, pos, &pathSize) || (pos + pathSize > body)) {
+            return false;
+        }
+        entry.path.assign((const char*) &in[pos], pathSize);
+        pos += pathSize;
+
+        if (!Journal_Get32(in, pos, &remove) || !Journal_Get32(in, pos, &dataSize) || (pos + dataSize > body)) {
+            return false;
+        }
+        entry.remove = remove != 0;
+        entry.data.assign(in.begin() + pos, in.begin() + pos + dataSize);
+        pos += dataSize;
+
+        entries.push_back(std::move(entry));
+    }
+
+    return pos == body;
+}
+
+/**
+ * Rewrites the real pak files from committed journal entries. Safe to repeat after a crash.
+ */
+bool Journal_Apply(const std::vector<JournalEntry>& entries) {
+    bool ok = true;
+
+    for (const auto& entry : entries) {
+        if (entry.remove) {
+            remove(entry.path.c_str());
+        } else if (!Pak_WriteWholeFile(entry.path.c_str(), entry.data)) {
+            printf("[ControllerPak] Failed to write %s\n", entry.path.c_str());
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+void Journal_Recover(const char* path) {
+    std::vector<uint8_t> journal;
+    std::vector<JournalEntry> entries;
+
+    if (!Pak_ReadWholeFile(path, journal)) {
+        return;
+    }
+
+    if (Journal_Parse(journal, entries)) {
+        printf("[ControllerPak] Replaying %zu journaled writes from an interrupted save\n", entries.size());
+        if (!Journal_Apply(entries)) {
+            return; // Keep the journal so the next start can try again
+        }
+    } else {
+        printf("[ControllerPak] Discarding incomplete journal, the previous save is kept\n");
+    }
+    remove(path);
+}
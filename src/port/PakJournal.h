@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One file write or removal carried by the controller pak journal.
+ */
+typedef struct JournalEntry {
+    std::string path;
+    bool remove;
+    std::vector<uint8_t> data;
+} JournalEntry;
+
+/**
+ * The crash safe half of the controller pak save (see pak.cpp). A flush writes every changed file into one journal
+ * closed by a checksum and a commit marker, syncs it, then rewrites the real files from it and deletes it.
+ *
+ * Kept free of the game so tests/PakJournalTest.cpp can cut the journal at every offset.
+ */
+
+bool Pak_ReadWholeFile(const char* path, std::vector<uint8_t>& out);
+/** @brief Writes the file and syncs it to disk before returning. */
+bool Pak_WriteWholeFile(const char* path, const std::vector<uint8_t>& data);
+
+std::vector<uint8_t> Journal_Serialize(const std::vector<JournalEntry>& entries);
+bool Journal_Parse(const std::vector<uint8_t>& in, std::vector<JournalEntry>& entries);
+bool Journal_Apply(const std::vector<JournalEntry>& entries);
+
+/**
+ * @brief Finishes or discards a flush that was interrupted by a crash, leaving either the old or the new files.
+ */
+void Journal_Recover(const char* path);
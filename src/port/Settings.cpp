@@ -0,0 +1,63 @@
+#include "Settings.h"
+
+#include <atomic>
+
+// The GUI marks the snapshot dirty while a window that can set CVars is open. Anything else that sets them
+// without telling us (config reloads) is picked up by polling at a low rate.
+#define SETTINGS_POLL_INTERVAL 60
+
+GameSettings gSettings = {
+    0,
+#define GAME_SETTINGS_DEFAULT(field, cvar, defaultValue) defaultValue,
+    GAME_SETTINGS_INT(GAME_SETTINGS_DEFAULT)
+    GAME_SETTINGS_FLOAT(GAME_SETTINGS_DEFAULT)
+#undef GAME_SETTINGS_DEFAULT
+};
+
+static std::atomic<bool> sSettingsDirty = true;
+static u32 sFramesSincePoll = 0;
+static std::atomic<f32> sVolumes[SETTINGS_VOLUME_COUNT] = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+extern "C" void Settings_Refresh(void) {
+    bool changed = false;
+
+#define GAME_SETTINGS_READ_INT(field, cvar, defaultValue)         \
+    {                                                             \
+        s32 value = CVarGetInteger(cvar, defaultValue);           \
+        changed |= (gSettings.field != value);                    \
+        gSettings.field = value;                                  \
+    }
+#define GAME_SETTINGS_READ_FLOAT(field, cvar, defaultValue)       \
+    {                                                             \
+        f32 value = CVarGetFloat(cvar, defaultValue);             \
+        changed |= (gSettings.field != value);                    \
+        gSettings.field = value;                                  \
+    }
+    GAME_SETTINGS_INT(GAME_SETTINGS_READ_INT)
+    GAME_SETTINGS_FLOAT(GAME_SETTINGS_READ_FLOAT)
+#undef GAME_SETTINGS_READ_INT
+#undef GAME_SETTINGS_READ_FLOAT
+
+    if (changed) {
+        gSettings.version++;
+    }
+    sVolumes[SETTINGS_VOLUME_MASTER].store(gSettings.gameMasterVolume, std::memory_order_relaxed);
+    sVolumes[SETTINGS_VOLUME_MUSIC].store(gSettings.mainMusicVolume, std::memory_order_relaxed);
+    sVolumes[SETTINGS_VOLUME_SFX].store(gSettings.sfxMusicVolume, std::memory_order_relaxed);
+    sVolumes[SETTINGS_VOLUME_ENVIRONMENT].store(gSettings.environmentVolume, std::memory_order_relaxed);
+    sFramesSincePoll = 0;
+}
+
+extern "C" void Settings_MarkDirty(void) {
+    sSettingsDirty.store(true, std::memory_order_release);
+}
+
+extern "C" void Settings_Update(void) {
+    if (sSettingsDirty.exchange(false, std::memory_order_acq_rel) || (++sFramesSincePoll >= SETTINGS_POLL_INTERVAL)) {
+        Settings_Refresh();
+    }
+}
+
+extern "C" f32 Settings_GetVolume(SettingsVolume volume) {
+    return sVolumes[volume].load(std::memory_order_relaxed);
+}
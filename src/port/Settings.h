@@ -0,0 +1,92 @@
+#ifndef SETTINGS_H
+#define SETTINGS_H
+
+#include <libultraship.h>
+
+/**
+ * Typed snapshot of the CVars read by the game code.
+ *
+ * Game code reads gSettings.<field> instead of doing a string keyed CVar lookup in
+ * per-actor tick and render functions. The snapshot is refreshed once per frame when
+ * a CVar setter reports a change through Settings_MarkDirty(), every frame while the
+ * menu, the console or another GUI window is open, and periodically to pick up config
+ * reloads. gSettings.version is incremented every time a
+ * refresh changes at least one value, so code can cache derived state and compare a
+ * single integer to find out if it is stale.
+ *
+ * To add a setting, add a line to one of the lists below: X(field, "cvarName", default)
+ */
+#define GAME_SETTINGS_INT(X)                                         \
+    X(noCulling, "gNoCulling", 0)                                    \
+    X(disableLod, "gDisableLod", 1)                                  \
+    X(enableDebugMode, "gEnableDebugMode", 0)                        \
+    X(freecam, "gFreecam", 0)                                        \
+    X(harderCPU, "gHarderCPU", 0)                                    \
+    X(noWallCollision, "gNoWallColision", 0)                         \
+    X(enableCustomCC, "gEnableCustomCC", 0)                          \
+    X(disableItemboxes, "gDisableItemboxes", 0)                      \
+    X(disableRubberbanding, "gDisableRubberbanding", 0)              \
+    X(enableMoonJump, "gEnableMoonJump", 0)                          \
+    X(enableDigitalSpeedometer, "gEnableDigitalSpeedometer", 0)      \
+    X(showSpaghettiVersion, "gShowSpaghettiVersion", 1)              \
+    X(betterResultPortraits, "gBetterResultPortraits", 0)            \
+    X(controllerPakScreen, "gControllerPakScreen", 0)                \
+    X(renderCollisionMesh, "gRenderCollisionMesh", 0)                \
+    X(editorEnabled, "gEditorEnabled", 0)
+
+#define GAME_SETTINGS_FLOAT(X)                                       \
+    X(customCC, "gCustomCC", 150.0f)                                 \
+    X(minHeight, "gMinHeight", 0.0f)                                 \
+    X(farFrustrum, "gFarFrustrum", 10000.0f)                         \
+    X(gameMasterVolume, "gGameMasterVolume", 1.0f)                   \
+    X(mainMusicVolume, "gMainMusicVolume", 1.0f)                     \
+    X(sfxMusicVolume, "gSFXMusicVolume", 1.0f)                       \
+    X(environmentVolume, "gEnvironmentVolume", 1.0f)
+
+#define GAME_SETTINGS_DECLARE_INT(field, cvar, defaultValue) s32 field;
+#define GAME_SETTINGS_DECLARE_FLOAT(field, cvar, defaultValue) f32 field;
+
+typedef struct {
+    u32 version;
+    GAME_SETTINGS_INT(GAME_SETTINGS_DECLARE_INT)
+    GAME_SETTINGS_FLOAT(GAME_SETTINGS_DECLARE_FLOAT)
+} GameSettings;
+
+#undef GAME_SETTINGS_DECLARE_INT
+#undef GAME_SETTINGS_DECLARE_FLOAT
+
+/** @brief Volumes published for the audio thread, see Settings_GetVolume(). */
+typedef enum {
+    SETTINGS_VOLUME_MASTER,
+    SETTINGS_VOLUME_MUSIC,
+    SETTINGS_VOLUME_SFX,
+    SETTINGS_VOLUME_ENVIRONMENT,
+    SETTINGS_VOLUME_COUNT
+} SettingsVolume;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern GameSettings gSettings;
+
+/** @brief Reads every setting from its CVar. Bumps gSettings.version if anything changed. */
+void Settings_Refresh(void);
+
+/** @brief Change notification for CVar setters. The snapshot is refreshed on the next Settings_Update(). */
+void Settings_MarkDirty(void);
+
+/** @brief Called once per frame before the game tick. Refreshes the snapshot if it was marked dirty. */
+void Settings_Update(void);
+
+/**
+ * @brief Thread safe copy of a volume setting. gSettings is only safe to read on the game thread, the audio
+ * thread uses this instead.
+ */
+f32 Settings_GetVolume(SettingsVolume volume);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SETTINGS_H
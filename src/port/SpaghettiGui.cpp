@@ -1,5 +1,6 @@
 #include <libultraship.h>
 #include "SpaghettiGui.h"
+#include "Settings.h"
 #include <libultraship/src/window/gui/Gui.h>
 #include <libultraship/src/window/Window.h>
 #ifdef __SWITCH__
@@ -152,9 +153,16 @@ namespace Ship {
             GetMenu()->Draw();
         }
 
+        // The menu, the console and the other windows set CVars without going through Settings_MarkDirty(), so
+        // refresh the settings snapshot every frame while any of them is open.
+        bool canSetCVars = GetMenuOrMenubarVisible();
         for (auto& windowIter : mGuiWindows) {
             windowIter.second->Update();
             windowIter.second->Draw();
+            canSetCVars |= windowIter.second->IsVisible();
+        }
+        if (canSetCVars) {
+            Settings_MarkDirty();
         }
 
         ImGui::End();
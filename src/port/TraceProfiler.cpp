@@ -0,0 +1,166 @@
+#include <libultraship.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "profiler.h"
+
+s32 gTraceCaptureActive = 0;
+
+namespace {
+
+// Bounds memory use if a capture is left running; roughly 24 MB per thread.
+constexpr size_t kMaxEventsPerThread = 1 << 20;
+
+struct TraceEvent {
+    const char* Name;
+    int64_t Start;
+    int64_t Duration;
+};
+
+struct TraceThread {
+    std::mutex Mutex;
+    uint32_t Id = 0;
+    std::string Name;
+    uint32_t Generation = 0;
+    std::vector<TraceEvent> Open;
+    std::vector<TraceEvent> Events;
+};
+
+std::mutex sThreadsMutex;
+// Shared so a thread exiting mid-capture does not take its events with it.
+std::vector<std::shared_ptr<TraceThread>> sThreads;
+std::atomic<uint32_t> sGeneration{ 1 };
+int64_t sCaptureStart = 0;
+
+int64_t Now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+TraceThread* GetThread() {
+    thread_local std::shared_ptr<TraceThread> sThread;
+
+    if (sThread == nullptr) {
+        sThread = std::make_shared<TraceThread>();
+        std::lock_guard<std::mutex> lock(sThreadsMutex);
+        sThread->Id = (uint32_t) sThreads.size();
+        sThread->Name = "Thread " + std::to_string(sThread->Id);
+        sThreads.push_back(sThread);
+    }
+    return sThread.get();
+}
+
+// Zones left open by a previous capture are dropped instead of closing zones from the new one.
+void SyncGeneration(TraceThread* thread) {
+    uint32_t generation = sGeneration.load(std::memory_order_relaxed);
+    if (thread->Generation != generation) {
+        thread->Generation = generation;
+        thread->Open.clear();
+    }
+}
+
+void WriteEscaped(FILE* file, const char* str) {
+    for (; *str != '\0'; str++) {
+        if ((*str == '"') || (*str == '\\')) {
+            fputc('\\', file);
+        }
+        fputc(*str, file);
+    }
+}
+
+} // namespace
+
+void trace_zone_begin(const char* name) {
+    TraceThread* thread = GetThread();
+    int64_t start = Now();
+
+    std::lock_guard<std::mutex> lock(thread->Mutex);
+    SyncGeneration(thread);
+    thread->Open.push_back({ name, start, 0 });
+}
+
+void trace_zone_end(void) {
+    int64_t end = Now();
+    TraceThread* thread = GetThread();
+
+    std::lock_guard<std::mutex> lock(thread->Mutex);
+    SyncGeneration(thread);
+    if (thread->Open.empty()) {
+        // Zone was opened before the capture started.
+        return;
+    }
+
+    TraceEvent event = thread->Open.back();
+    thread->Open.pop_back();
+    event.Duration = end - event.Start;
+
+    if (gTraceCaptureActive && (thread->Events.size() < kMaxEventsPerThread)) {
+        thread->Events.push_back(event);
+    }
+}
+
+void trace_set_thread_name(const char* name) {
+    TraceThread* thread = GetThread();
+    std::lock_guard<std::mutex> lock(thread->Mutex);
+    thread->Name = name;
+}
+
+void trace_capture_start(void) {
+    std::lock_guard<std::mutex> lock(sThreadsMutex);
+    for (auto& thread : sThreads) {
+        std::lock_guard<std::mutex> threadLock(thread->Mutex);
+        thread->Events.clear();
+    }
+    sGeneration.fetch_add(1, std::memory_order_relaxed);
+    sCaptureStart = Now();
+    gTraceCaptureActive = 1;
+}
+
+/**
+ * Stops the capture and writes it to path. Returns 1 on success.
+ */
+s32 trace_capture_stop(const char* path) {
+    gTraceCaptureActive = 0;
+
+    FILE* file = fopen(path, "wb");
+    if (file == nullptr) {
+        printf("[Profiler] Could not open %s for writing\n", path);
+        return 0;
+    }
+
+    size_t eventCount = 0;
+    bool first = true;
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    std::lock_guard<std::mutex> lock(sThreadsMutex);
+    for (auto& thread : sThreads) {
+        std::lock_guard<std::mutex> threadLock(thread->Mutex);
+
+        fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"",
+                first ? "" : ",\n", thread->Id);
+        WriteEscaped(file, thread->Name.c_str());
+        fprintf(file, "\"}}");
+        first = false;
+
+        for (const auto& event : thread->Events) {
+            fprintf(file, ",\n{\"name\":\"");
+            WriteEscaped(file, event.Name);
+            fprintf(file, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", thread->Id,
+                    (double) (event.Start - sCaptureStart) / 1000.0, (double) event.Duration / 1000.0);
+        }
+        eventCount += thread->Events.size();
+        thread->Events.clear();
+        thread->Events.shrink_to_fit();
+    }
+
+    fprintf(file, "\n]}\n");
+    fclose(file);
+    printf("[Profiler] Wrote %zu trace events to %s\n", eventCount, path);
+    return 1;
+}
@@ -1,5 +1,6 @@
 #include <libultraship/bridge.h>
 
+#include <algorithm>
 #include <vector>
 #include <map>
 #include <unordered_map>
@@ -259,6 +260,10 @@ uint32_t camera_epoch;
 uint32_t previous_camera_epoch;
 Recording current_recording;
 Recording previous_recording;
+// Logic ticks between the two recordings, 0 when they are one game frame apart, and the scheduler alphas after them
+uint32_t tick_span;
+float tick_alpha;
+float previous_tick_alpha = 1.0f;
 
 bool next_is_actor_pos_rot_matrix;
 bool has_inv_actor_mtx;
@@ -611,6 +616,27 @@ unordered_map<Mtx*, MtxF> FrameInterpolation_Interpolate(float step) {
     return ctx.mtx_replacements;
 }
 
+/**
+ * Maps how far a present is through the game frame, from 0 to 1, to the step between the two recordings.
+ * When the frame ran fixed ticks it is drawn one tick behind the scheduler's clock, alpha of the way between its last
+ * two ticks, so frames that ran a different number of ticks still move at a steady speed.
+ */
+float FrameInterpolation_GetTickStep(float t) {
+    if (tick_span == 0) {
+        return t;
+    }
+    // The previous frame was drawn up to its own alpha, which sits before the previous recording
+    float start = -(1.0f - previous_tick_alpha) / tick_span;
+    float end = 1.0f - (1.0f - tick_alpha) / tick_span;
+    // Only interpolate, stepping outside the recordings would extrapolate angles
+    return std::clamp(start + (end - start) * t, 0.0f, 1.0f);
+}
+
+void FrameInterpolation_SetTickSpan(u32 ticks, f32 alpha) {
+    tick_span = ticks;
+    tick_alpha = alpha;
+}
+
 bool camera_interpolation = true;
 
 void FrameInterpolation_ShouldInterpolateFrame(bool shouldInterpolate) {
@@ -623,6 +649,8 @@ bool check_if_recording() {
 }
 
 void FrameInterpolation_StartRecord(void) {
+    previous_tick_alpha = (tick_span != 0) ? tick_alpha : 1.0f;
+    tick_span = 0;
     previous_recording = move(current_recording);
     current_recording = {};
     current_path.clear();
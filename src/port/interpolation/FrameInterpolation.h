@@ -13,6 +13,7 @@
 
 
 std::unordered_map<Mtx*, MtxF> FrameInterpolation_Interpolate(float step);
+float FrameInterpolation_GetTickStep(float t);
 void FrameInterpolation_ApplyMatrixTransformations(Mat4* matrix, FVector pos, IRotator rot, FVector scale);
 
 extern "C" {
@@ -31,6 +32,12 @@ void FrameInterpolation_StartRecord(void);
 
 void FrameInterpolation_StopRecord(void);
 
+/**
+ * @brief Tells the interpolator the frame being recorded ran ticks fixed logic ticks, with alpha of a tick left in the
+ * scheduler. Frames that do not call it, like menus, are one game frame after the previous recording.
+ */
+void FrameInterpolation_SetTickSpan(u32 ticks, f32 alpha);
+
 void FrameInterpolation_RecordMarker(const char* file, int line);
 
 void FrameInterpolation_RecordOpenChild(const void* a, uintptr_t b);
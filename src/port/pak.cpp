@@ -1,81 +1,232 @@
 #include <filesystem>
 #include <fstream>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include <libultraship.h>
 #include <libultraship/libultra.h>
 #include <save.h>
 #include <cstdio>
+#include <cstring>
+
+#include "pak.h"
+#include "PakJournal.h"
 
 #define MAX_FILES 16
 #define EXT_NAME_SIZE 4
 #define GAME_NAME_SIZE 16
-
+#define HEADER_SIZE (MAX_FILES * sizeof(OSPfsState))
+
+#define HEADER_PATH "controllerPak_header.sav"
+#define JOURNAL_PATH "controllerPak.journal"
+
+// Writes that arrive within this window are coalesced into one flush, e.g. a ghost save written in chunks.
+#define FLUSH_DELAY_MS 250
+
+/**
+ * The whole controller pak lives in memory: the header table and every file's contents.
+ * Reads never touch the disk and writes only mark the image dirty; a background thread flushes it.
+ *
+ * A flush first writes every dirty file into one journal closed by a checksum and a commit marker and syncs it to disk,
+ * then rewrites the real files from it and deletes the journal (see PakJournal.h). On startup a complete journal is
+ * replayed and a torn one is discarded, so a crash at any point leaves either the old or the new pak on disk, never a
+ * mix.
+ */
 typedef struct ControllerPak {
-    FILE* header;
-    FILE* file;
+    std::vector<u8> header;
+    std::vector<u8> files[MAX_FILES];
+    bool exists[MAX_FILES];
+    bool headerDirty;
+    bool fileDirty[MAX_FILES];
+    bool loaded;
 } ControllerPak;
 
-bool Pfs_PakHeader_Write(u32* file_size, u32* game_code, u16* company_code, u8* ext_name, u8* game_name, u8 fileIndex) {
-    ControllerPak pak;
+static ControllerPak sPak;
+static std::mutex sPakMutex;     // Guards sPak
+static std::mutex sFlushMutex;   // Serializes journal writes
+static std::condition_variable sFlushCv;
+static bool sFlushRequested = false;
+static bool sFlushStop = false;
+
+void ControllerPak_Shutdown();
+
+// Still flushes and joins the writer if the game leaves through exit() instead of ControllerPak_Shutdown
+static struct FlushThread {
+    std::thread thread;
+    ~FlushThread() {
+        ControllerPak_Shutdown();
+    }
+} sFlushThread;
+
+static std::string Pak_FilePath(s32 fileIndex) {
+    char filename[100];
+    sprintf(filename, "controllerPak_file_%d.sav", fileIndex);
+    return filename;
+}
+
+static void Pak_Load() {
+    if (sPak.loaded) {
+        return;
+    }
 
-    pak.header = fopen("controllerPak_header.sav", "w+b");
+    Journal_Recover(JOURNAL_PATH);
 
-    if (!pak.header) {
+    // Header files written by older builds may be shorter than the full table
+    Pak_ReadWholeFile(HEADER_PATH, sPak.header);
+    sPak.header.resize(HEADER_SIZE, 0);
+    sPak.headerDirty = false;
+
+    for (size_t i = 0; i < MAX_FILES; i++) {
+        sPak.files[i].clear();
+        sPak.exists[i] = Pak_ReadWholeFile(Pak_FilePath(i).c_str(), sPak.files[i]);
+        sPak.fileDirty[i] = false;
+    }
+
+    sPak.loaded = true;
+}
+
+/**
+ * Puts entries that did not reach disk back in line for the next flush.
+ */
+static void Pak_MarkDirty(const std::vector<JournalEntry>& entries) {
+    std::lock_guard<std::mutex> lock(sPakMutex);
+
+    for (const auto& entry : entries) {
+        if (entry.path == HEADER_PATH) {
+            sPak.headerDirty = true;
+            continue;
+        }
+        for (size_t i = 0; i < MAX_FILES; i++) {
+            if (entry.path == Pak_FilePath(i)) {
+                sPak.fileDirty[i] = true;
+            }
+        }
+    }
+}
+
+/**
+ * Moves every dirty part of the image into a committed journal and then into the real files.
+ */
+static void Pak_FlushNow() {
+    std::lock_guard<std::mutex> flushLock(sFlushMutex);
+    std::vector<JournalEntry> entries;
+
+    {
+        std::lock_guard<std::mutex> lock(sPakMutex);
+        if (sPak.headerDirty) {
+            entries.push_back({ HEADER_PATH, false, sPak.header });
+            sPak.headerDirty = false;
+        }
+        for (size_t i = 0; i < MAX_FILES; i++) {
+            if (sPak.fileDirty[i]) {
+                entries.push_back({ Pak_FilePath(i), !sPak.exists[i], sPak.files[i] });
+                sPak.fileDirty[i] = false;
+            }
+        }
+    }
+
+    if (entries.empty()) {
+        return;
+    }
+
+    if (!Pak_WriteWholeFile(JOURNAL_PATH, Journal_Serialize(entries))) {
+        printf("[ControllerPak] Failed to write the save journal\n");
+        Pak_MarkDirty(entries);
+        return;
+    }
+
+    if (Journal_Apply(entries)) {
+        remove(JOURNAL_PATH);
+    } else {
+        // The next journal replaces this one, so it has to carry these entries again
+        Pak_MarkDirty(entries);
+    }
+}
+
+static void Pak_FlushThread() {
+    std::unique_lock<std::mutex> lock(sPakMutex);
+
+    while (!sFlushStop) {
+        sFlushCv.wait(lock, [] { return sFlushRequested || sFlushStop; });
+        if (sFlushStop) {
+            break;
+        }
+
+        // Let a burst of writes settle before touching the disk
+        sFlushCv.wait_for(lock, std::chrono::milliseconds(FLUSH_DELAY_MS), [] { return sFlushStop; });
+        sFlushRequested = false;
+
+        lock.unlock();
+        Pak_FlushNow();
+        lock.lock();
+    }
+}
+
+/**
+ * Wakes the background writer. Called with sPakMutex held.
+ */
+static void Pak_RequestFlush() {
+    if (!sFlushThread.thread.joinable()) {
+        sFlushStop = false;
+        sFlushThread.thread = std::thread(Pak_FlushThread);
+    }
+    sFlushRequested = true;
+    sFlushCv.notify_one();
+}
+
+void ControllerPak_Flush() {
+    Pak_FlushNow();
+}
+
+void ControllerPak_Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(sPakMutex);
+        sFlushStop = true;
+    }
+    sFlushCv.notify_one();
+    if (sFlushThread.thread.joinable()) {
+        sFlushThread.thread.join();
+    }
+    Pak_FlushNow();
+}
+
+// The header helpers expect sPakMutex to be held.
+
+bool Pfs_PakHeader_Write(u32* file_size, u32* game_code, u16* company_code, u8* ext_name, u8* game_name, u8 fileIndex) {
+    if (fileIndex >= MAX_FILES) {
         return false;
     }
 
     /* Set file parameters to header */
-    u32 seek = fileIndex * sizeof(OSPfsState);
-
-    // file_size
-    fseek(pak.header, seek + 0x00, SEEK_SET);
-    fwrite(file_size, 1, 4, pak.header);
-    // game_code
-    fseek(pak.header, seek + 0x04, SEEK_SET);
-    fwrite(game_code, 1, 4, pak.header);
-    // company_code
-    fseek(pak.header, seek + 0x08, SEEK_SET);
-    fwrite(company_code, 1, 2, pak.header);
-    // ext_name
-    fseek(pak.header, seek + 0x0C, SEEK_SET);
-    fwrite(ext_name, 1, EXT_NAME_SIZE, pak.header);
-    // game_name
-    fseek(pak.header, seek + 0x10, SEEK_SET);
-    fwrite(game_name, 1, GAME_NAME_SIZE, pak.header);
-    fclose(pak.header);
+    u8* entry = sPak.header.data() + (fileIndex * sizeof(OSPfsState));
+
+    memcpy(entry + 0x00, file_size, 4);
+    memcpy(entry + 0x04, game_code, 4);
+    memcpy(entry + 0x08, company_code, 2);
+    memcpy(entry + 0x0C, ext_name, EXT_NAME_SIZE);
+    memcpy(entry + 0x10, game_name, GAME_NAME_SIZE);
+    sPak.headerDirty = true;
 
     return true;
 }
 
 bool Pfs_PakHeader_Read(u32* file_size, u32* game_code, u16* company_code, char* ext_name, char* game_name,
                         u8 fileIndex) {
-    ControllerPak pak;
-
-    pak.header = fopen("controllerPak_header.sav", "rb");
-
-    if(!pak.header) {
+    if (fileIndex >= MAX_FILES) {
         return false;
     }
 
-    /* Set file parameters to header */
-    u32 seek = fileIndex * sizeof(OSPfsState);
-
-    // file_size
-    fseek(pak.header, seek + 0x00, SEEK_SET);
-    fread(file_size, 1, 4, pak.header);
-    // game_code
-    fseek(pak.header, seek + 0x04, SEEK_SET);
-    fread(game_code, 1, 4, pak.header);
-    // company_code
-    fseek(pak.header, seek + 0x08, SEEK_SET);
-    fread(company_code, 1, 2, pak.header);
-    // ext_name
-    fseek(pak.header, seek + 0x0C, SEEK_SET);
-    fread(ext_name, 1, EXT_NAME_SIZE, pak.header);
-    // game_name
-    fseek(pak.header, seek + 0x10, SEEK_SET);
-    fread(game_name, 1, GAME_NAME_SIZE, pak.header);
-    fclose(pak.header);
+    const u8* entry = sPak.header.data() + (fileIndex * sizeof(OSPfsState));
+
+    memcpy(file_size, entry + 0x00, 4);
+    memcpy(game_code, entry + 0x04, 4);
+    memcpy(company_code, entry + 0x08, 2);
+    memcpy(ext_name, entry + 0x0C, EXT_NAME_SIZE);
+    memcpy(game_name, entry + 0x10, GAME_NAME_SIZE);
 
     return true;
 }
@@ -90,30 +241,15 @@ extern "C" s32 osPfsInit(OSMesgQueue* queue, OSPfs* pfs, int channel) {
     pfs->channel = channel;
     pfs->status = PFS_INITIALIZED;
 
-    ControllerPak pak;
-
-    pak.header = fopen("controllerPak_header.sav", "rb");
-
-    // If a header file doesn't exist, create it.
-    if(!pak.header) {
-        pak.header = fopen("controllerPak_header.sav", "w+b");
-        if (!pak.header) {
-            return PFS_ERR_INVALID;
-        }
-        fclose(pak.header);
-    }
+    std::lock_guard<std::mutex> lock(sPakMutex);
+    Pak_Load();
 
     return PFS_NO_ERROR;
 }
 
 extern "C" s32 osPfsFreeBlocks(OSPfs* pfs, s32* bytes_not_used) {
-    ControllerPak pak;
-
-    pak.header = fopen("controllerPak_header.sav", "rb");
-
-    if (!pak.header) {
-        return PFS_ERR_INVALID;
-    }
+    std::lock_guard<std::mutex> lock(sPakMutex);
+    Pak_Load();
 
     s32 usedSpace = 0;
     for (size_t i = 0; i < MAX_FILES; i++) {
@@ -134,8 +270,6 @@ extern "C" s32 osPfsFreeBlocks(OSPfs* pfs, s32* bytes_not_used) {
         }
     }
 
-    fclose(pak.header);
-
     *bytes_not_used = (123 - usedSpace) << 8;
 
     return PFS_NO_ERROR;
@@ -148,7 +282,8 @@ extern "C" s32 osPfsAllocateFile(OSPfs* pfs, u16 company_code, u32 game_code, u8
         return PFS_ERR_INVALID;
     }
 
-    ControllerPak pak;
+    std::lock_guard<std::mutex> lock(sPakMutex);
+    Pak_Load();
 
     /* Search for a free slot */
     u8 freeFileIndex = 0;
@@ -178,25 +313,12 @@ extern "C" s32 osPfsAllocateFile(OSPfs* pfs, u16 company_code, u32 game_code, u8
     }
 
     /* Create empty file */
-    char filename[100];
-    sprintf(filename, "controllerPak_file_%d.sav", freeFileIndex);
-    pak.file = fopen(filename, "w+b");
-
-    if (!pak.file) {
-        return PFS_ERR_INVALID;
-    }
-
     file_size_in_bytes = (file_size_in_bytes + 31) & ~31;
 
-    char* zero_block = (char*) malloc(file_size_in_bytes);
-    for (size_t i = 0; i < file_size_in_bytes; i++) {
-        zero_block[i] = 0;
-    }
-
-    fseek(pak.file, 0, SEEK_SET);
-    fwrite(zero_block, 1, file_size_in_bytes, pak.file);
-    free(zero_block);
-    fclose(pak.file);
+    sPak.files[freeFileIndex].assign(file_size_in_bytes, 0);
+    sPak.exists[freeFileIndex] = true;
+    sPak.fileDirty[freeFileIndex] = true;
+    Pak_RequestFlush();
 
     *file_no = freeFileIndex;
 
@@ -214,12 +336,14 @@ extern "C" s32 osPfsFileState(OSPfs* pfs, s32 file_no, OSPfsState* state) {
     // games call this function 16 times, once per file
     // fills the incoming state with the information inside the header of the pak.
 
-    char filename[100];
-    sprintf(filename, "controllerPak_file_%d.sav", file_no);
-    FILE* file = fopen(filename, "rb");
-    if (file) {
-        fclose(file);
-    } else {
+    if ((file_no < 0) || (file_no >= MAX_FILES)) {
+        return PFS_ERR_INVALID;
+    }
+
+    std::lock_guard<std::mutex> lock(sPakMutex);
+    Pak_Load();
+
+    if (!sPak.exists[file_no]) {
         return PFS_ERR_INVALID;
     }
 
@@ -243,7 +367,8 @@ extern "C" s32 osPfsFileState(OSPfs* pfs, s32 file_no, OSPfsState* state) {
 }
 
 extern "C" s32 osPfsFindFile(OSPfs* pfs, u16 company_code, u32 game_code, u8* game_name, u8* ext_name, s32* file_no) {
-    ControllerPak pak;
+    std::lock_guard<std::mutex> lock(sPakMutex);
+    Pak_Load();
 
     for (size_t i = 0; i < MAX_FILES; i++) {
         u32 file_size_ = 0;
@@ -274,30 +399,44 @@ extern "C" s32 osPfsFindFile(OSPfs* pfs, u16 company_code, u32 game_code, u8* ga
 }
 
 extern "C" s32 osPfsReadWriteFile(OSPfs* pfs, s32 file_no, u8 flag, int offset, int size_in_bytes, u8* data_buffer) {
-    ControllerPak pak;
-
-    char filename[100];
-    sprintf(filename, "controllerPak_file_%d.sav", file_no);
-    pak.file = fopen(filename, flag == 0 ? "r+b" : "w+b");
-
-    if (!pak.file) {
+    if ((file_no < 0) || (file_no >= MAX_FILES) || (offset < 0) || (size_in_bytes < 0)) {
         return PFS_ERR_INVALID;
     }
 
+    std::lock_guard<std::mutex> lock(sPakMutex);
+    Pak_Load();
+
+    std::vector<u8>& file = sPak.files[file_no];
+
     if (flag == 0) {
-        fseek(pak.file, offset, SEEK_SET);
-        fread(data_buffer, 1, size_in_bytes, pak.file);
+        if (!sPak.exists[file_no]) {
+            return PFS_ERR_INVALID;
+        }
+
+        // Bytes past the end of the file read as zero
+        size_t end = std::min<size_t>(file.size(), offset + size_in_bytes);
+        size_t available = (end > (size_t) offset) ? end - offset : 0;
+        if (available != 0) {
+            memcpy(data_buffer, file.data() + offset, available);
+        }
+        memset(data_buffer + available, 0, size_in_bytes - available);
     } else {
-        fseek(pak.file, offset, SEEK_SET);
-        fwrite(data_buffer, 1, size_in_bytes, pak.file);
+        if (file.size() < (size_t) (offset + size_in_bytes)) {
+            file.resize(offset + size_in_bytes, 0);
+        }
+        memcpy(file.data() + offset, data_buffer, size_in_bytes);
+        sPak.exists[file_no] = true;
+        sPak.fileDirty[file_no] = true;
+        Pak_RequestFlush();
     }
 
-    fclose(pak.file);
-
     return PFS_NO_ERROR;
 }
 
 extern "C" s32 osPfsNumFiles(OSPfs* pfs, s32* max_files, s32* files_used) {
+    std::lock_guard<std::mutex> lock(sPakMutex);
+    Pak_Load();
+
     u8 files = 0;
     for (size_t i = 0; i < MAX_FILES; i++) {
         u32 file_size = 0;
@@ -326,7 +465,8 @@ extern "C" s32 osPfsDeleteFile(OSPfs* pfs, u16 company_code, u32 game_code, u8*
         return PFS_ERR_INVALID;
     }
 
-    ControllerPak pak;
+    std::lock_guard<std::mutex> lock(sPakMutex);
+    Pak_Load();
 
     for (int i = 0; i < MAX_FILES; i++) {
         u32 file_size_ = 0;
@@ -344,31 +484,14 @@ extern "C" s32 osPfsDeleteFile(OSPfs* pfs, u16 company_code, u32 game_code, u8*
         } else {
             if ((game_code == game_code_) && (strcmp((const char*) game_name, (const char*) game_name_) == 0) &&
                 strcmp((const char*) ext_name, (const char*) ext_name_) == 0) {
-                // File found
-                pak.header = fopen("controllerPak_header.sav", "w+b");
-
-                if(!pak.header) {
-                    return PFS_ERR_INVALID;
-                }
-
-                u32 seek = i * sizeof(OSPfsState);
-
-                // Zero out the header for this file.
-                u8* zero_block = (u8*) malloc(sizeof(OSPfsState));
-                for (size_t i = 0; i < sizeof(OSPfsState); i++) {
-                    zero_block[i] = 0;
-                }
-
-                fseek(pak.header, seek + 0x0, SEEK_SET);
-                fwrite(zero_block, 1, sizeof(OSPfsState), pak.header);
-
-                free(zero_block);
-
-                fclose(pak.header);
-                char filename[100];
-                sprintf(filename, "controllerPak_file_%d.sav", i);
-
-                remove(filename);
+                // File found, zero out the header for this file.
+                memset(sPak.header.data() + (i * sizeof(OSPfsState)), 0, sizeof(OSPfsState));
+                sPak.headerDirty = true;
+
+                sPak.files[i].clear();
+                sPak.exists[i] = false;
+                sPak.fileDirty[i] = true;
+                Pak_RequestFlush();
 
                 return PFS_NO_ERROR;
             }
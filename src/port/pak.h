@@ -0,0 +1,13 @@
+#pragma once
+
+/**
+ * @brief Writes pending controller pak changes to disk and waits for them to land.
+ *
+ * Pak writes normally reach disk from a background thread shortly after they happen.
+ */
+void ControllerPak_Flush();
+
+/**
+ * @brief Flushes the controller pak and stops its background writer. Call once before exiting.
+ */
+void ControllerPak_Shutdown();
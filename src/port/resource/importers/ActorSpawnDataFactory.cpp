@@ -1,5 +1,6 @@
 #include "ActorSpawnDataFactory.h"
 #include "../type/SpawnData.h"
+#include "BulkReader.h"
 #include "spdlog/spdlog.h"
 #include "libultraship/libultra/gbi.h"
 #include <common_structs.h>
@@ -15,17 +16,15 @@ ResourceFactoryBinaryActorSpawnDataV0::ReadResource(std::shared_ptr<Ship::File>
     auto section = std::make_shared<ActorSpawn>(initData);
     auto reader = std::get<std::shared_ptr<Ship::BinaryReader>>(file->Reader);
 
-    uint32_t count = reader->ReadUInt32();
-    section->ActorSpawnDataList.reserve(count);
-
-    for (uint32_t i = 0; i < count; i++) {
-        ActorSpawnData data;
-        data.pos[0] = reader->ReadInt16();
-        data.pos[1] = reader->ReadInt16();
-        data.pos[2] = reader->ReadInt16();
-        data.signedSomeId = reader->ReadInt16();
+    // On disk: s16 pos[3], s16 signedSomeId
+    static_assert(sizeof(ActorSpawnData) == 8);
 
-        section->ActorSpawnDataList.push_back(data);
+    uint32_t count = reader->ReadUInt32();
+    if (!ReadRecords(reader, section->ActorSpawnDataList, count)) {
+        return nullptr;
+    }
+    if (ReaderNeedsSwap(reader)) {
+        SwapWords16(section->ActorSpawnDataList.data(), count * 4);
     }
 
     return section;
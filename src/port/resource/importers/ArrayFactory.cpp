@@ -1,5 +1,6 @@
 #include "ArrayFactory.h"
 #include "../type/Array.h"
+#include "BulkReader.h"
 #include "spdlog/spdlog.h"
 #include "graphic/Fast3D/lus_gbi.h"
 
@@ -17,47 +18,45 @@ ResourceFactoryBinaryArrayV0::ReadResource(std::shared_ptr<Ship::File> file,
     array->ArrayType = (ArrayResourceType)reader->ReadUInt32();
     array->ArrayCount = reader->ReadUInt32();
 
-    for (uint32_t i = 0; i < array->ArrayCount; i++) {
-        if (array->ArrayType == ArrayResourceType::Vertex) {
-            // OTRTODO: Implement Vertex arrays as just a vertex resource.
-            Fast::F3DVtx data;
-            data.v.ob[0] = reader->ReadInt16();
-            data.v.ob[1] = reader->ReadInt16();
-            data.v.ob[2] = reader->ReadInt16();
-            data.v.flag = reader->ReadUInt16();
-            data.v.tc[0] = reader->ReadInt16();
-            data.v.tc[1] = reader->ReadInt16();
-            data.v.cn[0] = reader->ReadUByte();
-            data.v.cn[1] = reader->ReadUByte();
-            data.v.cn[2] = reader->ReadUByte();
-            data.v.cn[3] = reader->ReadUByte();
-            array->Vertices.push_back(data);
-        } else {
-            array->ArrayScalarType = (ScalarType) reader->ReadUInt32();
+    if (array->ArrayType == ArrayResourceType::Vertex) {
+        // OTRTODO: Implement Vertex arrays as just a vertex resource.
+        // On disk: s16 ob[3], u16 flag, s16 tc[2], u8 cn[4], same as Vtx_t
+        static_assert(sizeof(Fast::F3DVtx) == 16);
 
-            int iter = 1;
+        if (!ReadRecords(reader, array->Vertices, array->ArrayCount)) {
+            return nullptr;
+        }
+        if (ReaderNeedsSwap(reader)) {
+            SwapRecords16(array->Vertices.data(), array->ArrayCount, sizeof(Fast::F3DVtx), 6);
+        }
+        return array;
+    }
 
-            if (array->ArrayType == ArrayResourceType::Vector) {
-                iter = reader->ReadUInt32();
-            }
+    for (uint32_t i = 0; i < array->ArrayCount; i++) {
+        array->ArrayScalarType = (ScalarType) reader->ReadUInt32();
+
+        int iter = 1;
 
-            for (int k = 0; k < iter; k++) {
-                ScalarData data;
+        if (array->ArrayType == ArrayResourceType::Vector) {
+            iter = reader->ReadUInt32();
+        }
 
-                switch (array->ArrayScalarType) {
-                    case ScalarType::ZSCALAR_S16:
-                        data.s16 = reader->ReadInt16();
-                        break;
-                    case ScalarType::ZSCALAR_U16:
-                        data.u16 = reader->ReadUInt16();
-                        break;
-                    default:
-                        throw std::runtime_error("ARRAY FACTORY TYPE NOT IMPLEMENTED");
-                        break;
-                }
+        for (int k = 0; k < iter; k++) {
+            ScalarData data;
 
-                array->Scalars.push_back(data);
+            switch (array->ArrayScalarType) {
+                case ScalarType::ZSCALAR_S16:
+                    data.s16 = reader->ReadInt16();
+                    break;
+                case ScalarType::ZSCALAR_U16:
+                    data.u16 = reader->ReadUInt16();
+                    break;
+                default:
+                    throw std::runtime_error("ARRAY FACTORY TYPE NOT IMPLEMENTED");
+                    break;
             }
+
+            array->Scalars.push_back(data);
         }
     }
 
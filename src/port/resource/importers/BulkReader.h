@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "spdlog/spdlog.h"
+#include "utils/binarytools/BinaryReader.h"
+
+namespace MK64 {
+
+/**
+ * @brief Helpers for factories that decode arrays of fixed-size records.
+ *
+ * Instead of one virtual BinaryReader call per field, the whole array is read with a single Read() into its
+ * destination and then byte swapped in place if the archive was written with the other endianness. The swap
+ * loops work on plain bytes with fixed strides so compilers turn them into vector shuffles.
+ */
+
+inline bool ReaderNeedsSwap(const std::shared_ptr<Ship::BinaryReader>& reader) {
+    return reader->GetEndianness() != Ship::Endianness::Native;
+}
+
+/**
+ * Checks that count records of size bytes are left in the reader, so a corrupt count cannot make the
+ * bulk read run past the end of the file.
+ */
+inline bool ReaderHasRecords(const std::shared_ptr<Ship::BinaryReader>& reader, uint64_t count, size_t size) {
+    uint64_t remaining = reader->GetLength() - reader->GetBaseAddress();
+    if (count * size > remaining) {
+        SPDLOG_ERROR("Resource declares {} records of {} bytes but only {} bytes remain", count, size, remaining);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Swaps the first wordCount 16-bit words of every record; any bytes after them (colors, flags) are left alone.
+ */
+inline void SwapRecords16(void* data, size_t count, size_t stride, size_t wordCount) {
+    uint8_t* bytes = static_cast<uint8_t*>(data);
+    for (size_t i = 0; i < count; i++) {
+        uint8_t* record = bytes + (i * stride);
+        for (size_t w = 0; w < wordCount; w++) {
+            uint8_t tmp = record[w * 2];
+            record[w * 2] = record[w * 2 + 1];
+            record[w * 2 + 1] = tmp;
+        }
+    }
+}
+
+inline void SwapWords16(void* data, size_t wordCount) {
+    SwapRecords16(data, 1, 0, wordCount);
+}
+
+inline void SwapWords32(void* data, size_t wordCount) {
+    uint8_t* bytes = static_cast<uint8_t*>(data);
+    for (size_t i = 0; i < wordCount; i++) {
+        uint8_t* word = bytes + (i * 4);
+        uint8_t b0 = word[0];
+        uint8_t b1 = word[1];
+        word[0] = word[3];
+        word[1] = word[2];
+        word[2] = b1;
+        word[3] = b0;
+    }
+}
+
+inline void SwapWords64(void* data, size_t wordCount) {
+    uint8_t* bytes = static_cast<uint8_t*>(data);
+    for (size_t i = 0; i < wordCount; i++) {
+        uint8_t* word = bytes + (i * 8);
+        for (size_t b = 0; b < 4; b++) {
+            uint8_t tmp = word[b];
+            word[b] = word[7 - b];
+            word[7 - b] = tmp;
+        }
+    }
+}
+
+/**
+ * Resizes list to count and fills it straight from the reader. T must match the on-disk record byte for byte.
+ * The caller fixes up endianness afterwards.
+ */
+template <typename T> bool ReadRecords(const std::shared_ptr<Ship::BinaryReader>& reader, std::vector<T>& list,
+                                       size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>, "Records are filled with a raw read");
+
+    if (!ReaderHasRecords(reader, count, sizeof(T))) {
+        return false;
+    }
+    list.resize(count);
+    if (count != 0) {
+        reader->Read(reinterpret_cast<char*>(list.data()), (int32_t) (count * sizeof(T)));
+    }
+    return true;
+}
+
+} // namespace MK64
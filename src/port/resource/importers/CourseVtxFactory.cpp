@@ -1,5 +1,6 @@
 #include "CourseVtxFactory.h"
 #include "../type/CourseVtx.h"
+#include "BulkReader.h"
 #include "spdlog/spdlog.h"
 #include "libultraship/libultra/gbi.h"
 
@@ -14,22 +15,15 @@ ResourceFactoryBinaryCourseVtxV0::ReadResource(std::shared_ptr<Ship::File> file,
     auto cvtx = std::make_shared<CourseVtxClass>(initData);
     auto reader = std::get<std::shared_ptr<Ship::BinaryReader>>(file->Reader);
 
-    uint32_t count = reader->ReadUInt32();
-    cvtx->CourseVtxList.reserve(count);
-
-    for (uint32_t i = 0; i < count; i++) {
-        CourseVtxData data;
-        data.ob[0] = reader->ReadInt16();
-        data.ob[1] = reader->ReadInt16();
-        data.ob[2] = reader->ReadInt16();
-        data.tc[0] = reader->ReadInt16();
-        data.tc[1] = reader->ReadInt16();
-        data.ca[0] = reader->ReadUByte();
-        data.ca[1] = reader->ReadUByte();
-        data.ca[2] = reader->ReadUByte();
-        data.ca[3] = reader->ReadUByte();
+    // On disk: s16 ob[3], s16 tc[2], u8 ca[4], same as CourseVtxData
+    static_assert(sizeof(CourseVtxData) == 14);
 
-        cvtx->CourseVtxList.push_back(data);
+    uint32_t count = reader->ReadUInt32();
+    if (!ReadRecords(reader, cvtx->CourseVtxList, count)) {
+        return nullptr;
+    }
+    if (ReaderNeedsSwap(reader)) {
+        SwapRecords16(cvtx->CourseVtxList.data(), count, sizeof(CourseVtxData), 5);
     }
 
     return cvtx;
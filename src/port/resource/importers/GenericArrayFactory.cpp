@@ -1,5 +1,6 @@
 #include "GenericArrayFactory.h"
 #include "../type/GenericArray.h"
+#include "BulkReader.h"
 #include "spdlog/spdlog.h"
 
 namespace SF64 {
@@ -21,91 +22,77 @@ ResourceFactoryBinaryGenericArrayV0::ReadResource(std::shared_ptr<Ship::File> fi
 
     SPDLOG_INFO("GenericArray Count: {}", count);
 
-    for (uint32_t i = 0; i < count; i++) {
-        switch (static_cast<ArrayType>(type)) {
-            case ArrayType::u8: {
-                auto x = reader->ReadUByte();
-                arr->mData.push_back(x);
-                break;
-            }
-            case ArrayType::s8: {
-                auto x = reader->ReadInt8();
-                arr->mData.push_back(x);
-                break;
-            }
-            case ArrayType::u16: {
-                auto x = reader->ReadUInt16();
-                std::copy_n(reinterpret_cast<uint8_t*>(&x), 2, std::back_inserter(arr->mData));
-                break;
-            }
-            case ArrayType::s16: {
-                auto x = reader->ReadInt16();
-                std::copy_n(reinterpret_cast<uint8_t*>(&x), 2, std::back_inserter(arr->mData));
-                break;
-            }
-            case ArrayType::u32: {
-                auto x = reader->ReadUInt32();
-                std::copy_n(reinterpret_cast<uint8_t*>(&x), 4, std::back_inserter(arr->mData));
-                break;
-            }
-            case ArrayType::s32: {
-                auto x = reader->ReadInt32();
-                std::copy_n(reinterpret_cast<uint8_t*>(&x), 4, std::back_inserter(arr->mData));
-                break;
-            }
-            case ArrayType::u64: {
-                auto x = reader->ReadUInt64();
-                std::copy_n(reinterpret_cast<uint8_t*>(&x), 8, std::back_inserter(arr->mData));
-                break;
-            }
-            case ArrayType::f32: {
-                auto x = reader->ReadFloat();
-                std::copy_n(reinterpret_cast<uint8_t*>(&x), 4, std::back_inserter(arr->mData));
-                break;
-            }
-            case ArrayType::f64: {
-                auto x = reader->ReadDouble();
-                std::copy_n(reinterpret_cast<uint8_t*>(&x), 8, std::back_inserter(arr->mData));
-                break;
-            }
-            case ArrayType::Vec2f: {
-                Vec2f vec(reader->ReadFloat(), reader->ReadFloat());
-                std::copy_n(reinterpret_cast<uint8_t*>(&vec), sizeof(Vec2f), std::back_inserter(arr->mData));
-                break;
-            }
-            case ArrayType::Vec3f: {
-                Vec3f vec(reader->ReadFloat(), reader->ReadFloat(), reader->ReadFloat());
-                std::copy_n(reinterpret_cast<uint8_t*>(&vec), sizeof(Vec3f), std::back_inserter(arr->mData));
-                break;
-            }
-            case ArrayType::Vec3s: {
-                Vec3s vec(reader->ReadInt16(), reader->ReadInt16(), reader->ReadInt16());
-                std::copy_n(reinterpret_cast<uint8_t*>(&vec), sizeof(Vec3s), std::back_inserter(arr->mData));
-                break;
-            }
-            case ArrayType::Vec3i: {
-                Vec3i vec(reader->ReadInt32(), reader->ReadInt32(), reader->ReadInt32());
-                std::copy_n(reinterpret_cast<uint8_t*>(&vec), sizeof(Vec3i), std::back_inserter(arr->mData));
-                break;
-            }
-            case ArrayType::Vec3iu: {
-                Vec3i vec(reader->ReadUInt32(), reader->ReadUInt32(), reader->ReadUInt32());
-                std::copy_n(reinterpret_cast<uint8_t*>(&vec), sizeof(Vec3iu), std::back_inserter(arr->mData));
+    // Every element type is stored as consecutive scalars of one width: read them all at once.
+    size_t elementSize;
+    size_t scalarSize;
+    switch (static_cast<ArrayType>(type)) {
+        case ArrayType::u8:
+        case ArrayType::s8:
+            elementSize = 1;
+            scalarSize = 1;
+            break;
+        case ArrayType::u16:
+        case ArrayType::s16:
+            elementSize = 2;
+            scalarSize = 2;
+            break;
+        case ArrayType::u32:
+        case ArrayType::s32:
+        case ArrayType::f32:
+            elementSize = 4;
+            scalarSize = 4;
+            break;
+        case ArrayType::u64:
+        case ArrayType::f64:
+            elementSize = 8;
+            scalarSize = 8;
+            break;
+        case ArrayType::Vec2f:
+            elementSize = sizeof(Vec2f);
+            scalarSize = 4;
+            break;
+        case ArrayType::Vec3f:
+            elementSize = sizeof(Vec3f);
+            scalarSize = 4;
+            break;
+        case ArrayType::Vec3s:
+            elementSize = sizeof(Vec3s);
+            scalarSize = 2;
+            break;
+        case ArrayType::Vec3i:
+        case ArrayType::Vec3iu:
+            elementSize = sizeof(Vec3i);
+            scalarSize = 4;
+            break;
+        case ArrayType::Vec4f:
+            elementSize = sizeof(Vec4f);
+            scalarSize = 4;
+            break;
+        case ArrayType::Vec4s:
+            elementSize = sizeof(Vec4s);
+            scalarSize = 2;
+            break;
+        default: {
+            throw std::runtime_error("UNIMPLEMENTED GENERICARRAY TYPE");
+        }
+    }
+
+    size_t size = (size_t) count * elementSize;
+    if (!MK64::ReadRecords(reader, arr->mData, size)) {
+        return nullptr;
+    }
+
+    if (MK64::ReaderNeedsSwap(reader)) {
+        switch (scalarSize) {
+            case 2:
+                MK64::SwapWords16(arr->mData.data(), size / 2);
                 break;
-            }
-            case ArrayType::Vec4f: {
-                Vec4f vec(reader->ReadFloat(), reader->ReadFloat(), reader->ReadFloat(), reader->ReadFloat());
-                std::copy_n(reinterpret_cast<uint8_t*>(&vec), sizeof(Vec4f), std::back_inserter(arr->mData));
+            case 4:
+                MK64::SwapWords32(arr->mData.data(), size / 4);
                 break;
-            }
-            case ArrayType::Vec4s: {
-                Vec4s vec(reader->ReadInt16(), reader->ReadInt16(), reader->ReadInt16(), reader->ReadInt16());
-                std::copy_n(reinterpret_cast<uint8_t*>(&vec), sizeof(Vec4s), std::back_inserter(arr->mData));
+            case 8:
+                MK64::SwapWords64(arr->mData.data(), size / 8);
                 break;
-            }
-            default: {
-                throw std::runtime_error("UNIMPLEMENTED GENERICARRAY TYPE");
-            }
         }
     }
 
@@ -1,5 +1,6 @@
 #include "TrackPathPointFactory.h"
 #include "../type/TrackPathPointData.h"
+#include "BulkReader.h"
 #include "spdlog/spdlog.h"
 #include "libultraship/libultra/gbi.h"
 #include "tinyxml2.h"
@@ -15,17 +16,15 @@ ResourceFactoryBinaryTrackPathPointsV0::ReadResource(std::shared_ptr<Ship::File>
     auto section = std::make_shared<TrackPathPointData>(initData);
     auto reader = std::get<std::shared_ptr<Ship::BinaryReader>>(file->Reader);
 
-    uint32_t count = reader->ReadUInt32();
-    section->TrackPathPointList.reserve(count);
-
-    for (uint32_t i = 0; i < count; i++) {
-        TrackPathPoint data;
-        data.posX = reader->ReadInt16();
-        data.posY = reader->ReadInt16();
-        data.posZ = reader->ReadInt16();
-        data.trackSectionId = reader->ReadUInt16();
+    // On disk: s16 posX, posY, posZ, u16 trackSectionId
+    static_assert(sizeof(TrackPathPoint) == 8);
 
-        section->TrackPathPointList.push_back(data);
+    uint32_t count = reader->ReadUInt32();
+    if (!ReadRecords(reader, section->TrackPathPointList, count)) {
+        return nullptr;
+    }
+    if (ReaderNeedsSwap(reader)) {
+        SwapWords16(section->TrackPathPointList.data(), count * 4);
     }
 
     return section;
@@ -1,5 +1,6 @@
 #include "Vec3fFactory.h"
 #include "../type/Vec3fArray.h"
+#include "BulkReader.h"
 #include "spdlog/spdlog.h"
 
 namespace SF64 {
@@ -13,15 +14,17 @@ ResourceFactoryBinaryVec3fV0::ReadResource(std::shared_ptr<Ship::File> file,
     auto vec = std::make_shared<Vec3fArray>(initData);
     auto reader = std::get<std::shared_ptr<Ship::BinaryReader>>(file->Reader);
 
+    static_assert(sizeof(Vec3fData) == 12);
+
     auto vecCount = reader->ReadUInt32();
 
     SPDLOG_INFO("Vec3f Count: {}", vecCount);
 
-    for (uint32_t i = 0; i < vecCount; i++) {
-        auto x = reader->ReadFloat();
-        auto y = reader->ReadFloat();
-        auto z = reader->ReadFloat();
-        vec->mData.emplace_back(x, y, z);
+    if (!MK64::ReadRecords(reader, vec->mData, vecCount)) {
+        return nullptr;
+    }
+    if (MK64::ReaderNeedsSwap(reader)) {
+        MK64::SwapWords32(vec->mData.data(), vecCount * 3);
     }
 
     return vec;
@@ -1,5 +1,6 @@
 #include "Vec3sFactory.h"
 #include "../type/Vec3sArray.h"
+#include "BulkReader.h"
 #include "spdlog/spdlog.h"
 
 namespace SF64 {
@@ -13,15 +14,17 @@ ResourceFactoryBinaryVec3sV0::ReadResource(std::shared_ptr<Ship::File> file,
     auto vec = std::make_shared<Vec3sArray>(initData);
     auto reader = std::get<std::shared_ptr<Ship::BinaryReader>>(file->Reader);
 
+    static_assert(sizeof(Vec3sData) == 6);
+
     auto vecCount = reader->ReadUInt32();
 
     SPDLOG_INFO("Vec3s Count: {}", vecCount);
 
-    for (uint32_t i = 0; i < vecCount; i++) {
-        auto x = reader->ReadInt16();
-        auto y = reader->ReadInt16();
-        auto z = reader->ReadInt16();
-        vec->mData.emplace_back(x, y, z);
+    if (!MK64::ReadRecords(reader, vec->mData, vecCount)) {
+        return nullptr;
+    }
+    if (MK64::ReaderNeedsSwap(reader)) {
+        MK64::SwapWords16(vec->mData.data(), vecCount * 3);
     }
 
     return vec;
@@ -8,6 +8,7 @@ namespace SF64 {
 
 struct Vec3fData {
     float x, y, z;
+    Vec3fData() = default;
     Vec3fData(float x, float y, float z) : x(x), y(y), z(z) {
     }
 };
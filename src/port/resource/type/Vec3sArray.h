@@ -8,6 +8,7 @@ namespace SF64 {
 
 struct Vec3sData {
     int16_t x, y, z;
+    Vec3sData() = default;
     Vec3sData(int16_t x, int16_t y, int16_t z) : x(x), y(y), z(z) {
     }
 };
@@ -5,9 +5,13 @@
 #include "port/Engine.h"
 
 #include <imgui.h>
+#include <algorithm>
 #include <map>
+#include <set>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <nlohmann/json.hpp>
 #include <libultraship/libultraship.h>
 #include <spdlog/fmt/fmt.h>
 #include "spdlog/formatter.h"
@@ -15,9 +19,10 @@
 #include <defines.h>
 #include "CoreMath.h"
 #include "World.h"
-#include "AllActors.h"
+#include "Registry.h"
 #include "port/Game.h"
 #include "src/engine/editor/SceneManager.h"
+#include "src/engine/editor/SceneBinary.h"
 
 namespace Editor {
 
@@ -33,9 +38,9 @@ namespace Editor {
         // Query content in o2r and add them to Content
         if (Refresh) {
             Refresh = false;
-            RemoveCustomTracksFromTrackList();
-            Tracks.clear();
-            Content.clear();
+            // Archive contents may have been replaced on disk since their paths were resolved
+            GameEngine_InvalidateResolutionCache();
+            UpdateArchiveIndex();
             FindTracks();
             FindContent();
             return;
@@ -79,48 +84,6 @@ namespace Editor {
         }
     }
 
-    std::unordered_map<std::string, std::function<AActor*(const FVector&)>> ActorList = {
-        { "Mario Sign", [](const FVector& pos) { return new AMarioSign(pos); } },
-        { "Wario Sign", [](const FVector& pos) { return new AWarioSign(pos); } },
-        { "Cloud", [](const FVector& pos) { return new ACloud(pos); } },
-        { "Finishline", [](const FVector& pos) { return new AFinishline(pos); } },
-        { "Ghostship", [](const FVector& pos) { return new AShip(pos, AShip::Skin::GHOSTSHIP); } },
-        { "Ship_1", [](const FVector& pos) { return new AShip(pos, AShip::Skin::SHIP2); } },
-        { "Ship_2", [](const FVector& pos) { return new AShip(pos, AShip::Skin::SHIP3); } },
-        { "SpaghettiShip", [](const FVector& pos) { return new ASpaghettiShip(pos); } },
-        { "Starship", [](const FVector& pos) { return new AStarship(pos); } },
-        { "Train", [](const FVector& pos) { return new ATrain(ATrain::TenderStatus::HAS_TENDER, 4, 2.5f, 0); } },
-        { "Boat", [](const FVector& pos) { return new ABoat((0.6666666f)/4, 0); } },
-        { "Bus", [](const FVector& pos) { return new ABus(2.0f, 2.5f, &gTrackPaths[0][0], 0); } },
-        { "Car", [](const FVector& pos) { return new ACar(2.0f, 2.5f, &gTrackPaths[0][0], 0); } },
-        { "Truck", [](const FVector& pos) { return new ATruck(2.0f, 2.5f, &gTrackPaths[0][0], 0); } },
-        { "Tanker Truck", [](const FVector& pos) { return new ATankerTruck(2.0f, 2.5f, &gTrackPaths[0][0], 0); } },
-    };
-
-    std::unordered_map<std::string, std::function<OObject*(const FVector&)>> ObjectList = {
-        { "Bat", [](const FVector& pos) { return new OBat(pos, IRotator(0, 0, 0)); } },
-        { "Bomb Kart", [](const FVector& pos) { return new OBombKart(pos, &gTrackPaths[0][0], 0, 0, 0.8333333f); } },
-        // { "Boos", [](const FVector& pos) { return new OBoos(pos, &gTrackPaths[0][0], 0, 0, 0.8333333f); } },
-        { "CheepCheep", [](const FVector& pos) { return new OCheepCheep(pos, OCheepCheep::CheepType::RACE, IPathSpan(0, 10)); } },
-        { "Crab", [](const FVector& pos) { return new OCrab(FVector2D(0, 10), FVector2D(20, 10)); } },
-        { "ChainChomp", [](const FVector& pos) { return new OChainChomp(); } },
-        { "Flagpole", [](const FVector& pos) { return new OFlagpole(pos, 0); } },
-        { "Hedgehog", [](const FVector& pos) { return new OHedgehog(pos, FVector2D(0, 10), 0); } },
-        { "HotAirBalloon", [](const FVector& pos) { return new OHotAirBalloon(pos); } },
-        { "Lakitu", [](const FVector& pos) { return new OLakitu(0, OLakitu::LakituType::STARTER); } },
-        // { "Mole", [](const FVector& pos) { return new OMole(pos, ); } }, // <-- Needs a group
-        { "Chick Penguin", [](const FVector& pos) { return new OPenguin(pos, 0, OPenguin::PenguinType::CHICK, OPenguin::Behaviour::SLIDE3); } },
-        { "Penguin", [](const FVector& pos) { return new OPenguin(pos, 0, OPenguin::PenguinType::ADULT, OPenguin::Behaviour::CIRCLE); } },
-        { "Emperor Penguin", [](const FVector& pos) { return new OPenguin(pos, 0, OPenguin::PenguinType::EMPEROR, OPenguin::Behaviour::STRUT); } },
-        { "Seagull", [](const FVector& pos) { return new OSeagull(pos); } },
-        { "Thwomp", [](const FVector& pos) { return new OThwomp(pos.x, pos.z, 0, 1.0f, 0, 0, 2.0f); } },
-        { "Trashbin", [](const FVector& pos) { return new OTrashBin(pos, IRotator(0, 0, 0), 1.0f, OTrashBin::Behaviour::MUNCHING); } },
-        { "Trophy", [](const FVector& pos) { return new OTrophy(pos, OTrophy::TrophyType::GOLD_150, OTrophy::Behaviour::ROTATE2); } },
-        { "Snowman", [](const FVector& pos) { return new OSnowman(pos); } },
-        { "Podium", [](const FVector& pos) { return new OPodium(pos); } },
-        { "Balloons", [](const FVector& pos) { return new OGrandPrixBalloons(pos); } },
-    };
-
     void ContentBrowserWindow::AddTrackContent() {
         size_t i_track = 0;
         for (auto& track : Tracks) {
@@ -147,17 +110,20 @@ namespace Editor {
         }
     }
 
-    // When resetting the known content, we need to also pop the custom courses
+    // When an archive changes, we need to also pop its custom courses
     // out of World::Courses vector. Otherwise, duplicate courses would show up for users.
-    void ContentBrowserWindow::RemoveCustomTracksFromTrackList() {
-        for (auto& track : Tracks) {
-            auto it = gWorldInstance.Courses.begin();
-            while (it != gWorldInstance.Courses.end()) {
-                if (track.course.get() == it->get()) {
-                    it = gWorldInstance.Courses.erase(it);
-                } else {
-                    ++it;
+    void ContentBrowserWindow::RemoveStaleTracks(const std::unordered_set<std::string>& staleDirs) {
+        auto it = Tracks.begin();
+        while (it != Tracks.end()) {
+            bool stale = (it->Archive == nullptr) || ChangedArchives.count(it->Archive->GetPath()) ||
+                         staleDirs.count(it->Dir);
+            if (stale) {
+                if (it->course != nullptr) {
+                    gWorldInstance.RemoveCourse(it->course.get());
                 }
+                it = Tracks.erase(it);
+            } else {
+                ++it;
             }
         }
     }
@@ -166,15 +132,15 @@ namespace Editor {
         FVector pos = GetPositionAheadOfCamera(300.0f);
 
         size_t i_actor = 0;
-        for (const auto& actor : ActorList) {
+        for (const auto& actor : gActorRegistry.GetEntries()) {
             if ((i_actor != 0) && (i_actor % 10 == 0)) {
             } else {
                 ImGui::SameLine();
             }
 
-            std::string label = fmt::format("{}##{}", actor.first, i_actor);
+            std::string label = fmt::format("{}##{}", actor.Value.Name, i_actor);
             if (ImGui::Button(label.c_str())) {
-                gWorldInstance.AddActor(actor.second(pos));
+                gWorldInstance.AddActor(actor.Value.Create(pos));
             }
             i_actor += 1;
         }
@@ -184,15 +150,15 @@ namespace Editor {
         FVector pos = GetPositionAheadOfCamera(300.0f);
 
         size_t i_object = 0;
-        for (auto& object : ObjectList) {
+        for (const auto& object : gObjectRegistry.GetEntries()) {
             if ((i_object != 0) && (i_object % 10 == 0)) {
             } else {
                 ImGui::SameLine();
             }
 
-            std::string label = fmt::format("{}##{}", object.first, i_object);
+            std::string label = fmt::format("{}##{}", object.Value.Name, i_object);
             if (ImGui::Button(label.c_str())) {
-                gWorldInstance.AddObject(object.second(pos));
+                gWorldInstance.AddObject(object.Value.Create(pos));
             }
             i_object += 1;
         }
@@ -222,28 +188,202 @@ namespace Editor {
         }
     }
 
+    static bool GetArchiveStamp(const std::string& path, int64_t& stamp, uint64_t& size) {
+        std::error_code err;
+        if (!std::filesystem::is_regular_file(path, err)) {
+            return false;
+        }
+        auto time = std::filesystem::last_write_time(path, err);
+        size = std::filesystem::file_size(path, err);
+        if (err) {
+            return false;
+        }
+        stamp = (int64_t) time.time_since_epoch().count();
+        return stamp != 0;
+    }
+
+    // Same filters the browser always applied to ListFiles({"hmintro/*", "*tracks/*", "actors/*", "objects/*"})
+    static bool IsBrowsableContent(const std::string& file) {
+        if ((file.rfind("hmintro/", 0) != 0) && (file.find("tracks/") == std::string::npos) &&
+            (file.rfind("actors/", 0) != 0) && (file.rfind("objects/", 0) != 0)) {
+            return false;
+        }
+
+        if (file.find("/mat_") != std::string::npos) {
+            return false;
+        } else if (file.size() >= 6 && file.substr(file.size() - 6, 5) == "_tri_" && isdigit(file.back())) {
+            // ends with _tri_#
+            return false;
+        } else if (file.find("_vtx_") != std::string::npos) {
+            // Has _vtx_
+            return false;
+        } else if (file.find('.') != std::string::npos) {
+            // File has an extension
+            return false;
+        }
+        return true;
+    }
+
+    static std::string GetArchiveIndexPath() {
+        return Ship::Context::GetPathRelativeToAppDirectory("content_index.json");
+    }
+
+    void ContentBrowserWindow::LoadArchiveIndex() {
+        ArchiveIndexLoaded = true;
+
+        std::ifstream file(GetArchiveIndexPath());
+        if (!file.is_open()) {
+            return;
+        }
+
+        try {
+            nlohmann::json data = nlohmann::json::parse(file);
+            if (data.at("Version").get<int>() != 1) {
+                return;
+            }
+            for (const auto& archive : data.at("Archives")) {
+                ArchiveIndexEntry entry;
+                entry.Stamp = archive.at("Stamp").get<int64_t>();
+                entry.Size = archive.at("Size").get<uint64_t>();
+                entry.TrackDirs = archive.at("Tracks").get<std::vector<std::string>>();
+                entry.Content = archive.at("Content").get<std::vector<std::string>>();
+                ArchiveIndex[archive.at("Path").get<std::string>()] = std::move(entry);
+            }
+        } catch (const nlohmann::json::exception& e) {
+            printf("ContentBrowser.cpp: Ignoring invalid content index: %s\n", e.what());
+            ArchiveIndex.clear();
+        }
+    }
+
+    void ContentBrowserWindow::SaveArchiveIndex() {
+        nlohmann::json archives = nlohmann::json::array();
+        for (const auto& [path, entry] : ArchiveIndex) {
+            archives.push_back({
+                { "Path", path },
+                { "Stamp", entry.Stamp },
+                { "Size", entry.Size },
+                { "Tracks", entry.TrackDirs },
+                { "Content", entry.Content },
+            });
+        }
+
+        std::ofstream file(GetArchiveIndexPath());
+        if (!file.is_open()) {
+            printf("ContentBrowser.cpp: Could not write %s\n", GetArchiveIndexPath().c_str());
+            return;
+        }
+        file << nlohmann::json({ { "Version", 1 }, { "Archives", archives } }).dump();
+    }
+
+    // Rescans only the archives whose stamp changed since they were indexed.
+    void ContentBrowserWindow::UpdateArchiveIndex() {
+        if (!ArchiveIndexLoaded) {
+            LoadArchiveIndex();
+        }
+
+        auto manager = GameEngine::Instance->context->GetResourceManager()->GetArchiveManager();
+        auto archives = manager->GetArchives();
+
+        std::map<std::string, ArchiveIndexEntry> index;
+        ChangedArchives.clear();
+        ArchiveOrder.clear();
+
+        for (const auto& archive : *archives) {
+            const std::string& path = archive->GetPath();
+            ArchiveIndexEntry entry;
+            bool validated = GetArchiveStamp(path, entry.Stamp, entry.Size);
+            ArchiveOrder.push_back(path);
+
+            auto cached = ArchiveIndex.find(path);
+            if (validated && (cached != ArchiveIndex.end()) && (cached->second.Stamp == entry.Stamp) &&
+                (cached->second.Size == entry.Size)) {
+                index[path] = std::move(cached->second);
+                ArchiveIndex.erase(cached);
+                continue;
+            }
+
+            auto files = archive->ListFiles();
+            if (files != nullptr) {
+                std::set<std::string> trackDirs;
+                for (const auto& [hash, file] : *files) {
+                    // tracks/<name>/...
+                    if (file.rfind("tracks/", 0) == 0) {
+                        size_t end = file.find('/', 7);
+                        if (end != std::string::npos) {
+                            trackDirs.insert(file.substr(0, end));
+                        }
+                    }
+                    if (IsBrowsableContent(file)) {
+                        entry.Content.push_back(file);
+                    }
+                }
+                entry.TrackDirs.assign(trackDirs.begin(), trackDirs.end());
+                std::sort(entry.Content.begin(), entry.Content.end());
+            }
+            if (!validated) {
+                entry.Stamp = 0;
+            }
+            index[path] = std::move(entry);
+            ChangedArchives.insert(path);
+        }
+
+        // Entries left over belong to archives that changed or were unmounted; their tracks must go too.
+        for (const auto& [path, entry] : ArchiveIndex) {
+            ChangedArchives.insert(path);
+        }
+
+        std::unordered_set<std::string> staleDirs;
+        for (const auto& path : ChangedArchives) {
+            for (const auto* source : { &ArchiveIndex, &index }) {
+                auto it = source->find(path);
+                if (it != source->end()) {
+                    staleDirs.insert(it->second.TrackDirs.begin(), it->second.TrackDirs.end());
+                }
+            }
+        }
+        RemoveStaleTracks(staleDirs);
+
+        bool dirty = !ChangedArchives.empty();
+        ArchiveIndex = std::move(index);
+
+        if (dirty) {
+            // Archives were mounted, unmounted or rewritten, so cached paths may resolve elsewhere now
+            GameEngine_InvalidateResolutionCache();
+            SaveArchiveIndex();
+        }
+    }
+
     // Finds modded archives only. For discovering tracks
     void ContentBrowserWindow::FindTracks() {
         auto manager = GameEngine::Instance->context->GetResourceManager()->GetArchiveManager();
 
-        auto ptr2 = manager->ListDirectories("tracks/*");
-        if (ptr2) {
-            auto dirs = *ptr2;
+        std::unordered_set<std::string> known;
+        for (const auto& track : Tracks) {
+            known.insert(track.Dir);
+        }
+
+        for (const auto& archivePath : ArchiveOrder) {
+            for (const std::string& dir : ArchiveIndex[archivePath].TrackDirs) {
+                if (!known.insert(dir).second) {
+                    continue;
+                }
 
-            for (const std::string& dir : dirs) {
                 std::string name = dir.substr(dir.find_last_of('/') + 1);
                 std::string sceneFile = dir + "/scene.json";
                 std::string minimapFile = dir + "/minimap.png";
+                std::string binarySceneFile = GetBinarySceneFile(sceneFile);
                 // The track has a valid scene file
-                if (manager->HasFile(sceneFile)) {
-                    auto archive = manager->GetArchiveFromFile(sceneFile);
+                if (manager->HasFile(binarySceneFile) || manager->HasFile(sceneFile)) {
+                    auto archive = manager->GetArchiveFromFile(manager->HasFile(binarySceneFile) ? binarySceneFile
+                                                                                                : sceneFile);
                     
                     auto course = std::make_shared<Course>();
+                    course->Id = std::string("mods:") + name;
                     course->LoadO2R(dir);
                     LoadLevel(archive, course.get(), sceneFile);
                     LoadMinimap(archive, course.get(), minimapFile);
                     Tracks.push_back({nullptr, course, sceneFile, name, dir, archive});
-                    gWorldInstance.Courses.push_back(std::move(course));
+                    gWorldInstance.AddCourse(std::move(course));
                 } else { // The track does not have a valid scene file
                     const std::string file = dir + "/data_track_sections";
                     
@@ -268,24 +408,14 @@ namespace Editor {
     }
 
     void ContentBrowserWindow::FindContent() {
-        auto ptr = GameEngine::Instance->context->GetResourceManager()->GetArchiveManager()->ListFiles({"hmintro/*", "*tracks/*","actors/*", "objects/*"}, {""});
-        if (ptr) {
-            auto files = *ptr;
-            for (const auto& file : files) {
-                if (file.find("/mat_") != std::string::npos) {
-                    continue;
-                } else if (file.size() >= 6 && file.substr(file.size() - 6, 5) == "_tri_" && isdigit(file.back())) {
-                    // ends with _tri_#
-                    continue;
-                } else if (file.find("_vtx_") != std::string::npos) {
-                    // Has _vtx_
-                    continue;
-                } else if (file.find('.') != std::string::npos) {
-                    // File has an extension
-                    continue;
+        std::unordered_set<std::string> seen;
+        Content.clear();
+        for (const auto& archivePath : ArchiveOrder) {
+            for (const auto& file : ArchiveIndex[archivePath].Content) {
+                // Archives mounted later can override the same file
+                if (seen.insert(file).second) {
+                    Content.push_back(file);
                 }
-
-                Content.push_back(file);
             }
         }
     }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <libultraship/libultraship.h>
+#include <map>
+#include <unordered_set>
 #include "engine/courses/Course.h"
 
 namespace Editor {
@@ -22,6 +24,22 @@ public:
 
     std::vector<std::string> Content;
 
+    /**
+     * What one archive contributes to the browser. Archives whose file stamp still matches are not
+     * rescanned on refresh; the index is saved to content_index.json so this also holds across launches.
+     */
+    struct ArchiveIndexEntry {
+        int64_t Stamp = 0; // Last write time, 0 if the archive cannot be validated (e.g. a folder)
+        uint64_t Size = 0;
+        std::vector<std::string> TrackDirs;
+        std::vector<std::string> Content;
+    };
+
+    std::map<std::string, ArchiveIndexEntry> ArchiveIndex; // Keyed by archive path
+    std::vector<std::string> ArchiveOrder; // Mount order of the indexed archives
+    std::unordered_set<std::string> ChangedArchives; // Rescanned or removed during the last refresh
+    bool ArchiveIndexLoaded = false;
+
     bool Refresh = true;
 
     bool ActorContent = false;
@@ -33,10 +51,13 @@ protected:
     void DrawElement() override;
     void UpdateElement() override {};
     void AddTrackContent();
-    void RemoveCustomTracksFromTrackList(); // Prevents duplicate courses being added to World->Courses array
+    void RemoveStaleTracks(const std::unordered_set<std::string>& staleDirs); // Prevents duplicate courses being added to World->Courses array
     void AddActorContent();
     void AddObjectContent();
     void AddCustomContent();
+    void LoadArchiveIndex();
+    void SaveArchiveIndex();
+    void UpdateArchiveIndex();
     void FindTracks();
     void FindContent();
     void FolderButton(const char* label, bool& contentFlag, const ImVec2& size = ImVec2(80, 32));
@@ -0,0 +1,128 @@
+#include "FramePacingWindow.h"
+#include "libultraship/src/Context.h"
+
+#include <imgui.h>
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <libultraship/libultraship.h>
+#include <spdlog/fmt/fmt.h>
+
+#include "port/FramePacing.h"
+
+namespace GameUI {
+
+namespace {
+
+constexpr int kHistogramBuckets = 100;
+constexpr float kHistogramBucketMs = 0.5f;
+
+struct Percentiles {
+    float P50 = 0.0f;
+    float P95 = 0.0f;
+    float P99 = 0.0f;
+    float Max = 0.0f;
+};
+
+// Reorders values
+Percentiles GetPercentiles(std::vector<float>& values) {
+    Percentiles result;
+    if (values.empty()) {
+        return result;
+    }
+
+    auto at = [&](float fraction) {
+        auto nth = values.begin() + (size_t) (fraction * (values.size() - 1));
+        std::nth_element(values.begin(), nth, values.end());
+        return *nth;
+    };
+    result.P50 = at(0.50f);
+    result.P95 = at(0.95f);
+    result.P99 = at(0.99f);
+    result.Max = *std::max_element(values.begin(), values.end());
+    return result;
+}
+
+template <typename F> Percentiles GetMetric(const std::vector<FramePacingSample>& samples, F getNs) {
+    std::vector<float> values;
+    values.reserve(samples.size());
+    for (const FramePacingSample& sample : samples) {
+        values.push_back((float) getNs(sample) / 1000000.0f);
+    }
+    return GetPercentiles(values);
+}
+
+void MetricRow(const char* name, const Percentiles& p) {
+    ImGui::TableNextRow();
+    ImGui::TableNextColumn();
+    ImGui::TextUnformatted(name);
+    for (float value : { p.P50, p.P95, p.P99, p.Max }) {
+        ImGui::TableNextColumn();
+        ImGui::Text("%.2f", value);
+    }
+}
+
+} // namespace
+
+FramePacingWindow::~FramePacingWindow() {
+    SPDLOG_TRACE("destruct frame pacing window");
+}
+
+void FramePacingWindow::DrawElement() {
+    static int sWindowSize = 600;
+    static std::string sExportStatus;
+    static std::vector<FramePacingSample> sSamples(FRAME_PACING_CAPACITY);
+
+    ImGui::SliderInt("Samples", &sWindowSize, 60, FRAME_PACING_CAPACITY);
+    size_t count = FramePacing::GetRecentSamples(sSamples.data(), sWindowSize);
+    std::vector<FramePacingSample> samples(sSamples.begin(), sSamples.begin() + count);
+
+    // The first present after startup has no interval
+    std::vector<FramePacingSample> presents;
+    presents.reserve(samples.size());
+    std::copy_if(samples.begin(), samples.end(), std::back_inserter(presents),
+                 [](const FramePacingSample& sample) { return sample.presentIntervalNs != 0; });
+
+    ImGui::Text("%zu presents", samples.size());
+    if (ImGui::BeginTable("FramePacingStats", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("ms");
+        ImGui::TableSetupColumn("p50");
+        ImGui::TableSetupColumn("p95");
+        ImGui::TableSetupColumn("p99");
+        ImGui::TableSetupColumn("max");
+        ImGui::TableHeadersRow();
+        MetricRow("Present interval",
+                  GetMetric(presents, [](const FramePacingSample& s) { return s.presentIntervalNs; }));
+        MetricRow("Logic ticks", GetMetric(samples, [](const FramePacingSample& s) { return s.logicNs; }));
+        MetricRow("Display list build", GetMetric(samples, [](const FramePacingSample& s) { return s.buildNs; }));
+        MetricRow("Interpolation", GetMetric(samples, [](const FramePacingSample& s) { return s.interpolationNs; }));
+        ImGui::EndTable();
+    }
+
+    float buckets[kHistogramBuckets] = { 0 };
+    float highest = 0.0f;
+    for (const FramePacingSample& sample : presents) {
+        int bucket = (int) (((float) sample.presentIntervalNs / 1000000.0f) / kHistogramBucketMs);
+        bucket = std::min(bucket, kHistogramBuckets - 1);
+        buckets[bucket] += 1.0f;
+        highest = std::max(highest, buckets[bucket]);
+    }
+    std::string overlay = fmt::format("Present interval, {:.1f} ms per bar", kHistogramBucketMs);
+    ImGui::PlotHistogram("##PresentHistogram", buckets, kHistogramBuckets, 0, overlay.c_str(), 0.0f, highest,
+                         ImVec2(ImGui::GetContentRegionAvail().x, 120));
+
+    if (ImGui::Button("Export CSV")) {
+        std::string path = Ship::Context::GetPathRelativeToAppDirectory("frame_pacing.csv");
+        sExportStatus = FramePacing::ExportCsv(path, FRAME_PACING_CAPACITY) ? ("Wrote " + path) : "Export failed";
+    }
+    if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Saves the last %d presents to frame_pacing.csv in the app folder", FRAME_PACING_CAPACITY);
+    }
+    if (!sExportStatus.empty()) {
+        ImGui::SameLine();
+        ImGui::TextUnformatted(sExportStatus.c_str());
+    }
+}
+
+} // namespace GameUI
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <libultraship/libultraship.h>
+
+namespace GameUI {
+class FramePacingWindow : public Ship::GuiWindow {
+public:
+    using Ship::GuiWindow::GuiWindow;
+    ~FramePacingWindow();
+protected:
+    void InitElement() override {};
+    void DrawElement() override;
+    void UpdateElement() override {};
+};
+}
@@ -8,6 +8,7 @@
 #include "Properties.h"
 #include "TrackProperties.h"
 #include "ContentBrowser.h"
+#include "FramePacingWindow.h"
 
 #include <spdlog/spdlog.h>
 #include <imgui.h>
@@ -40,6 +41,7 @@ std::shared_ptr<Ship::GuiWindow> mSceneExplorerWindow;
 std::shared_ptr<Ship::GuiWindow> mPropertiesWindow;
 std::shared_ptr<Ship::GuiWindow> mTrackPropertiesWindow;
 std::shared_ptr<Ship::GuiWindow> mContentBrowserWindow;
+std::shared_ptr<Ship::GuiWindow> mFramePacingWindow;
 
 void SetupGuiElements() {
     auto gui = Ship::Context::GetInstance()->GetWindow()->GetGui();
@@ -92,6 +94,9 @@ void SetupGuiElements() {
     mContentBrowserWindow =
         std::make_shared<Editor::ContentBrowserWindow>("gEditorEnabled", "Content Browser");
     gui->AddGuiWindow(mContentBrowserWindow);
+
+    mFramePacingWindow = std::make_shared<GameUI::FramePacingWindow>("gFramePacingEnabled", "Frame Pacing");
+    gui->AddGuiWindow(mFramePacingWindow);
 }
 
 void Destroy() {
@@ -103,6 +108,7 @@ void Destroy() {
     mPropertiesWindow = nullptr;
     mTrackPropertiesWindow = nullptr;
     mContentBrowserWindow = nullptr;
+    mFramePacingWindow = nullptr;
 }
 
 std::string GetWindowButtonText(const char* text, bool menuOpen) {
@@ -67,6 +67,27 @@ void DrawColumn1(WidgetInfo& info) {
     if (gNetwork.isConnected) {
         ImGui::EndDisabled();
     }
+
+    ImGui::Spacing();
+    ImGui::Text("Replication:");
+    ImGui::Text("Sent: %u B/s (%u packets, %u full)", gReplicationStats.bytesSentPerSecond,
+                gReplicationStats.packetsSent, gReplicationStats.fullSnapshotsSent);
+    ImGui::Text("Received: %u B/s (%u packets, %u rejected)", gReplicationStats.bytesReceivedPerSecond,
+                gReplicationStats.packetsReceived, gReplicationStats.packetsRejected);
+    ImGui::Text("Dropped by simulation: %u", gReplicationStats.packetsDropped);
+
+    static ReplicationConditions conditions = { 0, 0, 0 };
+    bool changed = ImGui::SliderInt("Packet loss %", &conditions.lossPercent, 0, 50);
+    changed |= ImGui::SliderInt("Latency ms", &conditions.latencyMs, 0, 500);
+    changed |= ImGui::SliderInt("Jitter ms", &conditions.jitterMs, 0, 200);
+    if (changed) {
+        replication_set_conditions(&conditions);
+    }
+
+    // Sends snapshots to ourselves, exercises delta encoding, acks and baselines without a server
+    if (!gNetwork.isConnected && ImGui::Button("Loopback test")) {
+        replication_init_loopback(64011);
+    }
 }
 
 void DrawColumn2(WidgetInfo& info) {
@@ -1,6 +1,7 @@
 #include "PortMenu.h"
 #include "UIWidgets.h"
 #include "port/Game.h"
+#include "port/Engine.h"
 #include "window/gui/GuiMenuBar.h"
 #include "window/gui/GuiElement.h"
 #include <variant>
@@ -23,7 +24,10 @@ extern s32 gGamestateNext;
 extern s32 gMenuSelection;
 #include "audio/external.h"
 #include "defines.h"
+#include "replays.h"
 }
+#include "profiler.h"
+#include "engine/wasm.h"
 
 namespace GameUI {
 extern std::shared_ptr<PortMenu> mPortMenu;
@@ -525,6 +529,61 @@ void PortMenu::AddDevTools() {
     AddWidget(path, "Render Collision", WIDGET_CVAR_CHECKBOX)
         .CVar("gRenderCollisionMesh")
         .Options(CheckboxOptions().Tooltip("Renders the collision mesh instead of the course mesh"));
+    AddWidget(path, "Start Trace Capture", WIDGET_BUTTON)
+        .PreFunc([](WidgetInfo& info) { info.isHidden = gTraceCaptureActive; })
+        .Callback([](WidgetInfo& info) { trace_capture_start(); })
+        .Options(ButtonOptions().Tooltip("Records profiler zones from every thread until the capture is stopped."));
+    AddWidget(path, "Stop Trace Capture", WIDGET_BUTTON)
+        .PreFunc([](WidgetInfo& info) { info.isHidden = !gTraceCaptureActive; })
+        .Callback([](WidgetInfo& info) {
+            trace_capture_stop(Ship::Context::GetPathRelativeToAppDirectory("trace.json").c_str());
+        })
+        .Options(ButtonOptions().Tooltip("Saves the capture to trace.json in the app folder. Open it in "
+                                         "ui.perfetto.dev or chrome://tracing."));
+    AddWidget(path, "Determinism Check Ticks", WIDGET_CVAR_SLIDER_INT)
+        .CVar("gDeterminismCheckTicks")
+        .Options(IntSliderOptions()
+                     .Tooltip("Number of game ticks simulated by the determinism check")
+                     .Min(1)
+                     .Max(600)
+                     .DefaultValue(120));
+    AddWidget(path, "Determinism Check", WIDGET_BUTTON)
+        .Callback([](WidgetInfo& info) { CM_RequestDeterminismCheck(CVarGetInteger("gDeterminismCheckTicks", 120)); })
+        .Options(ButtonOptions().Tooltip("Saves the race state, simulates it twice from the same snapshot and "
+                                         "compares the resulting state hashes. Results are printed to the console."));
+    AddWidget(path, "Replay: Back 10 Seconds", WIDGET_BUTTON)
+        .Callback([](WidgetInfo& info) { replays_request_seek(-10 * 30); })
+        .Options(ButtonOptions().Tooltip("Rewinds the replay shown after a time trial to the nearest keyframe "
+                                         "and plays forward from there."));
+    AddWidget(path, "Replay: Forward 10 Seconds", WIDGET_BUTTON)
+        .Callback([](WidgetInfo& info) { replays_request_seek(10 * 30); })
+        .Options(ButtonOptions().Tooltip("Skips ahead in the replay shown after a time trial."));
+
+    AddWidget(path, "Print Asset Cache Stats", WIDGET_BUTTON)
+        .Callback([](WidgetInfo& info) {
+            uint64_t hits;
+            uint64_t misses;
+            GameEngine_GetResolutionCacheStats(&hits, &misses);
+            printf("[GBI] Asset path cache: %llu hits, %llu misses (%.1f%% hit rate)\n", (unsigned long long) hits,
+                   (unsigned long long) misses, (hits + misses) ? (100.0 * hits / (hits + misses)) : 0.0);
+            GameEngine_ResetResolutionCacheStats();
+        })
+        .Options(ButtonOptions().Tooltip("Prints how often __OTR__ paths in display lists were resolved from the "
+                                         "cache since the last print, then resets the counters."));
+#ifdef USE_WASM_MODS
+    AddWidget(path, "WASM Mod Budget (us)", WIDGET_CVAR_SLIDER_INT)
+        .CVar("gWasmTickBudgetUs")
+        .Options(IntSliderOptions()
+                     .Tooltip("Time WebAssembly mods may spend per game tick, split evenly between them. A mod "
+                              "that keeps running past its share is disabled.")
+                     .Min(100)
+                     .Max(16000)
+                     .DefaultValue(2000));
+    AddWidget(path, "Benchmark WASM Host Calls", WIDGET_BUTTON)
+        .Callback([](WidgetInfo& info) { wasm_benchmark_host_calls(1000000); })
+        .Options(ButtonOptions().Tooltip("Times one million host calls in every mod exporting bench_host_calls. "
+                                         "Results are printed to the console."));
+#endif
 
     path = { "Developer", "Gfx Debugger", SECTION_COLUMN_1 };
     AddSidebarEntry("Developer", "Gfx Debugger", 1);
@@ -541,6 +600,11 @@ void PortMenu::AddDevTools() {
         .Options(ButtonOptions().Tooltip(
             "Shows the stats window, with your FPS and frametimes, and the OS you're playing on"))
         .WindowName("Stats");
+    AddWidget(path, "Popout Frame Pacing", WIDGET_WINDOW_BUTTON)
+        .CVar("gFramePacingEnabled")
+        .Options(ButtonOptions().Tooltip(
+            "Shows p50/p95/p99 present intervals, logic, display list and interpolation times, with CSV export"))
+        .WindowName("Frame Pacing");
 
     path = { "Developer", "Console", SECTION_COLUMN_1 };
     AddSidebarEntry("Developer", "Console", 1);
@@ -29,6 +29,7 @@ namespace Editor {
         }
 
         ImGui::Begin("Properties");
+        bool edited = false;
 
         if (selected->Pos) {
             ImGui::Text("Location");
@@ -46,6 +47,7 @@ namespace Editor {
 
             if (positionChanged) {
                 gEditor.eObjectPicker.eGizmo.Pos = *selected->Pos;
+                edited = true;
             }
         }
 
@@ -69,6 +71,7 @@ namespace Editor {
                 selected->Rot->pitch = static_cast<uint16_t>(rot[0]);
                 selected->Rot->yaw   = static_cast<uint16_t>(rot[1]);
                 selected->Rot->roll  = static_cast<uint16_t>(rot[2]);
+                edited = true;
             }
 
             ImGui::SameLine();
@@ -76,6 +79,7 @@ namespace Editor {
                 selected->Rot->pitch = 0;
                 selected->Rot->yaw   = 0;
                 selected->Rot->roll  = 0;
+                edited = true;
             }
         }
 
@@ -83,12 +87,13 @@ namespace Editor {
             ImGui::Text("Scale   ");
             ImGui::SameLine();
 
-            ImGui::DragFloat3("##Scale", &selected->Scale->x, 0.1f);
+            edited |= ImGui::DragFloat3("##Scale", &selected->Scale->x, 0.1f);
             ImGui::SameLine();
             if (ImGui::Button(ICON_FA_UNDO "##ResetScale")) {
                 selected->Scale->x = 1.0f;
                 selected->Scale->y = 1.0f;
                 selected->Scale->z = 1.0f;
+                edited = true;
             }
         }
 
@@ -102,6 +107,9 @@ namespace Editor {
             ImGui::PopID();
         }
 
+        if (edited) {
+            selected->MarkEdited();
+        }
         ImGui::End();
     }
 }
\ No newline at end of file
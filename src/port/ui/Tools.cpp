@@ -40,6 +40,15 @@ namespace Editor {
 
         ImGui::SameLine();
 
+        if (ImGui::Button("JSON", ImVec2(50, 25))) {
+            ExportLevelJson();
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("Export the scene as scene.json for diffing");
+        }
+
+        ImGui::SameLine();
+
         ImVec4 defaultColor = ImGui::GetStyle().Colors[ImGuiCol_Button];
         // Function to check and highlight the selected button
         auto ToolButton = [&](const char* label, int id) {
@@ -7,6 +7,7 @@
 #include <unordered_map>
 #include <libultraship/libultra/types.h>
 #include <spdlog/fmt/fmt.h>
+#include "port/Settings.h"
 
 namespace UIWidgets {
 
@@ -292,6 +293,7 @@ bool CVarCheckbox(const char* label, const char* cvarName, const CheckboxOptions
     if (Checkbox(label, &value, options)) {
         CVarSetInteger(cvarName, value);
         Ship::Context::GetInstance()->GetWindow()->GetGui()->SaveConsoleVariablesNextFrame();
+        Settings_MarkDirty();
         dirty = true;
     }
     return dirty;
@@ -405,6 +407,7 @@ bool CVarSliderInt(const char* label, const char* cvarName, const IntSliderOptio
     if (SliderInt(label, &value, options)) {
         CVarSetInteger(cvarName, value);
         Ship::Context::GetInstance()->GetWindow()->GetGui()->SaveConsoleVariablesNextFrame();
+        Settings_MarkDirty();
         dirty = true;
     }
     return dirty;
@@ -515,6 +518,7 @@ bool CVarSliderFloat(const char* label, const char* cvarName, const FloatSliderO
     if (SliderFloat(label, &value, options)) {
         CVarSetFloat(cvarName, value);
         Ship::Context::GetInstance()->GetWindow()->GetGui()->SaveConsoleVariablesNextFrame();
+        Settings_MarkDirty();
         dirty = true;
     }
     return dirty;
@@ -532,6 +536,7 @@ bool CVarColorPicker(const char* label, const char* cvarName, Color_RGBA8 defaul
         color.a = (uint8_t)(colorVec.w * 255.0f);
         CVarSetColor(cvarName, color);
         Ship::Context::GetInstance()->GetWindow()->GetGui()->SaveConsoleVariablesNextFrame();
+        Settings_MarkDirty();
         changed = true;
     }
     PopStyleCombobox();
@@ -10,6 +10,7 @@
 #include <libultraship/libultraship.h>
 #include <unordered_map>
 #include "port/ShipUtils.h"
+#include "port/Settings.h"
 
 namespace UIWidgets {
 
@@ -666,6 +667,7 @@ namespace UIWidgets {
         if (Combobox<T>(label, &value, comboMap, options)) {
             CVarSetInteger(cvarName, value);
             Ship::Context::GetInstance()->GetWindow()->GetGui()->SaveConsoleVariablesNextFrame();
+            Settings_MarkDirty();
             dirty = true;
         }
         return dirty;
@@ -678,6 +680,7 @@ namespace UIWidgets {
         if (Combobox<T>(label, &value, comboVector, options)) {
             CVarSetInteger(cvarName, value);
             Ship::Context::GetInstance()->GetWindow()->GetGui()->SaveConsoleVariablesNextFrame();
+            Settings_MarkDirty();
             dirty = true;
         }
         return dirty;
@@ -690,6 +693,7 @@ namespace UIWidgets {
         if (Combobox<T>(label, &value, comboArray, options)) {
             CVarSetInteger(cvarName, value);
             Ship::Context::GetInstance()->GetWindow()->GetGui()->SaveConsoleVariablesNextFrame();
+            Settings_MarkDirty();
             dirty = true;
         }
         return dirty;
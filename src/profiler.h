@@ -1,6 +1,10 @@
 #ifndef PROFILER_H
 #define PROFILER_H
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 extern u64 osClockRate;
 
 struct ProfilerFrameData {
@@ -36,4 +40,64 @@ void resource_display(void);
 
 extern s32 gEnableResourceMeters;
 
+/**
+ * @brief Scoped trace zones exported in the Chrome trace event format (chrome://tracing, ui.perfetto.dev).
+ *
+ * Zones nest per thread and can be opened from any thread, including the audio and network threads.
+ * Zone names must be string literals. While no capture is running a zone costs a single load and branch.
+ */
+extern s32 gTraceCaptureActive;
+
+void trace_zone_begin(const char* name);
+void trace_zone_end(void);
+void trace_set_thread_name(const char* name);
+void trace_capture_start(void);
+s32 trace_capture_stop(const char* path);
+
+#define TRACE_ZONE_BEGIN(name)         \
+    do {                               \
+        if (gTraceCaptureActive) {     \
+            trace_zone_begin(name);    \
+        }                              \
+    } while (0)
+
+#define TRACE_ZONE_END()               \
+    do {                               \
+        if (gTraceCaptureActive) {     \
+            trace_zone_end();          \
+        }                              \
+    } while (0)
+
+#ifdef __cplusplus
+}
+
+/**
+ * @brief RAII trace zone for C++ code. Closes the zone it opened even if the capture stops meanwhile.
+ */
+class TraceZone {
+public:
+    explicit TraceZone(const char* name) : mActive(gTraceCaptureActive != 0) {
+        if (mActive) {
+            trace_zone_begin(name);
+        }
+    }
+
+    ~TraceZone() {
+        if (mActive) {
+            trace_zone_end();
+        }
+    }
+
+    TraceZone(const TraceZone&) = delete;
+    TraceZone& operator=(const TraceZone&) = delete;
+
+private:
+    bool mActive;
+};
+
+#define TRACE_ZONE_CONCAT2(a, b) a##b
+#define TRACE_ZONE_CONCAT(a, b) TRACE_ZONE_CONCAT2(a, b)
+#define TRACE_ZONE(name) TraceZone TRACE_ZONE_CONCAT(sTraceZone, __LINE__)(name)
+#endif
+
 #endif /* PROFILER_H */
@@ -35,6 +35,7 @@
 #include <assets/frappe_snowland_data.h>
 #include "port/Game.h"
 #include "port/interpolation/FrameInterpolation.h"
+#include "port/Settings.h"
 
 // Appears to be textures
 // or tluts
@@ -670,7 +671,7 @@ void render_palm_trees(Camera* camera, Mat4 arg1) {
 
         if (is_within_render_distance(camera->pos, spD4, camera->rot[1], 0.0f, gCameraZoom[camera - camera1], var_f22) <
                 0.0f &&
-            CVarGetInteger("gNoCulling", 0) == 0) {
+            gSettings.noCulling == 0) {
             var_s1++;
             continue;
         }
@@ -735,7 +736,7 @@ void render_actor_shell(Camera* camera, Mat4 matrix, struct ShellActor* shell) {
 
     f32 temp_f0 =
         is_within_render_distance(camera->pos, shell->pos, camera->rot[1], 0, gCameraZoom[camera - camera1], 490000.0f);
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gSettings.noCulling == 1) {
         temp_f0 = CLAMP(temp_f0, 0.0f, 40000.0f);
     }
     s32 maxObjectsReached;
@@ -816,7 +817,7 @@ UNUSED void func_8029ABD4(f32* pos, s16 state) {
 void func_8029AC18(Camera* camera, Mat4 arg1, struct Actor* arg2) {
     if (is_within_render_distance(camera->pos, arg2->pos, camera->rot[1], 0, gCameraZoom[camera - camera1],
                                   4000000.0f) < 0 &&
-        CVarGetInteger("gNoCulling", 0) == 0) {
+        gSettings.noCulling == 0) {
         return;
     }
 
@@ -1280,17 +1281,21 @@ void play_sound_before_despawn(struct Actor* actor) {
  * Actors are expected to set members such as pos and rot data if used. Not doing so could result in the use of expired
  * data.
  *
- * This method does not require modification to gActorList directly.
- * No popping members of gActorList. The list is always the size of ACTOR_LIST_SIZE.
- * Actors are members of gActorList by definition.
+ * The actor is also marked for the garbage collector, which frees it once no live actor sits after it.
+ * Indices that outlive it read back as an empty slot, see CM_GetActor.
  *
  * @param Actor to destroy
  */
 void destroy_actor(struct Actor* actor) {
+    ActorHandle handle = CM_GetActorHandle(actor);
+
     play_sound_before_despawn(actor);
     actor->flags = 0;
     actor->type = 0;
     gNumActors--;
+    if (CM_ResolveActorHandle(handle) != NULL) {
+        CM_DeleteActor(ACTOR_HANDLE_INDEX(handle));
+    }
 }
 
 s16 try_remove_destructable_item(Vec3f pos, Vec3s rot, Vec3f velocity, s16 actorType) {
@@ -1414,20 +1419,11 @@ s16 try_remove_destructable_item(Vec3f pos, Vec3s rot, Vec3f velocity, s16 actor
 
 // returns actor index if any available actor type is -1
 s16 add_actor_to_empty_slot(Vec3f pos, Vec3s rot, Vec3f velocity, s16 actorType) {
-    size_t index;
-
     // if (gNumActors >= CM_GetActorSize()) {
     //     return try_remove_destructable_item(pos, rot, velocity, actorType);
     // }
 
-    // Cleanup unused actors
-    for (index = 0; index < CM_GetActorSize(); index++) {
-        // if (CM_GetActor(index)->flags == 0) {
-        //! @todo Commented out because deletes too soon.
-        // CM_DeleteActor(index);
-        // gNumActors--;
-        //}
-    }
+    // Destroyed actors are freed by the garbage collector, see destroy_actor
     gNumActors++;
     struct Actor* actor = CM_AddBaseActor();
     actor_init(actor, pos, rot, velocity, actorType);
@@ -2433,7 +2429,7 @@ void render_course_actors(struct UnkStruct_800DC5EC* arg0) {
     // Freecam rotY is reversed in the engine for whatever reason
     f32 sp48 = 0;
     f32 temp_f0 = 0;
-    if (CVarGetInteger("gFreecam", 0) == true) {
+    if (gSettings.freecam == true) {
         sp48 = sins(-camera->rot[1] - 0x8000);
         temp_f0 = coss(-camera->rot[1] - 0x8000);
     } else {
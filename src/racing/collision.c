@@ -12,6 +12,7 @@
 #include <defines.h>
 #include "port/Game.h"
 #include <stdio.h>
+#include "port/Settings.h"
 
 #pragma intrinsic(sqrtf)
 
@@ -808,7 +809,7 @@ s32 is_colliding_with_drivable_surface(Collision* collision, f32 boundingBoxSize
  */
 s32 is_colliding_with_wall2(Collision* arg, f32 boundingBoxSize, f32 x1, f32 y1, f32 z1, u16 surfaceIndex, f32 posX,
                             f32 posY, f32 posZ) {
-    if (CVarGetInteger("gNoWallColision", 0)) {
+    if (gSettings.noWallCollision) {
         return NO_COLLISION;
     }
     CollisionTriangle* triangle = &gCollisionMesh[surfaceIndex];
@@ -993,7 +994,7 @@ s32 is_colliding_with_wall2(Collision* arg, f32 boundingBoxSize, f32 x1, f32 y1,
  */
 s32 is_colliding_with_wall1(Collision* arg, f32 boundingBoxSize, f32 x1, f32 y1, f32 z1, u16 surfaceIndex, f32 posX,
                             f32 posY, f32 posZ) {
-    if (CVarGetInteger("gNoWallColision", 0)) {
+    if (gSettings.noWallCollision) {
         return NO_COLLISION;
     }
     CollisionTriangle* triangle = &gCollisionMesh[surfaceIndex];
@@ -1,5 +1,6 @@
 #include <libultraship.h>
 #include "framebuffer_effects.h"
+#include "framebuffer_readback.h"
 #include "mk64.h"
 #include <assets/common_data.h>
 #include "port/Engine.h"
@@ -17,6 +18,10 @@ s32 gReusableFrameBuffer = -1;
 // N64 resolution sized buffer (320x240), used by picto box and deku bubble
 s32 gN64ResFrameBuffer = -1;
 
+// 320x240 RGBA16 slices of the final frame, sampled by the jumbotrons
+static u16 sReadbackBuffers[FB_READBACK_BUFFER_COUNT][SCREEN_WIDTH * SCREEN_HEIGHT];
+static FBReadbackQueue sReadbackQueue = { 0, 0, 0, -1, -1 };
+
 void FB_CreateFramebuffers(void) {
     if (gReusableFrameBuffer == -1) {
         gReusableFrameBuffer = gfx_create_framebuffer(SCREEN_WIDTH, SCREEN_HEIGHT, SCREEN_WIDTH, SCREEN_HEIGHT, true);
@@ -168,3 +173,29 @@ void FB_DrawFromFramebufferScaled(Gfx** gfxP, s32 fb, u8 alpha, float scaleX, fl
 
     *gfxP = gfx;
 }
+
+/**
+ * Registers interest in the framebuffer slice. Call this every frame the slice is sampled; the readback is skipped
+ * entirely on frames where nothing subscribed.
+ * Returns the slice written at the end of the previous frame, or NULL if it was not read back.
+ */
+u16* FB_SubscribeReadback(void) {
+    s32 index;
+
+    FBReadback_Subscribe(&sReadbackQueue);
+    index = FBReadback_GetReadIndex(&sReadbackQueue);
+    return (index != -1) ? sReadbackBuffers[index] : NULL;
+}
+
+/**
+ * Queues the framebuffer slice readback if anything subscribed to it, then ends the readback frame.
+ * Call once per frame after all rendering is complete.
+ */
+void FB_QueueReadback(Gfx** gfxP) {
+    s32 index = FBReadback_BeginCapture(&sReadbackQueue);
+
+    if (index != -1) {
+        FB_WriteFramebufferSliceToCPU(gfxP, sReadbackBuffers[index], true);
+    }
+    FBReadback_EndFrame(&sReadbackQueue);
+}
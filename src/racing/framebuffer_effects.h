@@ -9,6 +9,8 @@ extern s32 gN64ResFrameBuffer;
 void FB_CreateFramebuffers(void);
 void FB_CopyToFramebuffer(Gfx** gfxP, s32 fb_src, s32 fb_dest, u8 oncePerFrame, u8* hasCopied);
 void FB_WriteFramebufferSliceToCPU(Gfx** gfxP, void* buffer, u8 byteSwap);
+u16* FB_SubscribeReadback(void);
+void FB_QueueReadback(Gfx** gfxP);
 void FB_DrawFromFramebuffer(Gfx** gfxP, s32 fb, u8 alpha);
 void FB_DrawFromFramebufferScaled(Gfx** gfxP, s32 fb, u8 alpha, float scaleX, float scaleY);
 
@@ -0,0 +1,56 @@
+#include "framebuffer_readback.h"
+
+void FBReadback_Init(FBReadbackQueue* queue) {
+    queue->frame = 0;
+    queue->leaseEnd = 0;
+    queue->writeIndex = 0;
+    queue->readIndex = -1;
+    queue->pendingIndex = -1;
+}
+
+/**
+ * Registers interest in the readback for this frame and the next FB_READBACK_LEASE_FRAMES - 1 frames.
+ */
+void FBReadback_Subscribe(FBReadbackQueue* queue) {
+    queue->leaseEnd = queue->frame + FB_READBACK_LEASE_FRAMES;
+}
+
+bool FBReadback_IsSubscribed(const FBReadbackQueue* queue) {
+    // Signed difference so the lease survives the frame counter wrapping
+    return (int32_t) (queue->leaseEnd - queue->frame) > 0;
+}
+
+/**
+ * Returns the buffer this frame's readback should write to, or -1 if nobody is subscribed.
+ * At most one readback is queued per frame.
+ */
+int32_t FBReadback_BeginCapture(FBReadbackQueue* queue) {
+    if (queue->pendingIndex != -1) {
+        return queue->pendingIndex;
+    }
+    if (!FBReadback_IsSubscribed(queue)) {
+        return -1;
+    }
+
+    queue->pendingIndex = queue->writeIndex;
+    return queue->pendingIndex;
+}
+
+int32_t FBReadback_GetReadIndex(const FBReadbackQueue* queue) {
+    return queue->readIndex;
+}
+
+/**
+ * Publishes this frame's readback to consumers of the next frame and flips the write buffer.
+ * Once the lease runs out the old readback is dropped, so a consumer that comes back never samples a stale frame.
+ */
+void FBReadback_EndFrame(FBReadbackQueue* queue) {
+    if (queue->pendingIndex != -1) {
+        queue->readIndex = queue->pendingIndex;
+        queue->writeIndex = (queue->pendingIndex + 1) % FB_READBACK_BUFFER_COUNT;
+        queue->pendingIndex = -1;
+    } else if (!FBReadback_IsSubscribed(queue)) {
+        queue->readIndex = -1;
+    }
+    queue->frame++;
+}
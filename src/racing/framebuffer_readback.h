@@ -0,0 +1,46 @@
+#ifndef FRAMEBUFFER_READBACK_H
+#define FRAMEBUFFER_READBACK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Decides when the framebuffer slice is read back to the CPU and which buffer it lands in.
+ *
+ * Consumers subscribe every frame they sample the slice. A subscription lasts FB_READBACK_LEASE_FRAMES frames,
+ * so the frame a consumer stops subscribing is the last one to pay for a readback.
+ *
+ * Readbacks alternate between two buffers. The readback queued at the end of frame N is what consumers sample
+ * in frame N + 1, while frame N + 1 writes into the other buffer.
+ *
+ * This only tracks indices and frame numbers so it can be driven without a renderer, as
+ * tests/FramebufferReadbackTest.c does.
+ */
+
+#define FB_READBACK_BUFFER_COUNT 2
+#define FB_READBACK_LEASE_FRAMES 2
+
+typedef struct {
+    uint32_t frame;
+    uint32_t leaseEnd;    // Readbacks are queued while frame < leaseEnd
+    int32_t writeIndex;   // Buffer the next readback writes to
+    int32_t readIndex;    // Buffer holding the last completed readback, -1 if there is none
+    int32_t pendingIndex; // Buffer written by the readback queued this frame, -1 if none was queued
+} FBReadbackQueue;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void FBReadback_Init(FBReadbackQueue* queue);
+void FBReadback_Subscribe(FBReadbackQueue* queue);
+bool FBReadback_IsSubscribed(const FBReadbackQueue* queue);
+int32_t FBReadback_BeginCapture(FBReadbackQueue* queue);
+int32_t FBReadback_GetReadIndex(const FBReadbackQueue* queue);
+void FBReadback_EndFrame(FBReadbackQueue* queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FRAMEBUFFER_READBACK_H
@@ -3,6 +3,7 @@
 #include <align_asset_macro.h>
 #include <macros.h>
 #include <string.h>
+#include <stdlib.h>
 #include <common_structs.h>
 #include <segments.h>
 #include <decode.h>
@@ -24,11 +25,15 @@
 #include "engine/courses/Course.h"
 
 #include <stdio.h>
+#include <SDL2/SDL.h>
 
 #include "port/Game.h"
 
-s32 sGfxSeekPosition;
-s32 sPackedSeekPosition;
+// Unpacking may run on a loader thread while the game thread unpacks too, so its state is per thread.
+THREAD_LOCAL s32 sGfxSeekPosition;
+THREAD_LOCAL s32 sPackedSeekPosition;
+static THREAD_LOCAL DisplayListUnpackContext sUnpackContext;
+static THREAD_LOCAL bool sUnpackContextActive = false;
 
 static u8 sMemoryPool[0xFFFFFFF]; // Stock memory pool size: 0xAB630
 uintptr_t sPoolEnd = sMemoryPool + sizeof(sMemoryPool);
@@ -597,34 +602,40 @@ uintptr_t MIO0_0F(u8* arg0, uintptr_t arg1, uintptr_t arg2) {
 }
 
 void func_802A86A8(CourseVtx* data, Vtx* vtx, size_t arg1) {
-    CourseVtx* courseVtx = data;
+#ifdef TARGET_N64
     s32 tmp = ALIGN16(arg1 * 0x10);
+    gHeapEndPtr -= tmp;
+    vtx = (Vtx*) gHeapEndPtr;
+#endif
+    convert_course_vtx(data, vtx, arg1, gIsMirrorMode, gVtxStretch);
+}
+
+/**
+ * @brief func_802A86A8 without reading the mirror mode and stretch globals. Safe to call from a loader thread.
+ */
+void convert_course_vtx(CourseVtx* data, Vtx* vtx, size_t arg1, s32 isMirrorMode, Vec3f vtxStretch) {
+    CourseVtx* courseVtx = data;
     size_t i;
     s8 temp_a0;
     s8 temp_a3;
     s8 flags;
 
-#ifdef TARGET_N64
-    gHeapEndPtr -= tmp;
-    vtx = (Vtx*) gHeapEndPtr;
-#endif
-
     // s32 to uintptr_t comparison required for matching.
     for (i = 0; i < arg1; i++) {
-        if (gIsMirrorMode) {
-            vtx->v.ob[0] = -(courseVtx->ob[0] * gVtxStretch[0]);
+        if (isMirrorMode) {
+            vtx->v.ob[0] = -(courseVtx->ob[0] * vtxStretch[0]);
         } else {
-            vtx->v.ob[0] = courseVtx->ob[0] * gVtxStretch[0];
+            vtx->v.ob[0] = courseVtx->ob[0] * vtxStretch[0];
         }
 
-        vtx->v.ob[1] = (courseVtx->ob[1] * gVtxStretch[1]);
+        vtx->v.ob[1] = (courseVtx->ob[1] * vtxStretch[1]);
         temp_a0 = courseVtx->ca[0];
         temp_a3 = courseVtx->ca[1];
 
         flags = temp_a0 & 3;
         flags |= (temp_a3 << 2) & 0xC;
 
-        vtx->v.ob[2] = courseVtx->ob[2] * gVtxStretch[2];
+        vtx->v.ob[2] = courseVtx->ob[2] * vtxStretch[2];
         vtx->v.tc[0] = courseVtx->tc[0];
         vtx->v.tc[1] = courseVtx->tc[1];
         vtx->v.cn[0] = (temp_a0 & 0xFC);
@@ -688,8 +699,8 @@ void unpack_displaylist(Gfx* arg0, u8* args, UNUSED s8 opcode) {
     uintptr_t temp_t7 = ((args[sPackedSeekPosition++]) << 8 | temp_v0) * 8;
     arg0[sGfxSeekPosition].words.w0 = 0x06000000;
     // Segment seven addr
-    arg0[sGfxSeekPosition].words.w1 = segment_offset_to_virtual(
-        0x07, temp_t7); // (0x07000000 + temp_t7); // (gSegmentTable[segment] + ( (offset / 8) * sizeof(Gfx) ) );
+    arg0[sGfxSeekPosition].words.w1 =
+        sUnpackContext.gfxBase + ((temp_t7 / 8) * sizeof(Gfx)); // (gSegmentTable[segment] + ( (offset / 8) * sizeof(Gfx) ) );
     sGfxSeekPosition++;
 }
 
@@ -889,7 +900,7 @@ void unpack_tile_sync(Gfx* gfx, u8* args, s8 opcode) {
 }
 
 uintptr_t get_texture(size_t offset) {
-    course_texture* textures = CM_GetProps()->textures;
+    const course_texture* textures = sUnpackContext.textures;
     size_t totalOffset = 0;
 
     while (textures->addr) {
@@ -1027,7 +1038,7 @@ void unpack_vtx1(Gfx* gfx, u8* args, UNUSED s8 arg2) {
 
     gfx[sGfxSeekPosition].words.w0 =
         ((uintptr_t) (uint8_t) G_VTX << 24) | (temp_t7_2 * 2 << 16) | (((temp_t7 << 10) + ((0x10 * temp_t7) - 1)));
-    gfx[sGfxSeekPosition].words.w1 = (uintptr_t) segment_vtx_to_virtual(temp2);
+    gfx[sGfxSeekPosition].words.w1 = sUnpackContext.vtxBase + temp2;
     sGfxSeekPosition++;
 }
 
@@ -1042,7 +1053,7 @@ void unpack_vtx2(Gfx* gfx, u8* args, s8 arg2) {
     temp_t9 = arg2 - 50;
 
     gfx[sGfxSeekPosition].words.w0 = ((uintptr_t) (uint8_t) G_VTX << 24) | ((temp_t9 << 10) + (((temp_t9) * 0x10) - 1));
-    gfx[sGfxSeekPosition].words.w1 = (uintptr_t) segment_vtx_to_virtual(temp_v2);
+    gfx[sGfxSeekPosition].words.w1 = sUnpackContext.vtxBase + temp_v2;
     sGfxSeekPosition++;
 }
 
@@ -1054,7 +1065,7 @@ void unpack_triangle(Gfx* gfx, u8* args, UNUSED s8 arg2) {
 
     temp_v0 = args[sPackedSeekPosition++];
 
-    if (gIsMirrorMode) {
+    if (sUnpackContext.isMirrorMode) {
         phi_a3 = temp_v0 & 0x1F;
         phi_a2 = (temp_v0 >> 5) & 7;
         temp_v0 = args[sPackedSeekPosition++];
@@ -1083,7 +1094,7 @@ void unpack_quadrangle(Gfx* gfx, u8* args, UNUSED s8 arg2) {
 
     temp_v0 = args[sPackedSeekPosition++];
 
-    if (gIsMirrorMode) {
+    if (sUnpackContext.isMirrorMode) {
         phi_t0 = temp_v0 & 0x1F;
         phi_a3 = (temp_v0 >> 5) & 7;
         temp_v0 = args[sPackedSeekPosition++];
@@ -1099,7 +1110,7 @@ void unpack_quadrangle(Gfx* gfx, u8* args, UNUSED s8 arg2) {
 
     temp_v0 = args[sPackedSeekPosition++];
 
-    if (gIsMirrorMode) {
+    if (sUnpackContext.isMirrorMode) {
         phi_a2 = temp_v0 & 0x1F;
         phi_t1 = (temp_v0 >> 5) & 7;
         temp_v0 = args[sPackedSeekPosition++];
@@ -1127,7 +1138,7 @@ void unpack_spline_3D(Gfx* gfx, u8* arg1, UNUSED s8 arg2) {
 
     temp_v0 = arg1[sPackedSeekPosition++];
 
-    if (gIsMirrorMode != 0) {
+    if (sUnpackContext.isMirrorMode != 0) {
         phi_a0 = temp_v0 & 0x1F;
         phi_a2 = ((temp_v0 >> 5) & 7);
         temp_v0 = arg1[sPackedSeekPosition++];
@@ -1188,6 +1199,13 @@ void displaylist_unpack(uintptr_t* data, uintptr_t finalDisplaylistOffset, u32 a
     addr = gHeapEndPtr;
     gfx = (Gfx*) gHeapEndPtr;
 #endif
+    if (!sUnpackContextActive) {
+        // Unpack against the current course
+        sUnpackContext.vtxBase = gSegmentTable[4];
+        sUnpackContext.gfxBase = gSegmentTable[7];
+        sUnpackContext.textures = CM_GetProps()->textures;
+        sUnpackContext.isMirrorMode = gIsMirrorMode;
+    }
     sGfxSeekPosition = 0;
     sPackedSeekPosition = 0;
 
@@ -1473,6 +1491,256 @@ void displaylist_unpack(uintptr_t* data, uintptr_t finalDisplaylistOffset, u32 a
 #endif
 }
 
+/**
+ * @brief displaylist_unpack() with explicit segment bases, textures and mirror mode instead of the current course's.
+ * Thread safe so long as the packed data and textures are not modified during the unpack.
+ */
+void displaylist_unpack_with_context(Gfx* gfx, u8* packed, const DisplayListUnpackContext* context) {
+    sUnpackContext = *context;
+    sUnpackContextActive = true;
+    displaylist_unpack((uintptr_t*) gfx, (uintptr_t) packed, 0);
+    sUnpackContextActive = false;
+}
+
+/**
+ * Course geometry cache
+ *
+ * Converting course vertices and unpacking the packed displaylists is the most expensive part of a stock course load.
+ * The results only depend on the course, mirror mode and gVtxStretch so they are kept around between loads.
+ *
+ * The unpacked displaylists contain absolute pointers into the vertex buffer and into themselves (segments 4 and 7).
+ * Therefore each entry owns a live buffer pair at a stable address which the course renders from, and a pristine copy
+ * of both. Courses modify their geometry at runtime (scrolling textures, vertex colours), so a cache hit restores the
+ * live buffers from the pristine copy instead of handing out a dirty course.
+ *
+ * course_geometry_build() does not touch any game state and may run on a worker thread (see ModelLoader).
+ * Everything else here belongs to the game thread.
+ */
+
+#define COURSE_GEOMETRY_CACHE_SLOTS 8
+#define COURSE_GEOMETRY_CACHE_BUDGET (32 * 1024 * 1024) // Bytes, including the pristine copies
+
+typedef struct {
+    CourseGeometry* geometry;
+    u32 lastUsed; // Load counter at the last hit, for LRU eviction
+} CourseGeometryCacheEntry;
+
+static CourseGeometryCacheEntry sCourseGeometryCache[COURSE_GEOMETRY_CACHE_SLOTS];
+static size_t sCourseGeometryCacheSize = 0;
+static u32 sCourseGeometryCacheClock = 0;
+// Read by course_geometry_build on the ModelLoader worker, so it is atomic rather than a plain counter
+static SDL_atomic_t sCourseGeometryCacheGeneration;
+
+static size_t course_geometry_size(size_t vtxCount, size_t gfxCount) {
+    return 2 * (vtxCount * sizeof(Vtx) + gfxCount * sizeof(Gfx));
+}
+
+void course_geometry_free(CourseGeometry* geometry) {
+    if (geometry == NULL) {
+        return;
+    }
+    free(geometry->vtx);
+    free(geometry->gfx);
+    free(geometry->vtxPristine);
+    free(geometry->gfxPristine);
+    free(geometry);
+}
+
+/**
+ * @brief Converts a stock course's vertices and unpacks its displaylists into newly allocated buffers.
+ * Thread safe. Only reads the resource manager and its arguments.
+ * @return Geometry owned by the caller, or NULL on failure
+ */
+CourseGeometry* course_geometry_build(const char* vtxAsset, const char* gfxAsset, size_t gfxCount,
+                                      const course_texture* textures, s32 isMirrorMode, Vec3f vtxStretch) {
+    CourseGeometry* geometry = (CourseGeometry*) calloc(1, sizeof(CourseGeometry));
+    DisplayListUnpackContext context;
+    CourseVtx* courseVtx;
+    u8* packed;
+
+    if (geometry == NULL) {
+        return NULL;
+    }
+
+    geometry->generation = (u32) SDL_AtomicGet(&sCourseGeometryCacheGeneration);
+    courseVtx = (CourseVtx*) LOAD_ASSET_RAW(vtxAsset);
+    packed = (u8*) LOAD_ASSET_RAW(gfxAsset);
+    if ((courseVtx == NULL) || (packed == NULL)) {
+        printf("memory.c: Course geometry assets %s, %s not found\n", vtxAsset, gfxAsset);
+        course_geometry_free(geometry);
+        return NULL;
+    }
+
+    geometry->vtxAsset = vtxAsset;
+    geometry->gfxAsset = gfxAsset;
+    geometry->isMirrorMode = isMirrorMode;
+    geometry->vtxStretch[0] = vtxStretch[0];
+    geometry->vtxStretch[1] = vtxStretch[1];
+    geometry->vtxStretch[2] = vtxStretch[2];
+    geometry->vtxCount = ResourceGetSizeByName(vtxAsset) / sizeof(CourseVtx);
+    geometry->gfxCount = gfxCount;
+
+    geometry->vtx = (Vtx*) malloc(geometry->vtxCount * sizeof(Vtx));
+    geometry->gfx = (Gfx*) malloc(gfxCount * sizeof(Gfx));
+    geometry->vtxPristine = (Vtx*) malloc(geometry->vtxCount * sizeof(Vtx));
+    geometry->gfxPristine = (Gfx*) malloc(gfxCount * sizeof(Gfx));
+    if ((geometry->vtx == NULL) || (geometry->gfx == NULL) || (geometry->vtxPristine == NULL) ||
+        (geometry->gfxPristine == NULL)) {
+        printf("memory.c: Failed to allocate course geometry for %s\n", vtxAsset);
+        course_geometry_free(geometry);
+        return NULL;
+    }
+
+    // Convert course vtx to vtx
+    convert_course_vtx(courseVtx, geometry->vtx, geometry->vtxCount, isMirrorMode, vtxStretch);
+
+    // Extract packed DLs
+    context.vtxBase = (uintptr_t) &geometry->vtx[0];
+    context.gfxBase = (uintptr_t) &geometry->gfx[0];
+    context.textures = textures;
+    context.isMirrorMode = isMirrorMode;
+    displaylist_unpack_with_context(geometry->gfx, packed, &context);
+
+    memcpy(geometry->vtxPristine, geometry->vtx, geometry->vtxCount * sizeof(Vtx));
+    memcpy(geometry->gfxPristine, geometry->gfx, gfxCount * sizeof(Gfx));
+    return geometry;
+}
+
+static void course_geometry_cache_free_entry(CourseGeometryCacheEntry* entry) {
+    if (entry->geometry == NULL) {
+        return;
+    }
+    sCourseGeometryCacheSize -= course_geometry_size(entry->geometry->vtxCount, entry->geometry->gfxCount);
+    course_geometry_free(entry->geometry);
+    memset(entry, 0, sizeof(CourseGeometryCacheEntry));
+}
+
+static bool course_geometry_key_matches(CourseGeometry* geometry, const char* vtxAsset, const char* gfxAsset,
+                                        size_t gfxCount, s32 isMirrorMode, Vec3f vtxStretch) {
+    return (strcmp(geometry->vtxAsset, vtxAsset) == 0) && (strcmp(geometry->gfxAsset, gfxAsset) == 0) &&
+           (geometry->gfxCount == gfxCount) && (geometry->isMirrorMode == isMirrorMode) &&
+           (geometry->vtxStretch[0] == vtxStretch[0]) && (geometry->vtxStretch[1] == vtxStretch[1]) &&
+           (geometry->vtxStretch[2] == vtxStretch[2]);
+}
+
+static CourseGeometryCacheEntry* course_geometry_cache_find(const char* vtxAsset, const char* gfxAsset,
+                                                            size_t gfxCount, s32 isMirrorMode, Vec3f vtxStretch) {
+    for (size_t i = 0; i < COURSE_GEOMETRY_CACHE_SLOTS; i++) {
+        CourseGeometryCacheEntry* entry = &sCourseGeometryCache[i];
+        if ((entry->geometry != NULL) &&
+            course_geometry_key_matches(entry->geometry, vtxAsset, gfxAsset, gfxCount, isMirrorMode, vtxStretch)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Evicts least recently used entries until `incoming` more bytes fit in the budget.
+ * @return A free slot
+ */
+static CourseGeometryCacheEntry* course_geometry_cache_make_room(size_t incoming) {
+    CourseGeometryCacheEntry* oldest;
+
+    while (true) {
+        CourseGeometryCacheEntry* freeSlot = NULL;
+        oldest = NULL;
+        for (size_t i = 0; i < COURSE_GEOMETRY_CACHE_SLOTS; i++) {
+            CourseGeometryCacheEntry* entry = &sCourseGeometryCache[i];
+            if (entry->geometry == NULL) {
+                if (freeSlot == NULL) {
+                    freeSlot = entry;
+                }
+            } else if ((oldest == NULL) || (entry->lastUsed < oldest->lastUsed)) {
+                oldest = entry;
+            }
+        }
+
+        if ((freeSlot != NULL) && ((sCourseGeometryCacheSize + incoming) <= COURSE_GEOMETRY_CACHE_BUDGET)) {
+            return freeSlot;
+        }
+        if (oldest == NULL) {
+            // Cache is empty. A course bigger than the whole budget still gets a slot so it can load.
+            return freeSlot;
+        }
+        course_geometry_cache_free_entry(oldest);
+    }
+}
+
+/**
+ * @brief Hands geometry built by course_geometry_build() to the cache, replacing an entry with the same key.
+ * Must not be called while the geometry of the replaced entry is in use, ie. only between course loads.
+ */
+void course_geometry_cache_insert(CourseGeometry* geometry) {
+    CourseGeometryCacheEntry* entry;
+
+    if (geometry == NULL) {
+        return;
+    }
+    if (geometry->generation != (u32) SDL_AtomicGet(&sCourseGeometryCacheGeneration)) {
+        // Built from assets that have since changed
+        course_geometry_free(geometry);
+        return;
+    }
+
+    entry = course_geometry_cache_find(geometry->vtxAsset, geometry->gfxAsset, geometry->gfxCount,
+                                       geometry->isMirrorMode, geometry->vtxStretch);
+    if (entry != NULL) {
+        course_geometry_cache_free_entry(entry);
+    }
+
+    entry = course_geometry_cache_make_room(course_geometry_size(geometry->vtxCount, geometry->gfxCount));
+    entry->geometry = geometry;
+    entry->lastUsed = ++sCourseGeometryCacheClock;
+    sCourseGeometryCacheSize += course_geometry_size(geometry->vtxCount, geometry->gfxCount);
+}
+
+/**
+ * @brief Stops reuse of every cached course, eg. after archives or alt assets change.
+ * The current course may still be rendering from its entry, so entries are only freed on the next load.
+ */
+void course_geometry_cache_invalidate(void) {
+    SDL_AtomicAdd(&sCourseGeometryCacheGeneration, 1);
+}
+
+/**
+ * @brief Converts a stock course's vertices and unpacks its displaylists, or restores them from the cache.
+ * Sets segment 4 (vtx) and segment 7 (gfx) to the resulting buffers.
+ * @param vtxAsset CourseVtx resource
+ * @param gfxAsset Packed displaylist resource
+ * @param gfxCount Number of Gfx commands the unpacked displaylists need
+ */
+void load_course_geometry(const char* vtxAsset, const char* gfxAsset, size_t gfxCount) {
+    CourseGeometryCacheEntry* entry;
+    CourseGeometry* geometry;
+    u32 generation = (u32) SDL_AtomicGet(&sCourseGeometryCacheGeneration);
+
+    for (size_t i = 0; i < COURSE_GEOMETRY_CACHE_SLOTS; i++) {
+        if ((sCourseGeometryCache[i].geometry != NULL) &&
+            (sCourseGeometryCache[i].geometry->generation != generation)) {
+            course_geometry_cache_free_entry(&sCourseGeometryCache[i]);
+        }
+    }
+
+    entry = course_geometry_cache_find(vtxAsset, gfxAsset, gfxCount, gIsMirrorMode, gVtxStretch);
+    if (entry != NULL) {
+        geometry = entry->geometry;
+        memcpy(geometry->vtx, geometry->vtxPristine, geometry->vtxCount * sizeof(Vtx));
+        memcpy(geometry->gfx, geometry->gfxPristine, geometry->gfxCount * sizeof(Gfx));
+        entry->lastUsed = ++sCourseGeometryCacheClock;
+    } else {
+        geometry = course_geometry_build(vtxAsset, gfxAsset, gfxCount, CM_GetProps()->textures, gIsMirrorMode,
+                                         gVtxStretch);
+        if (geometry == NULL) {
+            return;
+        }
+        course_geometry_cache_insert(geometry);
+    }
+
+    gSegmentTable[4] = (uintptr_t) &geometry->vtx[0];
+    gSegmentTable[7] = (uintptr_t) &geometry->gfx[0];
+}
+
 struct UnkStr_802AA7C8 {
     u8* unk0;
     uintptr_t unk4;
@@ -36,6 +36,42 @@ struct AllocOnlyPool {
     u8* freePtr;
 };
 
+/**
+ * Where displaylist_unpack() points the commands it generates.
+ */
+typedef struct {
+    uintptr_t vtxBase; // Segment 4
+    uintptr_t gfxBase; // Segment 7
+    const course_texture* textures;
+    s32 isMirrorMode;
+} DisplayListUnpackContext;
+
+/**
+ * Converted vertices and unpacked displaylists of a stock course. See load_course_geometry().
+ */
+typedef struct CourseGeometry {
+    const char* vtxAsset;
+    const char* gfxAsset;
+    s32 isMirrorMode;
+    Vec3f vtxStretch;
+    u32 generation;
+
+    Vtx* vtx; // Live buffers, referenced by segment 4 and 7
+    Gfx* gfx;
+    Vtx* vtxPristine; // Untouched copies to restore from
+    Gfx* gfxPristine;
+    size_t vtxCount;
+    size_t gfxCount;
+} CourseGeometry;
+
+#if defined(_MSC_VER) && !defined(__cplusplus)
+#define THREAD_LOCAL __declspec(thread)
+#elif defined(__cplusplus)
+#define THREAD_LOCAL thread_local
+#else
+#define THREAD_LOCAL _Thread_local
+#endif
+
 #define MEMORY_POOL_LEFT 0
 #define MEMORY_POOL_RIGHT 1
 
@@ -60,7 +96,15 @@ void* load_data(uintptr_t, uintptr_t);
 void func_802A7D54(s32, s32);
 
 void func_802A86A8(CourseVtx* data, Vtx* vtx, size_t arg1);
+void convert_course_vtx(CourseVtx* data, Vtx* vtx, size_t arg1, s32 isMirrorMode, Vec3f vtxStretch);
 void displaylist_unpack(uintptr_t* data, uintptr_t finalDisplaylistOffset, u32 arg2);
+void displaylist_unpack_with_context(Gfx* gfx, u8* packed, const DisplayListUnpackContext* context);
+CourseGeometry* course_geometry_build(const char* vtxAsset, const char* gfxAsset, size_t gfxCount,
+                                      const course_texture* textures, s32 isMirrorMode, Vec3f vtxStretch);
+void course_geometry_free(CourseGeometry* geometry);
+void course_geometry_cache_insert(CourseGeometry* geometry);
+void course_geometry_cache_invalidate(void);
+void load_course_geometry(const char* vtxAsset, const char* gfxAsset, size_t gfxCount);
 
 void main_pool_init(uintptr_t, uintptr_t);
 void* main_pool_alloc(uintptr_t, uintptr_t);
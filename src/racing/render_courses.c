@@ -25,6 +25,7 @@
 #include "engine/courses/Course.h"
 
 #include "enhancements/collision_viewer.h"
+#include "port/Settings.h"
 
 s16 D_802B87B0 = 995;
 s16 D_802B87B4 = 1000;
@@ -176,7 +177,7 @@ void render_course_segments(const char* addr[], struct UnkStruct_800DC5EC* arg1)
     index = ((index - 1) * 4) + direction;
     gSPDisplayList(gDisplayListHead++, addr[index]);
 
-    if (CVarGetInteger("gDisableLod", 1) == 1 && (IsBowsersCastle()) &&
+    if (gSettings.disableLod == 1 && (IsBowsersCastle()) &&
         (index < 20 || index > 99)) { // always render higher version of bowser statue
         gDisplayListHead--;
         gSPDisplayList(gDisplayListHead++, d_course_bowsers_castle_dl_9148); // use credit version of the course
@@ -193,7 +194,7 @@ void render_mario_raceway_pipe(void) {
         // d_course_mario_raceway_packed_dl_8E8
         gSPDisplayList(gDisplayListHead++, ((uintptr_t) segmented_gfx_to_virtual(0x070008E8)));
     } else {
-        if (CVarGetInteger("gDisableLod", 1) == true) {
+        if (gSettings.disableLod == true) {
             gSPDisplayList(gDisplayListHead++, ((uintptr_t) segmented_gfx_to_virtual(0x070008E8)));
             return;
         }
@@ -870,7 +871,10 @@ void render_luigi_raceway(struct UnkStruct_800DC5EC* arg0) {
 
     UNUSED s32 pad;
     u16 sp22 = (u16) arg0->pathCounter;
+#ifdef TARGET_N64
     s16 prevFrame;
+#endif
+    u16* readback;
 
     gSPTexture(gDisplayListHead++, 0xFFFF, 0xFFFF, 0, G_TX_RENDERTILE, G_ON);
     gSPSetGeometryMode(gDisplayListHead++, G_SHADING_SMOOTH);
@@ -910,7 +914,7 @@ void render_luigi_raceway(struct UnkStruct_800DC5EC* arg0) {
 
     // Render only the first player camera onto the television billboard. Screen agnostic screens of other players).
     if ((gActiveScreenMode == SCREEN_MODE_1P) && (sp22 >= 10) && (sp22 < 17)) {
-
+#ifdef TARGET_N64
         prevFrame = (s16) sRenderedFramebuffer - 1;
 
         if (prevFrame < 0) {
@@ -918,6 +922,7 @@ void render_luigi_raceway(struct UnkStruct_800DC5EC* arg0) {
         } else if (prevFrame >= 3) {
             prevFrame = 0;
         }
+#endif
         currentScreenSection++;
         if (currentScreenSection >= 6) {
             currentScreenSection = 0;
@@ -972,9 +977,11 @@ void render_luigi_raceway(struct UnkStruct_800DC5EC* arg0) {
                 break;
         }
 
-        copy_jumbotron_fb_port(D_800DC5DC, D_800DC5E0, currentScreenSection,
-                               (u16*) PHYSICAL_TO_VIRTUAL(gPortFramebuffers[prevFrame]),
-                               (u16*) PHYSICAL_TO_VIRTUAL(gSegmentTable[5] + 0xF800));
+        readback = FB_SubscribeReadback();
+        if (readback != NULL) {
+            copy_jumbotron_fb_port(D_800DC5DC, D_800DC5E0, currentScreenSection, readback,
+                                   (u16*) PHYSICAL_TO_VIRTUAL(gSegmentTable[5] + 0xF800));
+        }
     }
 }
 
@@ -1132,7 +1139,10 @@ void render_rainbow_road(UNUSED struct UnkStruct_800DC5EC* arg0) {
 }
 
 void render_wario_stadium(struct UnkStruct_800DC5EC* arg0) {
+#ifdef TARGET_N64
     s16 prevFrame;
+#endif
+    u16* readback;
 
     gSPTexture(gDisplayListHead++, 0xFFFF, 0xFFFF, 0, G_TX_RENDERTILE, G_ON);
     gSPSetGeometryMode(gDisplayListHead++, G_SHADING_SMOOTH);
@@ -1172,12 +1182,14 @@ void render_wario_stadium(struct UnkStruct_800DC5EC* arg0) {
     D_800DC5DC = 88;
     D_800DC5E0 = 72;
     if (gActiveScreenMode == SCREEN_MODE_1P) {
+#ifdef TARGET_N64
         prevFrame = (s16) sRenderedFramebuffer - 1;
         if (prevFrame < 0) {
             prevFrame = 2;
         } else if (prevFrame >= 3) {
             prevFrame = 0;
         }
+#endif
         currentScreenSection++;
         if (currentScreenSection > 5) {
             currentScreenSection = 0;
@@ -1227,9 +1239,11 @@ void render_wario_stadium(struct UnkStruct_800DC5EC* arg0) {
                 break;
         }
 
-        copy_jumbotron_fb_port(D_800DC5DC, D_800DC5E0, currentScreenSection,
-                               (u16*) PHYSICAL_TO_VIRTUAL(gPortFramebuffers[prevFrame]),
-                               (u16*) PHYSICAL_TO_VIRTUAL(gSegmentTable[5] + 0x8800));
+        readback = FB_SubscribeReadback();
+        if (readback != NULL) {
+            copy_jumbotron_fb_port(D_800DC5DC, D_800DC5E0, currentScreenSection, readback,
+                                   (u16*) PHYSICAL_TO_VIRTUAL(gSegmentTable[5] + 0x8800));
+        }
     }
 }
 
@@ -1398,7 +1412,7 @@ void render_course(struct UnkStruct_800DC5EC* arg0) {
     set_track_light_direction(D_800DC610, D_802B87D4, 0, 1);
 
     // Freecam priority renders collision.
-    if (CVarGetInteger("gRenderCollisionMesh", 0) == true) {
+    if (gSettings.renderCollisionMesh == true) {
         render_collision();
         return;
     }
@@ -1498,6 +1512,7 @@ void func_80295C6C(void) {
 
     gCollisionIndices = (u16*) gNextFreeMemoryAddress;
     generate_collision_grid();
+    collision_viewer_invalidate();
     gNextFreeMemoryAddress += ALIGN16(gNumCollisionTriangles * sizeof(u16));
 }
 
@@ -3,8 +3,10 @@
 #include <libultra/gbi.h>
 #include <mk64.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "skybox_and_splitscreen.h"
+#include "framebuffer_effects.h"
 #include "code_800029B0.h"
 #include <common_structs.h>
 #include "memory.h"
@@ -24,6 +26,8 @@
 #include "math_util.h"
 #include "src/enhancements/freecam/freecam.h"
 #include "port/interpolation/FrameInterpolation.h"
+#include "port/Settings.h"
+#include "profiler.h"
 
 Vp D_802B8880[] = {
     { { { 640, 480, 511, 0 }, { 640, 480, 511, 0 } } },
@@ -762,7 +766,7 @@ void setup_camera(Camera* camera, s32 playerId, s32 cameraId, struct UnkStruct_8
     u16 perspNorm;
 
     // This allows freecam to create a new separate camera
-    // if (CVarGetInteger("gFreecam", 0) == true) {
+    // if (gSettings.freecam == true) {
     //     freecam_render_setup(gFreecamCamera);
     //     return;
     // }
@@ -846,11 +850,13 @@ void render_screens(s32 mode, s32 cameraId, s32 playerId) {
             break;
     }
 
+    TRACE_ZONE_BEGIN("render_screens");
+
     struct UnkStruct_800DC5EC* screen = &D_8015F480[screenId];
     Camera* camera;
 
     // Required for freecam to have its own camera
-    //if (CVarGetInteger("gFreecam", 0) == true) {
+    //if (gSettings.freecam == true) {
     //    camera = &gFreecamCamera;
     //    cameraId = 4;
     //} else {
@@ -928,6 +934,7 @@ void render_screens(s32 mode, s32 cameraId, s32 playerId) {
         gNumScreens += 1;
     }
     FrameInterpolation_RecordCloseChild();
+    TRACE_ZONE_END();
 }
 
 void func_802A74BC(void) {
@@ -1012,48 +1019,50 @@ void copy_framebuffer(s32 arg0, s32 arg1, s32 width, s32 height, u16* source, u1
     }
 }
 
+#define JUMBOTRON_TILE_WIDTH 64
+#define JUMBOTRON_TILE_HEIGHT 32
+#define JUMBOTRON_TILE_ROWS 3
+
 // Handles copying framebuffer to course texture data region for the Jumbotron in the port
 // This only supports framebuffers and copy regions being within 320x240
 // Any attempt to support larger sizes would require reworking course data
+//
+// The course data splits the screen into six 64x32 tiles laid out back to back in texture memory (left then right,
+// top to bottom). The readback is already big endian RGBA16, the texture format, so each framebuffer row is copied
+// in one pass as two contiguous tile rows instead of pixel by pixel through copy_framebuffer.
 void copy_jumbotron_fb_port(s32 ulx, s32 uly, s16 portionToDraw, u16* source, u16* target) {
     // Add CVar if we want to expose a user toggle for only updating 1/6 of the jumbotron per frame
     u8 updateWholeJumbo = true;
+    size_t rowBytes = JUMBOTRON_TILE_WIDTH * sizeof(u16);
+    size_t tileSize = JUMBOTRON_TILE_WIDTH * JUMBOTRON_TILE_HEIGHT;
+    s32 row;
 
     if (portionToDraw == -1 || updateWholeJumbo) {
-        copy_framebuffer(ulx, uly, 64, 32, source, target);
-        copy_framebuffer(ulx + 64, uly, 64, 32, source, target + (64 * 32 * 1));
-        copy_framebuffer(ulx, uly + 32, 64, 32, source, target + (64 * 32 * 2));
-        copy_framebuffer(ulx + 64, uly + 32, 64, 32, source, target + (64 * 32 * 3));
-        copy_framebuffer(ulx, uly + 64, 64, 32, source, target + (64 * 32 * 4));
-        copy_framebuffer(ulx + 64, uly + 64, 64, 32, source, target + (64 * 32 * 5));
-    } else {
-        switch (portionToDraw) {
-            case 0:
-                copy_framebuffer(ulx, uly, 64, 32, source, target);
-                break;
-            case 1:
-                copy_framebuffer(ulx + 64, uly, 64, 32, source, target + (64 * 32 * 1));
-                break;
-            case 2:
-                copy_framebuffer(ulx, uly + 32, 64, 32, source, target + (64 * 32 * 2));
-                break;
-            case 3:
-                copy_framebuffer(ulx + 64, uly + 32, 64, 32, source, target + (64 * 32 * 3));
-                break;
-            case 4:
-                copy_framebuffer(ulx, uly + 64, 64, 32, source, target + (64 * 32 * 4));
-                break;
-            case 5:
-                copy_framebuffer(ulx + 64, uly + 64, 64, 32, source, target + (64 * 32 * 5));
-                break;
-            default:
-                break;
+        for (row = 0; row < JUMBOTRON_TILE_HEIGHT * JUMBOTRON_TILE_ROWS; row++) {
+            u16* src = source + ((uly + row) * SCREEN_WIDTH) + ulx;
+            u16* dst = target + ((row / JUMBOTRON_TILE_HEIGHT) * 2 * tileSize) +
+                       ((row % JUMBOTRON_TILE_HEIGHT) * JUMBOTRON_TILE_WIDTH);
+
+            memcpy(dst, src, rowBytes);
+            memcpy(dst + tileSize, src + JUMBOTRON_TILE_WIDTH, rowBytes);
+        }
+    } else if (portionToDraw >= 0 && portionToDraw < JUMBOTRON_TILE_ROWS * 2) {
+        s32 x = ulx + ((portionToDraw % 2) * JUMBOTRON_TILE_WIDTH);
+        s32 y = uly + ((portionToDraw / 2) * JUMBOTRON_TILE_HEIGHT);
+        u16* dst = target + (portionToDraw * tileSize);
+
+        for (row = 0; row < JUMBOTRON_TILE_HEIGHT; row++) {
+            memcpy(dst + (row * JUMBOTRON_TILE_WIDTH), source + ((y + row) * SCREEN_WIDTH) + x, rowBytes);
         }
     }
 }
 
 void func_802A7728(void) {
+#if TARGET_N64
     s16 temp_v0;
+#else
+    u16* readback;
+#endif
 
     if (gActiveScreenMode == SCREEN_MODE_3P_4P_SPLITSCREEN) {
         D_800DC5DC = 0;
@@ -1061,13 +1070,13 @@ void func_802A7728(void) {
         D_800DC5DC = 128;
     }
     D_800DC5E0 = 0;
+#if TARGET_N64
     temp_v0 = (s16) sRenderedFramebuffer - 1;
     if (temp_v0 < 0) {
         temp_v0 = 2;
     } else if (temp_v0 > 2) {
         temp_v0 = 0;
     }
-#if TARGET_N64
     copy_framebuffer(D_800DC5DC, D_800DC5E0, 64, 32, (u16*) PHYSICAL_TO_VIRTUAL(gPhysicalFramebuffers[temp_v0]),
                      (u16*) PHYSICAL_TO_VIRTUAL(gSegmentTable[5] + 0x8800));
     copy_framebuffer(D_800DC5DC + 64, D_800DC5E0, 64, 32, (u16*) PHYSICAL_TO_VIRTUAL(gPhysicalFramebuffers[temp_v0]),
@@ -1083,13 +1092,20 @@ void func_802A7728(void) {
                      (u16*) PHYSICAL_TO_VIRTUAL(gPhysicalFramebuffers[temp_v0]),
                      (u16*) PHYSICAL_TO_VIRTUAL(gSegmentTable[5] + 0xD800));
 #else
-    copy_jumbotron_fb_port(D_800DC5DC, D_800DC5E0, -1, PHYSICAL_TO_VIRTUAL(gPortFramebuffers[temp_v0]),
-                           (u16*) PHYSICAL_TO_VIRTUAL(gSegmentTable[5] + 0x8800));
+    readback = FB_SubscribeReadback();
+    if (readback != NULL) {
+        copy_jumbotron_fb_port(D_800DC5DC, D_800DC5E0, -1, readback,
+                               (u16*) PHYSICAL_TO_VIRTUAL(gSegmentTable[5] + 0x8800));
+    }
 #endif
 }
 
 void func_802A7940(void) {
+#if TARGET_N64
     s16 temp_v0;
+#else
+    u16* readback;
+#endif
 
     if (gActiveScreenMode == SCREEN_MODE_3P_4P_SPLITSCREEN) {
         D_800DC5DC = 0;
@@ -1097,13 +1113,13 @@ void func_802A7940(void) {
         D_800DC5DC = 128;
     }
     D_800DC5E0 = 0;
+#if TARGET_N64
     temp_v0 = (s16) sRenderedFramebuffer - 1;
     if (temp_v0 < 0) {
         temp_v0 = 2;
     } else if (temp_v0 > 2) {
         temp_v0 = 0;
     }
-#if TARGET_N64
     copy_framebuffer(D_800DC5DC, D_800DC5E0, 0x40, 0x20, (u16*) PHYSICAL_TO_VIRTUAL(gPhysicalFramebuffers[temp_v0]),
                      (u16*) PHYSICAL_TO_VIRTUAL(gSegmentTable[5] + 0xF800));
     copy_framebuffer(D_800DC5DC + 0x40, D_800DC5E0, 0x40, 0x20,
@@ -1122,7 +1138,10 @@ void func_802A7940(void) {
                      (u16*) PHYSICAL_TO_VIRTUAL(gPhysicalFramebuffers[temp_v0]),
                      (u16*) PHYSICAL_TO_VIRTUAL(gSegmentTable[5] + 0x14800));
 #else
-    copy_jumbotron_fb_port(D_800DC5DC, D_800DC5E0, -1, (u16*) PHYSICAL_TO_VIRTUAL(gPortFramebuffers[temp_v0]),
-                           (u16*) PHYSICAL_TO_VIRTUAL(gSegmentTable[5] + 0xF800));
+    readback = FB_SubscribeReadback();
+    if (readback != NULL) {
+        copy_jumbotron_fb_port(D_800DC5DC, D_800DC5E0, -1, readback,
+                               (u16*) PHYSICAL_TO_VIRTUAL(gSegmentTable[5] + 0xF800));
+    }
 #endif
 }
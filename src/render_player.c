@@ -34,6 +34,7 @@
 #include "engine/Matrix.h"
 #include "port/interpolation/FrameInterpolation.h"
 #include "port/Engine.h"
+#include "port/Settings.h"
 
 s8 gRenderingFramebufferByPlayer[] = { 0x00, 0x02, 0x00, 0x01, 0x00, 0x01, 0x00, 0x02 };
 
@@ -113,7 +114,7 @@ u16 check_player_camera_collision(Player* player, Camera* camera, f32 arg2, f32
     s16 var_v0;
     u16 ret;
 
-    if (CVarGetInteger("gNoCulling", 0) == 1) {
+    if (gSettings.noCulling == 1) {
         return true;
     }
 
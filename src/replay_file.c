@@ -0,0 +1,576 @@
+#include <libultraship.h>
+#include <macros.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include "main.h"
+#include "buffers.h"
+#include "code_80057C60.h"
+#include "mio0.h"
+#include "replay_file.h"
+#include "port/Game.h"
+
+extern s32 gLapCountByPlayerId[];
+
+#define FNV_OFFSET_BASIS 2166136261u
+#define FNV_PRIME 16777619u
+
+static u32 replay_hash(u32 hash, const void* data, size_t size) {
+    const u8* bytes = (const u8*) data;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+static s32 replay_reserve_runs(Replay* replay, u32 count) {
+    u32* runs;
+    u32 capacity;
+
+    if (count <= replay->runCapacity) {
+        return 0;
+    }
+    capacity = MAX(count, replay->runCapacity * 2);
+    capacity = MAX(capacity, 0x400);
+    runs = (u32*) realloc(replay->runs, capacity * sizeof(u32));
+    if (runs == NULL) {
+        printf("[replay] Failed to grow input stream to %u runs\n", capacity);
+        return -1;
+    }
+    replay->runs = runs;
+    replay->runCapacity = capacity;
+    return 0;
+}
+
+static s32 replay_reserve_keyframes(Replay* replay, u32 count) {
+    ReplayKeyframe* keyframes;
+    ReplayState* states;
+    u32 capacity;
+
+    if (count <= replay->keyframeCapacity) {
+        return 0;
+    }
+    capacity = MAX(count, replay->keyframeCapacity * 2);
+    capacity = MAX(capacity, 16);
+    keyframes = (ReplayKeyframe*) realloc(replay->keyframes, capacity * sizeof(ReplayKeyframe));
+    if (keyframes != NULL) {
+        replay->keyframes = keyframes;
+    }
+    states = (ReplayState*) realloc(replay->states, capacity * sizeof(ReplayState));
+    if (states != NULL) {
+        replay->states = states;
+    }
+    if ((keyframes == NULL) || (states == NULL)) {
+        printf("[replay] Failed to grow keyframes to %u\n", capacity);
+        return -1;
+    }
+    memset(&states[replay->keyframeCapacity], 0, (capacity - replay->keyframeCapacity) * sizeof(ReplayState));
+    replay->keyframeCapacity = capacity;
+    return 0;
+}
+
+static void replay_free_state(Replay* replay, u32 index) {
+    ReplayState* state = &replay->states[index];
+
+    if (state->retained) {
+        CM_ReleaseState(state->data, replay->keyframes[index].stateSize);
+    }
+    free(state->data);
+    state->data = NULL;
+    state->retained = 0;
+    replay->keyframes[index].stateSize = 0;
+}
+
+void replay_init(Replay* replay, s32 courseId, s32 characterId, u16 keyframeInterval) {
+    replay_free(replay);
+    replay->courseId = courseId;
+    replay->characterId = characterId;
+    replay->keyframeInterval = keyframeInterval;
+}
+
+void replay_free(Replay* replay) {
+    for (u32 i = 0; i < replay->keyframeCount; i++) {
+        replay_free_state(replay, i);
+    }
+    free(replay->runs);
+    free(replay->keyframes);
+    free(replay->states);
+    memset(replay, 0, sizeof(Replay));
+}
+
+u32 replay_encode_controller(struct Controller* controller) {
+    u32 inputs = 0;
+    u16 buttons = controller->button;
+
+    if (buttons & A_BUTTON) {
+        inputs |= REPLAY_A_BUTTON;
+    }
+    if (buttons & B_BUTTON) {
+        inputs |= REPLAY_B_BUTTON;
+    }
+    if (buttons & Z_TRIG) {
+        inputs |= REPLAY_Z_TRIG;
+    }
+    if (buttons & R_TRIG) {
+        inputs |= REPLAY_R_TRIG;
+    }
+    inputs |= (u32) controller->rawStickX & 0xFF;
+    inputs |= ((u32) controller->rawStickY & 0xFF) << 8;
+    return inputs;
+}
+
+void replay_record_frame(Replay* replay, u32 inputs) {
+    u32* last = (replay->runCount != 0) ? &replay->runs[replay->runCount - 1] : NULL;
+
+    inputs &= REPLAY_CLEAR_FRAME_COUNTER;
+    if ((last != NULL) && ((*last & REPLAY_CLEAR_FRAME_COUNTER) == inputs) &&
+        ((*last & REPLAY_FRAME_COUNTER) != REPLAY_FRAME_COUNTER)) {
+        *last += REPLAY_FRAME_INCREMENT;
+    } else {
+        if (replay_reserve_runs(replay, replay->runCount + 1) != 0) {
+            return;
+        }
+        replay->runs[replay->runCount++] = inputs;
+    }
+
+    if ((replay->keyframeInterval != 0) && ((replay->frameCount % replay->keyframeInterval) == 0)) {
+        if (replay_reserve_keyframes(replay, replay->keyframeCount + 1) == 0) {
+            ReplayKeyframe* keyframe = &replay->keyframes[replay->keyframeCount];
+            keyframe->frame = replay->frameCount;
+            keyframe->runIndex = replay->runCount - 1;
+            keyframe->runFrame = (replay->runs[replay->runCount - 1] & REPLAY_FRAME_COUNTER) >> 16;
+            replay_capture_keyframe(replay, replay->keyframeCount++);
+        }
+    }
+    replay->frameCount++;
+}
+
+u32 replay_state_checksum(void) {
+    u32 hash = FNV_OFFSET_BASIS;
+
+    hash = replay_hash(hash, &gRandomSeed16, sizeof(gRandomSeed16));
+    for (s32 i = 0; i < NUM_PLAYERS; i++) {
+        Player* player = &gPlayers[i];
+        hash = replay_hash(hash, &player->type, sizeof(player->type));
+        hash = replay_hash(hash, player->pos, sizeof(player->pos));
+        hash = replay_hash(hash, player->rotation, sizeof(player->rotation));
+        hash = replay_hash(hash, player->velocity, sizeof(player->velocity));
+        hash = replay_hash(hash, &player->speed, sizeof(player->speed));
+        hash = replay_hash(hash, &gLapCountByPlayerId[i], sizeof(gLapCountByPlayerId[i]));
+    }
+    return hash;
+}
+
+void replay_capture_keyframe(Replay* replay, u32 index) {
+    ReplayKeyframe* keyframe = &replay->keyframes[index];
+    ReplayState* state = &replay->states[index];
+
+    keyframe->checksum = replay_state_checksum();
+    keyframe->stateSize = (u32) CM_CaptureState(&state->data);
+    state->retained = (keyframe->stateSize != 0);
+}
+
+s32 replay_restore_keyframe(const Replay* replay, u32 index) {
+    const ReplayKeyframe* keyframe = &replay->keyframes[index];
+
+    if ((keyframe->stateSize == 0) || !CM_RestoreState(replay->states[index].data, keyframe->stateSize)) {
+        return -1;
+    }
+    return 0;
+}
+
+void replay_refresh_keyframe(Replay* replay, u32 frame) {
+    u32 index;
+    u32 checksum;
+
+    if ((replay->keyframeInterval == 0) || ((frame % replay->keyframeInterval) != 0)) {
+        return;
+    }
+    index = frame / replay->keyframeInterval;
+    if ((index >= replay->keyframeCount) || (replay->keyframes[index].frame != frame)) {
+        return;
+    }
+    if ((replay->keyframes[index].stateSize != 0) &&
+        CM_IsStateCurrent(replay->states[index].data, replay->keyframes[index].stateSize)) {
+        return;
+    }
+    // The recorded checksum is what playback validates against, keep it.
+    checksum = replay->keyframes[index].checksum;
+    replay_free_state(replay, index);
+    replay_capture_keyframe(replay, index);
+    replay->keyframes[index].checksum = checksum;
+}
+
+s32 replay_copy(Replay* dest, const Replay* src) {
+    replay_init(dest, src->courseId, src->characterId, src->keyframeInterval);
+    if ((replay_reserve_runs(dest, src->runCount) != 0) || (replay_reserve_keyframes(dest, src->keyframeCount) != 0)) {
+        replay_free(dest);
+        return -1;
+    }
+    memcpy(dest->runs, src->runs, src->runCount * sizeof(u32));
+    memcpy(dest->keyframes, src->keyframes, src->keyframeCount * sizeof(ReplayKeyframe));
+    dest->runCount = src->runCount;
+    dest->frameCount = src->frameCount;
+    dest->keyframeCount = src->keyframeCount;
+    for (u32 i = 0; i < src->keyframeCount; i++) {
+        u32 size = src->keyframes[i].stateSize;
+        ReplayState* state = &dest->states[i];
+
+        state->data = (size != 0) ? (u8*) malloc(size) : NULL;
+        if (state->data == NULL) {
+            dest->keyframes[i].stateSize = 0;
+            continue;
+        }
+        memcpy(state->data, src->states[i].data, size);
+        state->retained = CM_RetainState(state->data, size);
+    }
+    return 0;
+}
+
+static size_t replay_compress_block(const void* data, size_t size, u8** outData) {
+    size_t capacity = mio0_max_encoded_size(size);
+    u8* buffer = (u8*) malloc(capacity);
+    size_t written;
+
+    *outData = NULL;
+    if (buffer == NULL) {
+        return 0;
+    }
+    written = mio0_encode((const u8*) data, size, buffer, capacity);
+    if (written == 0) {
+        free(buffer);
+        return 0;
+    }
+    *outData = buffer;
+    return written;
+}
+
+size_t replay_serialize(const Replay* replay, u8** outData) {
+    ReplayFileHeader header;
+    u8* inputs = NULL;
+    u8* keyframes = NULL;
+    u8* states = NULL;
+    u8* stateData = NULL;
+    u8* data;
+    size_t inputsSize;
+    size_t keyframesSize;
+    size_t statesSize;
+    size_t stateDataSize = 0;
+    size_t total = 0;
+
+    *outData = NULL;
+    for (u32 i = 0; i < replay->keyframeCount; i++) {
+        stateDataSize += replay->keyframes[i].stateSize;
+    }
+    stateData = (u8*) malloc(MAX(stateDataSize, 1));
+    if (stateData == NULL) {
+        return 0;
+    }
+    stateDataSize = 0;
+    for (u32 i = 0; i < replay->keyframeCount; i++) {
+        if (replay->keyframes[i].stateSize != 0) {
+            memcpy(stateData + stateDataSize, replay->states[i].data, replay->keyframes[i].stateSize);
+            stateDataSize += replay->keyframes[i].stateSize;
+        }
+    }
+
+    inputsSize = replay_compress_block(replay->runs, replay->runCount * sizeof(u32), &inputs);
+    keyframesSize =
+        replay_compress_block(replay->keyframes, replay->keyframeCount * sizeof(ReplayKeyframe), &keyframes);
+    statesSize = replay_compress_block(stateData, stateDataSize, &states);
+    if ((inputsSize == 0) || (keyframesSize == 0) || (statesSize == 0)) {
+        printf("[replay] Failed to compress replay\n");
+        goto cleanup;
+    }
+
+    header.magic = REPLAY_FILE_MAGIC;
+    header.version = REPLAY_FILE_VERSION;
+    header.keyframeInterval = replay->keyframeInterval;
+    header.courseId = replay->courseId;
+    header.characterId = replay->characterId;
+    header.frameCount = replay->frameCount;
+    header.runCount = replay->runCount;
+    header.keyframeCount = replay->keyframeCount;
+    header.inputsSize = (u32) inputsSize;
+    header.keyframesSize = (u32) keyframesSize;
+    header.statesSize = (u32) statesSize;
+
+    total = sizeof(header) + inputsSize + keyframesSize + statesSize;
+    data = (u8*) malloc(total);
+    if (data == NULL) {
+        total = 0;
+        goto cleanup;
+    }
+    memcpy(data, &header, sizeof(header));
+    memcpy(data + sizeof(header), inputs, inputsSize);
+    memcpy(data + sizeof(header) + inputsSize, keyframes, keyframesSize);
+    memcpy(data + sizeof(header) + inputsSize + keyframesSize, states, statesSize);
+    *outData = data;
+
+cleanup:
+    free(inputs);
+    free(keyframes);
+    free(states);
+    free(stateData);
+    return total;
+}
+
+// Splits the decoded save states between the keyframes. Returns -1 if the sizes don't add up.
+static s32 replay_split_states(Replay* replay, const u8* stateData, size_t stateDataSize) {
+    size_t offset = 0;
+
+    for (u32 i = 0; i < replay->keyframeCount; i++) {
+        u32 size = replay->keyframes[i].stateSize;
+        ReplayState* state = &replay->states[i];
+
+        if ((stateDataSize - offset) < size) {
+            return -1;
+        }
+        if (size != 0) {
+            state->data = (u8*) malloc(size);
+            if (state->data == NULL) {
+                return -1;
+            }
+            memcpy(state->data, stateData + offset, size);
+            // A state from an earlier race or run of the game stays stale until replay_refresh_keyframe
+            state->retained = CM_RetainState(state->data, size);
+        }
+        offset += size;
+    }
+    return (offset == stateDataSize) ? 0 : -1;
+}
+
+s32 replay_deserialize(Replay* replay, const u8* data, size_t size) {
+    ReplayFileHeader header;
+    const u8* inputs;
+    const u8* keyframes;
+    const u8* states;
+    u8* stateData;
+    size_t stateDataSize;
+
+    if (size < sizeof(header)) {
+        return -1;
+    }
+    memcpy(&header, data, sizeof(header));
+    if ((header.magic != REPLAY_FILE_MAGIC) || (header.version != REPLAY_FILE_VERSION)) {
+        printf("[replay] Unsupported replay file (magic %08X, version %u)\n", header.magic, header.version);
+        return -1;
+    }
+    if ((size - sizeof(header)) < ((size_t) header.inputsSize + header.keyframesSize + header.statesSize)) {
+        printf("[replay] Replay file is truncated\n");
+        return -1;
+    }
+    inputs = data + sizeof(header);
+    keyframes = inputs + header.inputsSize;
+    states = keyframes + header.keyframesSize;
+
+    replay_init(replay, header.courseId, header.characterId, header.keyframeInterval);
+    if ((replay_reserve_runs(replay, header.runCount) != 0) ||
+        (replay_reserve_keyframes(replay, header.keyframeCount) != 0)) {
+        replay_free(replay);
+        return -1;
+    }
+    if ((mio0_decoded_size(inputs, header.inputsSize) != header.runCount * sizeof(u32)) ||
+        (mio0_decode(inputs, header.inputsSize, (u8*) replay->runs, replay->runCapacity * sizeof(u32)) < 0) ||
+        (mio0_decoded_size(keyframes, header.keyframesSize) != header.keyframeCount * sizeof(ReplayKeyframe)) ||
+        (mio0_decode(keyframes, header.keyframesSize, (u8*) replay->keyframes,
+                     replay->keyframeCapacity * sizeof(ReplayKeyframe)) < 0)) {
+        printf("[replay] Replay file is corrupted\n");
+        replay_free(replay);
+        return -1;
+    }
+    replay->frameCount = header.frameCount;
+    replay->runCount = header.runCount;
+    replay->keyframeCount = header.keyframeCount;
+
+    stateDataSize = mio0_decoded_size(states, header.statesSize);
+    stateData = (u8*) malloc(MAX(stateDataSize, 1));
+    if ((stateData == NULL) || (mio0_decode(states, header.statesSize, stateData, stateDataSize) < 0) ||
+        (replay_split_states(replay, stateData, stateDataSize) != 0)) {
+        printf("[replay] Replay file is corrupted\n");
+        free(stateData);
+        replay_free(replay);
+        return -1;
+    }
+    free(stateData);
+    return 0;
+}
+
+s32 replay_write_file(const Replay* replay, const char* path) {
+    u8* data;
+    size_t size = replay_serialize(replay, &data);
+    FILE* file;
+    s32 result = -1;
+
+    if (size == 0) {
+        return -1;
+    }
+    file = fopen(path, "wb");
+    if (file != NULL) {
+        if ((fwrite(data, 1, size, file) == size) && (fflush(file) == 0)) {
+            result = 0;
+        }
+        fclose(file);
+    }
+    if (result != 0) {
+        printf("[replay] Failed to write %s\n", path);
+    }
+    free(data);
+    return result;
+}
+
+s32 replay_read_file(Replay* replay, const char* path) {
+    FILE* file = fopen(path, "rb");
+    u8* data;
+    long size;
+    s32 result = -1;
+
+    if (file == NULL) {
+        return -1;
+    }
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    data = (size > 0) ? (u8*) malloc(size) : NULL;
+    if ((data != NULL) && (fread(data, 1, size, file) == (size_t) size)) {
+        result = replay_deserialize(replay, data, size);
+    }
+    fclose(file);
+    free(data);
+    return result;
+}
+
+void replay_ghost_byteswap(u32* dest, const u32* src, u32 count) {
+    const u8* in = (const u8*) src;
+    u8* out = (u8*) dest;
+
+    for (u32 i = 0; i < count * sizeof(u32); i += sizeof(u32)) {
+        out[i] = in[i + 3];
+        out[i + 1] = in[i + 2];
+        out[i + 2] = in[i + 1];
+        out[i + 3] = in[i];
+    }
+}
+
+s32 replay_from_ghost(Replay* replay, const u32* ghost, u32 runCount, s32 byteSwap, s32 courseId,
+                      s32 characterId) {
+    replay_init(replay, courseId, characterId, 0);
+    if (replay_reserve_runs(replay, runCount) != 0) {
+        return -1;
+    }
+    if (byteSwap) {
+        replay_ghost_byteswap(replay->runs, ghost, runCount);
+    } else {
+        memcpy(replay->runs, ghost, runCount * sizeof(u32));
+    }
+    replay->runCount = runCount;
+    for (u32 i = 0; i < runCount; i++) {
+        replay->frameCount += ((replay->runs[i] & REPLAY_FRAME_COUNTER) >> 16) + 1;
+    }
+    return 0;
+}
+
+s32 replay_matches_ghost(const Replay* replay, const u32* ghost, u32 runCount) {
+    u32 count = MIN(replay->runCount, runCount);
+
+    if (count == 0) {
+        return 0;
+    }
+    if (memcmp(replay->runs, ghost, (count - 1) * sizeof(u32)) != 0) {
+        return 0;
+    }
+    return (replay->runs[count - 1] & REPLAY_CLEAR_FRAME_COUNTER) == (ghost[count - 1] & REPLAY_CLEAR_FRAME_COUNTER);
+}
+
+void replay_cursor_init(ReplayCursor* cursor, const Replay* replay) {
+    cursor->replay = replay;
+    cursor->frame = 0;
+    cursor->runIndex = 0;
+    cursor->runFrame = 0;
+    cursor->desyncFrame = -1;
+}
+
+u32 replay_cursor_next(ReplayCursor* cursor) {
+    const Replay* replay = cursor->replay;
+    u32 run;
+
+    if ((replay == NULL) || (cursor->runIndex >= replay->runCount)) {
+        return REPLAY_END;
+    }
+    run = replay->runs[cursor->runIndex];
+    cursor->runFrame++;
+    if (cursor->runFrame > ((run & REPLAY_FRAME_COUNTER) >> 16)) {
+        cursor->runIndex++;
+        cursor->runFrame = 0;
+    }
+    cursor->frame++;
+    return run & REPLAY_CLEAR_FRAME_COUNTER;
+}
+
+u32 replay_seek(ReplayCursor* cursor, u32 frame) {
+    const Replay* replay = cursor->replay;
+    u32 low = 0;
+    u32 high;
+
+    frame = MIN(frame, replay->frameCount);
+    high = replay->keyframeCount;
+    // First keyframe with keyframe->frame > frame
+    while (low < high) {
+        u32 mid = (low + high) / 2;
+        if (replay->keyframes[mid].frame <= frame) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    // Nearest keyframe with a state, unless simulating on from the current frame is shorter
+    while (low > 0) {
+        const ReplayKeyframe* keyframe = &replay->keyframes[low - 1];
+        if ((frame >= cursor->frame) && (keyframe->frame <= cursor->frame)) {
+            break;
+        }
+        if (replay_restore_keyframe(replay, low - 1) == 0) {
+            cursor->frame = keyframe->frame;
+            cursor->runIndex = keyframe->runIndex;
+            cursor->runFrame = keyframe->runFrame;
+            return frame - keyframe->frame;
+        }
+        low--;
+    }
+
+    if (frame >= cursor->frame) {
+        return frame - cursor->frame;
+    }
+    // Rewinding without a state would need a restart of the race
+    return REPLAY_END;
+}
+
+s32 replay_cursor_validate(ReplayCursor* cursor) {
+    const Replay* replay = cursor->replay;
+    const ReplayKeyframe* keyframe;
+    u32 index;
+    u32 checksum;
+
+    if ((replay == NULL) || (replay->keyframeInterval == 0) || ((cursor->frame % replay->keyframeInterval) != 0)) {
+        return 0;
+    }
+    index = cursor->frame / replay->keyframeInterval;
+    if (index >= replay->keyframeCount) {
+        return 0;
+    }
+    keyframe = &replay->keyframes[index];
+    if (keyframe->frame != cursor->frame) {
+        return 0;
+    }
+    checksum = replay_state_checksum();
+    if (checksum != keyframe->checksum) {
+        if (cursor->desyncFrame < 0) {
+            cursor->desyncFrame = (s32) cursor->frame;
+            printf("[replay] Desync at frame %u (expected %08X, got %08X)\n", cursor->frame, keyframe->checksum,
+                   checksum);
+        }
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,159 @@
+#ifndef REPLAY_FILE_H
+#define REPLAY_FILE_H
+
+#include <libultraship.h>
+#include <common_structs.h>
+#include <defines.h>
+
+/**
+ * Seekable replay container.
+ *
+ * The input stream uses the same run encoding as the ghost buffers (see process_post_time_trial_replay),
+ * but is not limited to REPLAY_GHOST_RUNS runs. Every keyframeInterval frames a save state (CM_CaptureState)
+ * and a checksum are stored, which allows seeking (restore the nearest keyframe and simulate forward) and
+ * desync detection (compare the live state checksum against the recorded one).
+ *
+ * A save state only restores into the world it was captured in, and every race start builds a new world.
+ * Checksums stay valid; replay_refresh_keyframe recaptures stale states while the replay plays in sync.
+ *
+ * Serialized layout: ReplayFileHeader, then the MIO0 compressed input runs, keyframes and save states.
+ */
+
+#define REPLAY_FILE_MAGIC 0x4D4B5250 // "MKRP"
+#define REPLAY_FILE_VERSION 2
+#define REPLAY_KEYFRAME_INTERVAL 300
+// Runs a legacy ghost buffer holds
+#define REPLAY_GHOST_RUNS 0x1000
+// Game ticks per replay frame, the stock game's 30 fps
+#define REPLAY_TICKS_PER_FRAME 2
+
+// Returned by replay_cursor_next once every recorded frame was played
+#define REPLAY_END 0xFFFFFFFF
+
+typedef struct {
+    u32 magic;
+    u16 version;
+    u16 keyframeInterval;
+    s32 courseId;
+    s32 characterId;
+    u32 frameCount;
+    u32 runCount;
+    u32 keyframeCount;
+    u32 inputsSize;    // Compressed size of the input runs
+    u32 keyframesSize; // Compressed size of the keyframes
+    u32 statesSize;    // Compressed size of the save states
+} ReplayFileHeader;
+
+typedef struct {
+    u32 frame;
+    u32 runIndex;  // Run being played on this frame
+    u32 runFrame;  // Frames of that run already played
+    u32 checksum;  // replay_state_checksum() at this frame
+    u32 stateSize; // Size of the keyframe's save state, 0 if it has none
+} ReplayKeyframe;
+
+typedef struct {
+    u8* data; // CM_CaptureState buffer
+    s32 retained; // Holds its entities, see CM_RetainState
+} ReplayState;
+
+typedef struct {
+    s32 courseId;
+    s32 characterId;
+    u16 keyframeInterval;
+    u32 frameCount;
+    u32* runs;
+    u32 runCount;
+    u32 runCapacity;
+    ReplayKeyframe* keyframes;
+    ReplayState* states; // One per keyframe
+    u32 keyframeCount;
+    u32 keyframeCapacity;
+} Replay;
+
+typedef struct {
+    const Replay* replay;
+    u32 frame;
+    u32 runIndex;
+    u32 runFrame;
+    s32 desyncFrame; // First frame that failed validation, -1 if none
+} ReplayCursor;
+
+/** @brief Resets the replay, freeing previous data. The replay must be zeroed or previously initialized. */
+void replay_init(Replay* replay, s32 courseId, s32 characterId, u16 keyframeInterval);
+void replay_free(Replay* replay);
+
+/** @brief Appends one frame of inputs (a REPLAY_* word without frame counter). Captures a keyframe on interval. */
+void replay_record_frame(Replay* replay, u32 inputs);
+
+/** @brief Packs a controller into a REPLAY_* input word. */
+u32 replay_encode_controller(struct Controller* controller);
+
+/** @brief Checksum of the state stored in keyframes, used to detect desyncs. */
+u32 replay_state_checksum(void);
+
+void replay_capture_keyframe(Replay* replay, u32 index);
+/** @brief Restores the keyframe's save state. Returns 0 on success, -1 if it has none or it is stale. */
+s32 replay_restore_keyframe(const Replay* replay, u32 index);
+
+/**
+ * @brief Recaptures the save state of the keyframe at frame if it can't be restored in this world.
+ * Only call it while the replay plays in sync (see replay_cursor_validate).
+ */
+void replay_refresh_keyframe(Replay* replay, u32 frame);
+
+/** @brief Copies the replay including its keyframes. Returns 0 on success. */
+s32 replay_copy(Replay* dest, const Replay* src);
+
+/**
+ * @brief Serializes the replay.
+ * @return Size of the malloc'd buffer stored in *outData, 0 on failure.
+ */
+size_t replay_serialize(const Replay* replay, u8** outData);
+
+/**
+ * @brief Loads a serialized replay. Returns 0 on success, -1 if the data is invalid.
+ * Save states that are not restorable in this world are kept but stale.
+ */
+s32 replay_deserialize(Replay* replay, const u8* data, size_t size);
+
+/** @brief replay_serialize / replay_deserialize to a file. Return 0 on success. */
+s32 replay_write_file(const Replay* replay, const char* path);
+s32 replay_read_file(Replay* replay, const char* path);
+
+/** @brief Copies ghost runs while converting them from the big endian staff ghost data. */
+void replay_ghost_byteswap(u32* dest, const u32* src, u32 count);
+
+/**
+ * @brief Converts a legacy ghost buffer (D_802BFB80 runs or staff ghost data) to a replay.
+ * The converted replay has no keyframes, seeking falls back to playing from the start.
+ */
+s32 replay_from_ghost(Replay* replay, const u32* ghost, u32 runCount, s32 byteSwap, s32 courseId,
+                      s32 characterId);
+
+/**
+ * @brief Returns 1 if the ghost buffer holds the replay's inputs cut to runCount runs.
+ * The last compared run may have been cut short, so only its inputs are compared.
+ */
+s32 replay_matches_ghost(const Replay* replay, const u32* ghost, u32 runCount);
+
+void replay_cursor_init(ReplayCursor* cursor, const Replay* replay);
+
+/** @brief Returns the input word for the cursor frame and advances, or REPLAY_END. */
+u32 replay_cursor_next(ReplayCursor* cursor);
+
+/**
+ * @brief Restores the nearest keyframe at or before frame and moves the cursor to it. Seeking forward past
+ * the last keyframe before frame keeps the current state instead.
+ * @return Number of frames the caller must simulate with replay_cursor_next to reach frame, or REPLAY_END
+ * if no keyframe could be restored. The cursor and the world are left alone then.
+ */
+u32 replay_seek(ReplayCursor* cursor, u32 frame);
+
+/**
+ * @brief Compares the live state against the keyframe recorded for the cursor frame, if there is one.
+ * @return 0 if the state matches or no keyframe exists for this frame, -1 on desync.
+ */
+s32 replay_cursor_validate(ReplayCursor* cursor);
+
+#endif // REPLAY_FILE_H
@@ -1,4 +1,5 @@
 #include <libultraship.h>
+#include <stdio.h>
 #include <macros.h>
 #include <mk64.h>
 #include <stubs.h>
@@ -21,20 +22,17 @@ u8* sReplayGhostBuffer;
 size_t sReplayGhostBufferSize;
 s16 D_80162D86;
 
-static u16 sPlayerGhostButtonsPrev;
-static u32 sPlayerGhostFramesRemaining;
-static s16 sPlayerGhostReplayIdx;
+// Ghost playback positions are part of the save state (see SaveState.cpp) so seeking rewinds the ghosts too
+u16 sPlayerGhostButtonsPrev;
+ReplayCursor sPlayerGhostCursor;
 u32* sPlayerGhostReplay;
 
-static u16 sButtonsPrevCourseGhost;
-static u32 sCourseGhostFramesRemaining;
-static s16 sCourseGhostReplayIdx;
+u16 sButtonsPrevCourseGhost;
+u32 sCourseGhostFramesRemaining;
+s16 sCourseGhostReplayIdx;
 static u32* sCourseGhostReplay;
 
-static u16 sPostTTButtonsPrev;
-static s32 sPostTTFramesRemaining;
-static s16 sPostTTReplayIdx;
-static u32* sPostTTReplay;
+u16 sPostTTButtonsPrev;
 
 static s16 sPlayerInputIdx;
 static u32* sPlayerInputs;
@@ -59,6 +57,17 @@ s32 D_80162DFC;
 
 s32 D_80162E00;
 
+// Seekable recording of the current time trial, see replay_file.h
+Replay gReplayRecording;
+// Drives the post time trial replay
+static ReplayCursor sPostTTCursor;
+// Full length recording of the player ghost, or the ghost buffer converted by replay_from_ghost
+Replay gPlayerGhostRecording;
+// Frame the post time trial replay jumps to at the start of the next frame, -1 for none
+static s32 sReplaySeekFrame = -1;
+// Logic ticks since replays_loop last ran, see replays_tick
+static u32 sReplayTickPhase;
+
 u32* sReplayGhostEncoded = (u32*) &D_802BFB80.arraySize8[0][2][3];
 u32* gReplayGhostCompressed = (u32*) &D_802BFB80.arraySize8[1][1][3];
 
@@ -80,30 +89,36 @@ void load_course_ghost(void) {
         size = 1907 * sizeof(StaffGhost);
     }
 
-    // Manual memcpy required for byte swap
-    for (size_t i = 0; i < size; i += sizeof(StaffGhost)) {
-        dest[i] = ghost[i + 3];
-        dest[i + 1] = ghost[i + 2];
-        dest[i + 2] = ghost[i + 1];
-        dest[i + 3] = ghost[i];
-    }
-    // memcpy(dest, ghost, size);
+    // Staff ghosts are stored big endian
+    replay_ghost_byteswap((u32*) dest, (const u32*) ghost, size / sizeof(StaffGhost));
 
     osRecvMesg(&gDmaMesgQueue, &gMainReceivedMesg, OS_MESG_BLOCK);
     sCourseGhostFramesRemaining = (*sCourseGhostReplay & REPLAY_FRAME_COUNTER);
     sCourseGhostReplayIdx = 0;
 }
 
+// Plays the seekable recording of the race instead of the D_80162DD0 buffer, which holds the same inputs cut
+// to REPLAY_GHOST_RUNS runs.
 void load_post_time_trial_replay(void) {
-    sPostTTReplay = (u32*) &D_802BFB80.arraySize8[0][D_80162DD0][3];
-    sPostTTFramesRemaining = *sPostTTReplay & REPLAY_FRAME_COUNTER;
-    sPostTTReplayIdx = 0;
+    replay_cursor_init(&sPostTTCursor, &gReplayRecording);
+    sReplaySeekFrame = -1;
+}
+
+/**
+ * Plays the player ghost from gPlayerGhostRecording. Keeps the recording if the ghost buffer was cut from it
+ * (the ghost was raced in this session or loaded with its replay file), converts the buffer otherwise.
+ */
+static void set_player_ghost(void) {
+    if (!replay_matches_ghost(&gPlayerGhostRecording, sPlayerGhostReplay, REPLAY_GHOST_RUNS)) {
+        replay_from_ghost(&gPlayerGhostRecording, sPlayerGhostReplay, REPLAY_GHOST_RUNS, 0, (s32) GetCourseIndex(),
+                          D_80162DE0);
+    }
+    replay_cursor_init(&sPlayerGhostCursor, &gPlayerGhostRecording);
 }
 
 void load_player_ghost(void) {
     sPlayerGhostReplay = (u32*) &D_802BFB80.arraySize8[0][D_80162DC8][3];
-    sPlayerGhostFramesRemaining = (s32) *sPlayerGhostReplay & REPLAY_FRAME_COUNTER;
-    sPlayerGhostReplayIdx = 0;
+    set_player_ghost();
 }
 /**
  * Activates staff ghost if time trial lap time is low enough
@@ -140,8 +155,7 @@ s32 func_800051C4(void) {
 void func_8000522C(void) {
     sPlayerGhostReplay = (u32*) &D_802BFB80.arraySize8[0][D_80162DC8][3];
     mio0decode((u8*) gReplayGhostCompressed, (u8*) sPlayerGhostReplay);
-    sPlayerGhostFramesRemaining = (s32) (*sPlayerGhostReplay & REPLAY_FRAME_COUNTER);
-    sPlayerGhostReplayIdx = 0;
+    set_player_ghost();
     D_80162E00 = 1;
 }
 
@@ -162,6 +176,7 @@ void func_800052A4(void) {
 }
 
 void func_80005310(void) {
+    sReplayTickPhase = 0;
 
     if (gModeSelection == TIME_TRIALS) {
 
@@ -189,6 +204,8 @@ void func_80005310(void) {
             } else {
 
                 D_80162DD8 = 1U;
+                replay_init(&gReplayRecording, (s32) GetCourseIndex(), gPlayerOne->characterId,
+                            REPLAY_KEYFRAME_INTERVAL);
                 sPlayerInputs = (u32*) &D_802BFB80.arraySize8[0][D_80162DCC][3];
                 sPlayerInputs[0] = -1;
                 sPlayerInputIdx = 0;
@@ -233,12 +250,11 @@ void process_post_time_trial_replay(void) {
     s16 stickVal;
     s16 buttons = 0;
 
-    if (sPostTTReplayIdx >= 0x1000) {
+    inputs = replay_cursor_next(&sPostTTCursor);
+    if (inputs == REPLAY_END) {
         gPlayerOne->type = PLAYER_CINEMATIC_MODE | PLAYER_START_SEQUENCE | PLAYER_CPU;
         return;
     }
-
-    inputs = sPostTTReplay[sPostTTReplayIdx];
     stickBytes = inputs & REPLAY_STICK_X;
 
     // twos complement trick, converting singned 8-bit value to signed 16 bit
@@ -275,13 +291,6 @@ void process_post_time_trial_replay(void) {
     gControllerEight->buttonDepressed = (sPostTTButtonsPrev & (buttons ^ sPostTTButtonsPrev)) | buttons_temp;
     sPostTTButtonsPrev = buttons;
     gControllerEight->button = buttons;
-
-    if (sPostTTFramesRemaining == 0) {
-        sPostTTReplayIdx++;
-        sPostTTFramesRemaining = (s32) (sPostTTReplay[sPostTTReplayIdx] & REPLAY_FRAME_COUNTER);
-    } else {
-        sPostTTFramesRemaining -= REPLAY_FRAME_INCREMENT;
-    }
 }
 
 // See process_post_time_trial_replay comment
@@ -353,11 +362,11 @@ void process_player_ghost_replay(void) {
     s16 stickVal;
     s16 buttons = 0;
 
-    if (sPlayerGhostReplayIdx >= 0x1000) {
+    inputs = replay_cursor_next(&sPlayerGhostCursor);
+    if (inputs == REPLAY_END) {
         func_80005AE8(gPlayerTwo);
         return;
     }
-    inputs = sPlayerGhostReplay[sPlayerGhostReplayIdx];
     stickBytes = inputs & REPLAY_STICK_X;
     if (stickBytes < 0x80U) {
         stickVal = (s16) (stickBytes & 0xFF);
@@ -396,13 +405,6 @@ void process_player_ghost_replay(void) {
     gControllerSix->buttonDepressed = (sPlayerGhostButtonsPrev & (buttons ^ sPlayerGhostButtonsPrev)) | buttons_temp;
     sPlayerGhostButtonsPrev = buttons;
     gControllerSix->button = buttons;
-
-    if (sPlayerGhostFramesRemaining == 0) {
-        sPlayerGhostReplayIdx++;
-        sPlayerGhostFramesRemaining = (s32) (sPlayerGhostReplay[sPlayerGhostReplayIdx] & REPLAY_FRAME_COUNTER);
-    } else {
-        sPlayerGhostFramesRemaining -= (s32) REPLAY_FRAME_INCREMENT;
-    }
 }
 
 // See process_post_time_trial_replay comment
@@ -414,6 +416,9 @@ void save_player_replay(void) {
     u32 inputCounter;
     u32 prevInputsWCounter;
     u32 prevInputs;
+    // The seekable recording has no length limit and stays valid when lakitu picks the player up
+    replay_record_frame(&gReplayRecording, replay_encode_controller(gControllerOne));
+
     /* Input file is too long or picked up by lakitu or Out of bounds
     Not sure if there is any way to be considered out of bounds without lakitu getting called */
 
@@ -484,6 +489,7 @@ void func_80005B18(void) {
             if (bPlayerGhostDisabled == 1) {
                 D_80162DD0 = D_80162DCC;
                 func_800052A4();
+                replay_copy(&gPlayerGhostRecording, &gReplayRecording);
                 bPlayerGhostDisabled = 0;
                 D_80162DDC = 1;
                 D_80162DE0 = gPlayerOne->characterId;
@@ -495,6 +501,7 @@ void func_80005B18(void) {
             } else if (gLapCountByPlayerId[1] != 3) {
                 D_80162DD0 = D_80162DCC;
                 func_800052A4();
+                replay_copy(&gPlayerGhostRecording, &gReplayRecording);
                 D_80162DDC = 1;
                 D_80162DE0 = gPlayerOne->characterId;
                 D_80162DFC = playerHUD[PLAYER_ONE].someTimer;
@@ -552,6 +559,10 @@ void func_80005E6C(void) {
             process_course_ghost_replay(); // 2
         }
         if ((gPlayerOne->type & PLAYER_CINEMATIC_MODE) != PLAYER_CINEMATIC_MODE) {
+            // Keyframes recorded during the race can't restore into this world, recapture them for seeking
+            if ((replay_cursor_validate(&sPostTTCursor) == 0) && (sPostTTCursor.desyncFrame < 0)) {
+                replay_refresh_keyframe(&gReplayRecording, sPostTTCursor.frame);
+            }
             process_post_time_trial_replay(); // 1
             return;
         }
@@ -560,6 +571,74 @@ void func_80005E6C(void) {
     }
 }
 
+#define REPLAY_GHOST_FILE "ghost_replay_%d.mkrp"
+
+// Saves the seekable recording of the ghost next to the controller pak after func_800B6178 wrote it
+void replays_save_ghost_file(s32 slot) {
+    char path[32];
+
+    if (!replay_matches_ghost(&gPlayerGhostRecording, (u32*) sReplayGhostBuffer, (u32) sReplayGhostBufferSize + 1)) {
+        return;
+    }
+    sprintf(path, REPLAY_GHOST_FILE, slot);
+    replay_write_file(&gPlayerGhostRecording, path);
+}
+
+// Swaps in the recording saved with the ghost func_800B64EC just loaded, if it still is that ghost's
+void replays_load_ghost_file(s32 slot) {
+    Replay replay = { 0 };
+    char path[32];
+
+    sprintf(path, REPLAY_GHOST_FILE, slot);
+    if (replay_read_file(&replay, path) != 0) {
+        return;
+    }
+    if (!replay_matches_ghost(&replay, sPlayerGhostReplay, REPLAY_GHOST_RUNS)) {
+        replay_free(&replay);
+        return;
+    }
+    replay_free(&gPlayerGhostRecording);
+    gPlayerGhostRecording = replay;
+    replay_cursor_init(&sPlayerGhostCursor, &gPlayerGhostRecording);
+}
+
+void replays_request_seek(s32 frames) {
+    if ((gModeSelection != TIME_TRIALS) || (D_8015F890 != 1)) {
+        return;
+    }
+    sReplaySeekFrame = MAX((s32) sPostTTCursor.frame + frames, 0);
+}
+
+/**
+ * Jumps the post time trial replay to the frame replays_request_seek asked for: restores the nearest keyframe
+ * and simulates the frames after it without drawing them. Runs at the start of a race frame, before
+ * replays_loop.
+ */
+void replays_apply_seek(void) {
+    u32 target;
+    u32 frames;
+
+    if (sReplaySeekFrame < 0) {
+        return;
+    }
+    target = (u32) sReplaySeekFrame;
+    sReplaySeekFrame = -1;
+    if ((gModeSelection != TIME_TRIALS) || (D_8015F890 != 1)) {
+        return;
+    }
+
+    frames = replay_seek(&sPostTTCursor, target);
+    if (frames == REPLAY_END) {
+        printf("[replay] No keyframe to rewind to frame %u yet\n", target);
+        return;
+    }
+    // Keyframes are taken by replays_loop, so the restored frame starts with it
+    sReplayTickPhase = 0;
+    for (u32 i = 0; i < frames; i++) {
+        race_logic_step();
+    }
+}
+
 void replays_loop(void) {
     if (D_8015F890 == 1) {
         func_80005E6C();
@@ -573,3 +652,14 @@ void replays_loop(void) {
        Seems like just for pausing */
     gPostTimeTrialReplayCannotSave = 1;
 }
+
+/**
+ * Runs replays_loop on every REPLAY_TICKS_PER_FRAME-th logic tick. Replays and ghosts hold one input per replay
+ * frame, so calling this before each tick keeps them on the tick scheduler instead of the display rate.
+ */
+void replays_tick(void) {
+    if (sReplayTickPhase == 0) {
+        replays_loop();
+    }
+    sReplayTickPhase = (sReplayTickPhase + 1) % REPLAY_TICKS_PER_FRAME;
+}
@@ -3,6 +3,7 @@
 
 #include <libultraship.h>
 #include <common_structs.h>
+#include "replay_file.h"
 
 void func_80005B18(void);
 void load_course_ghost(void);
@@ -20,6 +21,13 @@ void save_player_replay(void);
 void func_80005AE8(Player*);
 void func_80005E6C(void);
 void replays_loop(void);
+/** @brief Called before every logic tick of a time trial, advances replays and ghosts once per replay frame. */
+void replays_tick(void);
+void replays_save_ghost_file(s32 slot);
+void replays_load_ghost_file(s32 slot);
+/** @brief Moves the post time trial replay by frames (negative rewinds) at the start of the next frame. */
+void replays_request_seek(s32 frames);
+void replays_apply_seek(void);
 
 // mi0decode
 
@@ -42,5 +50,7 @@ extern s32 gPostTimeTrialReplayCannotSave;
 extern u8* sReplayGhostBuffer;
 extern size_t sReplayGhostBufferSize;
 extern u32* sPlayerGhostReplay;
+extern Replay gReplayRecording;
+extern Replay gPlayerGhostRecording;
 
 #endif /* REPLAYS_H */
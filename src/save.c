@@ -784,6 +784,7 @@ s32 func_800B6178(s32 arg0) {
                                (arg0 * (sizeof(u8) * 0x10000)) + 0x100, sizeof(u8) * 0x10000, (u8*) sReplayGhostBuffer);
         if (var_v0 == 0) {
             temp_s3->ghostDataSaved = 1;
+            replays_save_ghost_file(arg0);
             if (gGamestate == 4) {
                 temp_s3->courseIndex = (GetCupIndex() * 4) + GetCupCursorPosition();
             }
@@ -879,6 +880,7 @@ s32 func_800B64EC(s32 arg0) {
             }
         }
         func_8000522C();
+        replays_load_ghost_file(arg0);
         bPlayerGhostDisabled = 0;
         D_80162DE0 = (s32) D_8018EE10[arg0].characterId;
         D_80162DFC = D_8018EE10[arg0].unk_00;
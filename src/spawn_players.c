@@ -27,6 +27,7 @@
 #include "effects.h"
 #include "decode.h"
 #include "port/Game.h"
+#include "port/Settings.h"
 
 f32 D_80165210[8];
 f32 D_80165230[8];
@@ -112,7 +113,7 @@ void spawn_player(Player* player, s8 playerIndex, f32 startingRow, f32 startingC
             player->topSpeed = gTopSpeedTable[CC_BATTLE][player->characterId];
             break;
     }
-    if (CVarGetInteger("gEnableCustomCC", 0) == 1) {
+    if (gSettings.enableCustomCC == 1) {
 #define calc_a(x, y, x2, y2) (y2 - y) / (x2 - x)
 #define calc_b(x, y, b) y - (b * x)
         f32 a;
@@ -121,7 +122,7 @@ void spawn_player(Player* player, s8 playerIndex, f32 startingRow, f32 startingC
 #define calc(table, field)                                                                      \
     a = calc_a(50, table[CC_50][player->characterId], 150, table[CC_150][player->characterId]); \
     b = calc_b(50, table[CC_50][player->characterId], a);                                       \
-    player->field = a * CVarGetFloat("gCustomCC", 150.0f) + b;
+    player->field = a * gSettings.customCC + b;
 
         calc(gTopSpeedTable, topSpeed);
         calc(D_800E2400, unk_084);
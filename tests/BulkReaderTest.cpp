@@ -0,0 +1,391 @@
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "utils/binarytools/BinaryReader.h"
+#include "port/resource/importers/BulkReader.h"
+#include "port/resource/type/CourseVtx.h"
+#include "port/resource/type/TrackPathPointData.h"
+#include "port/resource/type/SpawnData.h"
+#include "port/resource/type/Vec3fArray.h"
+#include "port/resource/type/Vec3sArray.h"
+
+/**
+ * The bulk record decoding in BulkReader.h against the per-field reads the factories used to make. Records are
+ * encoded in both byte orders, then decoded the way each factory does (ReadRecords and the swap fix-up) and field by
+ * field with BinaryReader, and both results must match byte for byte. Also checks that a count larger than the
+ * data is refused, and times both decoders on a course sized vertex array.
+ */
+
+#define BULK_RECORDS 1000
+#define BULK_BENCH_RECORDS 200000
+#define BULK_BENCH_ROUNDS 20
+
+#define CHECK(cond, ...)                                         \
+    do {                                                         \
+        if (!(cond)) {                                           \
+            printf("%s:%d: %s: ", __FILE__, __LINE__, #cond);    \
+            printf(__VA_ARGS__);                                 \
+            printf("\n");                                        \
+            return 1;                                            \
+        }                                                        \
+    } while (0)
+
+static const Ship::Endianness sByteOrders[] = { Ship::Endianness::Little, Ship::Endianness::Big };
+
+static const char* ByteOrderName(Ship::Endianness order) {
+    return (order == Ship::Endianness::Big) ? "big endian" : "little endian";
+}
+
+// Writes scalars in the byte order of the archive being faked
+class Encoder {
+  public:
+    explicit Encoder(Ship::Endianness order) : mBig(order == Ship::Endianness::Big) {
+    }
+
+    void Write(uint64_t value, size_t size) {
+        for (size_t i = 0; i < size; i++) {
+            size_t shift = mBig ? (size - 1 - i) * 8 : i * 8;
+            mData.push_back((char) ((value >> shift) & 0xFF));
+        }
+    }
+    void U8(uint8_t value) {
+        Write(value, 1);
+    }
+    void U16(uint16_t value) {
+        Write(value, 2);
+    }
+    void U32(uint32_t value) {
+        Write(value, 4);
+    }
+    void F32(float value) {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        Write(bits, 4);
+    }
+
+    std::shared_ptr<Ship::BinaryReader> Reader() {
+        auto reader = std::make_shared<Ship::BinaryReader>(mData.data(), mData.size());
+        reader->SetEndianness(mBig ? Ship::Endianness::Big : Ship::Endianness::Little);
+        return reader;
+    }
+
+  private:
+    bool mBig;
+    std::vector<char> mData;
+};
+
+static std::mt19937 sRandom(0x5eed);
+
+static uint16_t RandomU16() {
+    return (uint16_t) sRandom();
+}
+
+static float RandomF32() {
+    return std::uniform_real_distribution<float>(-10000.0f, 10000.0f)(sRandom);
+}
+
+template <typename T> static bool SameRecords(const std::vector<T>& a, const std::vector<T>& b) {
+    return (a.size() == b.size()) && ((a.size() == 0) || (memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0));
+}
+
+/* Reference decoders, one BinaryReader call per field like the factories before the bulk reads */
+
+static std::vector<CourseVtxData> ReadCourseVtxPerField(const std::shared_ptr<Ship::BinaryReader>& reader) {
+    std::vector<CourseVtxData> list(reader->ReadUInt32());
+    for (CourseVtxData& data : list) {
+        memset(&data, 0, sizeof(data));
+        for (s16& ob : data.ob) {
+            ob = reader->ReadInt16();
+        }
+        for (s16& tc : data.tc) {
+            tc = reader->ReadInt16();
+        }
+        for (s8& ca : data.ca) {
+            ca = (s8) reader->ReadUByte();
+        }
+    }
+    return list;
+}
+
+static std::vector<TrackPathPoint> ReadPathPerField(const std::shared_ptr<Ship::BinaryReader>& reader) {
+    std::vector<TrackPathPoint> list(reader->ReadUInt32());
+    for (TrackPathPoint& point : list) {
+        memset(&point, 0, sizeof(point));
+        point.posX = reader->ReadInt16();
+        point.posY = reader->ReadInt16();
+        point.posZ = reader->ReadInt16();
+        point.trackSectionId = reader->ReadUInt16();
+    }
+    return list;
+}
+
+static std::vector<ActorSpawnData> ReadSpawnPerField(const std::shared_ptr<Ship::BinaryReader>& reader) {
+    std::vector<ActorSpawnData> list(reader->ReadUInt32());
+    for (ActorSpawnData& spawn : list) {
+        memset(&spawn, 0, sizeof(spawn));
+        spawn.pos[0] = reader->ReadInt16();
+        spawn.pos[1] = reader->ReadInt16();
+        spawn.pos[2] = reader->ReadInt16();
+        spawn.signedSomeId = reader->ReadInt16();
+    }
+    return list;
+}
+
+static std::vector<SF64::Vec3fData> ReadVec3fPerField(const std::shared_ptr<Ship::BinaryReader>& reader) {
+    std::vector<SF64::Vec3fData> list(reader->ReadUInt32());
+    for (SF64::Vec3fData& vec : list) {
+        vec.x = reader->ReadFloat();
+        vec.y = reader->ReadFloat();
+        vec.z = reader->ReadFloat();
+    }
+    return list;
+}
+
+static std::vector<SF64::Vec3sData> ReadVec3sPerField(const std::shared_ptr<Ship::BinaryReader>& reader) {
+    std::vector<SF64::Vec3sData> list(reader->ReadUInt32());
+    for (SF64::Vec3sData& vec : list) {
+        vec.x = reader->ReadInt16();
+        vec.y = reader->ReadInt16();
+        vec.z = reader->ReadInt16();
+    }
+    return list;
+}
+
+// GenericArray stores native scalars of one width back to back
+static std::vector<uint8_t> ReadScalarsPerField(const std::shared_ptr<Ship::BinaryReader>& reader, size_t count,
+                                                size_t scalarSize) {
+    std::vector<uint8_t> data(count * scalarSize);
+    for (size_t i = 0; i < count; i++) {
+        uint8_t* out = data.data() + (i * scalarSize);
+        if (scalarSize == 1) {
+            out[0] = reader->ReadUByte();
+        } else if (scalarSize == 2) {
+            uint16_t value = reader->ReadUInt16();
+            memcpy(out, &value, sizeof(value));
+        } else if (scalarSize == 4) {
+            uint32_t value = reader->ReadUInt32();
+            memcpy(out, &value, sizeof(value));
+        } else {
+            uint64_t value = reader->ReadUInt64();
+            memcpy(out, &value, sizeof(value));
+        }
+    }
+    return data;
+}
+
+/* Bulk decoders, the same calls the factories make */
+
+static bool ReadCourseVtxBulk(const std::shared_ptr<Ship::BinaryReader>& reader, std::vector<CourseVtxData>& list) {
+    uint32_t count = reader->ReadUInt32();
+    if (!MK64::ReadRecords(reader, list, count)) {
+        return false;
+    }
+    if (MK64::ReaderNeedsSwap(reader)) {
+        MK64::SwapRecords16(list.data(), count, sizeof(CourseVtxData), 5);
+    }
+    return true;
+}
+
+template <typename T>
+static bool ReadWords16Bulk(const std::shared_ptr<Ship::BinaryReader>& reader, std::vector<T>& list) {
+    uint32_t count = reader->ReadUInt32();
+    if (!MK64::ReadRecords(reader, list, count)) {
+        return false;
+    }
+    if (MK64::ReaderNeedsSwap(reader)) {
+        MK64::SwapWords16(list.data(), count * (sizeof(T) / 2));
+    }
+    return true;
+}
+
+static bool ReadVec3fBulk(const std::shared_ptr<Ship::BinaryReader>& reader, std::vector<SF64::Vec3fData>& list) {
+    uint32_t count = reader->ReadUInt32();
+    if (!MK64::ReadRecords(reader, list, count)) {
+        return false;
+    }
+    if (MK64::ReaderNeedsSwap(reader)) {
+        MK64::SwapWords32(list.data(), count * 3);
+    }
+    return true;
+}
+
+static bool ReadScalarsBulk(const std::shared_ptr<Ship::BinaryReader>& reader, std::vector<uint8_t>& data,
+                            size_t count, size_t scalarSize) {
+    size_t size = count * scalarSize;
+    if (!MK64::ReadRecords(reader, data, size)) {
+        return false;
+    }
+    if (MK64::ReaderNeedsSwap(reader)) {
+        switch (scalarSize) {
+            case 2:
+                MK64::SwapWords16(data.data(), size / 2);
+                break;
+            case 4:
+                MK64::SwapWords32(data.data(), size / 4);
+                break;
+            case 8:
+                MK64::SwapWords64(data.data(), size / 8);
+                break;
+        }
+    }
+    return true;
+}
+
+static void EncodeCourseVtx(Encoder& encoder, uint32_t count) {
+    encoder.U32(count);
+    for (uint32_t i = 0; i < count; i++) {
+        for (int f = 0; f < 5; f++) {
+            encoder.U16(RandomU16());
+        }
+        for (int c = 0; c < 4; c++) {
+            encoder.U8((uint8_t) sRandom());
+        }
+    }
+}
+
+static void EncodeWords16(Encoder& encoder, uint32_t count, size_t words) {
+    encoder.U32(count);
+    for (uint32_t i = 0; i < count * words; i++) {
+        encoder.U16(RandomU16());
+    }
+}
+
+static int TestRecords(Ship::Endianness order) {
+    const char* name = ByteOrderName(order);
+
+    {
+        Encoder encoder(order);
+        std::vector<CourseVtxData> bulk;
+        EncodeCourseVtx(encoder, BULK_RECORDS);
+        CHECK(ReadCourseVtxBulk(encoder.Reader(), bulk), "%s CourseVtx bulk read failed", name);
+        CHECK(SameRecords(bulk, ReadCourseVtxPerField(encoder.Reader())), "%s CourseVtx differ", name);
+    }
+    {
+        Encoder encoder(order);
+        std::vector<TrackPathPoint> bulk;
+        EncodeWords16(encoder, BULK_RECORDS, 4);
+        CHECK(ReadWords16Bulk(encoder.Reader(), bulk), "%s TrackPathPoint bulk read failed", name);
+        CHECK(SameRecords(bulk, ReadPathPerField(encoder.Reader())), "%s TrackPathPoint differ", name);
+    }
+    {
+        Encoder encoder(order);
+        std::vector<ActorSpawnData> bulk;
+        EncodeWords16(encoder, BULK_RECORDS, 4);
+        CHECK(ReadWords16Bulk(encoder.Reader(), bulk), "%s ActorSpawnData bulk read failed", name);
+        CHECK(SameRecords(bulk, ReadSpawnPerField(encoder.Reader())), "%s ActorSpawnData differ", name);
+    }
+    {
+        Encoder encoder(order);
+        std::vector<SF64::Vec3sData> bulk;
+        EncodeWords16(encoder, BULK_RECORDS, 3);
+        CHECK(ReadWords16Bulk(encoder.Reader(), bulk), "%s Vec3s bulk read failed", name);
+        CHECK(SameRecords(bulk, ReadVec3sPerField(encoder.Reader())), "%s Vec3s differ", name);
+    }
+    {
+        Encoder encoder(order);
+        std::vector<SF64::Vec3fData> bulk;
+        encoder.U32(BULK_RECORDS);
+        for (uint32_t i = 0; i < BULK_RECORDS * 3; i++) {
+            encoder.F32(RandomF32());
+        }
+        CHECK(ReadVec3fBulk(encoder.Reader(), bulk), "%s Vec3f bulk read failed", name);
+        CHECK(SameRecords(bulk, ReadVec3fPerField(encoder.Reader())), "%s Vec3f differ", name);
+    }
+    // GenericArray element types come down to 1, 2, 4 and 8 byte scalars
+    for (size_t scalarSize : { 1, 2, 4, 8 }) {
+        Encoder encoder(order);
+        std::vector<uint8_t> bulk;
+        for (size_t i = 0; i < BULK_RECORDS; i++) {
+            encoder.Write(((uint64_t) sRandom() << 32) | sRandom(), scalarSize);
+        }
+        CHECK(ReadScalarsBulk(encoder.Reader(), bulk, BULK_RECORDS, scalarSize), "%s GenericArray bulk read failed",
+              name);
+        CHECK(SameRecords(bulk, ReadScalarsPerField(encoder.Reader(), BULK_RECORDS, scalarSize)),
+              "%s GenericArray of %zu byte scalars differ", name, scalarSize);
+    }
+    return 0;
+}
+
+static int TestTruncated(void) {
+    for (Ship::Endianness order : sByteOrders) {
+        std::vector<CourseVtxData> list(3);
+
+        {
+            // Declares one record more than the data holds
+            Encoder shortEncoder(order);
+            shortEncoder.U32(17);
+            for (int i = 0; i < 16 * 14; i++) {
+                shortEncoder.U8((uint8_t) i);
+            }
+            auto reader = shortEncoder.Reader();
+            uint32_t count = reader->ReadUInt32();
+            CHECK(!MK64::ReaderHasRecords(reader, count, sizeof(CourseVtxData)), "%s count past the end accepted",
+                  ByteOrderName(order));
+            CHECK(MK64::ReaderHasRecords(reader, count - 1, sizeof(CourseVtxData)), "%s exact count refused",
+                  ByteOrderName(order));
+            CHECK(!MK64::ReadRecords(reader, list, count), "%s ReadRecords read past the end",
+                  ByteOrderName(order));
+            CHECK(list.size() == 3, "%s a refused read resized the list to %zu", ByteOrderName(order), list.size());
+        }
+        {
+            // A corrupt count near UINT32_MAX
+            Encoder hugeEncoder(order);
+            hugeEncoder.U32(0xFFFFFFFF);
+            auto reader = hugeEncoder.Reader();
+            CHECK(!MK64::ReaderHasRecords(reader, reader->ReadUInt32(), sizeof(CourseVtxData)),
+                  "%s huge count accepted", ByteOrderName(order));
+        }
+        {
+            Encoder emptyEncoder(order);
+            emptyEncoder.U32(0);
+            auto reader = emptyEncoder.Reader();
+            CHECK(MK64::ReadRecords(reader, list, reader->ReadUInt32()) && list.empty(), "%s empty array",
+                  ByteOrderName(order));
+        }
+    }
+    return 0;
+}
+
+// Timings vary too much between machines to assert on, so they are only printed
+static void Benchmark(void) {
+    for (Ship::Endianness order : sByteOrders) {
+        Encoder encoder(order);
+        std::vector<CourseVtxData> bulk;
+        long long checksum = 0;
+
+        EncodeCourseVtx(encoder, BULK_BENCH_RECORDS);
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < BULK_BENCH_ROUNDS; round++) {
+            checksum += ReadCourseVtxPerField(encoder.Reader())[round].ob[0];
+        }
+        auto middle = std::chrono::steady_clock::now();
+        for (int round = 0; round < BULK_BENCH_ROUNDS; round++) {
+            ReadCourseVtxBulk(encoder.Reader(), bulk);
+            checksum += bulk[round].ob[0];
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        double records = (double) BULK_BENCH_RECORDS * BULK_BENCH_ROUNDS;
+        double perField = std::chrono::duration<double, std::nano>(middle - start).count() / records;
+        double perBulk = std::chrono::duration<double, std::nano>(end - middle).count() / records;
+        printf("CourseVtx %s: per field %.2f ns, bulk %.2f ns per record (%.1fx, checksum %lld)\n",
+               ByteOrderName(order), perField, perBulk, perField / perBulk, checksum);
+    }
+}
+
+int main(void) {
+    for (Ship::Endianness order : sByteOrders) {
+        if (TestRecords(order) != 0) {
+            return 1;
+        }
+    }
+    if (TestTruncated() != 0) {
+        return 1;
+    }
+    Benchmark();
+    return 0;
+}
@@ -0,0 +1,197 @@
+#include <stdio.h>
+
+#include "fixed_timestep.h"
+
+/**
+ * The fixed timestep scheduler driven by a fake clock: tick counts at common display rates, vsync jitter, drift over
+ * long runs, the catch-up cap, the interpolation alpha and a clock that goes backwards.
+ */
+
+#define STEP (NSEC_PER_SEC / 60)
+#define MAX_TICKS 4
+
+#define CHECK(cond, ...)                                         \
+    do {                                                         \
+        if (!(cond)) {                                           \
+            printf("%s:%d: %s: ", __FILE__, __LINE__, #cond);    \
+            printf(__VA_ARGS__);                                 \
+            printf("\n");                                        \
+            return 1;                                            \
+        }                                                        \
+    } while (0)
+
+static uint64_t sNow;
+
+static uint64_t fake_clock(void) {
+    return sNow;
+}
+
+static void start(FixedTimestep* ts) {
+    sNow = 1000 * NSEC_PER_SEC;
+    fixed_timestep_init(ts, fake_clock, STEP, MAX_TICKS);
+    fixed_timestep_advance(ts);
+}
+
+// Frame i of a display running at hz ends at exactly i / hz seconds, so truncation does not add up
+static uint64_t run_display(FixedTimestep* ts, uint64_t hz, uint64_t seconds, uint32_t* minTicks, uint32_t* maxTicks) {
+    uint64_t begin = sNow;
+    uint64_t total = 0;
+
+    *minTicks = UINT32_MAX;
+    *maxTicks = 0;
+    for (uint64_t frame = 1; frame <= hz * seconds; frame++) {
+        uint32_t ticks;
+
+        sNow = begin + frame * NSEC_PER_SEC / hz;
+        ticks = fixed_timestep_advance(ts);
+        total += ticks;
+        *minTicks = (ticks < *minTicks) ? ticks : *minTicks;
+        *maxTicks = (ticks > *maxTicks) ? ticks : *maxTicks;
+    }
+    return total;
+}
+
+static int test_first_frame(void) {
+    FixedTimestep ts;
+
+    sNow = 5 * NSEC_PER_SEC;
+    fixed_timestep_init(&ts, fake_clock, STEP, MAX_TICKS);
+    CHECK(fixed_timestep_advance(&ts) == 0, "the first frame only starts the clock");
+    sNow += STEP;
+    CHECK(fixed_timestep_advance(&ts) == 1, "one step after starting");
+
+    // A reset forgets the time in between, e.g. a load screen
+    fixed_timestep_reset(&ts);
+    sNow += 10 * NSEC_PER_SEC;
+    CHECK(fixed_timestep_advance(&ts) == 0, "the first frame after a reset only restarts the clock");
+    return 0;
+}
+
+static int test_display_rates(void) {
+    static const struct {
+        uint64_t hz;
+        uint32_t minTicks;
+        uint32_t maxTicks;
+    } rates[] = { { 30, 2, 2 }, { 60, 1, 1 }, { 50, 1, 2 }, { 120, 0, 1 }, { 144, 0, 1 }, { 165, 0, 1 } };
+    const uint64_t seconds = 60;
+
+    for (size_t i = 0; i < sizeof(rates) / sizeof(rates[0]); i++) {
+        FixedTimestep ts;
+        uint32_t minTicks;
+        uint32_t maxTicks;
+        uint64_t total;
+
+        start(&ts);
+        total = run_display(&ts, rates[i].hz, seconds, &minTicks, &maxTicks);
+        // Real time speed: 60 ticks a second, give or take the step left in the accumulator
+        CHECK((total + 1 >= 60 * seconds) && (total <= 60 * seconds), "%llu hz ran %llu ticks in %llu s",
+              (unsigned long long) rates[i].hz, (unsigned long long) total, (unsigned long long) seconds);
+        CHECK((minTicks == rates[i].minTicks) && (maxTicks == rates[i].maxTicks), "%llu hz ran %u to %u ticks a frame",
+              (unsigned long long) rates[i].hz, minTicks, maxTicks);
+    }
+    return 0;
+}
+
+static int test_vsync_jitter(void) {
+    FixedTimestep ts;
+    uint64_t total = 0;
+    uint64_t ideal;
+
+    start(&ts);
+    ideal = sNow;
+    for (uint32_t frame = 1; frame <= 1800; frame++) {
+        // 30 fps presents land up to 0.1 ms early or late, so frame times vary by less than the snap window
+        int64_t jitter = (int64_t) ((frame * 7919) % 201) * 1000 - 100000;
+        uint32_t ticks;
+
+        sNow = ideal + frame * NSEC_PER_SEC / 30 + jitter;
+        ticks = fixed_timestep_advance(&ts);
+        CHECK(ticks == 2, "frame %u with %lld ns of jitter ran %u ticks", frame, (long long) jitter, ticks);
+        total += ticks;
+    }
+    CHECK(total == 3600, "jittered 30 fps ran %llu ticks in a minute", (unsigned long long) total);
+    return 0;
+}
+
+static int test_hitch(void) {
+    FixedTimestep ts;
+
+    start(&ts);
+    sNow += STEP / 2;
+    CHECK(fixed_timestep_advance(&ts) == 0, "half a step");
+
+    // A stall must not be followed by a burst of ticks or leave time behind for the next frames
+    sNow += 3 * NSEC_PER_SEC;
+    CHECK(fixed_timestep_advance(&ts) == MAX_TICKS, "a 3 s stall is capped at %u ticks", MAX_TICKS);
+    CHECK(ts.accumulator == 0, "the stall left %llu ns behind", (unsigned long long) ts.accumulator);
+    sNow += STEP;
+    CHECK(fixed_timestep_advance(&ts) == 1, "one step after the stall");
+
+    // Exactly the cap is not a stall
+    sNow += MAX_TICKS * STEP + STEP / 2;
+    CHECK(fixed_timestep_advance(&ts) == MAX_TICKS, "%u steps and a half", MAX_TICKS);
+    CHECK(ts.accumulator == STEP / 2, "kept %llu ns of half a step", (unsigned long long) ts.accumulator);
+    return 0;
+}
+
+static bool near(float a, float b) {
+    return (a - b < 0.0001f) && (b - a < 0.0001f);
+}
+
+static int test_alpha(void) {
+    FixedTimestep ts;
+    uint64_t begin;
+    uint64_t total = 0;
+
+    start(&ts);
+    CHECK(fixed_timestep_alpha(&ts) == 0.0f, "alpha %f before any time passed", fixed_timestep_alpha(&ts));
+    sNow += STEP / 4;
+    CHECK(fixed_timestep_advance(&ts) == 0, "a quarter step");
+    CHECK(near(fixed_timestep_alpha(&ts), 0.25f), "alpha %f after a quarter step", fixed_timestep_alpha(&ts));
+    sNow += STEP;
+    CHECK(fixed_timestep_advance(&ts) == 1, "one more step");
+    CHECK(near(fixed_timestep_alpha(&ts), 0.25f), "alpha %f after a step and a quarter", fixed_timestep_alpha(&ts));
+
+    // At 144 hz the ticks run plus alpha follow the clock, which is what the renderer interpolates to
+    start(&ts);
+    begin = sNow;
+    for (uint64_t frame = 1; frame <= 144; frame++) {
+        float alpha;
+        double clockTicks;
+
+        sNow = begin + frame * NSEC_PER_SEC / 144;
+        total += fixed_timestep_advance(&ts);
+        alpha = fixed_timestep_alpha(&ts);
+        clockTicks = (double) (sNow - begin) / STEP;
+        CHECK((alpha >= 0.0f) && (alpha < 1.0f), "frame %llu alpha %f", (unsigned long long) frame, alpha);
+        CHECK((clockTicks - (total + alpha) < 0.05) && (clockTicks - (total + alpha) > -0.05),
+              "frame %llu is at %f ticks but ran %llu plus %f", (unsigned long long) frame, clockTicks,
+              (unsigned long long) total, alpha);
+    }
+
+    // The catch-up cap drops the time it could not run, alpha included
+    sNow += 3 * NSEC_PER_SEC + STEP / 2;
+    fixed_timestep_advance(&ts);
+    CHECK(fixed_timestep_alpha(&ts) == 0.0f, "alpha %f after a stall", fixed_timestep_alpha(&ts));
+    return 0;
+}
+
+static int test_clock_backwards(void) {
+    FixedTimestep ts;
+
+    start(&ts);
+    sNow -= NSEC_PER_SEC;
+    CHECK(fixed_timestep_advance(&ts) == 0, "a clock going backwards runs nothing");
+    sNow += STEP;
+    CHECK(fixed_timestep_advance(&ts) == 1, "counting resumes from the earlier time");
+    return 0;
+}
+
+int main(void) {
+    if ((test_first_frame() != 0) || (test_display_rates() != 0) || (test_vsync_jitter() != 0) ||
+        (test_hitch() != 0) || (test_alpha() != 0) || (test_clock_backwards() != 0)) {
+        return 1;
+    }
+    printf("fixed timestep: all checks passed\n");
+    return 0;
+}
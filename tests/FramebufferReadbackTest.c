@@ -0,0 +1,180 @@
+#include <stdio.h>
+
+#include "racing/framebuffer_readback.h"
+
+/**
+ * The framebuffer readback queue driven without a renderer: lease expiry, the double buffer flip, dropping a stale
+ * readback once nobody is subscribed and the frame counter wrapping.
+ */
+
+#define CHECK(cond, ...)                                         \
+    do {                                                         \
+        if (!(cond)) {                                           \
+            printf("%s:%d: %s: ", __FILE__, __LINE__, #cond);    \
+            printf(__VA_ARGS__);                                 \
+            printf("\n");                                        \
+            return 1;                                            \
+        }                                                        \
+    } while (0)
+
+// Stands in for the readback buffers; each holds the frame its readback was queued in
+static uint32_t sBuffers[FB_READBACK_BUFFER_COUNT];
+
+/**
+ * Runs one frame the way framebuffer_effects.c does: consumers sample first, then the readback is queued after
+ * rendering. Returns the captured buffer, or -1 if nothing was read back.
+ */
+static int32_t run_frame(FBReadbackQueue* queue, bool subscribe, int32_t* readIndex) {
+    int32_t index;
+
+    if (subscribe) {
+        FBReadback_Subscribe(queue);
+    }
+    *readIndex = FBReadback_GetReadIndex(queue);
+    index = FBReadback_BeginCapture(queue);
+    if (index != -1) {
+        sBuffers[index] = queue->frame;
+    }
+    FBReadback_EndFrame(queue);
+    return index;
+}
+
+static int test_idle(void) {
+    FBReadbackQueue queue;
+    int32_t readIndex;
+
+    FBReadback_Init(&queue);
+    for (int frame = 0; frame < 10; frame++) {
+        CHECK(run_frame(&queue, false, &readIndex) == -1, "frame %d read back with nobody subscribed", frame);
+        CHECK(readIndex == -1, "frame %d sampled buffer %d before any readback", frame, readIndex);
+    }
+    return 0;
+}
+
+static int test_flip(void) {
+    FBReadbackQueue queue;
+    int32_t readIndex;
+    int32_t index;
+
+    FBReadback_Init(&queue);
+    index = run_frame(&queue, true, &readIndex);
+    CHECK(readIndex == -1, "the first subscribed frame has nothing to sample yet");
+    CHECK(index == 0, "the first readback went to buffer %d", index);
+
+    for (uint32_t frame = 1; frame < 100; frame++) {
+        index = run_frame(&queue, true, &readIndex);
+        CHECK(readIndex != -1, "frame %u has nothing to sample", frame);
+        CHECK(sBuffers[readIndex] == frame - 1, "frame %u sampled the readback of frame %u", frame,
+              sBuffers[readIndex]);
+        CHECK(index != -1, "frame %u was not read back while subscribed", frame);
+        CHECK(index != readIndex, "frame %u wrote into buffer %d while it was being sampled", frame, index);
+    }
+    return 0;
+}
+
+static int test_one_capture_per_frame(void) {
+    FBReadbackQueue queue;
+    int32_t first;
+
+    FBReadback_Init(&queue);
+    FBReadback_Subscribe(&queue);
+    first = FBReadback_BeginCapture(&queue);
+    CHECK(FBReadback_BeginCapture(&queue) == first, "a second capture in the same frame used another buffer");
+    FBReadback_EndFrame(&queue);
+    CHECK(FBReadback_GetReadIndex(&queue) == first, "the frame published buffer %d instead of %d",
+          FBReadback_GetReadIndex(&queue), first);
+    return 0;
+}
+
+static int test_lease_expiry(void) {
+    FBReadbackQueue queue;
+    int32_t readIndex;
+
+    // Subscribing once keeps readbacks going for the lease, then they stop
+    FBReadback_Init(&queue);
+    for (int frame = 0; frame < FB_READBACK_LEASE_FRAMES; frame++) {
+        CHECK(run_frame(&queue, frame == 0, &readIndex) != -1, "frame %d is inside the lease", frame);
+    }
+    CHECK(!FBReadback_IsSubscribed(&queue), "the lease outlived %d frames", FB_READBACK_LEASE_FRAMES);
+    CHECK(FBReadback_GetReadIndex(&queue) != -1, "the last readback of the lease was not published");
+    for (int frame = FB_READBACK_LEASE_FRAMES; frame < 10; frame++) {
+        CHECK(run_frame(&queue, false, &readIndex) == -1, "frame %d read back after the lease ran out", frame);
+    }
+
+    // Resubscribing every frame keeps extending it
+    for (int frame = 0; frame < 10; frame++) {
+        CHECK(run_frame(&queue, true, &readIndex) != -1, "resubscribed frame %d was not read back", frame);
+    }
+    return 0;
+}
+
+static int test_stale_frame(void) {
+    FBReadbackQueue queue;
+    int32_t readIndex;
+    int32_t index;
+
+    FBReadback_Init(&queue);
+    for (int frame = 0; frame < FB_READBACK_LEASE_FRAMES; frame++) {
+        run_frame(&queue, frame == 0, &readIndex);
+    }
+
+    // The readback from the last frame of the lease is still fresh for the frame right after it
+    CHECK(FBReadback_GetReadIndex(&queue) != -1, "the last readback was dropped one frame early");
+    run_frame(&queue, false, &readIndex);
+    CHECK(FBReadback_GetReadIndex(&queue) == -1, "a readback outlived the lease by more than a frame");
+
+    // A consumer coming back must not sample the old image, only the one captured after it returned
+    for (int frame = 0; frame < 5; frame++) {
+        run_frame(&queue, false, &readIndex);
+    }
+    index = run_frame(&queue, true, &readIndex);
+    CHECK(readIndex == -1, "a returning consumer sampled a readback from frame %u", sBuffers[readIndex]);
+    CHECK(index != -1, "a returning consumer was not read back");
+    run_frame(&queue, true, &readIndex);
+    CHECK(readIndex == index, "the next frame sampled buffer %d instead of %d", readIndex, index);
+    CHECK(sBuffers[readIndex] == queue.frame - 2, "sampled frame %u, expected %u", sBuffers[readIndex],
+          queue.frame - 2);
+    return 0;
+}
+
+static int test_wraparound(void) {
+    FBReadbackQueue queue;
+    int32_t readIndex;
+    uint32_t start = UINT32_MAX - 4;
+
+    // Continuous subscription straight through the wrap
+    FBReadback_Init(&queue);
+    queue.frame = start;
+    for (int frame = 0; frame < 10; frame++) {
+        uint32_t now = queue.frame;
+
+        CHECK(run_frame(&queue, true, &readIndex) != -1, "frame %u was not read back", now);
+        CHECK((frame == 0) || (sBuffers[readIndex] == now - 1), "frame %u sampled frame %u", now,
+              sBuffers[readIndex]);
+    }
+
+    // A lease taken just before the wrap ends on time after it
+    FBReadback_Init(&queue);
+    queue.frame = UINT32_MAX;
+    CHECK(run_frame(&queue, true, &readIndex) != -1, "the subscribing frame was not read back");
+    CHECK(queue.frame == 0, "the frame counter did not wrap");
+    for (int frame = 1; frame < FB_READBACK_LEASE_FRAMES; frame++) {
+        CHECK(run_frame(&queue, false, &readIndex) != -1, "lease frame %d after the wrap was not read back", frame);
+    }
+    CHECK(run_frame(&queue, false, &readIndex) == -1, "the lease did not end after the wrap");
+
+    // A lease that expired long ago must not come back to life when the counter wraps past it
+    FBReadback_Init(&queue);
+    queue.frame = 0x80000000u;
+    CHECK(!FBReadback_IsSubscribed(&queue), "an old lease counted as active half the counter range later");
+    return 0;
+}
+
+int main(void) {
+    if ((test_idle() != 0) || (test_flip() != 0) || (test_one_capture_per_frame() != 0) ||
+        (test_lease_expiry() != 0) || (test_stale_frame() != 0) || (test_wraparound() != 0)) {
+        return 1;
+    }
+    printf("framebuffer readback: all checks passed\n");
+    return 0;
+}
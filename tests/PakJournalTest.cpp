@@ -0,0 +1,193 @@
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "port/PakJournal.h"
+
+/**
+ * Crash consistency of the controller pak journal. A save that changes one file, removes another and creates a third
+ * is journaled, then the journal is cut short and corrupted at every offset, and the real files are left half
+ * rewritten after every entry. Each time recovery must either replay the whole journal or keep every previous file.
+ */
+
+#define CHECK(cond, ...)                                         \
+    do {                                                         \
+        if (!(cond)) {                                           \
+            printf("%s:%d: %s: ", __FILE__, __LINE__, #cond);    \
+            printf(__VA_ARGS__);                                 \
+            printf("\n");                                        \
+            return 1;                                            \
+        }                                                        \
+    } while (0)
+
+#define JOURNAL "test.journal"
+
+namespace fs = std::filesystem;
+
+typedef std::vector<uint8_t> Bytes;
+
+// exists is false for a file the pak does not have on disk
+struct PakFile {
+    const char* path;
+    bool exists;
+    Bytes data;
+};
+
+static Bytes ToBytes(const char* text) {
+    return Bytes(text, text + strlen(text));
+}
+
+static std::vector<PakFile> OldFiles() {
+    return { { "header.sav", true, ToBytes("header before the save") },
+             { "file_0.sav", true, ToBytes("ghost data") },
+             { "file_1.sav", true, ToBytes("a file the save deletes") },
+             { "file_2.sav", false, {} } };
+}
+
+static std::vector<PakFile> NewFiles() {
+    return { { "header.sav", true, ToBytes("header after the save") },
+             { "file_0.sav", true, ToBytes("longer ghost data written by the save") },
+             { "file_1.sav", false, {} },
+             { "file_2.sav", true, ToBytes("a file the save creates") } };
+}
+
+static std::vector<JournalEntry> SaveEntries() {
+    std::vector<JournalEntry> entries;
+
+    for (const PakFile& file : NewFiles()) {
+        entries.push_back({ file.path, !file.exists, file.data });
+    }
+    return entries;
+}
+
+static void WriteFiles(const std::vector<PakFile>& files) {
+    for (const PakFile& file : files) {
+        if (file.exists) {
+            Pak_WriteWholeFile(file.path, file.data);
+        } else {
+            remove(file.path);
+        }
+    }
+}
+
+static bool FilesMatch(const std::vector<PakFile>& files) {
+    for (const PakFile& file : files) {
+        Bytes data;
+
+        if (Pak_ReadWholeFile(file.path, data) != file.exists) {
+            return false;
+        }
+        if (file.exists && (data != file.data)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static int TestRoundTrip() {
+    std::vector<JournalEntry> entries = SaveEntries();
+    std::vector<JournalEntry> parsed;
+
+    CHECK(Journal_Parse(Journal_Serialize(entries), parsed), "a complete journal did not parse");
+    CHECK(parsed.size() == entries.size(), "%zu of %zu entries parsed", parsed.size(), entries.size());
+    for (size_t i = 0; i < entries.size(); i++) {
+        CHECK((parsed[i].path == entries[i].path) && (parsed[i].remove == entries[i].remove) &&
+                  (parsed[i].data == entries[i].data),
+              "entry %zu changed", i);
+    }
+    return 0;
+}
+
+static int TestTruncated() {
+    Bytes journal = Journal_Serialize(SaveEntries());
+
+    for (size_t size = 0; size <= journal.size(); size++) {
+        WriteFiles(OldFiles());
+        Pak_WriteWholeFile(JOURNAL, Bytes(journal.begin(), journal.begin() + size));
+        Journal_Recover(JOURNAL);
+
+        CHECK(!fs::exists(JOURNAL), "the journal cut at %zu bytes was kept", size);
+        if (size == journal.size()) {
+            CHECK(FilesMatch(NewFiles()), "the complete journal was not replayed");
+        } else {
+            CHECK(FilesMatch(OldFiles()), "the journal cut at %zu of %zu bytes changed the files", size,
+                  journal.size());
+        }
+    }
+    return 0;
+}
+
+static int TestCorrupted() {
+    static const uint8_t flips[] = { 0x01, 0x80, 0xFF };
+    Bytes journal = Journal_Serialize(SaveEntries());
+
+    for (size_t offset = 0; offset < journal.size(); offset++) {
+        for (uint8_t flip : flips) {
+            Bytes corrupted = journal;
+
+            corrupted[offset] ^= flip;
+            WriteFiles(OldFiles());
+            Pak_WriteWholeFile(JOURNAL, corrupted);
+            Journal_Recover(JOURNAL);
+
+            CHECK(!fs::exists(JOURNAL), "the journal corrupted at %zu was kept", offset);
+            CHECK(FilesMatch(OldFiles()), "the journal with byte %zu xored by 0x%02X changed the files", offset, flip);
+        }
+    }
+    return 0;
+}
+
+// A crash after the journal was committed but before every file was rewritten
+static int TestInterruptedApply() {
+    std::vector<JournalEntry> entries = SaveEntries();
+
+    for (size_t applied = 0; applied <= entries.size(); applied++) {
+        WriteFiles(OldFiles());
+        Pak_WriteWholeFile(JOURNAL, Journal_Serialize(entries));
+        Journal_Apply(std::vector<JournalEntry>(entries.begin(), entries.begin() + applied));
+        Journal_Recover(JOURNAL);
+
+        CHECK(!fs::exists(JOURNAL), "the journal was kept after %zu entries had landed", applied);
+        CHECK(FilesMatch(NewFiles()), "recovery after %zu of %zu entries did not finish the save", applied,
+              entries.size());
+    }
+    return 0;
+}
+
+// A journal that cannot be applied yet must survive so the next start can retry
+static int TestFailedApply() {
+    std::vector<JournalEntry> entries = SaveEntries();
+
+    WriteFiles(OldFiles());
+    fs::create_directory("blocked.sav");
+    entries.push_back({ "blocked.sav", false, ToBytes("cannot land") });
+    Pak_WriteWholeFile(JOURNAL, Journal_Serialize(entries));
+    Journal_Recover(JOURNAL);
+    CHECK(fs::exists(JOURNAL), "the journal was deleted although an entry failed");
+
+    fs::remove("blocked.sav");
+    Journal_Recover(JOURNAL);
+    CHECK(!fs::exists(JOURNAL), "the journal was kept after the retry landed");
+    CHECK(FilesMatch(NewFiles()), "the retry did not finish the save");
+    return 0;
+}
+
+int main(void) {
+    fs::path dir = fs::temp_directory_path() / "pak-journal-test";
+    int result;
+
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    fs::current_path(dir);
+
+    result = TestRoundTrip() || TestTruncated() || TestCorrupted() || TestInterruptedApply() || TestFailedApply();
+
+    fs::current_path(fs::temp_directory_path());
+    fs::remove_all(dir);
+    if (result == 0) {
+        printf("pak journal: all checks passed\n");
+    }
+    return result;
+}
@@ -0,0 +1,176 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "replication_codec.h"
+
+/**
+ * Round trip of the replication snapshot codec: random snapshots that change a little every step, encoded against
+ * a random earlier snapshot the way a baseline is picked from the acks, including packets too small for everything.
+ */
+
+#define CODEC_STEPS 4000
+#define CODEC_MTU 1200
+
+#define CHECK(cond, ...)                                         \
+    do {                                                         \
+        if (!(cond)) {                                           \
+            printf("%s:%d: %s: ", __FILE__, __LINE__, #cond);    \
+            printf(__VA_ARGS__);                                 \
+            printf("\n");                                        \
+            return 1;                                            \
+        }                                                        \
+    } while (0)
+
+static uint32_t sRandom = 0x5eed;
+
+static uint32_t next_random(void) {
+    sRandom ^= sRandom << 13;
+    sRandom ^= sRandom >> 17;
+    sRandom ^= sRandom << 5;
+    return sRandom;
+}
+
+static int32_t random_field(void) {
+    switch (next_random() % 4) {
+        case 0:
+            return (int32_t) next_random();
+        case 1:
+            return (next_random() % 2) ? INT32_MAX : INT32_MIN;
+        default:
+            return (int32_t) (next_random() % 2000) - 1000;
+    }
+}
+
+// Moves, adds and removes entities, keeping the list sorted by id
+static void mutate(const ReplicationSnapshot* from, ReplicationSnapshot* to) {
+    uint16_t j = 0;
+
+    to->entityCount = 0;
+    for (uint16_t id = 0; id < 0x3000; id += 0x200) {
+        const ReplicatedEntity* previous = NULL;
+        ReplicatedEntity* entity;
+
+        if ((j < from->entityCount) && (from->entities[j].id == id)) {
+            previous = &from->entities[j++];
+        }
+        if ((previous != NULL) ? ((next_random() % 64) == 0) : ((next_random() % 16) != 0)) {
+            continue;
+        }
+        entity = replication_snapshot_add(to, id);
+        if (entity == NULL) {
+            return;
+        }
+        for (int32_t f = 0; f < REPLICATION_FIELD_COUNT; f++) {
+            entity->fields[f] = (previous != NULL) ? previous->fields[f] : random_field();
+        }
+        // Most entities move a little, some jump or change state
+        if ((next_random() % 4) == 0) {
+            int32_t f = next_random() % REPLICATION_FIELD_COUNT;
+            entity->fields[f] = (int32_t) ((uint32_t) entity->fields[f] + (next_random() % 64) - 32);
+        }
+        if ((next_random() % 64) == 0) {
+            entity->fields[next_random() % REPLICATION_FIELD_COUNT] = random_field();
+        }
+    }
+}
+
+static int same_snapshot(const ReplicationSnapshot* a, const ReplicationSnapshot* b) {
+    if (a->entityCount != b->entityCount) {
+        return 0;
+    }
+    for (uint16_t i = 0; i < a->entityCount; i++) {
+        if (memcmp(&a->entities[i], &b->entities[i], sizeof(ReplicatedEntity)) != 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int test_varints(void) {
+    static const int32_t values[] = { 0, 1, -1, 63, -64, 64, 8191, -8192, 1000000, INT32_MAX, INT32_MIN };
+    uint8_t buffer[sizeof(values) / sizeof(values[0]) * 5];
+    ReplicationWriter writer = { buffer, sizeof(buffer), 0, false };
+    ReplicationReader reader;
+    size_t count = sizeof(values) / sizeof(values[0]);
+
+    for (size_t i = 0; i < count; i++) {
+        replication_write_varint(&writer, values[i]);
+    }
+    CHECK(!writer.overflow, "varints overflowed %zu bytes", sizeof(buffer));
+
+    reader = (ReplicationReader){ buffer, writer.pos, 0, false };
+    for (size_t i = 0; i < count; i++) {
+        int32_t value = replication_read_varint(&reader);
+        CHECK(value == values[i], "varint %zu read back as %d, wrote %d", i, value, values[i]);
+    }
+    CHECK(!reader.overflow && (reader.pos == writer.pos), "read %zu of %zu bytes", reader.pos, writer.pos);
+    replication_read_u8(&reader);
+    CHECK(reader.overflow, "reading past the end did not overflow");
+    return 0;
+}
+
+int main(void) {
+    static ReplicationSnapshot history[REPLICATION_HISTORY];
+    static ReplicationSnapshot sent[REPLICATION_HISTORY];
+    static ReplicationSnapshot decoded;
+    uint8_t buffer[CODEC_MTU];
+    uint32_t partial = 0;
+    uint32_t full = 0;
+
+    if (test_varints() != 0) {
+        return 1;
+    }
+
+    memset(history, 0, sizeof(history));
+    memset(sent, 0, sizeof(sent));
+    for (uint32_t step = 0; step < CODEC_STEPS; step++) {
+        ReplicationSnapshot* current = &history[step % REPLICATION_HISTORY];
+        ReplicationSnapshot* stored = &sent[step % REPLICATION_HISTORY];
+        const ReplicationSnapshot* baseline = NULL;
+        ReplicationWriter writer;
+        ReplicationReader reader;
+        uint16_t records;
+
+        if (step > 0) {
+            mutate(&history[(step - 1) % REPLICATION_HISTORY], current);
+        } else {
+            current->entityCount = 0;
+        }
+        current->sequence = (uint16_t) step;
+
+        // Baselines are always what the receiver reconstructed, never the raw snapshot
+        if ((step > 0) && ((next_random() % 32) != 0)) {
+            uint32_t oldest = (step < REPLICATION_HISTORY - 1) ? step : REPLICATION_HISTORY - 1;
+            uint32_t age = 1 + (next_random() % (((next_random() % 8) == 0) ? oldest : ((oldest < 3) ? oldest : 3)));
+            baseline = &sent[(step - age) % REPLICATION_HISTORY];
+        }
+
+        // Now and then a packet far too small for the snapshot
+        writer = (ReplicationWriter){ buffer, ((next_random() % 16) == 0) ? 64 : sizeof(buffer), 0, false };
+        records = replication_encode_snapshot(&writer, current, baseline, stored);
+        CHECK(!writer.overflow, "step %u: encoder left the writer overflowed", step);
+
+        reader = (ReplicationReader){ buffer, writer.pos, 0, false };
+        CHECK(replication_decode_snapshot(&reader, records, baseline, &decoded), "step %u: decode failed", step);
+        CHECK(reader.pos == writer.pos, "step %u: decoded %zu of %zu bytes", step, reader.pos, writer.pos);
+        CHECK(same_snapshot(&decoded, stored), "step %u: decoded %u entities, sender stored %u", step,
+              decoded.entityCount, stored->entityCount);
+        if (same_snapshot(stored, current)) {
+            full++;
+        } else {
+            partial++;
+        }
+
+        // A record cut short must be rejected rather than half applied
+        if (writer.pos > 0) {
+            reader = (ReplicationReader){ buffer, writer.pos - 1, 0, false };
+            CHECK(!replication_decode_snapshot(&reader, records, baseline, &decoded),
+                  "step %u: truncated packet decoded", step);
+        }
+    }
+    printf("%u snapshots complete, %u cut by the packet size\n", full, partial);
+    CHECK((full > 0) && (partial > 0), "both complete and cut snapshots need to be exercised");
+    CHECK(replication_sequence_newer(0, 0xFFFE) && !replication_sequence_newer(0xFFFE, 0),
+          "sequence wraparound");
+    return 0;
+}
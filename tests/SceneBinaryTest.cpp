@@ -0,0 +1,177 @@
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "engine/StaticMeshActor.h"
+#include "engine/editor/SceneBinary.h"
+
+/**
+ * The editor's binary scene encoding in SceneBinary.cpp: mesh chunks and scene headers must decode to exactly what
+ * was encoded, and every truncated or padded copy must be rejected without leaking the actors decoded before the cut.
+ */
+
+#define CHECK(cond, ...)                                         \
+    do {                                                         \
+        if (!(cond)) {                                           \
+            printf("%s:%d: %s: ", __FILE__, __LINE__, #cond);    \
+            printf(__VA_ARGS__);                                 \
+            printf("\n");                                        \
+            return 1;                                            \
+        }                                                        \
+    } while (0)
+
+// Stand-ins for StaticMeshActor.cpp, which draws through the game's display lists
+StaticMeshActor::StaticMeshActor(std::string name, FVector pos, IRotator rot, FVector scale, std::string model,
+                                 int32_t* collision)
+    : Name(name), Pos(pos), Rot(rot), Scale(scale), Model(model), Collision(collision) {
+}
+
+void StaticMeshActor::Draw() {
+}
+
+void StaticMeshActor::Destroy() {
+    bPendingDestroy = true;
+}
+
+static void DeleteActors(std::vector<StaticMeshActor*>& actors) {
+    for (StaticMeshActor* actor : actors) {
+        delete actor;
+    }
+    actors.clear();
+}
+
+static bool SameFloat(float a, float b) {
+    return memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+static bool SameActor(const StaticMeshActor* a, const StaticMeshActor* b) {
+    return (a->Name == b->Name) && SameFloat(a->Pos.x, b->Pos.x) && SameFloat(a->Pos.y, b->Pos.y) &&
+           SameFloat(a->Pos.z, b->Pos.z) && (a->Rot.pitch == b->Rot.pitch) && (a->Rot.yaw == b->Rot.yaw) &&
+           (a->Rot.roll == b->Rot.roll) && SameFloat(a->Scale.x, b->Scale.x) && SameFloat(a->Scale.y, b->Scale.y) &&
+           SameFloat(a->Scale.z, b->Scale.z) && (a->Model == b->Model);
+}
+
+// Edge values first, then random ones
+static std::vector<StaticMeshActor*> MakeActors(size_t count) {
+    static const float edges[] = { 0.0f, -0.0f, 1.0f, -1e30f, 1e-40f, INFINITY, -INFINITY, NAN };
+    std::mt19937 rng(1234);
+    std::vector<StaticMeshActor*> actors;
+
+    for (size_t i = 0; i < count; i++) {
+        float f = (i < 8) ? edges[i] : std::uniform_real_distribution<float>(-5000.0f, 5000.0f)(rng);
+        auto actor = new StaticMeshActor("", FVector(0, 0, 0), IRotator(0, 0, 0), FVector(1, 1, 1), "", nullptr);
+
+        actor->Name = (i == 0) ? "" : "mesh_" + std::to_string(i) + std::string(i % 7, 'x');
+        actor->Pos = FVector(f, -f, (float) i);
+        actor->Rot.pitch = (i == 1) ? 0xFFFF : (uint16_t) rng();
+        actor->Rot.yaw = (uint16_t) rng();
+        actor->Rot.roll = (uint16_t) i;
+        actor->Scale = FVector(f, 1.0f, 0.5f * i);
+        actor->Model = (i % 3 == 0) ? "" : "__OTR__tracks/custom/model_" + std::to_string(i);
+        actors.push_back(actor);
+    }
+    return actors;
+}
+
+static int TestChunkRoundTrip() {
+    static const size_t counts[] = { 0, 1, 9, SCENE_MESHES_PER_CHUNK };
+
+    for (size_t count : counts) {
+        std::vector<StaticMeshActor*> actors = MakeActors(count);
+        std::vector<uint8_t> bytes = Editor::EncodeSceneMeshChunk(actors.data(), actors.size());
+        std::vector<StaticMeshActor*> decoded = MakeActors(1);
+
+        // Decoding appends after what is already there
+        CHECK(Editor::DecodeSceneMeshChunk(bytes, decoded), "a chunk of %zu actors did not decode", count);
+        CHECK(decoded.size() == count + 1, "decoded %zu actors from a chunk of %zu", decoded.size() - 1, count);
+        for (size_t i = 0; i < count; i++) {
+            CHECK(SameActor(actors[i], decoded[i + 1]), "actor %zu of %zu changed in the round trip", i, count);
+        }
+        CHECK(Editor::EncodeSceneMeshChunk(decoded.data() + 1, count) == bytes,
+              "re-encoding %zu decoded actors gave other bytes", count);
+
+        DeleteActors(actors);
+        DeleteActors(decoded);
+    }
+    return 0;
+}
+
+static int TestChunkTruncated() {
+    std::vector<StaticMeshActor*> actors = MakeActors(20);
+    std::vector<uint8_t> bytes = Editor::EncodeSceneMeshChunk(actors.data(), actors.size());
+
+    for (size_t size = 0; size < bytes.size(); size++) {
+        std::vector<uint8_t> cut(bytes.begin(), bytes.begin() + size);
+        std::vector<StaticMeshActor*> decoded;
+
+        CHECK(!Editor::DecodeSceneMeshChunk(cut, decoded), "a chunk cut at %zu of %zu bytes decoded", size,
+              bytes.size());
+        // Whatever made it out before the cut is whole and the caller owns it
+        CHECK(decoded.size() < actors.size(), "%zu actors out of a chunk cut at %zu bytes", decoded.size(), size);
+        for (size_t i = 0; i < decoded.size(); i++) {
+            CHECK(SameActor(actors[i], decoded[i]), "actor %zu before the cut at %zu changed", i, size);
+        }
+        DeleteActors(decoded);
+    }
+
+    std::vector<StaticMeshActor*> decoded;
+    std::vector<uint8_t> padded = bytes;
+    padded.push_back(0);
+    CHECK(!Editor::DecodeSceneMeshChunk(padded, decoded), "a chunk with a trailing byte decoded");
+    DeleteActors(decoded);
+
+    std::vector<uint8_t> wrongMagic = bytes;
+    wrongMagic[0] ^= 0xFF;
+    CHECK(!Editor::DecodeSceneMeshChunk(wrongMagic, decoded), "a chunk with the wrong magic decoded");
+    CHECK(decoded.empty(), "a chunk with the wrong magic produced %zu actors", decoded.size());
+
+    // A damaged count must stop at the end of the data instead of allocating it
+    std::vector<uint8_t> hugeCount = bytes;
+    memset(&hugeCount[4], 0xFF, 4);
+    CHECK(!Editor::DecodeSceneMeshChunk(hugeCount, decoded), "a chunk claiming 0xFFFFFFFF actors decoded");
+    CHECK(decoded.size() == actors.size(), "%zu actors out of a chunk with a damaged count", decoded.size());
+    DeleteActors(decoded);
+
+    DeleteActors(actors);
+    return 0;
+}
+
+static int TestHeader() {
+    std::vector<uint8_t> props = { 0xA1, 0x64, 'N', 'a', 'm', 'e', 0x63, 'M', 'K', '6' };
+    std::vector<uint8_t> bytes = Editor::EncodeSceneHeader(props, 3, 700);
+    std::vector<uint8_t> decodedProps;
+    uint32_t chunkCount = 0;
+    uint32_t meshCount = 0;
+
+    CHECK(Editor::DecodeSceneHeader(bytes, decodedProps, chunkCount, meshCount), "the header did not decode");
+    CHECK(decodedProps == props, "the props changed in the round trip");
+    CHECK((chunkCount == 3) && (meshCount == 700), "decoded %u chunks and %u meshes", chunkCount, meshCount);
+
+    for (size_t size = 0; size < bytes.size(); size++) {
+        std::vector<uint8_t> cut(bytes.begin(), bytes.begin() + size);
+        CHECK(!Editor::DecodeSceneHeader(cut, decodedProps, chunkCount, meshCount),
+              "a header cut at %zu of %zu bytes decoded", size, bytes.size());
+    }
+    return 0;
+}
+
+static int TestFileNames() {
+    CHECK(Editor::GetBinarySceneFile("tracks/custom/scene.json") == "tracks/custom/scene.bin", "%s",
+          Editor::GetBinarySceneFile("tracks/custom/scene.json").c_str());
+    CHECK(Editor::GetBinarySceneFile("tracks/v1.2/scene") == "tracks/v1.2/scene.bin", "%s",
+          Editor::GetBinarySceneFile("tracks/v1.2/scene").c_str());
+    CHECK(Editor::GetSceneChunkFile("tracks/custom/scene.json", 3) == "tracks/custom/scene_meshes_3.bin", "%s",
+          Editor::GetSceneChunkFile("tracks/custom/scene.json", 3).c_str());
+    return 0;
+}
+
+int main(void) {
+    if ((TestChunkRoundTrip() != 0) || (TestChunkTruncated() != 0) || (TestHeader() != 0) || (TestFileNames() != 0)) {
+        return 1;
+    }
+    printf("scene binary: all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,51 @@
+#include <libultraship.h>
+
+#include "GameTests.h"
+#include "engine/World.h"
+#include "engine/ModelLoader.h"
+
+extern "C" {
+#include "main.h"
+#include "menus.h"
+}
+
+extern ModelLoader gModelLoader;
+
+/**
+ * Loads, races and unloads every registered course several times, with the next course preloading on the worker
+ * thread during each race. Run it in a USE_ASAN build: the checks here only catch hangs and failed loads, the
+ * sanitizer catches the leaks and the use-after-frees.
+ */
+
+#define STRESS_ROUNDS 3
+#define STRESS_RACE_FRAMES 180
+
+static bool IsBattleCourse(size_t courseIndex) {
+    for (s32 slot = 0; slot < NUM_COURSES_PER_CUP; slot++) {
+        if (gCupCourseOrder[BATTLE_CUP][slot] == (s16) courseIndex) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Test_CourseStress(void) {
+    size_t courseCount = gWorldInstance.Courses.size();
+    TEST_CHECK(courseCount > 0, "no courses registered");
+
+    for (s32 round = 0; round < STRESS_ROUNDS; round++) {
+        for (size_t i = 0; i < courseCount; i++) {
+            s32 mode = IsBattleCourse(i) ? BATTLE : TIME_TRIALS;
+            TEST_CHECK(GameTest_StartRace(i, mode), "round %d: course %zu did not start", round, i);
+
+            // Same as confirming the next course in the menus while this one is raced.
+            gModelLoader.Preload(gWorldInstance.Courses[(i + 1) % courseCount]);
+            GameTest_RunFrames(STRESS_RACE_FRAMES);
+
+            TEST_CHECK(GameTest_EndRace(), "round %d: course %zu did not unload", round, i);
+        }
+        printf("[Test] Round %d: %zu courses loaded and unloaded\n", round, courseCount);
+    }
+    gModelLoader.FinishPreload();
+    return true;
+}
@@ -0,0 +1,109 @@
+#include <libultraship.h>
+#include <cstring>
+
+#include "GameTests.h"
+#include "port/Game.h"
+
+extern "C" {
+#include "main.h"
+#include "menus.h"
+#include "code_800029B0.h"
+#include "racing/race_logic.h"
+}
+
+void push_frame();
+
+// Enough for the intro fades and the starting countdown with time to spare.
+#define TEST_FRAME_LIMIT 3000
+
+struct GameTest {
+    const char* Name;
+    bool (*Run)(void);
+};
+
+static const GameTest sGameTests[] = {
+    { "bvh-picking", Test_BVHPicking },
+    { "course-stress", Test_CourseStress },
+    { "savestate-determinism", Test_SaveStateDeterminism },
+    { "replay-roundtrip", Test_ReplayRoundTrip },
+    { "tick-schedule", Test_TickSchedule },
+    { "tick-schedule-bench", Test_TickScheduleBench },
+    { "traffic-golden", Test_TrafficGolden },
+};
+
+static bool sRecordGolden = false;
+
+int RunGameTest(const char* name, bool recordGolden) {
+    sRecordGolden = recordGolden;
+    for (const GameTest& test : sGameTests) {
+        if (strcmp(test.Name, name) == 0) {
+            printf("[Test] %s\n", test.Name);
+            bool passed = test.Run();
+            printf("[Test] %s %s\n", test.Name, passed ? "passed" : "FAILED");
+            return passed ? 0 : 1;
+        }
+    }
+    printf("[Test] Unknown test %s\n", name);
+    return 2;
+}
+
+void GameTest_RunFrames(s32 frames) {
+    for (s32 i = 0; i < frames; i++) {
+        push_frame();
+    }
+}
+
+bool GameTest_IsRecordingGolden(void) {
+    return sRecordGolden;
+}
+
+bool GameTest_StartRace(size_t courseIndex, s32 mode) {
+    return GameTest_StartRaceAtCC(courseIndex, mode, CC_150);
+}
+
+bool GameTest_StartRaceAtCC(size_t courseIndex, s32 mode, s32 cc) {
+    SetCourseById(courseIndex);
+    gCurrentCourseId = GetCourseIndex();
+    if (mode == GRAND_PRIX) {
+        for (s32 cup = 0; cup < NUM_CUPS; cup++) {
+            for (s32 slot = 0; slot < NUM_COURSES_PER_CUP; slot++) {
+                if (gCupCourseOrder[cup][slot] == (s16) courseIndex) {
+                    gCupSelection = cup;
+                    gCourseIndexInCup = slot;
+                }
+            }
+        }
+    }
+
+    // Same path as the debug menu, which keeps the selected course instead of taking the cup's.
+    gMenuSelection = START_MENU;
+    gModeSelection = mode;
+    // Battle needs two players.
+    gPlayerCount = (mode == BATTLE) ? 2 : 1;
+    gScreenModeSelection = (mode == BATTLE) ? SCREEN_MODE_2P_SPLITSCREEN_VERTICAL : SCREEN_MODE_1P;
+    gCCSelection = (mode == BATTLE) ? CC_BATTLE : cc;
+    gIsMirrorMode = (gCCSelection == CC_EXTRA) ? 1 : 0;
+    gGotoMode = RACING;
+    gGamestateNext = RACING;
+
+    for (s32 i = 0; i < TEST_FRAME_LIMIT; i++) {
+        push_frame();
+        if ((gGamestate == RACING) && (gRaceState == RACE_IN_PROGRESS)) {
+            return true;
+        }
+    }
+    printf("[Test] Course %zu never reached RACE_IN_PROGRESS\n", courseIndex);
+    return false;
+}
+
+bool GameTest_EndRace(void) {
+    func_80290338();
+    for (s32 i = 0; i < TEST_FRAME_LIMIT; i++) {
+        push_frame();
+        if ((gGamestate != RACING) && (gCurrentlyLoadedCourseId == COURSE_NULL)) {
+            return true;
+        }
+    }
+    printf("[Test] Race never returned to the menus\n");
+    return false;
+}
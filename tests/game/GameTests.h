@@ -0,0 +1,50 @@
+#pragma once
+
+#include <libultraship.h>
+#include <cstdio>
+
+/**
+ * @file In-game tests
+ *
+ * Tests that need the engine, the extracted archives or a running race are compiled into the game when
+ * BUILD_TESTS is on and are started with `Spaghettify --run-test <name>`. The process exit code is the
+ * result, so ctest can run them like any other test. Pure code (codecs, clocks) is tested by the standalone
+ * executables in tests/ instead.
+ */
+
+#define TEST_CHECK(cond, ...)                                    \
+    do {                                                         \
+        if (!(cond)) {                                           \
+            printf("[Test] %s:%d: %s: ", __FILE__, __LINE__, #cond); \
+            printf(__VA_ARGS__);                                 \
+            printf("\n");                                        \
+            return false;                                        \
+        }                                                        \
+    } while (0)
+
+/**
+ * @brief Runs the test registered as @p name. Returns the process exit code. With @p recordGolden, tests that compare
+ * against files in tests/game/golden rewrite them from this run instead (`--record-golden`).
+ */
+int RunGameTest(const char* name, bool recordGolden);
+
+/**
+ * @brief Loads @p courseIndex the way the debug menu does and runs frames until the countdown is over.
+ * In GRAND_PRIX the cup and cup slot are picked from gCupCourseOrder, so only stock courses work there.
+ */
+bool GameTest_StartRace(size_t courseIndex, s32 mode);
+/** @brief GameTest_StartRace at @p cc instead of 150cc. CC_EXTRA also turns mirror mode on, like the menus do. */
+bool GameTest_StartRaceAtCC(size_t courseIndex, s32 mode, s32 cc);
+/** @brief Quits the race back to the menus and runs frames until the course is unloaded. */
+bool GameTest_EndRace(void);
+void GameTest_RunFrames(s32 frames);
+/** @brief True when the golden files of this run should be written rather than checked. */
+bool GameTest_IsRecordingGolden(void);
+
+bool Test_BVHPicking(void);
+bool Test_CourseStress(void);
+bool Test_SaveStateDeterminism(void);
+bool Test_ReplayRoundTrip(void);
+bool Test_TickSchedule(void);
+bool Test_TickScheduleBench(void);
+bool Test_TrafficGolden(void);
@@ -0,0 +1,148 @@
+#include <libultraship.h>
+#include <cfloat>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "GameTests.h"
+#include "engine/editor/EditorMath.h"
+#include "engine/editor/GameObject.h"
+#include "engine/editor/ObjectPicker.h"
+#include "engine/editor/TriangleBVH.h"
+
+/**
+ * Randomized comparison of the BVH picker against the brute force triangle loop it replaced.
+ * Meshes are shared between objects and objects move between rays, which covers the tree cache too.
+ */
+
+#define PICKING_MESHES 6
+#define PICKING_OBJECTS 24
+#define PICKING_RAYS 4000
+
+static float RandomRange(std::mt19937& rng, float min, float max) {
+    return std::uniform_real_distribution<float>(min, max)(rng);
+}
+
+static FVector RandomPoint(std::mt19937& rng, float extent) {
+    return FVector(RandomRange(rng, -extent, extent), RandomRange(rng, -extent, extent),
+                   RandomRange(rng, -extent, extent));
+}
+
+static std::shared_ptr<const std::vector<Triangle>> RandomMesh(std::mt19937& rng) {
+    auto triangles = std::make_shared<std::vector<Triangle>>();
+    size_t count = 1 + (rng() % 400);
+    float extent = RandomRange(rng, 10.0f, 200.0f);
+    for (size_t i = 0; i < count; i++) {
+        // Mostly small triangles with the odd large one spanning the mesh, like course props.
+        FVector center = RandomPoint(rng, extent);
+        float size = ((rng() % 16) == 0) ? extent : RandomRange(rng, 1.0f, extent * 0.2f);
+        triangles->push_back({ center + RandomPoint(rng, size), center + RandomPoint(rng, size),
+                               center + RandomPoint(rng, size) });
+    }
+    return triangles;
+}
+
+// The picker before the BVH: every triangle of every object, in world space.
+static float BruteForceDistance(const Ray& ray, const Editor::GameObject& object) {
+    float closest = FLT_MAX;
+    for (const Triangle& tri : *object.Triangles) {
+        float t;
+        if (IntersectRayTriangleAndTransform(ray, *object.Pos, tri, t) && t < closest) {
+            closest = t;
+        }
+    }
+    return closest;
+}
+
+static bool SameDistance(float a, float b) {
+    return std::fabs(a - b) <= 1e-3f * std::max(1.0f, std::fabs(b));
+}
+
+bool Test_BVHPicking(void) {
+    std::mt19937 rng(0x5eed);
+
+    // The tree on its own against one mesh.
+    for (size_t i = 0; i < 50; i++) {
+        auto mesh = RandomMesh(rng);
+        Editor::TriangleBVH bvh;
+        bvh.Build(*mesh);
+        for (size_t r = 0; r < 200; r++) {
+            Ray ray = { RandomPoint(rng, 300.0f), RandomPoint(rng, 1.0f) };
+            if (ray.Direction.Dot(ray.Direction) < 1e-4f) {
+                continue;
+            }
+            float expected = FLT_MAX;
+            for (const Triangle& tri : *mesh) {
+                float t;
+                if (IntersectRayTriangle(ray, tri, t) && t < expected) {
+                    expected = t;
+                }
+            }
+            float t = FLT_MAX;
+            bool hit = bvh.Intersect(ray, t);
+            TEST_CHECK(hit == (expected != FLT_MAX), "mesh %zu ray %zu: bvh hit %d, brute force hit %d", i, r, hit,
+                       expected != FLT_MAX);
+            TEST_CHECK(!hit || SameDistance(t, expected), "mesh %zu ray %zu: bvh t %f, brute force t %f", i, r, t,
+                       expected);
+        }
+    }
+
+    // The whole picker: world bounds culling, shared trees and the object space ray.
+    std::vector<std::shared_ptr<const std::vector<Triangle>>> meshes;
+    for (size_t i = 0; i < PICKING_MESHES; i++) {
+        meshes.push_back(RandomMesh(rng));
+    }
+    std::vector<FVector> positions(PICKING_OBJECTS);
+    std::vector<std::unique_ptr<Editor::GameObject>> objects;
+    std::vector<Editor::GameObject*> pointers;
+    for (size_t i = 0; i < PICKING_OBJECTS; i++) {
+        positions[i] = RandomPoint(rng, 1000.0f);
+        objects.push_back(std::make_unique<Editor::GameObject>(
+            "Test", &positions[i], nullptr, nullptr, nullptr, meshes[rng() % PICKING_MESHES],
+            Editor::GameObject::CollisionType::VTX_INTERSECT, 0.0f, nullptr, 0));
+        pointers.push_back(objects.back().get());
+    }
+
+    Editor::ObjectPicker picker;
+    size_t hits = 0;
+    for (size_t r = 0; r < PICKING_RAYS; r++) {
+        // Dragging an object must never need a rebuild, so keep moving them.
+        if ((r % 8) == 0) {
+            positions[rng() % PICKING_OBJECTS] = RandomPoint(rng, 1000.0f);
+        }
+        FVector target = positions[rng() % PICKING_OBJECTS] + RandomPoint(rng, 150.0f);
+        FVector origin = RandomPoint(rng, 1500.0f);
+        FVector direction = target - origin;
+        float length = std::sqrt(direction.Dot(direction));
+        if (length < 1e-3f) {
+            continue;
+        }
+        Ray ray = { origin, direction * (1.0f / length) };
+
+        Editor::GameObject* expected = nullptr;
+        float expectedT = FLT_MAX;
+        for (Editor::GameObject* object : pointers) {
+            float t = BruteForceDistance(ray, *object);
+            if (t < expectedT) {
+                expectedT = t;
+                expected = object;
+            }
+        }
+
+        picker.FindObject(ray, pointers);
+        Editor::GameObject* selected = picker._selected;
+        TEST_CHECK((selected != nullptr) == (expected != nullptr), "ray %zu: picker hit %d, brute force hit %d", r,
+                   selected != nullptr, expected != nullptr);
+        if (selected != nullptr) {
+            hits++;
+            // Two objects at the same distance may resolve either way.
+            float selectedT = BruteForceDistance(ray, *selected);
+            TEST_CHECK(SameDistance(selectedT, expectedT), "ray %zu: picked t %f, closest t %f", r, selectedT,
+                       expectedT);
+        }
+    }
+    printf("[Test] %zu of %d rays hit an object\n", hits, PICKING_RAYS);
+    TEST_CHECK(hits > PICKING_RAYS / 10, "too few rays hit anything for the comparison to mean much");
+    return true;
+}
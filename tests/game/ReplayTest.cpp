@@ -0,0 +1,153 @@
+#include <libultraship.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "GameTests.h"
+#include "engine/World.h"
+#include "port/Game.h"
+
+extern "C" {
+#include "main.h"
+#include "replay_file.h"
+}
+
+/**
+ * Records a replay with save state keyframes during a Grand Prix race, round trips it through
+ * replay_serialize / replay_deserialize and a file, then seeks the loaded copy back and forth. After every
+ * seek the state must match the recording frame by frame while the race simulates forward.
+ */
+
+#define REPLAY_COURSE 0 // Mario Raceway
+#define REPLAY_FRAMES 600
+#define REPLAY_INTERVAL 60
+#define REPLAY_TEST_FILE "replay_roundtrip_test.mkrp"
+
+static bool SameReplay(const Replay& a, const Replay& b) {
+    TEST_CHECK((a.courseId == b.courseId) && (a.characterId == b.characterId) &&
+                   (a.keyframeInterval == b.keyframeInterval) && (a.frameCount == b.frameCount),
+               "headers differ");
+    TEST_CHECK((a.runCount == b.runCount) && (memcmp(a.runs, b.runs, a.runCount * sizeof(u32)) == 0),
+               "input runs differ");
+    TEST_CHECK((a.keyframeCount == b.keyframeCount) &&
+                   (memcmp(a.keyframes, b.keyframes, a.keyframeCount * sizeof(ReplayKeyframe)) == 0),
+               "keyframes differ");
+    for (u32 i = 0; i < a.keyframeCount; i++) {
+        TEST_CHECK(memcmp(a.states[i].data, b.states[i].data, a.keyframes[i].stateSize) == 0,
+                   "state of keyframe %u differs", i);
+        TEST_CHECK(b.states[i].retained, "state of keyframe %u was not retained", i);
+    }
+    return true;
+}
+
+static bool SeekAndPlay(ReplayCursor& cursor, u32 target, const std::vector<u32>& checksums) {
+    u32 previous = cursor.frame;
+    u32 frames = replay_seek(&cursor, target);
+    TEST_CHECK(frames != REPLAY_END, "could not seek to frame %u", target);
+    TEST_CHECK(cursor.frame + frames == target, "seek to %u left the cursor at %u with %u frames to go", target,
+               cursor.frame, frames);
+
+    // The cursor must sit where walking the stream from the start puts it.
+    ReplayCursor walked;
+    replay_cursor_init(&walked, cursor.replay);
+    while (walked.frame < cursor.frame) {
+        replay_cursor_next(&walked);
+    }
+    TEST_CHECK((walked.runIndex == cursor.runIndex) && (walked.runFrame == cursor.runFrame),
+               "frame %u: run %u/%u, walking gives %u/%u", cursor.frame, cursor.runIndex, cursor.runFrame,
+               walked.runIndex, walked.runFrame);
+
+    // Right after a restore the world is exactly the keyframe. Seeking a little forward keeps playing instead.
+    if ((target < previous) || (cursor.frame != previous)) {
+        u32 index = cursor.frame / REPLAY_INTERVAL;
+        u8* state;
+        size_t size = CM_CaptureState(&state);
+        bool same = (size == cursor.replay->keyframes[index].stateSize) &&
+                    (memcmp(state, cursor.replay->states[index].data, size) == 0);
+        CM_ReleaseState(state, size);
+        free(state);
+        TEST_CHECK(same, "state after restoring keyframe %u differs from the keyframe", index);
+    }
+
+    for (u32 i = 0; i < frames; i++) {
+        TEST_CHECK(replay_state_checksum() == checksums[cursor.frame], "desync at frame %u after seeking to %u",
+                   cursor.frame, target);
+        TEST_CHECK(replay_cursor_validate(&cursor) == 0, "keyframe check failed at frame %u", cursor.frame);
+        replay_cursor_next(&cursor);
+        race_logic_step();
+    }
+    TEST_CHECK(replay_state_checksum() == checksums[target], "desync at frame %u", target);
+    return true;
+}
+
+bool Test_ReplayRoundTrip(void) {
+    TEST_CHECK(GameTest_StartRace(REPLAY_COURSE, GRAND_PRIX), "could not start the race");
+
+    Replay recording = {};
+    replay_init(&recording, REPLAY_COURSE, gPlayerOne->characterId, REPLAY_INTERVAL);
+    std::vector<u32> checksums;
+    for (u32 frame = 0; frame <= REPLAY_FRAMES; frame++) {
+        checksums.push_back(replay_state_checksum());
+        if (frame == REPLAY_FRAMES) {
+            break;
+        }
+        replay_record_frame(&recording, replay_encode_controller(gControllerOne));
+        race_logic_step();
+    }
+    TEST_CHECK(recording.keyframeCount == REPLAY_FRAMES / REPLAY_INTERVAL, "%u keyframes", recording.keyframeCount);
+
+    u8* data;
+    size_t size = replay_serialize(&recording, &data);
+    TEST_CHECK(size != 0, "serialize failed");
+    Replay loaded = {};
+    s32 result = replay_deserialize(&loaded, data, size);
+    free(data);
+    TEST_CHECK(result == 0, "deserialize failed");
+    if (!SameReplay(recording, loaded)) {
+        return false;
+    }
+
+    Replay file = {};
+    TEST_CHECK(replay_write_file(&recording, REPLAY_TEST_FILE) == 0, "write failed");
+    result = replay_read_file(&file, REPLAY_TEST_FILE);
+    remove(REPLAY_TEST_FILE);
+    TEST_CHECK(result == 0, "read failed");
+    if (!SameReplay(recording, file)) {
+        return false;
+    }
+    replay_free(&file);
+    replay_free(&recording);
+
+    // Backwards, forwards within a keyframe interval, forwards past keyframes and back to the start.
+    ReplayCursor cursor;
+    replay_cursor_init(&cursor, &loaded);
+    while (cursor.frame < REPLAY_FRAMES) {
+        replay_cursor_next(&cursor);
+    }
+    const u32 targets[] = { 450, 130, 150, 599, 0, 301, REPLAY_FRAMES };
+    for (u32 target : targets) {
+        if (!SeekAndPlay(cursor, target, checksums)) {
+            return false;
+        }
+    }
+    TEST_CHECK(cursor.desyncFrame < 0, "desync at frame %d", cursor.desyncFrame);
+
+    // A converted ghost has no keyframes: it can only play on, not rewind.
+    Replay ghost = {};
+    TEST_CHECK(replay_from_ghost(&ghost, loaded.runs, loaded.runCount, 0, REPLAY_COURSE, 0) == 0, "convert failed");
+    TEST_CHECK((ghost.frameCount == loaded.frameCount) && (ghost.keyframeCount == 0), "%u frames, %u keyframes",
+               ghost.frameCount, ghost.keyframeCount);
+    TEST_CHECK(replay_matches_ghost(&loaded, ghost.runs, REPLAY_GHOST_RUNS), "the ghost does not match its replay");
+    ReplayCursor ghostCursor;
+    replay_cursor_init(&ghostCursor, &ghost);
+    TEST_CHECK(replay_seek(&ghostCursor, 100) == 100, "seeking forward without keyframes");
+    ghostCursor.frame = 100;
+    TEST_CHECK(replay_seek(&ghostCursor, 50) == REPLAY_END, "rewinding without keyframes");
+    replay_free(&ghost);
+
+    replay_free(&loaded);
+    TEST_CHECK(gWorldInstance.StateRefs.empty(), "freed replays still hold %zu entities",
+               gWorldInstance.StateRefs.size());
+    return GameTest_EndRace();
+}
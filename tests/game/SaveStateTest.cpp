@@ -0,0 +1,70 @@
+#include <libultraship.h>
+
+#include "GameTests.h"
+#include "engine/World.h"
+#include "engine/SaveState.h"
+#include "engine/GarbageCollector.h"
+#include "port/Game.h"
+
+extern "C" {
+#include "main.h"
+}
+
+/**
+ * Runs the determinism check of the debug menu headless during a Grand Prix race with CPU drivers, and rewinds
+ * across garbage collections that destroyed and compacted captured entities.
+ */
+
+#define DETERMINISM_COURSE 0 // Mario Raceway
+#define DETERMINISM_ROUNDS 4
+#define DETERMINISM_TICKS 240
+#define REWIND_FRAMES 600
+
+static bool RestoresTo(SaveState& state, uint64_t hash) {
+    TEST_CHECK(state.Restore(), "restore failed");
+    SaveState restored;
+    restored.Capture();
+    TEST_CHECK(restored.Hash() == hash, "restored state %016llx, captured %016llx", (unsigned long long) restored.Hash(),
+               (unsigned long long) hash);
+    return true;
+}
+
+bool Test_SaveStateDeterminism(void) {
+    TEST_CHECK(GameTest_StartRace(DETERMINISM_COURSE, GRAND_PRIX), "could not start the race");
+    // Let the CPUs spread out and pick up items first.
+    GameTest_RunFrames(300);
+
+    for (s32 i = 0; i < DETERMINISM_ROUNDS; i++) {
+        TEST_CHECK(CM_CheckDeterminism(DETERMINISM_TICKS), "round %d", i);
+        GameTest_RunFrames(120);
+    }
+
+    // An object from the middle of the list, so the collector has to compact the survivors.
+    SaveState state;
+    state.Capture();
+    uint64_t hash = state.Hash();
+    TEST_CHECK(gWorldInstance.Objects.size() > 2, "only %zu objects", gWorldInstance.Objects.size());
+    OObject* victim = gWorldInstance.Objects[gWorldInstance.Objects.size() / 2];
+    victim->bPendingDestroy = true;
+    RunGarbageCollector();
+    TEST_CHECK(gWorldInstance.DeadObjects.size() == 1, "%zu buried objects", gWorldInstance.DeadObjects.size());
+    if (!RestoresTo(state, hash)) {
+        return false;
+    }
+    TEST_CHECK(gWorldInstance.DeadObjects.empty(), "the restored object is still buried");
+
+    // Whatever the race itself spawned and collected in the meantime.
+    GameTest_RunFrames(REWIND_FRAMES);
+    printf("[Test] %zu actors and %zu objects buried after %d frames\n", gWorldInstance.DeadActors.size(),
+           gWorldInstance.DeadObjects.size(), REWIND_FRAMES);
+    if (!RestoresTo(state, hash)) {
+        return false;
+    }
+
+    state.Clear();
+    TEST_CHECK(gWorldInstance.DeadActors.empty() && gWorldInstance.DeadObjects.empty() &&
+                   gWorldInstance.StateRefs.empty(),
+               "the graveyard outlived the last save state");
+    GameTest_RunFrames(60);
+    return GameTest_EndRace();
+}
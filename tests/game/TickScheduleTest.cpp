@@ -0,0 +1,280 @@
+#include <libultraship.h>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "GameTests.h"
+#include "engine/World.h"
+#include "engine/SaveState.h"
+
+extern "C" {
+#include "main.h"
+#include "menus.h"
+#include "buffers/random.h"
+}
+
+/**
+ * The tick schedule must call entities in the same order as the plain per-element loops, since objects consume
+ * random_int and draw in list order. Checked on synthetic objects for every pass, then on every Grand Prix course
+ * by racing the same frames both ways from one save state and comparing the RNG and the trajectories.
+ */
+
+#define SCHEDULE_WARMUP_FRAMES 120
+#define SCHEDULE_COMPARE_FRAMES 240
+#define SCHEDULE_ORDER_OBJECTS 500
+#define SCHEDULE_BENCH_OBJECTS 4000
+#define SCHEDULE_BENCH_ROUNDS 200
+
+enum class SchedulePass { Tick, Tick60fps, Draw };
+
+static std::vector<const OObject*> sCalls;
+static bool sRecordCalls = false;
+
+// Roughly the arithmetic of a small object update, so the benchmark is not only call overhead.
+template <uint32_t Kind, uint32_t Flags> class ScheduleTestObject : public OObject {
+public:
+    virtual void Tick() override {
+        Record();
+        o.pos[0] += o.velocity[0] * (f32) (Kind + 1);
+        o.pos[1] += o.velocity[1];
+        o.velocity[1] -= 0.5f;
+    }
+    virtual void Tick60fps() override {
+        Record();
+        o.pos[2] += o.velocity[2];
+    }
+    virtual void Draw(s32 cameraId) override {
+        Record();
+        o.direction_angle[1] += (u16) (Kind + cameraId);
+    }
+    virtual uint32_t GetScheduleFlags() const override {
+        return Flags;
+    }
+
+private:
+    void Record() {
+        if (sRecordCalls) {
+            sCalls.push_back(this);
+        }
+    }
+};
+
+#define TICK_DRAW (OObject::SCHEDULE_TICK | OObject::SCHEDULE_DRAW)
+
+// Like the course objects: mostly tick and draw, a Thwomp style draw only, a mole style tick only and a Lakitu
+// style class that also ticks at 60fps.
+static OObject* MakeScheduleTestObject(uint32_t kind) {
+    switch (kind % 8) {
+        case 0:
+            return new ScheduleTestObject<0, TICK_DRAW>();
+        case 1:
+            return new ScheduleTestObject<1, TICK_DRAW>();
+        case 2:
+            return new ScheduleTestObject<2, OObject::SCHEDULE_DRAW>();
+        case 3:
+            return new ScheduleTestObject<3, TICK_DRAW>();
+        case 4:
+            return new ScheduleTestObject<4, TICK_DRAW>();
+        case 5:
+            return new ScheduleTestObject<5, OObject::SCHEDULE_TICK>();
+        case 6:
+            return new ScheduleTestObject<6, TICK_DRAW>();
+        default:
+            return new ScheduleTestObject<7, TICK_DRAW | OObject::SCHEDULE_TICK_60FPS>();
+    }
+}
+
+/** @brief Swaps synthetic objects in for the world's own for as long as it lives. */
+class ScopedTestObjects {
+public:
+    ScopedTestObjects(size_t count, bool grouped, std::mt19937& rng) {
+        mSaved.swap(gWorldInstance.Objects);
+        for (size_t i = 0; i < count; i++) {
+            // Grouped is how courses spawn them, class by class.
+            uint32_t kind = grouped ? (uint32_t) (i * 8 / count) : (uint32_t) rng();
+            OObject* object = MakeScheduleTestObject(kind);
+            object->o.velocity[0] = (f32) (rng() % 16);
+            gWorldInstance.Objects.push_back(object);
+        }
+        gWorldInstance.InvalidateSchedule();
+    }
+    ~ScopedTestObjects() {
+        for (OObject* object : gWorldInstance.Objects) {
+            delete object;
+        }
+        gWorldInstance.Objects.swap(mSaved);
+        gWorldInstance.InvalidateSchedule();
+        gWorldInstance.bUseSchedule = true;
+    }
+
+private:
+    std::vector<OObject*> mSaved;
+};
+
+static void RunPass(SchedulePass pass) {
+    switch (pass) {
+        case SchedulePass::Tick:
+            gWorldInstance.TickObjects();
+            break;
+        case SchedulePass::Tick60fps:
+            gWorldInstance.TickObjects60fps();
+            break;
+        case SchedulePass::Draw:
+            gWorldInstance.DrawObjects(0);
+            break;
+    }
+}
+
+static uint32_t PassFlag(SchedulePass pass) {
+    switch (pass) {
+        case SchedulePass::Tick:
+            return OObject::SCHEDULE_TICK;
+        case SchedulePass::Tick60fps:
+            return OObject::SCHEDULE_TICK_60FPS;
+        default:
+            return OObject::SCHEDULE_DRAW;
+    }
+}
+
+static bool CheckPassOrder(SchedulePass pass) {
+    std::vector<const OObject*> expected;
+    for (const OObject* object : gWorldInstance.Objects) {
+        if (object->GetScheduleFlags() & PassFlag(pass)) {
+            expected.push_back(object);
+        }
+    }
+
+    sCalls.clear();
+    sRecordCalls = true;
+    RunPass(pass);
+    sRecordCalls = false;
+    TEST_CHECK(sCalls.size() == expected.size(), "pass %d called %zu objects, expected %zu", (int) pass,
+               sCalls.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        TEST_CHECK(sCalls[i] == expected[i], "pass %d: call %zu is out of list order", (int) pass, i);
+    }
+    return true;
+}
+
+static uint64_t HashBytes(uint64_t hash, const void* data, size_t size) {
+    const uint8_t* bytes = (const uint8_t*) data;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// RNG and where everything is after each frame
+static void RecordTrajectory(std::vector<uint64_t>& trajectory) {
+    uint64_t hash = HashBytes(0xcbf29ce484222325ULL, &gRandomSeed16, sizeof(gRandomSeed16));
+    for (s32 i = 0; i < NUM_PLAYERS; i++) {
+        hash = HashBytes(hash, gPlayers[i].pos, sizeof(gPlayers[i].pos));
+    }
+    for (const OObject* object : gWorldInstance.Objects) {
+        hash = HashBytes(hash, object->o.pos, sizeof(object->o.pos));
+    }
+    for (s32 i = 0; i < OBJECT_LIST_SIZE; i++) {
+        hash = HashBytes(hash, gObjectList[i].pos, sizeof(gObjectList[i].pos));
+    }
+    trajectory.push_back(hash);
+}
+
+static bool RaceBothWays(size_t courseIndex) {
+    SaveState start;
+    start.Capture();
+
+    std::vector<uint64_t> trajectories[2];
+    uint64_t hashes[2];
+    for (size_t run = 0; run < 2; run++) {
+        TEST_CHECK(start.Restore(), "course %zu: could not restore the start state", courseIndex);
+        gWorldInstance.bUseSchedule = (run == 0);
+        for (s32 frame = 0; frame < SCHEDULE_COMPARE_FRAMES; frame++) {
+            race_logic_step();
+            RecordTrajectory(trajectories[run]);
+        }
+        SaveState result;
+        result.Capture();
+        hashes[run] = result.Hash();
+    }
+    gWorldInstance.bUseSchedule = true;
+    TEST_CHECK(start.Restore(), "course %zu: could not rewind", courseIndex);
+
+    for (s32 frame = 0; frame < SCHEDULE_COMPARE_FRAMES; frame++) {
+        TEST_CHECK(trajectories[0][frame] == trajectories[1][frame],
+                   "course %zu: scheduled and plain loops diverge at frame %d", courseIndex, frame);
+    }
+    TEST_CHECK(hashes[0] == hashes[1], "course %zu: final state %016llx scheduled, %016llx plain", courseIndex,
+               (unsigned long long) hashes[0], (unsigned long long) hashes[1]);
+    return true;
+}
+
+static bool IsCupCourse(size_t courseIndex) {
+    for (s32 cup = 0; cup < NUM_CUPS; cup++) {
+        for (s32 slot = 0; (cup != BATTLE_CUP) && (slot < NUM_COURSES_PER_CUP); slot++) {
+            if (gCupCourseOrder[cup][slot] == (s16) courseIndex) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool Test_TickSchedule(void) {
+    std::mt19937 rng(0x5eed);
+    for (bool grouped : { true, false }) {
+        ScopedTestObjects objects(SCHEDULE_ORDER_OBJECTS, grouped, rng);
+        for (SchedulePass pass : { SchedulePass::Tick, SchedulePass::Tick60fps, SchedulePass::Draw }) {
+            if (!CheckPassOrder(pass)) {
+                return false;
+            }
+        }
+    }
+
+    size_t raced = 0;
+    for (size_t i = 0; i < gWorldInstance.Courses.size(); i++) {
+        if (!IsCupCourse(i)) {
+            continue;
+        }
+        TEST_CHECK(GameTest_StartRace(i, GRAND_PRIX), "course %zu did not start", i);
+        GameTest_RunFrames(SCHEDULE_WARMUP_FRAMES);
+        printf("[Test] Course %zu: %zu objects\n", i, gWorldInstance.Objects.size());
+        if (!RaceBothWays(i)) {
+            return false;
+        }
+        TEST_CHECK(GameTest_EndRace(), "course %zu did not unload", i);
+        raced++;
+    }
+    TEST_CHECK(raced > 0, "no Grand Prix course registered");
+    return true;
+}
+
+static double TimeTicks(bool useSchedule) {
+    gWorldInstance.bUseSchedule = useSchedule;
+    gWorldInstance.TickObjects();
+    auto start = std::chrono::steady_clock::now();
+    for (s32 i = 0; i < SCHEDULE_BENCH_ROUNDS; i++) {
+        gWorldInstance.TickObjects();
+        gWorldInstance.DrawObjects(0);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / ((double) SCHEDULE_BENCH_ROUNDS * SCHEDULE_BENCH_OBJECTS);
+}
+
+/**
+ * Tick and draw passes over a few thousand mixed objects, scheduled against the plain loops. Timings vary too
+ * much between machines to assert on, so this only prints them; it fails if the schedule loses the list order.
+ */
+bool Test_TickScheduleBench(void) {
+    std::mt19937 rng(0x5eed);
+    for (bool grouped : { true, false }) {
+        ScopedTestObjects objects(SCHEDULE_BENCH_OBJECTS, grouped, rng);
+        double plain = TimeTicks(false);
+        double scheduled = TimeTicks(true);
+        printf("[Test] %d objects %s: plain %.2f ns, scheduled %.2f ns per object and frame\n",
+               SCHEDULE_BENCH_OBJECTS, grouped ? "grouped by class" : "interleaved", plain, scheduled);
+        if (!CheckPassOrder(SchedulePass::Tick) || !CheckPassOrder(SchedulePass::Draw)) {
+            return false;
+        }
+    }
+    return true;
+}
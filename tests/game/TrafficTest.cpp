@@ -0,0 +1,154 @@
+#include <libultraship.h>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "GameTests.h"
+#include "port/Game.h"
+
+extern "C" {
+#include "main.h"
+#include "defines.h"
+#include "actor_types.h"
+extern u16 gRandomSeed16;
+}
+
+/**
+ * Drives Toad's Turnpike in race, time trial and extra mode and compares the traffic against the trajectories in
+ * tests/game/golden: the random seed after every tick, and the position and rotation of every vehicle every
+ * TRAFFIC_SAMPLE_TICKS ticks.
+ *
+ * The vehicles are sampled from the actor list that ATraffic writes back to rather than from its columns. The test
+ * needs nothing from ATraffic, so carried back to a build from before it, where every vehicle was its own actor class,
+ * it records the baseline with `--record-golden`.
+ */
+
+#define TRAFFIC_COURSE COURSE_TOADS_TURNPIKE
+#define TRAFFIC_TICKS 1200
+#define TRAFFIC_SAMPLE_TICKS 30
+// Fixed before loading, so the lanes picked at spawn do not depend on how long the menus ran.
+#define TRAFFIC_SEED 0x1234
+
+struct TrafficRun {
+    const char* Name;
+    s32 Mode;
+    s32 CC;
+};
+
+static const TrafficRun sTrafficRuns[] = {
+    { "race", GRAND_PRIX, CC_150 },
+    { "time-trial", TIME_TRIALS, CC_150 },
+    { "extra", GRAND_PRIX, CC_EXTRA },
+};
+
+static bool IsTrafficActor(s16 type) {
+    return (type == ACTOR_BOX_TRUCK) || (type == ACTOR_SCHOOL_BUS) || (type == ACTOR_TANKER_TRUCK) ||
+           (type == ACTOR_CAR);
+}
+
+static u32 FloatBits(f32 value) {
+    u32 bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// Floats are written as their bits so the comparison is exact.
+static size_t SampleTraffic(std::vector<std::string>& lines, u32 tick) {
+    char line[128];
+    size_t count = 0;
+
+    snprintf(line, sizeof(line), "tick %u seed %04x", tick, gRandomSeed16);
+    lines.push_back(line);
+    if ((tick % TRAFFIC_SAMPLE_TICKS) != 0) {
+        return 0;
+    }
+    for (size_t i = 0; i < CM_GetActorSize(); i++) {
+        const struct Actor* actor = CM_GetActor(i);
+        if (!IsTrafficActor(actor->type)) {
+            continue;
+        }
+        snprintf(line, sizeof(line), "  actor %zu type %d pos %08x %08x %08x rot %d %d %d", i, actor->type,
+                 FloatBits(actor->pos[0]), FloatBits(actor->pos[1]), FloatBits(actor->pos[2]), actor->rot[0],
+                 actor->rot[1], actor->rot[2]);
+        lines.push_back(line);
+        count++;
+    }
+    return count;
+}
+
+static bool ReadLines(const std::string& path, std::vector<std::string>& lines) {
+    std::ifstream file(path);
+    std::string line;
+
+    if (!file.is_open()) {
+        return false;
+    }
+    while (std::getline(file, line)) {
+        lines.push_back(line);
+    }
+    return true;
+}
+
+static bool WriteLines(const std::string& path, const std::vector<std::string>& lines) {
+    std::ofstream file(path, std::ios::trunc);
+
+    if (!file.is_open()) {
+        return false;
+    }
+    for (const std::string& line : lines) {
+        file << line << '\n';
+    }
+    return file.good();
+}
+
+static bool RunTraffic(const TrafficRun& run) {
+    std::string path = std::string(GAME_TEST_GOLDEN_DIR) + "/traffic-" + run.Name + ".txt";
+    std::vector<std::string> lines;
+
+    // The counts are settings outside of time trials; the golden is recorded with the defaults.
+    CVarSetInteger("gNumTrucks", 7);
+    CVarSetInteger("gNumBuses", 7);
+    CVarSetInteger("gNumTankerTrucks", 7);
+    CVarSetInteger("gNumCars", 7);
+    gRandomSeed16 = TRAFFIC_SEED;
+    TEST_CHECK(GameTest_StartRaceAtCC(TRAFFIC_COURSE, run.Mode, run.CC), "%s: could not start the race", run.Name);
+
+    for (u32 tick = 0; tick <= TRAFFIC_TICKS; tick++) {
+        size_t sampled = SampleTraffic(lines, tick);
+        TEST_CHECK((tick != 0) || (sampled != 0), "%s: no vehicles on the road", run.Name);
+        if (tick < TRAFFIC_TICKS) {
+            race_logic_step();
+        }
+    }
+    TEST_CHECK(GameTest_EndRace(), "%s: could not end the race", run.Name);
+
+    if (GameTest_IsRecordingGolden()) {
+        std::filesystem::create_directories(GAME_TEST_GOLDEN_DIR);
+        TEST_CHECK(WriteLines(path, lines), "%s: could not write %s", run.Name, path.c_str());
+        printf("[Test] Recorded %zu lines into %s\n", lines.size(), path.c_str());
+        return true;
+    }
+
+    std::vector<std::string> golden;
+    TEST_CHECK(ReadLines(path, golden), "%s: no golden at %s, record one with --record-golden", run.Name,
+               path.c_str());
+    for (size_t i = 0; (i < lines.size()) && (i < golden.size()); i++) {
+        TEST_CHECK(lines[i] == golden[i], "%s: line %zu is \"%s\", the golden has \"%s\"", run.Name, i + 1,
+                   lines[i].c_str(), golden[i].c_str());
+    }
+    TEST_CHECK(lines.size() == golden.size(), "%s: %zu lines, the golden has %zu", run.Name, lines.size(),
+               golden.size());
+    return true;
+}
+
+bool Test_TrafficGolden(void) {
+    for (const TrafficRun& run : sTrafficRuns) {
+        if (!RunTraffic(run)) {
+            return false;
+        }
+    }
+    return true;
+}